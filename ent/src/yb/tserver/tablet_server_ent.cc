@@ -75,11 +75,13 @@ Status TabletServer::RegisterServices() {
 
   RETURN_NOT_OK(RpcAndWebServerBase::RegisterService(
       FLAGS_ts_backup_svc_queue_length,
-      std::make_unique<TabletServiceBackupImpl>(tablet_manager_.get(), metric_entity())));
+      std::make_unique<TabletServiceBackupImpl>(tablet_manager_.get(), metric_entity()),
+      rpc::ServicePriority::kLow));
 
   RETURN_NOT_OK(RpcAndWebServerBase::RegisterService(
       FLAGS_svc_queue_length_default,
-      std::make_unique<CDCServiceImpl>(tablet_manager_.get(), metric_entity(), metric_registry())));
+      std::make_unique<CDCServiceImpl>(tablet_manager_.get(), metric_entity(), metric_registry()),
+      rpc::ServicePriority::kLow));
 
   return super::RegisterServices();
 }
@@ -24,6 +24,7 @@
 #include "yb/client/table_handle.h"
 
 #include "yb/common/ql_value.h"
+#include "yb/common/read_hybrid_time.h"
 
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/consensus.pb.h"
@@ -85,6 +86,8 @@ DECLARE_double(leader_failure_max_missed_heartbeat_periods);
 DECLARE_int32(TEST_backfill_sabotage_frequency);
 DECLARE_string(regular_tablets_data_block_key_value_encoding);
 DECLARE_string(compression_type);
+DECLARE_int32(max_stale_read_bound_time_ms);
+DECLARE_int32(TEST_follower_read_delay_after_safe_time_ms);
 
 namespace yb {
 namespace client {
@@ -1613,6 +1616,65 @@ TEST_F(QLTabletTest, FollowerRestartDuringWrite) {
   }
 }
 
+// Checks that follower read without read time is served at the follower safe time that was
+// checked for staleness, even when safe time advances before the read picks its read time.
+TEST_F(QLTabletTest, FollowerReadAtCheckedSafeTime) {
+  const auto kDelayMs = FLAGS_raft_heartbeat_interval_ms * 4;
+  const auto kDelay = kDelayMs * 1ms;
+  FLAGS_max_stale_read_bound_time_ms = 60000;
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table, 1);
+  FillTable(0, 1, table);
+
+  const auto tablet_ids = ListTabletIdsForTable(cluster_.get(), table->id());
+  ASSERT_EQ(1, tablet_ids.size());
+  const auto& tablet_id = *tablet_ids.begin();
+
+  int leader_idx = ASSERT_RESULT(ServerWithLeaders(cluster_.get()));
+  int follower_idx = (leader_idx + 1) % cluster_->num_tablet_servers();
+  auto follower = cluster_->mini_tablet_server(follower_idx)->server();
+  auto follower_peer = ASSERT_RESULT(follower->tablet_manager()->LookupTablet(tablet_id));
+
+  tserver::ReadRequestPB req;
+  {
+    std::string partition_key;
+    auto op = CreateReadOp(0, table);
+    ASSERT_OK(op->GetPartitionKey(&partition_key));
+    auto* ql_batch = req.add_ql_batch();
+    *ql_batch = op->request();
+    const auto& hash_code = PartitionSchema::DecodeMultiColumnHashValue(partition_key);
+    ql_batch->set_hash_code(hash_code);
+    ql_batch->set_max_hash_code(hash_code);
+  }
+  req.set_tablet_id(tablet_id);
+  req.set_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
+
+  // Safe time propagated by leader heartbeats advances while the read is delayed.
+  FLAGS_TEST_follower_read_delay_after_safe_time_ms = kDelayMs;
+  auto proxy = std::make_unique<tserver::TabletServerServiceProxy>(
+      &follower->proxy_cache(),
+      HostPort::FromBoundEndpoint(follower->rpc_server()->GetBoundAddresses().front()));
+  rpc::RpcController controller;
+  controller.set_timeout(kDelay + 10s);
+  tserver::ReadResponsePB resp;
+  const auto start = follower->Clock()->Now();
+  ASSERT_OK(proxy->Read(req, &resp, &controller));
+  FLAGS_TEST_follower_read_delay_after_safe_time_ms = 0;
+
+  ASSERT_FALSE(resp.has_error()) << resp.error().ShortDebugString();
+  ASSERT_TRUE(resp.has_used_read_time());
+  const auto used_read_time = ReadHybridTime::FromPB(resp.used_read_time());
+  LOG(INFO) << "Start: " << start << ", used read time: " << used_read_time;
+
+  // Read time was picked before the delay, i.e. it is the safe time checked for staleness.
+  ASSERT_LT(used_read_time.read.GetPhysicalValueMicros(),
+            start.GetPhysicalValueMicros() + ToMicroseconds(kDelay / 2));
+  auto safe_time = follower_peer->tablet()->mvcc_manager()->SafeTimeForFollower(
+      HybridTime::kMin, CoarseTimePoint::min());
+  ASSERT_GT(safe_time, used_read_time.read);
+}
+
 TEST_F_EX(QLTabletTest, DataBlockKeyValueEncoding, QLTabletRf1Test) {
   constexpr auto kNumRows = 4000;
   constexpr auto kNumRowsPerBatch = 100;
@@ -18,12 +18,15 @@
 
 #include "yb/util/async_util.h"
 #include "yb/util/random_util.h"
+#include "yb/util/test_thread_holder.h"
 
 
 using namespace std::literals;
 
+DECLARE_bool(enable_wait_queues);
 DECLARE_int64(transaction_rpc_timeout_ms);
 DECLARE_int32(txn_max_apply_batch_records);
+DECLARE_int32(wait_queue_max_wait_ms);
 
 namespace yb {
 namespace client {
@@ -39,6 +42,7 @@ class SerializableTxnTest
   void TestIncrements(bool transactional);
   void TestIncrement(int key, bool transactional);
   void TestColoring();
+  void TestHotKey(int32_t key, int num_writers, int increments_per_writer, size_t* num_conflicts);
 };
 
 TEST_F(SerializableTxnTest, NonConflictingWrites) {
@@ -388,5 +392,87 @@ TEST_F(SerializableTxnTest, ColoringWithLongApply) {
   TestColoring();
 }
 
+// Multiple writers concurrently increment the same key, each increment in its own transaction.
+// Increments aborted by conflict are retried, and their number is returned in num_conflicts.
+void SerializableTxnTest::TestHotKey(
+    int32_t key, int num_writers, int increments_per_writer, size_t* num_conflicts) {
+  {
+    auto session = CreateSession();
+    auto op = ASSERT_RESULT(WriteRow(session, key, 0));
+    ASSERT_EQ(op->response().status(), QLResponsePB::YQL_STATUS_OK);
+  }
+
+  std::atomic<size_t> conflicts{0};
+  TestThreadHolder thread_holder;
+  for (int i = 0; i != num_writers; ++i) {
+    thread_holder.AddThreadFunctor([this, key, increments_per_writer, &conflicts] {
+      for (int committed = 0; committed != increments_per_writer;) {
+        auto txn = CreateTransaction();
+        auto session = CreateSession(txn);
+        auto op = ASSERT_RESULT(kv_table_test::Increment(&table_, session, key));
+        auto flush_status = session->Flush();
+        if (!flush_status.ok()) {
+          ASSERT_TRUE(flush_status.IsTryAgain()) << flush_status;
+          ++conflicts;
+          continue;
+        }
+        if (op->response().status() == QLResponsePB::YQL_STATUS_RESTART_REQUIRED_ERROR) {
+          continue;
+        }
+        ASSERT_EQ(op->response().status(), QLResponsePB::YQL_STATUS_OK);
+        auto commit_status = txn->CommitFuture().get();
+        if (!commit_status.ok()) {
+          ASSERT_TRUE(commit_status.IsExpired()) << commit_status;
+          ++conflicts;
+          continue;
+        }
+        ++committed;
+      }
+    });
+  }
+  thread_holder.JoinAll();
+
+  auto value = ASSERT_RESULT(SelectRow(CreateSession(), key));
+  ASSERT_EQ(value, num_writers * increments_per_writer);
+  *num_conflicts = conflicts.load();
+}
+
+// Conflicting writers wait in wait queue, while holder of the key is applied, instead of aborting
+// each other. So every increment commits from the first attempt.
+TEST_F(SerializableTxnTest, HotKeyWithWaitQueues) {
+  FLAGS_enable_wait_queues = true;
+  FLAGS_wait_queue_max_wait_ms = 60000;
+  FLAGS_transaction_rpc_timeout_ms = MonoDelta(1min).ToMilliseconds();
+
+  constexpr int kWriters = 8;
+  constexpr int kIncrements = RegularBuildVsSanitizers(20, 5);
+
+  size_t num_conflicts = 0;
+  ASSERT_NO_FATAL_FAILURE(TestHotKey(/* key= */ 0, kWriters, kIncrements, &num_conflicts));
+  ASSERT_EQ(num_conflicts, 0);
+}
+
+// Compares hot key throughput with and without wait queues.
+TEST_F(SerializableTxnTest, DISABLED_HotKeyThroughput) {
+  FLAGS_wait_queue_max_wait_ms = 60000;
+  FLAGS_transaction_rpc_timeout_ms = MonoDelta(1min).ToMilliseconds();
+
+  constexpr int kIncrements = 100;
+
+  int32_t key = 0;
+  for (int num_writers : {1, 4, 16, 64}) {
+    for (bool wait_queues : {false, true}) {
+      FLAGS_enable_wait_queues = wait_queues;
+      auto start = MonoTime::Now();
+      size_t num_conflicts = 0;
+      ASSERT_NO_FATAL_FAILURE(TestHotKey(key++, num_writers, kIncrements, &num_conflicts));
+      auto passed = MonoTime::Now() - start;
+      LOG(INFO) << "Wait queues: " << wait_queues << ", writers: " << num_writers
+                << ", commits/s: " << num_writers * kIncrements / passed.ToSeconds()
+                << ", conflicts: " << num_conflicts;
+    }
+  }
+}
+
 } // namespace client
 } // namespace yb
@@ -65,6 +65,10 @@ class TransactionStatusManagerMock : public TransactionStatusManager {
     return HybridTime::kMin;
   }
 
+  bool MayHaveIntentsInRange(const Slice& lower_bound, const Slice& upper_bound) const override {
+    return true;
+  }
+
   Result<HybridTime> WaitForSafeTime(HybridTime safe_time, CoarseTimePoint deadline) override {
     return STATUS(NotSupported, "WaitForSafeTime not implemented");
   }
@@ -31,6 +31,7 @@
 #include "yb/util/monotime.h"
 #include "yb/util/logging.h"
 #include "yb/util/result.h"
+#include "yb/util/slice.h"
 #include "yb/util/strongly_typed_bool.h"
 #include "yb/util/strongly_typed_uuid.h"
 #include "yb/util/tostring.h"
@@ -165,6 +166,11 @@ class TransactionStatusManager {
   // Returns minimal running hybrid time of all running transactions.
   virtual HybridTime MinRunningHybridTime() const = 0;
 
+  // Returns false when it is known that there are no intents of running transactions with keys in
+  // the specified range. Lower bound is inclusive, upper bound covers itself and all keys that
+  // start with it. Empty bound means that range is not limited from this side.
+  virtual bool MayHaveIntentsInRange(const Slice& lower_bound, const Slice& upper_bound) const = 0;
+
   virtual Result<HybridTime> WaitForSafeTime(HybridTime safe_time, CoarseTimePoint deadline) = 0;
 
   virtual const TabletId& tablet_id() const = 0;
@@ -47,6 +47,7 @@
 #include "yb/consensus/consensus.proxy.h"
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/consensus_queue.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/replicate_msgs_holder.h"
 
 #include "yb/gutil/strings/substitute.h"
@@ -55,6 +56,7 @@
 #include "yb/tserver/tserver.pb.h"
 #include "yb/tserver/tserver_error.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/backoff_waiter.h"
 #include "yb/util/fault_injection.h"
 #include "yb/util/flag_tags.h"
@@ -80,6 +82,8 @@ DEFINE_int32(max_wait_for_processresponse_before_closing_ms,
 TAG_FLAG(max_wait_for_processresponse_before_closing_ms, advanced);
 
 DECLARE_int32(raft_heartbeat_interval_ms);
+DECLARE_bool(enable_multi_raft_heartbeat_batcher);
+DECLARE_int32(consensus_max_in_flight_requests_per_peer);
 
 DEFINE_test_flag(double, fault_crash_on_leader_request_fraction, 0.0,
                  "Fraction of the time when the leader will crash just before sending an "
@@ -110,6 +114,13 @@ using rpc::PeriodicTimer;
 using rpc::RpcController;
 using strings::Substitute;
 
+struct Peer::PipelinedRequest {
+  ConsensusRequestPB request;
+  ConsensusResponsePB response;
+  rpc::RpcController controller;
+  ReplicateMsgsHolder msgs_holder;
+};
+
 Peer::Peer(
     const RaftPeerPB& peer_pb, string tablet_id, string leader_uuid, PeerProxyPtr proxy,
     PeerMessageQueue* queue, ThreadPoolToken* raft_pool_token, Consensus* consensus,
@@ -151,6 +162,11 @@ Status Peer::SignalRequest(RequestTriggerMode trigger_mode) {
   // If there are new requests in the queue we'll get them on ProcessResponse().
   auto performing_lock = LockPerforming(std::try_to_lock);
   if (!performing_lock.owns_lock()) {
+    // Request in flight could be a heartbeat delayed for batching. Send it now, so new operations
+    // or committed index are not delayed by the batch window.
+    if (trigger_mode == RequestTriggerMode::kNonEmptyOnly) {
+      proxy_->FlushDelayedRequests();
+    }
     return Status::OK();
   }
 
@@ -321,11 +337,105 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   // We will cleanup ops from request in ProcessResponse, because otherwise there could be race
   // condition. When rest of this function is running in parallel to ProcessResponse.
   needs_cleanup = false;
+
+  // Request could be completed at any moment after UpdateAsync, so check it before.
+  const bool has_ops = request_.ops_size() > 0;
+  if (has_ops && proxy_->AcceptsSerializedOps()) {
+    msgs_holder.MoveSerializedOps(&controller_);
+  }
   msgs_holder.ReleaseOps();
 
   controller_.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
   proxy_->UpdateAsync(&request_, trigger_mode, &response_, &controller_,
                       std::bind(&Peer::ProcessResponse, retain_self));
+
+  if (has_ops && GetAtomicFlag(&FLAGS_consensus_max_in_flight_requests_per_peer) > 1) {
+    SendPipelinedRequests();
+  }
+}
+
+void Peer::SendPipelinedRequests() {
+  for (;;) {
+    auto pipelined = std::make_shared<PipelinedRequest>();
+    {
+      // Queue is accessed while holding peer_lock_, so it does not happen after Close().
+      auto processing_lock = StartProcessingUnlocked();
+      if (!processing_lock.owns_lock() ||
+          num_pipelined_requests_ + 1 >=
+              GetAtomicFlag(&FLAGS_consensus_max_in_flight_requests_per_peer)) {
+        return;
+      }
+      bool needs_remote_bootstrap = false;
+      auto status = queue_->RequestForPeer(
+          peer_pb_.permanent_uuid(), &pipelined->request, &pipelined->msgs_holder,
+          &needs_remote_bootstrap, nullptr /* member_type */,
+          nullptr /* last_exchange_successful */, true /* pipelined */);
+      if (!status.ok() || pipelined->request.ops().empty()) {
+        return;
+      }
+      ++num_pipelined_requests_;
+    }
+
+    pipelined->request.set_tablet_id(tablet_id_);
+    pipelined->request.set_caller_uuid(leader_uuid_);
+    pipelined->request.set_dest_uuid(peer_pb_.permanent_uuid());
+    VLOG_WITH_PREFIX(2) << "Sending pipelined request with " << pipelined->request.ops_size()
+                        << " operations after " << pipelined->request.preceding_id().ShortDebugString();
+    if (proxy_->AcceptsSerializedOps()) {
+      pipelined->msgs_holder.MoveSerializedOps(&pipelined->controller);
+    }
+
+    pipelined->controller.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
+    proxy_->UpdateAsync(
+        &pipelined->request, RequestTriggerMode::kNonEmptyOnly, &pipelined->response,
+        &pipelined->controller,
+        std::bind(&Peer::ProcessPipelinedResponse, shared_from_this(), pipelined));
+  }
+}
+
+void Peer::ProcessPipelinedResponse(const PipelinedRequestPtr& pipelined) {
+  // Messages are held by msgs_holder, so request should not delete them.
+  pipelined->msgs_holder.Reset();
+
+  Status status = pipelined->controller.status();
+  if (status.ok()) {
+    status = pipelined->controller.thread_pool_failure();
+  }
+
+  const auto& response = pipelined->response;
+  bool more_pending = false;
+  {
+    auto processing_lock = StartProcessingUnlocked();
+    if (!processing_lock.owns_lock()) {
+      return;
+    }
+    --num_pipelined_requests_;
+
+    if (!status.ok() || response.has_error() ||
+        (response.status().has_error() &&
+         response.status().error().code() == consensus::ConsensusErrorPB::CANNOT_PREPARE)) {
+      // Operations that follow the failed request will be retransmitted by regular requests,
+      // starting from the last operation acked by the peer.
+      YB_LOG_WITH_PREFIX_EVERY_N_SECS(INFO, 5)
+          << "Pipelined request failed: " << status << ", response: "
+          << response.ShortDebugString();
+      queue_->RequestFailed(peer_pb_.permanent_uuid());
+      return;
+    }
+
+    if (response.has_propagated_hybrid_time()) {
+      queue_->clock()->Update(HybridTime(response.propagated_hybrid_time()));
+    }
+
+    // Other consensus errors, e.g. LMP mismatch, are handled by the queue.
+    more_pending = queue_->ResponseFromPeer(
+        peer_pb_.permanent_uuid(), response, true /* pipelined */) &&
+        !response.status().has_error();
+  }
+
+  if (more_pending) {
+    SendPipelinedRequests();
+  }
 }
 
 std::unique_lock<simple_spinlock> Peer::StartProcessingUnlocked() {
@@ -471,6 +581,7 @@ void Peer::ProcessRemoteBootstrapResponse() {
 void Peer::ProcessResponseError(const Status& status) {
   DCHECK(performing_mutex_.is_locked());
   failed_attempts_++;
+  queue_->RequestFailed(peer_pb_.permanent_uuid());
   YB_LOG_WITH_PREFIX_EVERY_N_SECS(WARNING, 5) << "Couldn't send request. "
       << " Status: " << status.ToString() << ". Retrying in the next heartbeat period."
       << " Already tried " << failed_attempts_ << " times. State: " << state_;
@@ -525,8 +636,10 @@ void Peer::CleanRequestOps() {
   request_.mutable_ops()->ExtractSubrange(0, request_.ops().size(), nullptr /* elements */);
 }
 
-RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy)
-    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)) {
+RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+                           MultiRaftHeartbeatBatcherPtr multi_raft_batcher)
+    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)),
+      multi_raft_batcher_(std::move(multi_raft_batcher)) {
 }
 
 void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
@@ -534,10 +647,37 @@ void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
                                ConsensusResponsePB* response,
                                rpc::RpcController* controller,
                                const rpc::ResponseCallback& callback) {
+  // Only idle heartbeats are batched, requests with operations or commit index advance are
+  // latency sensitive.
+  if (multi_raft_batcher_ && FLAGS_enable_multi_raft_heartbeat_batcher &&
+      !controller->has_serialized_request_fields() && IsIdleHeartbeat(*request, trigger_mode)) {
+    multi_raft_batcher_->AddRequestToBatch(request, response, controller, callback);
+    return;
+  }
   controller->set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
   consensus_proxy_->UpdateConsensusAsync(*request, response, controller, callback);
 }
 
+bool RpcPeerProxy::IsIdleHeartbeat(
+    const ConsensusRequestPB& request, RequestTriggerMode trigger_mode) {
+  const auto committed_index = request.committed_op_id().index();
+  const bool commit_advanced =
+      committed_index > last_sent_committed_index_.load(std::memory_order_acquire);
+  if (commit_advanced) {
+    UpdateAtomicMax(&last_sent_committed_index_, committed_index);
+  }
+  // Requests without operations triggered by kNonEmptyOnly are sent to propagate committed index,
+  // while heartbeat timer uses kAlwaysSend.
+  return trigger_mode == RequestTriggerMode::kAlwaysSend && request.ops().empty() &&
+         !commit_advanced;
+}
+
+void RpcPeerProxy::FlushDelayedRequests() {
+  if (multi_raft_batcher_) {
+    multi_raft_batcher_->FlushBatch();
+  }
+}
+
 void RpcPeerProxy::RequestConsensusVoteAsync(const VoteRequestPB* request,
                                              VoteResponsePB* response,
                                              rpc::RpcController* controller,
@@ -570,13 +710,18 @@ void RpcPeerProxy::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB* req
 RpcPeerProxy::~RpcPeerProxy() {}
 
 RpcPeerProxyFactory::RpcPeerProxyFactory(
-    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from)
-    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)) {}
+    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+    MultiRaftManager* multi_raft_manager)
+    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)),
+      multi_raft_manager_(multi_raft_manager) {}
 
 PeerProxyPtr RpcPeerProxyFactory::NewProxy(const RaftPeerPB& peer_pb) {
   auto hostport = HostPortFromPB(DesiredHostPort(peer_pb, from_));
   auto proxy = std::make_unique<ConsensusServiceProxy>(proxy_cache_, hostport);
-  return std::make_unique<RpcPeerProxy>(std::move(hostport), std::move(proxy));
+  auto multi_raft_batcher = multi_raft_manager_
+      ? multi_raft_manager_->AddOrGetBatcher(hostport) : nullptr;
+  return std::make_unique<RpcPeerProxy>(
+      std::move(hostport), std::move(proxy), std::move(multi_raft_batcher));
 }
 
 RpcPeerProxyFactory::~RpcPeerProxyFactory() {}
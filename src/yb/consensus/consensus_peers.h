@@ -115,6 +115,11 @@ namespace consensus {
 //        v                               v
 //  SignalRequest()                    return
 //
+// When consensus_max_in_flight_requests_per_peer is greater than 1, after a request with
+// operations is sent, the peer also sends pipelined requests with the following operations,
+// without waiting for the response. Each pipelined request has its own request, response and
+// controller, and its response is processed by ProcessPipelinedResponse().
+//
 class Peer;
 typedef std::shared_ptr<Peer> PeerPtr;
 
@@ -189,6 +194,15 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // Signals there was an error sending the request to the peer.
   void ProcessResponseError(const Status& status);
 
+  struct PipelinedRequest;
+  typedef std::shared_ptr<PipelinedRequest> PipelinedRequestPtr;
+
+  // Sends pipelined requests with operations that follow operations in flight, until there are no
+  // more operations to send or the limit of requests in flight is reached.
+  void SendPipelinedRequests();
+
+  void ProcessPipelinedResponse(const PipelinedRequestPtr& pipelined);
+
   // Returns true if the peer is closed and the calling function should return.
   std::unique_lock<simple_spinlock> StartProcessingUnlocked();
 
@@ -249,6 +263,9 @@ class Peer : public std::enable_shared_from_this<Peer> {
   Consensus* consensus_ = nullptr;
   rpc::Messenger* messenger_ = nullptr;
   std::atomic<int> using_thread_pool_{0};
+
+  // Number of pipelined requests in flight, protected by peer_lock_.
+  int num_pipelined_requests_ = 0;
 };
 
 // A proxy to another peer. Usually a thin wrapper around an rpc proxy but can be replaced for
@@ -292,6 +309,15 @@ class PeerProxy {
     LOG(DFATAL) << "Not implemented";
   }
 
+  // Whether UpdateAsync supports operations passed as serialized request fields of the
+  // controller, instead of the ops field of the request.
+  virtual bool AcceptsSerializedOps() const {
+    return false;
+  }
+
+  // Sends requests that were delayed for batching, if any.
+  virtual void FlushDelayedRequests() {}
+
   virtual ~PeerProxy() {}
 };
 
@@ -313,7 +339,9 @@ class PeerProxyFactory {
 // PeerProxy implementation that does RPC calls
 class RpcPeerProxy : public PeerProxy {
  public:
-  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy);
+  // Heartbeats are sent through multi_raft_batcher when it is specified and batching is enabled.
+  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+               MultiRaftHeartbeatBatcherPtr multi_raft_batcher = nullptr);
 
   virtual void UpdateAsync(const ConsensusRequestPB* request,
                            RequestTriggerMode trigger_mode,
@@ -341,17 +369,31 @@ class RpcPeerProxy : public PeerProxy {
                                        rpc::RpcController* controller,
                                        const rpc::ResponseCallback& callback) override;
 
+  void FlushDelayedRequests() override;
+
+  bool AcceptsSerializedOps() const override {
+    return true;
+  }
+
   virtual ~RpcPeerProxy();
 
  private:
+  // Returns true if request is an idle heartbeat, i.e. it does not carry operations nor
+  // advances committed index known to the peer, so it could be delayed for batching.
+  bool IsIdleHeartbeat(const ConsensusRequestPB& request, RequestTriggerMode trigger_mode);
+
   HostPort hostport_;
   ConsensusServiceProxyPtr consensus_proxy_;
+  MultiRaftHeartbeatBatcherPtr multi_raft_batcher_;
+  // Max committed index sent to the peer.
+  std::atomic<int64_t> last_sent_committed_index_{-1};
 };
 
 // PeerProxyFactory implementation that generates RPCPeerProxies
 class RpcPeerProxyFactory : public PeerProxyFactory {
  public:
-  RpcPeerProxyFactory(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from);
+  RpcPeerProxyFactory(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+                      MultiRaftManager* multi_raft_manager = nullptr);
 
   PeerProxyPtr NewProxy(const RaftPeerPB& peer_pb) override;
 
@@ -363,6 +405,7 @@ class RpcPeerProxyFactory : public PeerProxyFactory {
   rpc::Messenger* messenger_ = nullptr;
   rpc::ProxyCache* const proxy_cache_;
   const CloudInfoPB from_;
+  MultiRaftManager* const multi_raft_manager_;
 };
 
 // Query the consensus service at last known host/port that is specified in 'remote_peer' and set
@@ -48,18 +48,27 @@
 #include "yb/fs/fs_manager.h"
 #include "yb/server/hybrid_clock.h"
 #include "yb/util/metrics.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
 #include "yb/util/threadpool.h"
 
 DECLARE_bool(enable_data_block_fsync);
 DECLARE_int32(consensus_max_batch_size_bytes);
+DECLARE_int32(consensus_max_in_flight_requests_per_peer);
+DECLARE_bool(consensus_adaptive_batching);
+DECLARE_int32(consensus_batch_latency_budget_ms);
 
 METRIC_DECLARE_entity(tablet);
 
+using namespace yb::size_literals;
+
 namespace yb {
 namespace consensus {
 
+METRIC_DECLARE_histogram(raft_batch_size_bytes);
+METRIC_DECLARE_histogram(raft_replication_latency);
+
 static const char* kLeaderUuid = "peer-0";
 static const char* kPeerUuid = "peer-1";
 static const char* kTestTable = "test-table";
@@ -349,6 +358,169 @@ TEST_F(ConsensusQueueTest, TestGetPagedMessages) {
   ASSERT_FALSE(queue_->ResponseFromPeer(response.responder_uuid(), response));
 }
 
+// Tests that pipelined requests continue after operations in flight, and that responses that
+// arrive out of order do not move the peer back.
+TEST_F(ConsensusQueueTest, TestPipelinedRequests) {
+  google::FlagSaver saver;
+  FLAGS_consensus_max_batch_size_bytes = 1024;
+  FLAGS_consensus_max_in_flight_requests_per_peer = 3;
+
+  queue_->Init(OpId::Min());
+  queue_->SetLeaderMode(
+      OpId::Min(), OpId::Min().term, OpId::Min(), BuildRaftConfigPBForTests(2));
+
+  ConsensusRequestPB request;
+  ConsensusResponsePB response;
+  response.set_responder_uuid(kPeerUuid);
+  ASSERT_TRUE(UpdatePeerWatermarkToOp(&request, &response, MinimumOpId(), MinimumOpId()));
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 1, kNumMessages);
+
+  auto last_op_index = [](const ConsensusRequestPB& request) {
+    return request.ops(request.ops_size() - 1).id().index();
+  };
+
+  bool needs_remote_bootstrap;
+  {
+    // Last exchange failed with LMP mismatch, so requests could not be pipelined yet.
+    ConsensusRequestPB pipelined_request;
+    ReplicateMsgsHolder pipelined_refs;
+    ASSERT_NOK(queue_->RequestForPeer(
+        kPeerUuid, &pipelined_request, &pipelined_refs, &needs_remote_bootstrap,
+        nullptr /* member_type */, nullptr /* last_exchange_successful */, true /* pipelined */));
+  }
+
+  ReplicateMsgsHolder refs;
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_GT(request.ops_size(), 0);
+  ASSERT_LT(last_op_index(request), kNumMessages);
+  SetLastReceivedAndLastCommitted(&response, OpId::FromPB(request.ops().rbegin()->id()));
+  ASSERT_TRUE(queue_->ResponseFromPeer(response.responder_uuid(), response));
+
+  refs.Reset();
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_GT(request.ops_size(), 0);
+  const auto first_in_flight = last_op_index(request);
+
+  ConsensusRequestPB pipelined_request;
+  ReplicateMsgsHolder pipelined_refs;
+  ASSERT_OK(queue_->RequestForPeer(
+      kPeerUuid, &pipelined_request, &pipelined_refs, &needs_remote_bootstrap,
+      nullptr /* member_type */, nullptr /* last_exchange_successful */, true /* pipelined */));
+  ASSERT_GT(pipelined_request.ops_size(), 0);
+  ASSERT_EQ(first_in_flight, pipelined_request.preceding_id().index());
+  ASSERT_EQ(first_in_flight + 1, pipelined_request.ops(0).id().index());
+  ASSERT_FALSE(pipelined_request.has_leader_lease_duration_ms());
+  const auto second_in_flight = last_op_index(pipelined_request);
+
+  // Response to the pipelined request arrives first.
+  ConsensusResponsePB pipelined_response;
+  pipelined_response.set_responder_uuid(kPeerUuid);
+  SetLastReceivedAndLastCommitted(&pipelined_response, OpId::FromPB(
+      pipelined_request.ops().rbegin()->id()));
+  ASSERT_TRUE(queue_->ResponseFromPeer(kPeerUuid, pipelined_response, true /* pipelined */));
+  SetLastReceivedAndLastCommitted(&response, OpId::FromPB(request.ops().rbegin()->id()));
+  ASSERT_TRUE(queue_->ResponseFromPeer(kPeerUuid, response));
+  ASSERT_EQ(second_in_flight + 1, queue_->GetTrackedPeerForTests(kPeerUuid).next_index);
+
+  // After failure, operations are retransmitted starting from the last acked operation.
+  refs.Reset();
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_EQ(second_in_flight + 1, request.ops(0).id().index());
+  pipelined_refs.Reset();
+  pipelined_request.Clear();
+  ASSERT_OK(queue_->RequestForPeer(
+      kPeerUuid, &pipelined_request, &pipelined_refs, &needs_remote_bootstrap,
+      nullptr /* member_type */, nullptr /* last_exchange_successful */, true /* pipelined */));
+  ASSERT_EQ(last_op_index(request) + 1, pipelined_request.ops(0).id().index());
+  queue_->RequestFailed(kPeerUuid);
+  pipelined_refs.Reset();
+  pipelined_request.Clear();
+  ASSERT_NOK(queue_->RequestForPeer(
+      kPeerUuid, &pipelined_request, &pipelined_refs, &needs_remote_bootstrap,
+      nullptr /* member_type */, nullptr /* last_exchange_successful */, true /* pipelined */));
+  refs.Reset();
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_EQ(second_in_flight + 1, request.ops(0).id().index());
+}
+
+TEST_F(ConsensusQueueTest, TestAdaptiveBatchSize) {
+  google::FlagSaver saver;
+  FLAGS_consensus_batch_latency_budget_ms = 5;
+
+  PeerMessageQueue::TrackedPeer peer(kPeerUuid);
+  ASSERT_EQ(FLAGS_consensus_max_batch_size_bytes, peer.AdaptiveBatchSizeBytes());
+
+  // The first request establishes the minimal round trip time.
+  peer.UpdateTransferEstimates(MonoDelta::FromMilliseconds(10), 1_KB);
+  ASSERT_EQ(FLAGS_consensus_max_batch_size_bytes, peer.AdaptiveBatchSizeBytes());
+
+  // 1MB transferred in about 10ms above the minimal round trip time, so about 512KB fits 5ms
+  // budget.
+  peer.UpdateTransferEstimates(MonoDelta::FromMilliseconds(20), 1_MB);
+  ASSERT_GE(peer.min_rtt_us, 10000);
+  ASSERT_GT(peer.AdaptiveBatchSizeBytes(), static_cast<int64_t>(500_KB));
+  ASSERT_LT(peer.AdaptiveBatchSizeBytes(), static_cast<int64_t>(550_KB));
+
+  // Batch size is bounded by consensus_max_batch_size_bytes.
+  FLAGS_consensus_batch_latency_budget_ms = 1000;
+  ASSERT_EQ(FLAGS_consensus_max_batch_size_bytes, peer.AdaptiveBatchSizeBytes());
+}
+
+TEST_F(ConsensusQueueTest, TestAdaptiveBatching) {
+  google::FlagSaver saver;
+  FLAGS_consensus_adaptive_batching = true;
+  FLAGS_consensus_max_in_flight_requests_per_peer = 3;
+
+  queue_->Init(OpId::Min());
+  queue_->SetLeaderMode(
+      OpId::Min(), OpId::Min().term, OpId::Min(), BuildRaftConfigPBForTests(2));
+
+  ConsensusRequestPB request;
+  ConsensusResponsePB response;
+  response.set_responder_uuid(kPeerUuid);
+  ASSERT_TRUE(UpdatePeerWatermarkToOp(&request, &response, MinimumOpId(), MinimumOpId()));
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 1, 10);
+
+  bool needs_remote_bootstrap;
+  ReplicateMsgsHolder refs;
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_EQ(10, request.ops_size());
+  SetLastReceivedAndLastCommitted(&response, OpId::FromPB(request.ops().rbegin()->id()));
+  ASSERT_TRUE(queue_->ResponseFromPeer(response.responder_uuid(), response));
+
+  auto batch_size = METRIC_raft_batch_size_bytes.Instantiate(metric_entity_);
+  auto latency = METRIC_raft_replication_latency.Instantiate(metric_entity_);
+  ASSERT_EQ(1, batch_size->TotalCount());
+  ASSERT_EQ(10, latency->TotalCount());
+  auto tracked_peer = queue_->GetTrackedPeerForTests(kPeerUuid);
+  ASSERT_GT(tracked_peer.smoothed_rtt_us, 0);
+  ASSERT_TRUE(tracked_peer.sent_requests.empty());
+
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 11, 10);
+  refs.Reset();
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_EQ(10, request.ops_size());
+
+  // A few small operations are not worth a pipelined request, while the response is expected
+  // within the latency budget.
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 21, 1);
+  ConsensusRequestPB pipelined_request;
+  ReplicateMsgsHolder pipelined_refs;
+  auto status = queue_->RequestForPeer(
+      kPeerUuid, &pipelined_request, &pipelined_refs, &needs_remote_bootstrap,
+      nullptr /* member_type */, nullptr /* last_exchange_successful */, true /* pipelined */);
+  ASSERT_TRUE(status.IsIncomplete()) << status;
+  ASSERT_EQ(0, pipelined_request.ops_size());
+
+  // Without adaptive batching they are sent immediately.
+  FLAGS_consensus_adaptive_batching = false;
+  ASSERT_OK(queue_->RequestForPeer(
+      kPeerUuid, &pipelined_request, &pipelined_refs, &needs_remote_bootstrap,
+      nullptr /* member_type */, nullptr /* last_exchange_successful */, true /* pipelined */));
+  ASSERT_EQ(1, pipelined_request.ops_size());
+  ASSERT_EQ(2U, queue_->GetTrackedPeerForTests(kPeerUuid).sent_requests.size());
+}
+
 TEST_F(ConsensusQueueTest, TestPeersDontAckBeyondWatermarks) {
   queue_->Init(OpId::Min());
   queue_->SetLeaderMode(
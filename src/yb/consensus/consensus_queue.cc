@@ -113,6 +113,38 @@ DEFINE_int32(consensus_lagging_follower_threshold, 10,
 TAG_FLAG(consensus_lagging_follower_threshold, advanced);
 TAG_FLAG(consensus_lagging_follower_threshold, runtime);
 
+DEFINE_int32(consensus_max_in_flight_requests_per_peer, 1,
+             "Maximum number of UpdateConsensus requests with operations that the leader keeps "
+             "in flight to a single peer. Values greater than 1 pipeline replication, so the "
+             "throughput to followers with high round trip time is not bound by latency.");
+TAG_FLAG(consensus_max_in_flight_requests_per_peer, advanced);
+TAG_FLAG(consensus_max_in_flight_requests_per_peer, runtime);
+
+DEFINE_bool(consensus_send_serialized_ops, true,
+            "Keep operations serialized in the log cache and send them to followers from this "
+            "serialized form, instead of serializing them again for every peer and retry.");
+TAG_FLAG(consensus_send_serialized_ops, advanced);
+TAG_FLAG(consensus_send_serialized_ops, runtime);
+
+DEFINE_bool(consensus_adaptive_batching, false,
+            "Choose the size of batches sent to each peer from the measured round trip time and "
+            "bandwidth to this peer, instead of always using consensus_max_batch_size_bytes. Also "
+            "delay small pipelined requests while the round trip time is within "
+            "consensus_batch_latency_budget_ms.");
+TAG_FLAG(consensus_adaptive_batching, advanced);
+TAG_FLAG(consensus_adaptive_batching, runtime);
+
+DEFINE_int32(consensus_batch_latency_budget_ms, 5,
+             "Target time to transfer a single batch of operations to a peer, used by adaptive "
+             "batching.");
+TAG_FLAG(consensus_batch_latency_budget_ms, advanced);
+TAG_FLAG(consensus_batch_latency_budget_ms, runtime);
+
+DEFINE_int32(consensus_min_adaptive_batch_size_bytes, 64_KB,
+             "Minimal size of a batch of operations chosen by adaptive batching.");
+TAG_FLAG(consensus_min_adaptive_batch_size_bytes, advanced);
+TAG_FLAG(consensus_min_adaptive_batch_size_bytes, runtime);
+
 DEFINE_test_flag(bool, disallow_lmp_failures, false,
                  "Whether we disallow PRECEDING_ENTRY_DIDNT_MATCH failures for non new peers.");
 
@@ -156,6 +188,13 @@ METRIC_DEFINE_gauge_int64(tablet, in_progress_ops, "Leader Operations in Progres
                           MetricUnit::kOperations,
                           "Number of operations in the leader queue ack'd by a minority of "
                           "peers.");
+METRIC_DEFINE_coarse_histogram(tablet, raft_batch_size_bytes, "Raft Batch Size",
+                               MetricUnit::kBytes,
+                               "Size of batches of operations sent by the leader to peers.");
+METRIC_DEFINE_coarse_histogram(tablet, raft_replication_latency, "Raft Replication Latency",
+                               MetricUnit::kMicroseconds,
+                               "Time from sending an operation to a peer till the peer acks it, "
+                               "counted per operation.");
 
 const auto kCDCConsumerCheckpointInterval = FLAGS_cdc_checkpoint_opid_interval_ms * 1ms;
 
@@ -169,10 +208,10 @@ std::string PeerMessageQueue::TrackedPeer::ToString() const {
   return Format(
       "{ peer: $0 is_new: $1 last_received: $2 next_index: $3 last_known_committed_idx: $4 "
       "is_last_exchange_successful: $5 needs_remote_bootstrap: $6 member_type: $7 "
-      "num_sst_files: $8 last_applied: $9 }",
+      "num_sst_files: $8 last_applied: $9 last_in_flight_index: $10 }",
       uuid, is_new, last_received, next_index, last_known_committed_idx,
       is_last_exchange_successful, needs_remote_bootstrap, RaftPeerPB::MemberType_Name(member_type),
-      num_sst_files, last_applied);
+      num_sst_files, last_applied, last_in_flight_index);
 }
 
 void PeerMessageQueue::TrackedPeer::ResetLeaderLeases() {
@@ -186,11 +225,46 @@ void PeerMessageQueue::TrackedPeer::ResetLastRequest() {
   current_retransmissions = -1;
 }
 
+void PeerMessageQueue::TrackedPeer::UpdateTransferEstimates(
+    MonoDelta round_trip_time, size_t bytes) {
+  const auto rtt_us = std::max<int64_t>(round_trip_time.ToMicroseconds(), 1);
+  if (smoothed_rtt_us == 0) {
+    smoothed_rtt_us = rtt_us;
+    min_rtt_us = rtt_us;
+  } else {
+    // Same smoothing as for TCP round trip time.
+    smoothed_rtt_us += (rtt_us - smoothed_rtt_us) / 8;
+    // Slowly forget old minimum, so min_rtt_us follows changes of the network latency.
+    min_rtt_us = rtt_us <= min_rtt_us ? rtt_us : min_rtt_us + (rtt_us - min_rtt_us) / 64;
+  }
+
+  // Time above the minimal round trip time is spent transferring the batch.
+  const auto transfer_us = rtt_us - min_rtt_us;
+  if (transfer_us <= 0) {
+    return;
+  }
+  const auto sample = static_cast<double>(bytes) / transfer_us;
+  bytes_per_us = bytes_per_us == 0 ? sample : bytes_per_us + (sample - bytes_per_us) / 8;
+}
+
+int64_t PeerMessageQueue::TrackedPeer::AdaptiveBatchSizeBytes() const {
+  const int64_t max_size = GetAtomicFlag(&FLAGS_consensus_max_batch_size_bytes);
+  if (bytes_per_us == 0) {
+    return max_size;
+  }
+  const auto budget_us = GetAtomicFlag(&FLAGS_consensus_batch_latency_budget_ms) * 1000;
+  const int64_t min_size = GetAtomicFlag(&FLAGS_consensus_min_adaptive_batch_size_bytes);
+  const auto size = static_cast<int64_t>(bytes_per_us * budget_us);
+  return std::min(std::max(size, min_size), max_size);
+}
+
 #define INSTANTIATE_METRIC(x) \
   x.Instantiate(metric_entity, 0)
 PeerMessageQueue::Metrics::Metrics(const scoped_refptr<MetricEntity>& metric_entity)
   : num_majority_done_ops(INSTANTIATE_METRIC(METRIC_majority_done_ops)),
-    num_in_progress_ops(INSTANTIATE_METRIC(METRIC_in_progress_ops)) {
+    num_in_progress_ops(INSTANTIATE_METRIC(METRIC_in_progress_ops)),
+    batch_size_bytes(METRIC_raft_batch_size_bytes.Instantiate(metric_entity)),
+    replication_latency(METRIC_raft_replication_latency.Instantiate(metric_entity)) {
 }
 #undef INSTANTIATE_METRIC
 
@@ -425,12 +499,17 @@ uint64_t GetNumMessagesToSendWithBackoff(int64_t last_num_messages_sent) {
   return std::max<int64_t>((last_num_messages_sent >> 1) - 1, 0);
 }
 
+bool PipelineRequests() {
+  return GetAtomicFlag(&FLAGS_consensus_max_in_flight_requests_per_peer) > 1;
+}
+
 Status PeerMessageQueue::RequestForPeer(const string& uuid,
                                         ConsensusRequestPB* request,
                                         ReplicateMsgsHolder* msgs_holder,
                                         bool* needs_remote_bootstrap,
                                         RaftPeerPB::MemberType* member_type,
-                                        bool* last_exchange_successful) {
+                                        bool* last_exchange_successful,
+                                        bool pipelined) {
   static constexpr uint64_t kSendUnboundedLogOps = std::numeric_limits<uint64_t>::max();
   DCHECK(request->ops().empty()) << request->ShortDebugString();
 
@@ -441,6 +520,9 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
   int64_t previously_sent_index;
   uint64_t num_log_ops_to_send;
   HybridTime propagated_safe_time;
+  int64_t batch_size_limit = GetAtomicFlag(&FLAGS_consensus_max_batch_size_bytes);
+  // Whether a pipelined request should be sent only when it has enough operations.
+  bool wait_for_full_batch = false;
 
   // Should be before now_ht, i.e. not greater than propagated_hybrid_time.
   if (context_) {
@@ -460,7 +542,17 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     HybridTime now_ht;
 
     is_new = peer->is_new;
-    if (!is_new) {
+    if (pipelined) {
+      // Pipelined request could be acked before the request that carries the lease, so it should
+      // not extend leases.
+      if (is_new || !peer->is_last_exchange_successful || peer->needs_remote_bootstrap ||
+          peer->last_in_flight_index == 0) {
+        return STATUS(Incomplete, "Peer is not ready for pipelined requests");
+      }
+      now_ht = clock_->Now();
+      request->clear_leader_lease_duration_ms();
+      request->clear_ht_lease_expiration();
+    } else if (!is_new) {
       now_ht = clock_->Now();
 
       auto ht_lease_expiration_micros = now_ht.GetPhysicalValueMicros() +
@@ -520,7 +612,13 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     *needs_remote_bootstrap = peer->needs_remote_bootstrap;
 
     previously_sent_index = peer->next_index - 1;
-    if (FLAGS_enable_consensus_exponential_backoff && peer->last_num_messages_sent >= 0) {
+    if (peer->is_last_exchange_successful && PipelineRequests()) {
+      // Continue after operations that are already in flight to the peer, last_in_flight_index is
+      // reset after any failure.
+      previously_sent_index = std::max(previously_sent_index, peer->last_in_flight_index);
+    }
+    if (FLAGS_enable_consensus_exponential_backoff && peer->last_num_messages_sent >= 0 &&
+        !pipelined) {
       // Previous request to peer has not been acked. Reduce number of entries to be sent
       // in this attempt using exponential backoff. Note that to_index is inclusive.
       num_log_ops_to_send = GetNumMessagesToSendWithBackoff(peer->last_num_messages_sent);
@@ -530,14 +628,25 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
       num_log_ops_to_send = kSendUnboundedLogOps;
     }
 
-    peer->current_retransmissions++;
+    if (!pipelined) {
+      peer->current_retransmissions++;
+    }
 
     if (peer->member_type == RaftPeerPB::VOTER) {
       is_voter = true;
     }
+
+    if (GetAtomicFlag(&FLAGS_consensus_adaptive_batching)) {
+      batch_size_limit = peer->AdaptiveBatchSizeBytes();
+      // Response to the request in flight is expected within the latency budget, and all
+      // operations accumulated till then will be sent after it.
+      wait_for_full_batch = pipelined &&
+          peer->smoothed_rtt_us <= GetAtomicFlag(&FLAGS_consensus_batch_latency_budget_ms) * 1000;
+    }
   }
 
-  if (unreachable_time.ToSeconds() > FLAGS_follower_unavailable_considered_failed_sec) {
+  if (!pipelined &&
+      unreachable_time.ToSeconds() > FLAGS_follower_unavailable_considered_failed_sec) {
     if (!is_voter || CountVoters(*queue_state_.active_config) > 2) {
       // We never drop from 2 voters to 1 voter automatically, at least for now (12/4/18). We may
       // want to revisit this later, we're just being cautious with this.
@@ -566,7 +675,7 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
   // Otherwise, we grab requests from the log starting at the last_received point.
   if (!is_new && num_log_ops_to_send > 0) {
     // The batch of messages to send to the peer.
-    int max_batch_size = FLAGS_consensus_max_batch_size_bytes - request->ByteSize();
+    int max_batch_size = static_cast<int>(batch_size_limit) - request->ByteSize();
     auto to_index = num_log_ops_to_send == kSendUnboundedLogOps ?
         0 : previously_sent_index + num_log_ops_to_send;
     auto result = ReadFromLogCache(previously_sent_index, to_index, max_batch_size, uuid);
@@ -581,6 +690,13 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
       return result.status();
     }
 
+    // Sizes are already computed by the log cache, from serialized ops when they are cached.
+    const auto batch_bytes = static_cast<size_t>(result->total_size);
+    if (wait_for_full_batch && !result->have_more_messages &&
+        batch_bytes < static_cast<size_t>(batch_size_limit / 2)) {
+      return STATUS(Incomplete, "Waiting for more operations to fill the batch");
+    }
+
     preceding_id = result->preceding_op;
     // We use AddAllocated rather than copy, because we pin the log cache at the "all replicated"
     // point. At some point we may want to allow partially loading (and not pinning) earlier
@@ -596,15 +712,43 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
         return STATUS(NotFound, "Peer not tracked.");
       }
 
-      peer->last_num_messages_sent = result->messages.size();
+      if (!pipelined) {
+        peer->last_num_messages_sent = result->messages.size();
+      }
+      if (!result->messages.empty() && PipelineRequests()) {
+        peer->last_in_flight_index = std::max(
+            peer->last_in_flight_index, result->messages.back()->id().index());
+      }
+      if (!result->messages.empty()) {
+        // Requests that overlap with this one are retransmitted, so they are not tracked anymore.
+        const auto first_index = result->messages.front()->id().index();
+        while (!peer->sent_requests.empty() &&
+               peer->sent_requests.back().last_index >= first_index) {
+          peer->sent_requests.pop_back();
+        }
+        peer->sent_requests.push_back(TrackedPeer::SentRequest {
+          .last_index = result->messages.back()->id().index(),
+          .num_ops = static_cast<int64_t>(result->messages.size()),
+          .bytes = batch_bytes,
+          .send_time = CoarseMonoClock::Now(),
+        });
+      }
+    }
+    if (!request->ops().empty()) {
+      metrics_.batch_size_bytes->Increment(batch_bytes);
     }
 
     ScopedTrackedConsumption consumption;
     if (result->read_from_disk_size) {
       consumption = ScopedTrackedConsumption(operations_mem_tracker_, result->read_from_disk_size);
     }
+    std::vector<RefCntBuffer> serialized_ops;
+    if (GetAtomicFlag(&FLAGS_consensus_send_serialized_ops)) {
+      serialized_ops = log_cache_.GetSerializedOps(result->messages);
+    }
     *msgs_holder = ReplicateMsgsHolder(
-        request->mutable_ops(), std::move(result->messages), std::move(consumption));
+        request->mutable_ops(), std::move(result->messages), std::move(consumption),
+        std::move(serialized_ops));
 
     if (propagated_safe_time &&
         !result->have_more_messages &&
@@ -1063,9 +1207,30 @@ void PeerMessageQueue::RequestWasNotSent(const std::string& peer_uuid) {
   peer->ResetLastRequest();
 }
 
+void PeerMessageQueue::RequestFailed(const std::string& peer_uuid) {
+  LockGuard scoped_lock(queue_lock_);
+  TrackedPeer* peer = FindPtrOrNull(peers_map_, peer_uuid);
+  if (peer) {
+    peer->last_in_flight_index = 0;
+    peer->sent_requests.clear();
+  }
+}
+
+void PeerMessageQueue::ProcessAckedRequestsUnlocked(TrackedPeer* peer) {
+  auto now = CoarseMonoClock::Now();
+  while (!peer->sent_requests.empty() &&
+         peer->sent_requests.front().last_index <= peer->last_received.index) {
+    const auto& sent = peer->sent_requests.front();
+    auto latency = MonoDelta(now - sent.send_time);
+    metrics_.replication_latency->IncrementBy(latency.ToMicroseconds(), sent.num_ops);
+    peer->UpdateTransferEstimates(latency, sent.bytes);
+    peer->sent_requests.pop_front();
+  }
+}
 
 bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
-                                        const ConsensusResponsePB& response) {
+                                        const ConsensusResponsePB& response,
+                                        bool pipelined) {
   DCHECK(response.IsInitialized()) << "Error: Uninitialized: "
       << response.InitializationErrorString() << ". Response: " << response.ShortDebugString();
 
@@ -1142,7 +1307,12 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
       // log, which is guaranteed by the Raft protocol to be a valid op.
 
       bool peer_has_prefix_of_log = IsOpInLog(yb::OpId::FromPB(status.last_received()));
-      if (peer_has_prefix_of_log) {
+      if (peer_has_prefix_of_log && !status.has_error() && PipelineRequests() &&
+          OpId::FromPB(status.last_received()) < previous.last_received) {
+        // Response to an earlier request arrived after response to a later request, keep the
+        // latest state of the peer.
+        VLOG_WITH_PREFIX_UNLOCKED(2) << "Outdated response from peer: " << peer->ToString();
+      } else if (peer_has_prefix_of_log) {
         // If the latest thing in their log is in our log, we are in sync.
         peer->last_received = OpId::FromPB(status.last_received());
         peer->next_index = peer->last_received.index + 1;
@@ -1163,8 +1333,15 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
         peer->next_index = peer->last_known_committed_idx + 1;
       }
 
+      if (peer->next_index > peer->last_in_flight_index) {
+        peer->last_in_flight_index = 0;
+      }
+
       if (PREDICT_FALSE(status.has_error())) {
         peer->is_last_exchange_successful = false;
+        // Operations in flight will be rejected by the peer, retransmit from next_index.
+        peer->last_in_flight_index = 0;
+        peer->sent_requests.clear();
         switch (status.error().code()) {
           case ConsensusErrorPB::PRECEDING_ENTRY_DIDNT_MATCH: {
             DCHECK(status.has_last_received());
@@ -1196,6 +1373,7 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
 
     peer->is_last_exchange_successful = true;
     peer->num_sst_files = response.num_sst_files();
+    ProcessAckedRequestsUnlocked(peer);
 
     if (response.has_responder_term()) {
       // The peer must have responded with a term that is greater than or equal to the last known
@@ -1228,8 +1406,10 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
         }
       }
 
-      peer->leader_lease_expiration.OnReplyFromFollower();
-      peer->leader_ht_lease_expiration.OnReplyFromFollower();
+      if (!pipelined) {
+        peer->leader_lease_expiration.OnReplyFromFollower();
+        peer->leader_ht_lease_expiration.OnReplyFromFollower();
+      }
 
       majority_replicated.op_id = queue_state_.majority_replicated_op_id;
       majority_replicated.leader_lease_expiration = LeaderLeaseExpirationWatermark();
@@ -33,6 +33,7 @@
 #ifndef YB_CONSENSUS_CONSENSUS_QUEUE_H_
 #define YB_CONSENSUS_CONSENSUS_QUEUE_H_
 
+#include <deque>
 #include <iosfwd>
 #include <map>
 #include <string>
@@ -59,6 +60,7 @@
 namespace yb {
 template<class T>
 class AtomicGauge;
+class Histogram;
 class MemTracker;
 class MetricEntity;
 class ThreadPoolToken;
@@ -106,8 +108,16 @@ struct FollowerWatermark {
 // This also takes care of pushing requests to peers as new operations are added, and notifying
 // RaftConsensus when the commit index advances.
 //
-// TODO Currently this class is able to track one outstanding operation per peer. If we want to have
-// more than one outstanding RPC we need to modify it.
+// When consensus_max_in_flight_requests_per_peer is greater than 1, the leader could send pipelined
+// requests to a peer, that continue after the last operation sent in a request that was not acked
+// yet. next_index is still advanced only by responses, so after any failure operations are
+// retransmitted starting from the last operation acked by the peer.
+//
+// When consensus_adaptive_batching is enabled, the size of a batch sent to a peer is chosen from
+// the round trip time and bandwidth measured for this peer, so that transferring a batch takes
+// about consensus_batch_latency_budget_ms. Also small pipelined requests are not sent while the
+// round trip time is within the budget. Operations accumulated meanwhile are sent after the
+// response to the request in flight, like in Nagle's algorithm.
 class PeerMessageQueue {
  public:
   struct TrackedPeer {
@@ -128,6 +138,13 @@ class PeerMessageQueue {
 
     void ResetLastRequest();
 
+    // Updates round trip time and bandwidth estimates using a request of the specified size that
+    // was acked after round_trip_time.
+    void UpdateTransferEstimates(MonoDelta round_trip_time, size_t bytes);
+
+    // Returns the maximum size of a batch to this peer, chosen by adaptive batching.
+    int64_t AdaptiveBatchSizeBytes() const;
+
     // UUID of the peer.
     const std::string uuid;
 
@@ -143,6 +160,10 @@ class PeerMessageQueue {
     // Number of retransmissions from same next_index_.
     int64_t current_retransmissions = -1;
 
+    // Index of the last operation sent to this peer in a request that was not acked yet, or 0.
+    // Used only when requests are pipelined, next requests continue after this operation.
+    int64_t last_in_flight_index = 0;
+
     // The last operation that we've sent to this peer and that it acked. Used for watermark
     // movement.
     OpId last_received = yb::OpId::Min();
@@ -179,6 +200,28 @@ class PeerMessageQueue {
 
     uint64_t num_sst_files = 0;
 
+    // Request with operations that was sent to this peer and was not acked yet.
+    struct SentRequest {
+      // Index of the last operation in the request.
+      int64_t last_index;
+      int64_t num_ops;
+      size_t bytes;
+      CoarseTimePoint send_time;
+    };
+
+    // Requests in flight, ordered by last_index. Used to measure replication latency, round trip
+    // time and bandwidth.
+    std::deque<SentRequest> sent_requests;
+
+    // Smoothed and minimal round trip time of requests with operations, in microseconds.
+    // 0 if not measured yet.
+    int64_t smoothed_rtt_us = 0;
+    int64_t min_rtt_us = 0;
+
+    // Smoothed bandwidth to this peer, i.e. bytes transferred per microsecond of round trip time
+    // above min_rtt_us. 0 if not measured yet.
+    double bytes_per_us = 0;
+
    private:
     // The last term we saw from a given peer.
     // This is only used for sanity checking that a peer doesn't
@@ -265,13 +308,18 @@ class PeerMessageQueue {
   // not delete the entries. The simplest way is to pass the same instance of ConsensusRequestPB to
   // RequestForPeer(): the buffer will replace the old entries with new ones without de-allocating
   // the old ones if they are still required.
+  //
+  // If pipelined is true, the request is an additional request sent while other requests to this
+  // peer are in flight. Such request contains operations only if the last exchange with the peer
+  // was successful, and does not extend leader leases.
   virtual CHECKED_STATUS RequestForPeer(
       const std::string& uuid,
       ConsensusRequestPB* request,
       ReplicateMsgsHolder* msgs_holder,
       bool* needs_remote_bootstrap,
       RaftPeerPB::MemberType* member_type = nullptr,
-      bool* last_exchange_successful = nullptr);
+      bool* last_exchange_successful = nullptr,
+      bool pipelined = false);
 
   // Fill in a StartRemoteBootstrapRequest for the specified peer.  If that peer should not remotely
   // bootstrap, returns a non-OK status.  On success, also internally resets
@@ -287,11 +335,17 @@ class PeerMessageQueue {
 
   // Updates the request queue with the latest response of a peer, returns whether this peer has
   // more requests pending.
+  // pipelined should be true for responses to pipelined requests, see RequestForPeer.
   virtual bool ResponseFromPeer(const std::string& peer_uuid,
-                                const ConsensusResponsePB& response);
+                                const ConsensusResponsePB& response,
+                                bool pipelined = false);
 
   void RequestWasNotSent(const std::string& peer_uuid);
 
+  // Notifies the queue that a request to the peer failed, so operations in flight to this peer
+  // should not be taken into account by the following requests.
+  void RequestFailed(const std::string& peer_uuid);
+
   // Closes the queue, peers are still allowed to call UntrackPeer() and ResponseFromPeer() but no
   // additional peers can be tracked or messages queued.
   virtual void Close();
@@ -336,6 +390,10 @@ class PeerMessageQueue {
     scoped_refptr<AtomicGauge<int64_t> > num_majority_done_ops;
     // Keeps track of the number of ops. that are still in progress (IsDone() returns false).
     scoped_refptr<AtomicGauge<int64_t> > num_in_progress_ops;
+    // Size of batches of operations sent to peers.
+    scoped_refptr<Histogram> batch_size_bytes;
+    // Time from sending an operation to a peer till the peer acks it, counted per operation.
+    scoped_refptr<Histogram> replication_latency;
 
     explicit Metrics(const scoped_refptr<MetricEntity>& metric_entity);
   };
@@ -506,6 +564,10 @@ class PeerMessageQueue {
   // Updates op id replicated on each non-lagging node.
   void UpdateAllNonLaggingReplicatedOpId(int32_t threshold) REQUIRES(queue_lock_);
 
+  // Removes requests acked by the peer from sent_requests, updating replication latency and
+  // transfer estimates of the peer.
+  void ProcessAckedRequestsUnlocked(TrackedPeer* peer) REQUIRES(queue_lock_);
+
   // Policy is responsible for tuning of watermark calculation.
   // I.e. simple leader lease or hybrid time leader lease etc.
   // It should provide result type and a function for extracting a value from a peer.
@@ -33,16 +33,19 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <thread>
 #include <vector>
 
 #include <boost/function.hpp>
 #include <glog/stl_logging.h>
 
 #include "yb/consensus/log-test-base.h"
+#include "yb/consensus/log_group_sync.h"
 #include "yb/consensus/log_index.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/util/path_util.h"
 #include "yb/util/random.h"
 
 DEFINE_int32(num_batches, 10000,
@@ -212,6 +215,55 @@ TEST_F(LogTest, TestMultipleEntriesInABatch) {
   ASSERT_OK(log_->Close());
 }
 
+class LogCompressionTest : public LogTest,
+                           public testing::WithParamInterface<LogEntryCompression> {
+};
+
+// Tests that compressed entry batches are transparently uncompressed by the reader.
+TEST_P(LogCompressionTest, TestCompressedEntries) {
+  options_.entry_compression = GetParam();
+  BuildLog();
+
+  constexpr int kNumBatches = 10;
+  constexpr int kOpsPerBatch = 50;
+  OpIdPB opid;
+  opid.set_term(1);
+  opid.set_index(1);
+  int uncompressed_size = 0;
+  for (int i = 0; i != kNumBatches; ++i) {
+    ASSERT_OK(AppendNoOpsToLogSync(clock_, log_.get(), &opid, kOpsPerBatch, &uncompressed_size));
+  }
+  // Small batch is written without compression.
+  ASSERT_OK(AppendNoOpsToLogSync(clock_, log_.get(), &opid, 1));
+  ASSERT_OK(log_->AllocateSegmentAndRollOver());
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  auto read_entries = segments[0]->ReadEntries();
+  ASSERT_OK(read_entries.status);
+  ASSERT_EQ(kNumBatches * kOpsPerBatch + 1, read_entries.entries.size());
+  for (size_t i = 0; i != read_entries.entries.size(); ++i) {
+    ASSERT_EQ(static_cast<int64_t>(i + 1), read_entries.entries[i]->replicate().id().index());
+  }
+
+  auto written_size = segments[0]->readable_up_to() - segments[0]->first_entry_offset();
+  if (GetParam() == LogEntryCompression::kNone) {
+    ASSERT_GE(written_size, uncompressed_size);
+  } else {
+    ASSERT_LT(written_size, uncompressed_size);
+  }
+
+  auto loaded_op = ASSERT_RESULT(log_->GetLogReader()->LookupOpId(kOpsPerBatch + 1));
+  ASSERT_EQ(yb::OpId(1, kOpsPerBatch + 1), loaded_op);
+
+  ASSERT_OK(log_->Close());
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Compression, LogCompressionTest,
+    ::testing::Values(
+        LogEntryCompression::kNone, LogEntryCompression::kSnappy, LogEntryCompression::kLZ4));
+
 // Tests that everything works properly with fsync enabled:
 // This also tests SyncDir() (see KUDU-261), which is called whenever
 // a new log segment is initialized.
@@ -227,6 +279,88 @@ TEST_F(LogTest, TestFsync) {
   ASSERT_OK(log_->Close());
 }
 
+#if defined(__linux__)
+// Tests durable writes synced by group sync shared with other logs on the same file system.
+TEST_F(LogTest, TestGroupSync) {
+  auto group_sync_result = LogGroupSync::ForPath(tablet_wal_path_);
+  if (!group_sync_result.ok()) {
+    LOG(INFO) << "Group sync is not supported: " << group_sync_result.status();
+    return;
+  }
+  auto group_sync = *group_sync_result;
+  ASSERT_EQ(group_sync, ASSERT_RESULT(LogGroupSync::ForPath(DirName(tablet_wal_path_))));
+
+  options_.durable_wal_write = true;
+  options_.durable_wal_write_group_sync = true;
+  BuildLog();
+
+  // Second log on the same file system, that shares group sync with the first one.
+  const auto other_wal_path = JoinPathSegments(DirName(tablet_wal_path_), "other-tablet");
+  ASSERT_OK(env_->CreateDir(other_wal_path));
+  scoped_refptr<Log> other_log;
+  ASSERT_OK(Log::Open(options_,
+                      "other-tablet",
+                      other_wal_path,
+                      fs_manager_->uuid(),
+                      SchemaBuilder(schema_).Build(),
+                      0, // schema_version
+                      table_metric_entity_.get(),
+                      tablet_metric_entity_.get(),
+                      log_thread_pool_.get(),
+                      log_thread_pool_.get(),
+                      std::numeric_limits<int64_t>::max(), // cdc_min_replicated_index
+                      &other_log));
+
+  constexpr int kNumThreads = 4;
+  constexpr int kNumSyncsPerThread = 100;
+  constexpr int kNumOps = 100;
+
+  const auto num_syncs_before = group_sync->num_syncs();
+
+  // Concurrent syncs share group sync.
+  std::vector<std::thread> threads;
+  for (int i = 0; i != kNumThreads; ++i) {
+    threads.emplace_back([group_sync] {
+      for (int j = 0; j != kNumSyncsPerThread; ++j) {
+        CHECK_OK(group_sync->Sync());
+      }
+    });
+  }
+  threads.emplace_back([this, other_log] {
+    OpIdPB opid;
+    opid.set_term(0);
+    opid.set_index(1);
+    for (int i = 0; i != kNumOps; ++i) {
+      CHECK_OK(AppendNoOpToLogSync(clock_, other_log.get(), &opid));
+    }
+  });
+
+  OpIdPB opid;
+  opid.set_term(0);
+  opid.set_index(1);
+  ASSERT_OK(AppendNoOps(&opid, kNumOps));
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+  ASSERT_OK(other_log->WaitUntilAllFlushed());
+  ASSERT_EQ(kNumOps, log_->GetLatestEntryOpId().index);
+  ASSERT_EQ(kNumOps, other_log->GetLatestEntryOpId().index);
+
+  // Each append to both logs and each direct call requires a sync, but concurrent requests share
+  // the same syncfs.
+  const auto num_requests = kNumThreads * kNumSyncsPerThread + 2 * kNumOps;
+  const auto num_syncs = group_sync->num_syncs() - num_syncs_before;
+  LOG(INFO) << "Sync requests: " << num_requests << ", syncfs calls: " << num_syncs;
+  ASSERT_GT(num_syncs, 0);
+  ASSERT_LT(num_syncs, num_requests);
+
+  ASSERT_OK(other_log->Close());
+  ASSERT_OK(log_->Close());
+}
+#endif
+
 // Tests interval for durable wal write
 TEST_F(LogTest, TestFsyncInterval) {
   options_.interval_durable_wal_write = MonoDelta::FromMilliseconds(1);
@@ -1160,6 +1294,36 @@ TEST_F(LogTest, TestGetMaxIndexesToSegmentSizeMap) {
   ASSERT_EQ(0, max_idx_to_segment_size.size());
 }
 
+TEST_F(LogTest, TestSizeOfSegmentsAfter) {
+  BuildLog();
+
+  const int kNumTotalSegments = 4;
+  const int kNumOpsPerSegment = 5;
+  OpIdPB op_id = MakeOpId(1, 1);
+  ASSERT_OK(AppendMultiSegmentSequence(kNumTotalSegments, kNumOpsPerSegment, &op_id, nullptr));
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  ASSERT_EQ(kNumTotalSegments, segments.size());
+  uint64_t expected_size = 0;
+  for (const auto& segment : segments) {
+    expected_size += segment->file_size();
+  }
+  ASSERT_EQ(expected_size, log_->SizeOfSegmentsAfter(0));
+
+  // Segments that contain only operations up to the specified index are not counted.
+  for (size_t i = 0; i + 1 < segments.size(); ++i) {
+    ASSERT_TRUE(segments[i]->HasFooter());
+    const auto max_index = segments[i]->footer().max_replicate_index();
+    ASSERT_EQ(expected_size, log_->SizeOfSegmentsAfter(max_index - 1));
+    expected_size -= segments[i]->file_size();
+    ASSERT_EQ(expected_size, log_->SizeOfSegmentsAfter(max_index));
+  }
+
+  // Active segment does not have footer, so it is always counted.
+  ASSERT_EQ(segments.back()->file_size(), log_->SizeOfSegmentsAfter(op_id.index()));
+}
+
 // Ensure that we can read replicate messages from the LogReader with a very
 // high (> 32 bit) log index and term. Regression test for KUDU-1933.
 TEST_F(LogTest, TestReadReplicatesHighIndex) {
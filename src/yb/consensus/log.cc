@@ -49,6 +49,7 @@
 #include "yb/common/wire_protocol.h"
 
 #include "yb/consensus/consensus_util.h"
+#include "yb/consensus/log_group_sync.h"
 #include "yb/consensus/log_index.h"
 #include "yb/consensus/log_metrics.h"
 #include "yb/consensus/log_reader.h"
@@ -606,6 +607,15 @@ Status Log::Init() {
 
   if (durable_wal_write_) {
     YB_LOG_FIRST_N(INFO, 1) << "durable_wal_write is turned on.";
+    if (options_.durable_wal_write_group_sync) {
+      auto group_sync = LogGroupSync::ForPath(wal_dir_);
+      if (group_sync.ok()) {
+        group_sync_ = std::move(*group_sync);
+      } else {
+        YB_LOG_FIRST_N(WARNING, 1) << "Failed to use WAL group sync, falling back to O_DIRECT "
+                                   << "writes: " << group_sync.status();
+      }
+    }
   } else if (interval_durable_wal_write_) {
     YB_LOG_FIRST_N(INFO, 1) << "interval_durable_wal_write_ms is turned on to sync every "
                             << interval_durable_wal_write_.ToMilliseconds() << " ms.";
@@ -806,7 +816,8 @@ Status Log::DoAppend(LogEntryBatch* entry_batch,
       LongOperationTracker long_operation_tracker(
           "Log append", FLAGS_consensus_log_scoped_watch_delay_append_threshold_ms * 1ms);
 
-      RETURN_NOT_OK(active_segment_->WriteEntryBatch(entry_batch_data));
+      RETURN_NOT_OK(active_segment_->WriteEntryBatch(
+          entry_batch_data, options_.entry_compression));
     }
 
     if (metrics_) {
@@ -935,7 +946,11 @@ Status Log::Sync() {
       periodic_sync_needed_.store(false);
       periodic_sync_unsynced_bytes_ = 0;
       LOG_SLOW_EXECUTION(WARNING, 50, "Fsync log took a long time") {
-        RETURN_NOT_OK(active_segment_->Sync());
+        if (group_sync_) {
+          RETURN_NOT_OK(group_sync_->Sync());
+        } else {
+          RETURN_NOT_OK(active_segment_->Sync());
+        }
       }
     }
   }
@@ -1230,6 +1245,25 @@ uint64_t Log::OnDiskSize() {
   return ret;
 }
 
+uint64_t Log::SizeOfSegmentsAfter(int64_t op_idx) {
+  SegmentSequence segments;
+  {
+    shared_lock<rw_spinlock> l(state_lock_.get_lock());
+    if (log_state_ == kLogClosed || !reader_->GetSegmentsSnapshot(&segments).ok()) {
+      return 0;
+    }
+  }
+  uint64_t result = 0;
+  for (const auto& segment : segments) {
+    // Active segment does not have footer yet, so it is always counted.
+    if (segment->HasFooter() && segment->footer().max_replicate_index() <= op_idx) {
+      continue;
+    }
+    result += segment->file_size();
+  }
+  return result;
+}
+
 void Log::SetSchemaForNextLogSegment(const Schema& schema,
                                      uint32_t version) {
   std::lock_guard<rw_spinlock> l(schema_lock_);
@@ -1406,7 +1440,8 @@ Status Log::PreAllocateNewSegment() {
   WritableFileOptions opts;
   // We always want to sync on close: https://github.com/yugabyte/yugabyte-db/issues/3490
   opts.sync_on_close = true;
-  opts.o_direct = durable_wal_write_;
+  // With group sync, data is written through the page cache and synced with syncfs.
+  opts.o_direct = durable_wal_write_ && !group_sync_;
   RETURN_NOT_OK(CreatePlaceholderSegment(opts, &next_segment_path_, &next_segment_file_));
 
   if (options_.preallocate_segments) {
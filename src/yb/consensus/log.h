@@ -71,6 +71,8 @@ class CDCServiceTestMinSpace_TestLogRetentionByOpId_MinSpace_Test;
 
 namespace log {
 
+class LogGroupSync;
+
 YB_STRONGLY_TYPED_BOOL(CreateNewSegment);
 YB_DEFINE_ENUM(
     SegmentAllocationState,
@@ -245,6 +247,11 @@ class Log : public RefCountedThreadSafe<Log> {
   // Returns 0 if the log is shut down.
   uint64_t OnDiskSize();
 
+  // Returns the total size of segments that could contain operations with index greater than
+  // op_idx, i.e. the amount of log that bootstrap would read if op_idx was flushed.
+  // Returns 0 if the log is shut down.
+  uint64_t SizeOfSegmentsAfter(int64_t op_idx);
+
   // Set the schema for the _next_ log segment.
   //
   // This method is thread-safe.
@@ -489,6 +496,10 @@ class Log : public RefCountedThreadSafe<Log> {
   // If non-zero, sync if more than given amount of data to sync.
   int32_t bytes_durable_wal_write_mb_;
 
+  // If set, durable writes are synced by the group sync of the WAL file system instead of the
+  // active segment.
+  std::shared_ptr<LogGroupSync> group_sync_;
+
   // Keeps track of oldest entry which needs to be synced.
   MonoTime periodic_sync_earliest_unsync_entry_time_ = MonoTime::kMin;
 
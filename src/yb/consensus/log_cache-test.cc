@@ -204,6 +204,47 @@ TEST_F(LogCacheTest, TestAppendAndGetMessages) {
   EXPECT_EQ(OpIdStrForIndex(start + 1), OpIdToString(read_result.messages[0]->id()));
 }
 
+TEST_F(LogCacheTest, TestSerializedOps) {
+  constexpr int kNumOps = 10;
+  ASSERT_OK(AppendReplicateMessagesToCache(1, kNumOps));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+
+  auto read_result = ASSERT_RESULT(cache_->ReadOps(0, 8_MB));
+  ASSERT_EQ(kNumOps, read_result.messages.size());
+  const auto size_before = cache_->metrics_.size->value();
+  auto serialized_ops = cache_->GetSerializedOps(read_result.messages);
+  ASSERT_EQ(kNumOps, serialized_ops.size());
+
+  // Serialized ops form a valid ConsensusRequestPB.
+  std::string serialized_request;
+  int64_t total_size = 0;
+  for (const auto& op : serialized_ops) {
+    serialized_request += op.ToBuffer();
+    total_size += op.size();
+  }
+  ConsensusRequestPB request;
+  ASSERT_TRUE(request.ParseFromString(serialized_request));
+  ASSERT_EQ(kNumOps, request.ops_size());
+  for (int i = 0; i != kNumOps; ++i) {
+    ASSERT_EQ(read_result.messages[i]->SerializeAsString(), request.ops(i).SerializeAsString());
+  }
+  ASSERT_EQ(size_before + total_size, cache_->metrics_.size->value());
+  // Size of read ops matches their serialized size, both before and after they were serialized.
+  ASSERT_EQ(total_size, read_result.total_size);
+
+  // Serialized ops are cached, so they are shared by subsequent reads.
+  read_result = ASSERT_RESULT(cache_->ReadOps(0, 8_MB));
+  ASSERT_EQ(total_size, read_result.total_size);
+  auto serialized_ops2 = cache_->GetSerializedOps(read_result.messages);
+  for (int i = 0; i != kNumOps; ++i) {
+    ASSERT_EQ(serialized_ops[i].data(), serialized_ops2[i].data());
+  }
+  ASSERT_EQ(size_before + total_size, cache_->metrics_.size->value());
+
+  // Memory used by serialized ops is released on eviction.
+  cache_->EvictThroughOp(kNumOps);
+  ASSERT_EQ(0, cache_->metrics_.size->value());
+}
 
 // Ensure that the cache always yields at least one message,
 // even if that message is larger than the batch size. This ensures
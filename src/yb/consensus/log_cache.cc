@@ -37,6 +37,8 @@
 #include <mutex>
 #include <vector>
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
 
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_reader.h"
@@ -287,6 +289,27 @@ int64_t TotalByteSizeForMessage(const ReplicateMsg& msg) {
   return msg_size;
 }
 
+int64_t TotalByteSizeForEntry(const ReplicateMsg& msg, const RefCntBuffer& serialized_op) {
+  return serialized_op ? serialized_op.size() : TotalByteSizeForMessage(msg);
+}
+
+RefCntBuffer SerializeOp(const ReplicateMsg& msg) {
+  using google::protobuf::internal::WireFormatLite;
+  using google::protobuf::io::CodedOutputStream;
+
+  const uint32_t tag = WireFormatLite::MakeTag(
+      ConsensusRequestPB::kOpsFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  const uint32_t size = msg.ByteSize();
+  RefCntBuffer result(
+      CodedOutputStream::VarintSize32(tag) + CodedOutputStream::VarintSize32(size) + size);
+  uint8_t* dst = result.udata();
+  dst = CodedOutputStream::WriteVarint32ToArray(tag, dst);
+  dst = CodedOutputStream::WriteVarint32ToArray(size, dst);
+  dst = msg.SerializeWithCachedSizesToArray(dst);
+  DCHECK_EQ(dst, result.udata() + result.size());
+  return result;
+}
+
 } // anonymous namespace
 
 Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
@@ -359,6 +382,7 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
         }
         result.messages.push_back(msg);
         result.read_from_disk_size += current_message_size;
+        result.total_size += current_message_size;
         next_index++;
       }
     } else {
@@ -373,13 +397,14 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
           continue;
         }
 
-        auto current_message_size = TotalByteSizeForMessage(*msg);
+        auto current_message_size = TotalByteSizeForEntry(*msg, iter->second.serialized_op);
         remaining_space -= current_message_size;
         if (remaining_space < 0 && !result.messages.empty()) {
           break;
         }
 
         result.messages.push_back(msg);
+        result.total_size += current_message_size;
         next_index++;
       }
     }
@@ -388,6 +413,54 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
   return result;
 }
 
+std::vector<RefCntBuffer> LogCache::GetSerializedOps(const ReplicateMsgs& msgs) {
+  std::vector<RefCntBuffer> result(msgs.size());
+  bool has_missing = false;
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    for (size_t i = 0; i != msgs.size(); ++i) {
+      auto it = cache_.find(msgs[i]->id().index());
+      if (it != cache_.end() && it->second.msg == msgs[i]) {
+        result[i] = it->second.serialized_op;
+      }
+      has_missing = has_missing || !result[i];
+    }
+  }
+  if (!has_missing) {
+    return result;
+  }
+
+  // Serialize outside of the lock, since it is relatively expensive.
+  for (size_t i = 0; i != msgs.size(); ++i) {
+    if (!result[i]) {
+      result[i] = SerializeOp(*msgs[i]);
+    }
+  }
+
+  // Messages could be serialized concurrently by another peer, or evicted meanwhile.
+  int64_t mem_required = 0;
+  int64_t tracked_mem_required = 0;
+  std::lock_guard<simple_spinlock> l(lock_);
+  for (size_t i = 0; i != msgs.size(); ++i) {
+    auto it = cache_.find(msgs[i]->id().index());
+    if (it == cache_.end() || it->second.msg != msgs[i] || it->second.serialized_op) {
+      continue;
+    }
+    auto& entry = it->second;
+    entry.serialized_op = result[i];
+    entry.mem_usage += result[i].size();
+    mem_required += result[i].size();
+    if (entry.tracked) {
+      tracked_mem_required += result[i].size();
+    }
+  }
+  metrics_.size->IncrementBy(mem_required);
+  if (tracked_mem_required) {
+    tracker_->Consume(tracked_mem_required);
+  }
+  return result;
+}
+
 size_t LogCache::EvictThroughOp(int64_t index, int64_t bytes_to_evict) {
   std::lock_guard<simple_spinlock> lock(lock_);
   return EvictSomeUnlocked(index, bytes_to_evict);
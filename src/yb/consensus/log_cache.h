@@ -48,6 +48,7 @@
 #include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
 #include "yb/util/opid.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/restart_safe_clock.h"
 #include "yb/util/result.h"
 
@@ -65,6 +66,8 @@ struct ReadOpsResult {
   yb::OpId preceding_op;
   bool have_more_messages = false;
   int64_t read_from_disk_size = 0;
+  // Size of messages on the wire, as part of ops field of ConsensusRequestPB.
+  int64_t total_size = 0;
 };
 
 // Write-through cache for the log.
@@ -116,6 +119,13 @@ class LogCache {
                                 int max_size_bytes,
                                 CoarseTimePoint deadline = CoarseTimePoint::max());
 
+  // Returns messages in the wire format of the ops field of ConsensusRequestPB, i.e. with tag and
+  // length prefix, so they could be appended to serialized requests as is.
+  //
+  // Serialized form of messages that are present in the cache is kept together with them, so each
+  // message is serialized only once, instead of once per peer and retry.
+  std::vector<RefCntBuffer> GetSerializedOps(const ReplicateMsgs& msgs);
+
   // Append the operations into the log and the cache.  When the messages have completed writing
   // into the on-disk log, fires 'callback'.
   //
@@ -176,6 +186,7 @@ class LogCache {
   FRIEND_TEST(LogCacheTest, TestGlobalMemoryLimitMB);
   FRIEND_TEST(LogCacheTest, TestGlobalMemoryLimitPercentage);
   FRIEND_TEST(LogCacheTest, TestReplaceMessages);
+  FRIEND_TEST(LogCacheTest, TestSerializedOps);
   friend class LogCacheTest;
 
   // An entry in the cache.
@@ -187,6 +198,10 @@ class LogCache {
 
     // Did we start memory tracking for this entry.
     bool tracked = false;
+
+    // msg serialized as ops field of ConsensusRequestPB, filled on first GetSerializedOps.
+    // Its size is included in mem_usage.
+    RefCntBuffer serialized_op;
   };
 
   // Try to evict the oldest operations from the queue, stopping either when
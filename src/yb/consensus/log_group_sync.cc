@@ -0,0 +1,140 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/log_group_sync.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+#include <unordered_map>
+
+#include "yb/util/debug/trace_event.h"
+#include "yb/util/errno.h"
+#include "yb/util/logging.h"
+#include "yb/util/thread_restrictions.h"
+
+namespace yb {
+namespace log {
+
+#if defined(__linux__)
+namespace {
+
+// Before Linux 5.8 syncfs does not report writeback errors, so data that failed to be written
+// would be treated as durable.
+Status CheckSyncfsReportsErrors() {
+  struct utsname uts_name;
+  if (uname(&uts_name) != 0) {
+    return STATUS_FROM_ERRNO("uname", errno);
+  }
+  int major_version = 0;
+  int minor_version = 0;
+  if (sscanf(uts_name.release, "%d.%d", &major_version, &minor_version) != 2) {
+    return STATUS_FORMAT(NotSupported, "Unknown kernel version: $0", uts_name.release);
+  }
+  if (major_version * 1000 + minor_version < 5008) {
+    return STATUS_FORMAT(
+        NotSupported, "syncfs does not report writeback errors on kernel $0, 5.8 is required",
+        uts_name.release);
+  }
+  return Status::OK();
+}
+
+} // namespace
+#endif
+
+Result<std::shared_ptr<LogGroupSync>> LogGroupSync::ForPath(const std::string& path) {
+#if defined(__linux__)
+  static const Status kernel_status = CheckSyncfsReportsErrors();
+  RETURN_NOT_OK(kernel_status);
+
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0) {
+    return STATUS_FROM_ERRNO(path, errno);
+  }
+
+  static std::mutex registry_mutex;
+  static std::unordered_map<dev_t, std::weak_ptr<LogGroupSync>> registry;
+
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  auto& weak_group_sync = registry[st.st_dev];
+  auto result = weak_group_sync.lock();
+  if (!result) {
+    int fd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+      return STATUS_FROM_ERRNO(path, errno);
+    }
+    result = std::make_shared<LogGroupSync>(fd, path);
+    weak_group_sync = result;
+    LOG(INFO) << "Created WAL group sync for file system of " << path;
+  }
+  return result;
+#else
+  return STATUS(NotSupported, "WAL group sync requires syncfs");
+#endif
+}
+
+LogGroupSync::LogGroupSync(int fd, std::string path) : fd_(fd), path_(std::move(path)) {
+}
+
+LogGroupSync::~LogGroupSync() {
+  if (close(fd_) != 0) {
+    LOG(WARNING) << "Failed to close " << path_ << ": " << ErrnoToString(errno);
+  }
+}
+
+Status LogGroupSync::Sync() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  // Sync that is already running could have started before data of the caller was written,
+  // so the caller is covered only by syncs that start after this point.
+  const auto target = started_ + 1;
+  while (completed_ < target) {
+    if (!in_progress_) {
+      in_progress_ = true;
+      const auto generation = ++started_;
+      lock.unlock();
+      auto status = DoSync();
+      lock.lock();
+      in_progress_ = false;
+      completed_ = generation;
+      last_status_ = status;
+      cond_.notify_all();
+      return status;
+    }
+    cond_.wait(lock);
+  }
+  return last_status_;
+}
+
+uint64_t LogGroupSync::num_syncs() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return started_;
+}
+
+Status LogGroupSync::DoSync() {
+  TRACE_EVENT0("log", "LogGroupSync::DoSync");
+  ThreadRestrictions::AssertIOAllowed();
+#if defined(__linux__)
+  if (syncfs(fd_) != 0) {
+    return STATUS_FROM_ERRNO(path_, errno);
+  }
+  return Status::OK();
+#else
+  return STATUS(NotSupported, "WAL group sync requires syncfs");
+#endif
+}
+
+} // namespace log
+} // namespace yb
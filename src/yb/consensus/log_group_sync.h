@@ -0,0 +1,80 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_LOG_GROUP_SYNC_H
+#define YB_CONSENSUS_LOG_GROUP_SYNC_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/util/result.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace log {
+
+// Group commit of WAL writes across all tablets whose WAL is located on the same file system.
+//
+// Instead of syncing its own segment file, a log calls Sync, which makes everything written to
+// the file system before the call durable, using a single syncfs for all concurrent callers.
+// While one syncfs is running, new callers wait for it to finish and then share the next one.
+// So the number of syncs is bounded by the latency of the device instead of the number of tablets.
+//
+// syncfs also flushes data that was written by other components to the same file system, so it
+// works best when WAL directories are located on dedicated devices.
+//
+// Group sync is not available before Linux 5.8, since syncfs there does not report writeback
+// errors. In this case logs fall back to syncing their own segments.
+class LogGroupSync {
+ public:
+  // Returns group sync shared by all logs located on the same file system as path.
+  static Result<std::shared_ptr<LogGroupSync>> ForPath(const std::string& path);
+
+  LogGroupSync(int fd, std::string path);
+  ~LogGroupSync();
+
+  // Makes data written to any file of this file system before this call durable.
+  CHECKED_STATUS Sync();
+
+  const std::string& path() const {
+    return path_;
+  }
+
+  // Number of syncfs calls made by this group sync.
+  uint64_t num_syncs();
+
+ private:
+  CHECKED_STATUS DoSync();
+
+  // Descriptor of the directory that is used to identify the file system.
+  const int fd_;
+  const std::string path_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  // Number of started and completed syncs.
+  uint64_t started_ GUARDED_BY(mutex_) = 0;
+  uint64_t completed_ GUARDED_BY(mutex_) = 0;
+  bool in_progress_ GUARDED_BY(mutex_) = false;
+  // Status of the last completed sync.
+  Status last_status_ GUARDED_BY(mutex_);
+};
+
+} // namespace log
+} // namespace yb
+
+#endif // YB_CONSENSUS_LOG_GROUP_SYNC_H
@@ -91,6 +91,36 @@ TEST_F(LogIndexTest, TestBasic) {
   VerifyEntry(MakeOpId(5, 1), 1, 50000);
 }
 
+// This test relies on kEntriesPerIndexChunk being 1000000, so range crosses chunk boundary.
+#if !defined(__APPLE__)
+TEST_F(LogIndexTest, TestGetEntries) {
+  constexpr int64_t kFirstIndex = 999990;
+  constexpr int64_t kLastIndex = 1000010;
+  for (int64_t index = kFirstIndex; index <= kLastIndex; ++index) {
+    ASSERT_OK(AddEntry(MakeOpId(2, index), index / 10, index * 100));
+  }
+
+  std::vector<LogIndexEntry> entries;
+  index_->GetEntries(kFirstIndex, kLastIndex, &entries);
+  ASSERT_EQ(kLastIndex - kFirstIndex + 1, entries.size());
+  for (size_t i = 0; i != entries.size(); ++i) {
+    const int64_t index = kFirstIndex + i;
+    ASSERT_EQ(yb::OpId(2, index), entries[i].op_id);
+    ASSERT_EQ(index / 10, entries[i].segment_sequence_number);
+    ASSERT_EQ(index * 100, entries[i].offset_in_segment);
+  }
+
+  // Stops at the first missing entry.
+  entries.clear();
+  index_->GetEntries(kLastIndex - 1, kLastIndex + 10, &entries);
+  ASSERT_EQ(2, entries.size());
+
+  entries.clear();
+  index_->GetEntries(kFirstIndex - 10, kLastIndex, &entries);
+  ASSERT_TRUE(entries.empty());
+}
+#endif
+
 // This test relies on kEntriesPerIndexChunk being 1000000, and that's no longer
 // the case after D1719 (2fe27d886390038bc734ea28638a1b1435e7d0d4) on Mac.
 #if !defined(__APPLE__)
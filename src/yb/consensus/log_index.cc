@@ -46,7 +46,9 @@
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/types.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -55,6 +57,7 @@
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/stringprintf.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/util/errno.h"
 #include "yb/util/locks.h"
 
 using std::string;
@@ -114,6 +117,9 @@ class LogIndex::IndexChunk : public RefCountedThreadSafe<LogIndex::IndexChunk> {
   // Open and map the memory.
   Status Open();
   void GetEntry(int entry_index, PhysicalEntry* ret);
+
+  // Copies count entries starting at entry_index to ret.
+  void GetEntries(int entry_index, int count, PhysicalEntry* ret);
   void SetEntry(int entry_index, const PhysicalEntry& entry);
 
   // Flush memory-mapped chunk to file.
@@ -171,6 +177,25 @@ void LogIndex::IndexChunk::GetEntry(int entry_index, PhysicalEntry* ret) {
   memcpy(ret, mapping_ + sizeof(PhysicalEntry) * entry_index, sizeof(PhysicalEntry));
 }
 
+void LogIndex::IndexChunk::GetEntries(int entry_index, int count, PhysicalEntry* ret) {
+  DCHECK_GE(fd_, 0) << "Must Open() first";
+  DCHECK_LE(entry_index + count, kEntriesPerIndexChunk);
+
+  uint8_t* start = mapping_ + sizeof(PhysicalEntry) * entry_index;
+  const size_t size = sizeof(PhysicalEntry) * count;
+#if defined(__linux__)
+  // Ask the kernel to read in all pages of the range at once, instead of faulting them in one by
+  // one while copying. madvise requires page aligned address.
+  static const uintptr_t kPageMask = ~(static_cast<uintptr_t>(getpagesize()) - 1);
+  uint8_t* aligned_start = reinterpret_cast<uint8_t*>(reinterpret_cast<uintptr_t>(start) &
+                                                      kPageMask);
+  if (madvise(aligned_start, start + size - aligned_start, MADV_WILLNEED) != 0) {
+    VLOG(1) << "madvise failed for " << path_ << ": " << ErrnoToString(errno);
+  }
+#endif
+  memcpy(ret, start, size);
+}
+
 void LogIndex::IndexChunk::SetEntry(int entry_index, const PhysicalEntry& phys) {
   DCHECK_GE(fd_, 0) << "Must Open() first";
   DCHECK_LT(entry_index, kEntriesPerIndexChunk);
@@ -279,6 +304,35 @@ Status LogIndex::GetEntry(int64_t index, LogIndexEntry* entry) {
   return Status::OK();
 }
 
+void LogIndex::GetEntries(int64_t start_index, int64_t end_index,
+                          std::vector<LogIndexEntry>* entries) {
+  std::vector<PhysicalEntry> physical_entries;
+  int64_t index = start_index;
+  while (index <= end_index) {
+    scoped_refptr<IndexChunk> chunk;
+    if (!GetChunkForIndex(index, false /* do not create */, &chunk).ok()) {
+      return;
+    }
+    const int index_in_chunk = index % kEntriesPerIndexChunk;
+    const int count = std::min<int64_t>(end_index - index + 1,
+                                        kEntriesPerIndexChunk - index_in_chunk);
+    physical_entries.resize(count);
+    chunk->GetEntries(index_in_chunk, count, physical_entries.data());
+    for (const auto& phys : physical_entries) {
+      // See GetEntry for details.
+      if (phys.offset_in_segment == 0) {
+        return;
+      }
+      entries->push_back(LogIndexEntry {
+        .op_id = yb::OpId(phys.term, index),
+        .segment_sequence_number = static_cast<int64_t>(phys.segment_sequence_number),
+        .offset_in_segment = static_cast<int64_t>(phys.offset_in_segment),
+      });
+      ++index;
+    }
+  }
+}
+
 void LogIndex::GC(int64_t min_index_to_retain) {
   int min_chunk_to_retain = min_index_to_retain / kEntriesPerIndexChunk;
 
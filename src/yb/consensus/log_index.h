@@ -34,6 +34,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 
 #include "yb/consensus/consensus.pb.h"
 #include "yb/consensus/opid_util.h"
@@ -85,6 +86,14 @@ class LogIndex : public RefCountedThreadSafe<LogIndex> {
   // Returns NotFound() if the given log entry was never written.
   CHECKED_STATUS GetEntry(int64_t index, LogIndexEntry* entry);
 
+  // Appends existing entries for consecutive indexes from start_index to end_index inclusive to
+  // entries. Stops at the first entry that was never written, so could append fewer entries than
+  // requested.
+  //
+  // Each index chunk is looked up once for the whole range and its mapped pages are prefetched,
+  // so it is much cheaper than calling GetEntry for each index.
+  void GetEntries(int64_t start_index, int64_t end_index, std::vector<LogIndexEntry>* entries);
+
   // Indicate that we no longer need to retain information about indexes lower than the
   // given index. Note that the implementation is conservative and _may_ choose to retain
   // earlier entries.
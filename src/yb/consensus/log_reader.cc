@@ -91,10 +91,20 @@ DEFINE_test_flag(int32, get_changes_read_loop_delay_ms, 0,
                  "Amount of time to sleep for between each iteration of the loop in "
                  "ReadReplicatesInRange. This is used to test the return of partial results.");
 
+DEFINE_int32(log_reader_read_ahead_bytes, 1024 * 1024,
+             "Size of sequential reads used to read ranges of log entries, e.g. to catch up "
+             "a lagging follower. If 0, each entry batch is read separately.");
+TAG_FLAG(log_reader_read_ahead_bytes, advanced);
+TAG_FLAG(log_reader_read_ahead_bytes, runtime);
+
 namespace yb {
 namespace log {
 
 namespace {
+
+// Number of log index entries that are fetched at once by ReadReplicatesInRange.
+constexpr int64_t kIndexEntriesPerFetch = 1024;
+
 struct LogSegmentSeqnoComparator {
   bool operator() (const scoped_refptr<ReadableLogSegment>& a,
                    const scoped_refptr<ReadableLogSegment>& b) {
@@ -423,6 +433,42 @@ Status LogReader::ReadBatchUsingIndexEntry(const LogIndexEntry& index_entry,
   return Status::OK();
 }
 
+Status LogReader::ReadBatchUsingIndexEntry(const LogIndexEntry& index_entry,
+                                           LogSegmentReadAhead* read_ahead,
+                                           LogEntryBatchPB* batch) const {
+  const int64_t index = index_entry.op_id.index;
+
+  if (!read_ahead->segment ||
+      read_ahead->segment->header().sequence_number() != index_entry.segment_sequence_number) {
+    read_ahead->segment = GetSegmentBySequenceNumber(index_entry.segment_sequence_number);
+    read_ahead->offset = 0;
+    read_ahead->data = Slice();
+    if (PREDICT_FALSE(!read_ahead->segment)) {
+      return STATUS(NotFound, Substitute("Segment $0 which contained index $1 has been GCed",
+                                         index_entry.segment_sequence_number,
+                                         index));
+    }
+  }
+
+  CHECK_GT(index_entry.offset_in_segment, 0);
+  int64_t offset = index_entry.offset_in_segment;
+  ScopedLatencyMetric scoped(read_batch_latency_.get());
+  RETURN_NOT_OK_PREPEND(
+      read_ahead->segment->ReadEntryHeaderAndBatch(
+          &offset, FLAGS_log_reader_read_ahead_bytes, read_ahead, batch),
+      Substitute("Failed to read LogEntry for index $0 from log segment $1 offset $2",
+                 index,
+                 index_entry.segment_sequence_number,
+                 index_entry.offset_in_segment));
+
+  if (bytes_read_) {
+    bytes_read_->IncrementBy(offset - index_entry.offset_in_segment);
+    entries_read_->IncrementBy(batch->entry_size());
+  }
+
+  return Status::OK();
+}
+
 Status LogReader::ReadReplicatesInRange(
     const int64_t starting_at,
     const int64_t up_to,
@@ -445,7 +491,12 @@ Status LogReader::ReadReplicatesInRange(
   int64_t total_size = 0;
   bool limit_exceeded = false;
   faststring tmp_buf;
+  LogSegmentReadAhead read_ahead;
+  const bool use_read_ahead = FLAGS_log_reader_read_ahead_bytes > 0;
   LogEntryBatchPB batch;
+  // Index entries are fetched in blocks, instead of looking up the index for each operation.
+  std::vector<LogIndexEntry> index_entries;
+  size_t next_index_entry = 0;
   for (int64_t index = starting_at; index <= up_to && !limit_exceeded; index++) {
     // Stop reading if a deadline was specified and the deadline has been exceeded.
     if (deadline != CoarseTimePoint::max() && CoarseMonoClock::Now() >= deadline) {
@@ -456,9 +507,20 @@ Status LogReader::ReadReplicatesInRange(
       SleepFor(MonoDelta::FromMilliseconds(FLAGS_TEST_get_changes_read_loop_delay_ms));
     }
 
-    LogIndexEntry index_entry;
-    RETURN_NOT_OK_PREPEND(log_index_->GetEntry(index, &index_entry),
-                          Substitute("Failed to read log index for op $0", index));
+    if (next_index_entry == index_entries.size()) {
+      index_entries.clear();
+      next_index_entry = 0;
+      log_index_->GetEntries(
+          index, std::min(up_to, index + kIndexEntriesPerFetch - 1), &index_entries);
+      if (index_entries.empty()) {
+        // Entry is missing, GetEntry provides the proper error.
+        LogIndexEntry index_entry;
+        RETURN_NOT_OK_PREPEND(log_index_->GetEntry(index, &index_entry),
+                              Substitute("Failed to read log index for op $0", index));
+        index_entries.push_back(index_entry);
+      }
+    }
+    const LogIndexEntry index_entry = index_entries[next_index_entry++];
 
     // Since a given LogEntryBatch may contain multiple REPLICATE messages,
     // it's likely that this index entry points to the same batch as the previous
@@ -468,7 +530,11 @@ Status LogReader::ReadReplicatesInRange(
         index_entry.segment_sequence_number != prev_index_entry.segment_sequence_number ||
         index_entry.offset_in_segment != prev_index_entry.offset_in_segment) {
       // Make read operation.
-      RETURN_NOT_OK(ReadBatchUsingIndexEntry(index_entry, &tmp_buf, &batch));
+      if (use_read_ahead) {
+        RETURN_NOT_OK(ReadBatchUsingIndexEntry(index_entry, &read_ahead, &batch));
+      } else {
+        RETURN_NOT_OK(ReadBatchUsingIndexEntry(index_entry, &tmp_buf, &batch));
+      }
 
       // Sanity-check the property that a batch should only have increasing indexes.
       int64_t prev_index = 0;
@@ -195,6 +195,12 @@ class LogReader {
                                           faststring* tmp_buf,
                                           LogEntryBatchPB* batch) const;
 
+  // Same as above, but reads the batch through read_ahead, so consecutive batches of the same
+  // segment are read with large sequential reads.
+  CHECKED_STATUS ReadBatchUsingIndexEntry(const LogIndexEntry& index_entry,
+                                          LogSegmentReadAhead* read_ahead,
+                                          LogEntryBatchPB* batch) const;
+
   LogReader(Env* env, const scoped_refptr<LogIndex>& index,
             std::string tablet_name, std::string peer_uuid,
             const scoped_refptr<MetricEntity>& table_metric_entity,
@@ -37,6 +37,8 @@
 #include <utility>
 
 #include <glog/logging.h>
+#include <lz4.h>
+#include <snappy.h>
 
 #include "yb/common/hybrid_time.h"
 #include "yb/consensus/opid_util.h"
@@ -46,6 +48,7 @@
 #include "yb/gutil/strings/substitute.h"
 #include "yb/gutil/strings/util.h"
 
+#include "yb/util/cast.h"
 #include "yb/util/coding-inl.h"
 #include "yb/util/coding.h"
 #include "yb/util/crc.h"
@@ -83,6 +86,23 @@ DEFINE_int32(bytes_durable_wal_write_mb, 1,
              "If 0 fsysnc() is not called.");
 TAG_FLAG(bytes_durable_wal_write_mb, stable);
 
+DEFINE_bool(durable_wal_write_group_sync, false,
+            "When durable_wal_write is set, write WAL through the page cache and make it durable "
+            "with a single syncfs shared by all tablets whose WAL is on the same file system, "
+            "instead of using O_DIRECT writes for each tablet separately. Recommended only when "
+            "WAL directories are located on dedicated devices.");
+TAG_FLAG(durable_wal_write_group_sync, advanced);
+
+DEFINE_string(log_compression_type, "none",
+              "Compression of WAL entry batches: none, snappy or lz4. Segments that contain "
+              "compressed entries cannot be read by versions that do not support it.");
+TAG_FLAG(log_compression_type, advanced);
+
+DEFINE_int32(log_compression_min_batch_size_bytes, 512,
+             "Entry batches smaller than this are written to the WAL without compression.");
+TAG_FLAG(log_compression_min_batch_size_bytes, advanced);
+TAG_FLAG(log_compression_min_batch_size_bytes, runtime);
+
 DEFINE_bool(log_preallocate_segments, true,
             "Whether the WAL should preallocate the entire segment before writing to it");
 TAG_FLAG(log_preallocate_segments, advanced);
@@ -125,12 +145,105 @@ const size_t kLogSegmentFooterMagicAndFooterLength  = 12;
 
 const size_t kEntryHeaderSize = 12;
 
+// Number of low bits of the length field of the entry header that contain the length of the batch
+// data. The remaining high bits contain LogEntryCompression.
+const size_t kEntryLengthBits = 29;
+const uint32_t kEntryLengthMask = (1U << kEntryLengthBits) - 1;
+
 const int kLogMajorVersion = 1;
 const int kLogMinorVersion = 0;
 
 // Maximum log segment header/footer size, in bytes (8 MB).
 const uint32_t kLogSegmentMaxHeaderOrFooterSize = 8 * 1024 * 1024;
 
+namespace {
+
+LogEntryCompression ParseLogEntryCompression(const std::string& name) {
+  if (name == "none") {
+    return LogEntryCompression::kNone;
+  }
+  if (name == "snappy") {
+    return LogEntryCompression::kSnappy;
+  }
+  if (name == "lz4") {
+    return LogEntryCompression::kLZ4;
+  }
+  LOG(DFATAL) << "Unknown log compression type: " << name << ", compression disabled";
+  return LogEntryCompression::kNone;
+}
+
+// Compresses input to output. Returns false if compressed data would not be smaller than input.
+bool CompressEntryBatch(LogEntryCompression compression, const Slice& input, faststring* output) {
+  switch (compression) {
+    case LogEntryCompression::kNone:
+      return false;
+    case LogEntryCompression::kSnappy: {
+      output->resize(snappy::MaxCompressedLength(input.size()));
+      size_t compressed_length = 0;
+      snappy::RawCompress(input.cdata(), input.size(), pointer_cast<char*>(output->data()),
+                          &compressed_length);
+      output->resize(compressed_length);
+      return compressed_length < input.size();
+    }
+    case LogEntryCompression::kLZ4: {
+      // LZ4 block does not contain the uncompressed length, so it is prepended as varint.
+      uint8_t length_buf[kMaxVarint32Length];
+      auto length_size = EncodeVarint32(length_buf, input.size()) - length_buf;
+      output->resize(length_size + LZ4_compressBound(input.size()));
+      memcpy(output->data(), length_buf, length_size);
+      int compressed_length = LZ4_compress_default(
+          input.cdata(), pointer_cast<char*>(output->data() + length_size), input.size(),
+          output->size() - length_size);
+      if (compressed_length <= 0) {
+        return false;
+      }
+      output->resize(length_size + compressed_length);
+      return output->size() < input.size();
+    }
+  }
+  FATAL_INVALID_ENUM_VALUE(LogEntryCompression, compression);
+}
+
+Status UncompressEntryBatch(LogEntryCompression compression, const Slice& input,
+                            faststring* output) {
+  switch (compression) {
+    case LogEntryCompression::kNone:
+      output->assign_copy(input.data(), input.size());
+      return Status::OK();
+    case LogEntryCompression::kSnappy: {
+      size_t uncompressed_length = 0;
+      if (!snappy::GetUncompressedLength(input.cdata(), input.size(), &uncompressed_length)) {
+        return STATUS(Corruption, "Invalid snappy compressed log entry batch");
+      }
+      output->resize(uncompressed_length);
+      if (!snappy::RawUncompress(input.cdata(), input.size(),
+                                 pointer_cast<char*>(output->data()))) {
+        return STATUS(Corruption, "Failed to uncompress snappy log entry batch");
+      }
+      return Status::OK();
+    }
+    case LogEntryCompression::kLZ4: {
+      uint32_t uncompressed_length = 0;
+      auto* data = GetVarint32Ptr(input.data(), input.end(), &uncompressed_length);
+      if (data == nullptr) {
+        return STATUS(Corruption, "Invalid LZ4 compressed log entry batch");
+      }
+      output->resize(uncompressed_length);
+      int result = LZ4_decompress_safe(
+          pointer_cast<const char*>(data), pointer_cast<char*>(output->data()),
+          input.end() - data, uncompressed_length);
+      if (result != static_cast<int>(uncompressed_length)) {
+        return STATUS_FORMAT(Corruption, "Failed to uncompress LZ4 log entry batch: $0, "
+                                         "expected length: $1", result, uncompressed_length);
+      }
+      return Status::OK();
+    }
+  }
+  FATAL_INVALID_ENUM_VALUE(LogEntryCompression, compression);
+}
+
+} // namespace
+
 LogOptions::LogOptions()
     : segment_size_bytes(FLAGS_log_segment_size_bytes == 0 ? FLAGS_log_segment_size_mb * 1_MB
                                                            : FLAGS_log_segment_size_bytes),
@@ -140,6 +253,8 @@ LogOptions::LogOptions()
                                      MonoDelta::FromMilliseconds(
                                          FLAGS_interval_durable_wal_write_ms) : MonoDelta()),
       bytes_durable_wal_write_mb(FLAGS_bytes_durable_wal_write_mb),
+      entry_compression(ParseLogEntryCompression(FLAGS_log_compression_type)),
+      durable_wal_write_group_sync(FLAGS_durable_wal_write_group_sync),
       preallocate_segments(FLAGS_log_preallocate_segments),
       async_preallocate_segments(FLAGS_log_async_preallocate_segments),
       env(Env::Default()) {
@@ -725,7 +840,8 @@ Status ReadableLogSegment::ReadEntryHeader(int64_t *offset, EntryHeader* header)
 
 Status ReadableLogSegment::DecodeEntryHeader(const Slice& data, EntryHeader* header) {
   DCHECK_EQ(kEntryHeaderSize, data.size());
-  header->msg_length = DecodeFixed32(data.data());
+  const uint32_t length_and_compression = DecodeFixed32(data.data());
+  header->msg_length = length_and_compression & kEntryLengthMask;
   header->msg_crc = DecodeFixed32(data.data() + 4);
   header->header_crc = DecodeFixed32(data.data() + 8);
 
@@ -736,6 +852,12 @@ Status ReadableLogSegment::DecodeEntryHeader(const Slice& data, EntryHeader* hea
         Corruption, "Invalid checksum in log entry head header: found=$0, computed=$1",
         header->header_crc, computed_crc);
   }
+
+  const uint32_t compression = length_and_compression >> kEntryLengthBits;
+  if (compression > to_underlying(LogEntryCompression::kLZ4)) {
+    return STATUS_FORMAT(Corruption, "Unknown log entry compression: $0", compression);
+  }
+  header->compression = static_cast<LogEntryCompression>(compression);
   return Status::OK();
 }
 
@@ -749,17 +871,7 @@ Status ReadableLogSegment::ReadEntryBatch(int64_t *offset,
                "range", Substitute("offset=$0 entry_len=$1",
                                    *offset, header.msg_length));
 
-  if (header.msg_length == 0) {
-    return STATUS(Corruption, "Invalid 0 entry length");
-  }
-  int64_t limit = readable_up_to();
-  if (PREDICT_FALSE(header.msg_length + *offset > limit)) {
-    // The log was likely truncated during writing.
-    return STATUS(Corruption,
-        Substitute("Could not read $0-byte log entry from offset $1 in $2: "
-                   "log only readable up to offset $3",
-                   header.msg_length, *offset, path_, limit));
-  }
+  RETURN_NOT_OK(CheckEntryLength(*offset, header));
 
   tmp_buf->clear();
   tmp_buf->resize(header.msg_length);
@@ -773,29 +885,110 @@ Status ReadableLogSegment::ReadEntryBatch(int64_t *offset,
   if (!s.ok()) return STATUS(IOError, Substitute("Could not read entry. Cause: $0",
                                                  s.ToString()));
 
+  RETURN_NOT_OK(ParseEntryBatch(*offset, header, entry_batch_slice, entry_batch));
+  *offset += entry_batch_slice.size();
+  return Status::OK();
+}
+
+Status ReadableLogSegment::CheckEntryLength(int64_t offset, const EntryHeader& header) {
+  if (header.msg_length == 0) {
+    return STATUS(Corruption, "Invalid 0 entry length");
+  }
+  int64_t limit = readable_up_to();
+  if (PREDICT_FALSE(header.msg_length + offset > limit)) {
+    // The log was likely truncated during writing.
+    return STATUS(Corruption,
+        Substitute("Could not read $0-byte log entry from offset $1 in $2: "
+                   "log only readable up to offset $3",
+                   header.msg_length, offset, path_, limit));
+  }
+  return Status::OK();
+}
+
+Status ReadableLogSegment::ParseEntryBatch(int64_t offset,
+                                           const EntryHeader& header,
+                                           const Slice& data,
+                                           LogEntryBatchPB* entry_batch) {
   // Verify the CRC.
-  uint32_t read_crc = crc::Crc32c(entry_batch_slice.data(), entry_batch_slice.size());
+  uint32_t read_crc = crc::Crc32c(data.data(), data.size());
   if (PREDICT_FALSE(read_crc != header.msg_crc)) {
     return STATUS(Corruption, Substitute("Entry CRC mismatch in byte range $0-$1: "
                                          "expected CRC=$2, computed=$3",
-                                         *offset, *offset + header.msg_length,
+                                         offset, offset + header.msg_length,
                                          header.msg_crc, read_crc));
   }
 
+  Slice entry_batch_data = data;
+  faststring uncompressed_buf;
+  if (header.compression != LogEntryCompression::kNone) {
+    auto s = UncompressEntryBatch(header.compression, data, &uncompressed_buf);
+    if (!s.ok()) {
+      return s.CloneAndPrepend(Substitute("Entry in byte range $0-$1", offset,
+                                          offset + header.msg_length));
+    }
+    entry_batch_data = Slice(uncompressed_buf);
+  }
 
   LogEntryBatchPB read_entry_batch;
-  s = pb_util::ParseFromArray(&read_entry_batch,
-                              entry_batch_slice.data(),
-                              header.msg_length);
+  auto s = pb_util::ParseFromArray(&read_entry_batch,
+                                   entry_batch_data.data(),
+                                   entry_batch_data.size());
 
   if (!s.ok()) return STATUS(Corruption, Substitute("Could parse PB. Cause: $0",
                                                     s.ToString()));
 
-  *offset += entry_batch_slice.size();
   entry_batch->Swap(&read_entry_batch);
   return Status::OK();
 }
 
+Status ReadableLogSegment::ReadEntryHeaderAndBatch(int64_t* offset,
+                                                   size_t read_ahead_bytes,
+                                                   LogSegmentReadAhead* read_ahead,
+                                                   LogEntryBatchPB* batch) {
+  DCHECK_EQ(read_ahead->segment.get(), this);
+
+  auto header_data = VERIFY_RESULT(ReadAhead(
+      *offset, kEntryHeaderSize, read_ahead_bytes, read_ahead));
+  EntryHeader header;
+  RETURN_NOT_OK(DecodeEntryHeader(header_data, &header));
+  const int64_t batch_offset = *offset + kEntryHeaderSize;
+  RETURN_NOT_OK(CheckEntryLength(batch_offset, header));
+
+  auto entry_data = VERIFY_RESULT(ReadAhead(
+      *offset, kEntryHeaderSize + header.msg_length, read_ahead_bytes, read_ahead));
+  entry_data.remove_prefix(kEntryHeaderSize);
+  RETURN_NOT_OK(ParseEntryBatch(batch_offset, header, entry_data, batch));
+  *offset = batch_offset + header.msg_length;
+  return Status::OK();
+}
+
+Result<Slice> ReadableLogSegment::ReadAhead(int64_t offset, size_t length,
+                                            size_t read_ahead_bytes,
+                                            LogSegmentReadAhead* read_ahead) {
+  if (offset < read_ahead->offset ||
+      offset + length > read_ahead->offset + read_ahead->data.size()) {
+    // Refill starting at the requested offset, so the whole entry is read by a single read.
+    const int64_t limit = readable_up_to();
+    const size_t size = std::min<int64_t>(std::max(length, read_ahead_bytes), limit - offset);
+    if (PREDICT_FALSE(size < length)) {
+      return STATUS_FORMAT(
+          Corruption, "Could not read $0 bytes from offset $1 in $2: "
+                      "log only readable up to offset $3", length, offset, path_, limit);
+    }
+    TRACE_EVENT2("log", "ReadableLogSegment::ReadAhead",
+                 "path", path_,
+                 "range", Substitute("offset=$0 size=$1", offset, size));
+    read_ahead->buffer.resize(size);
+    read_ahead->data = Slice();
+    RETURN_NOT_OK_PREPEND(
+        ReadFully(readable_file().get(), offset, size, &read_ahead->data,
+                  read_ahead->buffer.data()),
+        "Could not read log entries");
+    read_ahead->offset = offset;
+  }
+  return Slice(read_ahead->data.data() + (offset - read_ahead->offset), length);
+}
+
 const LogSegmentHeaderPB& ReadableLogSegment::header() const {
   DCHECK(header_.IsInitialized());
   return header_;
@@ -858,14 +1051,28 @@ Status WritableLogSegment::WriteFooterAndClose(const LogSegmentFooterPB& footer)
 }
 
 
-Status WritableLogSegment::WriteEntryBatch(const Slice& data) {
+Status WritableLogSegment::WriteEntryBatch(const Slice& entry_batch_data,
+                                           LogEntryCompression compression) {
   DCHECK(is_header_written_);
   DCHECK(!is_footer_written_);
   uint8_t header_buf[kEntryHeaderSize];
 
-  // First encode the length of the message.
+  Slice data = entry_batch_data;
+  if (compression != LogEntryCompression::kNone &&
+      data.size() >= FLAGS_log_compression_min_batch_size_bytes &&
+      CompressEntryBatch(compression, data, &compression_buffer_)) {
+    data = Slice(compression_buffer_);
+  } else {
+    compression = LogEntryCompression::kNone;
+  }
+
+  // First encode the length of the message, with compression in the highest bits.
   uint32_t len = data.size();
-  InlineEncodeFixed32(&header_buf[0], len);
+  if (PREDICT_FALSE(len > kEntryLengthMask)) {
+    return STATUS_FORMAT(InvalidArgument, "Log entry batch is too big: $0", len);
+  }
+  InlineEncodeFixed32(
+      &header_buf[0], len | (static_cast<uint32_t>(compression) << kEntryLengthBits));
 
   // Then the CRC of the message.
   uint32_t msg_crc = crc::Crc32c(data.data(), data.size());
@@ -50,7 +50,9 @@
 #include "yb/gutil/ref_counted.h"
 #include "yb/util/atomic.h"
 #include "yb/util/compare_util.h"
+#include "yb/util/enums.h"
 #include "yb/util/env.h"
+#include "yb/util/faststring.h"
 #include "yb/util/monotime.h"
 #include "yb/util/opid.h"
 #include "yb/util/restart_safe_clock.h"
@@ -73,6 +75,10 @@ extern const char kTmpSuffix[];
 // and checksum of the other two fields (see EntryHeader struct below).
 extern const size_t kEntryHeaderSize;
 
+// Compression of the entry batch data. It is stored in the highest bits of the length field of
+// the entry header, so entries written without compression have the same format as before.
+YB_DEFINE_ENUM(LogEntryCompression, ((kNone, 0))((kSnappy, 1))((kLZ4, 2)));
+
 extern const int kLogMajorVersion;
 extern const int kLogMinorVersion;
 
@@ -95,6 +101,13 @@ struct LogOptions {
   // If non-zero, call fsync on a call to Append() if more than given amount of data to sync.
   int32_t bytes_durable_wal_write_mb;
 
+  // Compression of entry batches written to the log.
+  LogEntryCompression entry_compression;
+
+  // Whether durable writes should be synced together with logs of other tablets on the same file
+  // system, see LogGroupSync.
+  bool durable_wal_write_group_sync;
+
   // Whether to fallocate segments before writing to them.
   bool preallocate_segments;
 
@@ -163,6 +176,23 @@ struct FirstEntryMetadata {
 // segments are rolled over and the Log continues in a new segment.
 
 // A readable log segment for recovery and follower catch-up.
+class ReadableLogSegment;
+
+// Data of a log segment that was read ahead of the current read position, so consecutive entry
+// batches could be read with a few large sequential reads instead of a read per batch.
+struct LogSegmentReadAhead {
+  // Segment the data was read from.
+  scoped_refptr<ReadableLogSegment> segment;
+
+  // Offset of the data in the segment.
+  int64_t offset = 0;
+
+  // Data read from the segment, could point to buffer or to memory owned by the file.
+  Slice data;
+
+  faststring buffer;
+};
+
 class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
  public:
   // Factory method to construct a ReadableLogSegment from a file on the FS.
@@ -273,9 +303,12 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
   FRIEND_TEST(LogTest, TestWriteAndReadToAndFromInProgressSegment);
 
   struct EntryHeader {
-    // The length of the batch data.
+    // The length of the batch data, as stored in the segment.
     uint32_t msg_length;
 
+    // Compression of the batch data.
+    LogEntryCompression compression;
+
     // The CRC32C of the batch data.
     uint32_t msg_crc;
 
@@ -318,6 +351,19 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
                                          faststring* tmp_buf,
                                          LogEntryBatchPB* batch);
 
+  // Same as above, but reads the entry from read_ahead, which should belong to this segment.
+  // When the entry is not fully contained in read_ahead, it is refilled with at least
+  // read_ahead_bytes of data starting at the entry.
+  CHECKED_STATUS ReadEntryHeaderAndBatch(int64_t* offset,
+                                         size_t read_ahead_bytes,
+                                         LogSegmentReadAhead* read_ahead,
+                                         LogEntryBatchPB* batch);
+
+  // Returns length bytes of the segment starting at offset from read_ahead, refilling it if
+  // necessary.
+  Result<Slice> ReadAhead(int64_t offset, size_t length, size_t read_ahead_bytes,
+                          LogSegmentReadAhead* read_ahead);
+
   // Reads a log entry header from the segment.
   // Also increments the passed offset* by the length of the entry.
   CHECKED_STATUS ReadEntryHeader(int64_t *offset, EntryHeader* header);
@@ -336,6 +382,15 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
                                 faststring* tmp_buf,
                                 LogEntryBatchPB* entry_batch);
 
+  // Verifies and parses batch data that was read from the provided offset.
+  CHECKED_STATUS ParseEntryBatch(int64_t offset,
+                                 const EntryHeader& header,
+                                 const Slice& data,
+                                 LogEntryBatchPB* entry_batch);
+
+  // Checks that the entry with the provided header, starting at offset, could be read.
+  CHECKED_STATUS CheckEntryLength(int64_t offset, const EntryHeader& header);
+
   void UpdateReadableToOffset(int64_t readable_to_offset);
 
   const std::string path_;
@@ -398,7 +453,10 @@ class WritableLogSegment {
   // Appends the provided batch of data, including a header
   // and checksum.
   // Makes sure that the log segment has not been closed.
-  CHECKED_STATUS WriteEntryBatch(const Slice& entry_batch_data);
+  // The data is compressed with the specified compression, unless it does not make it smaller.
+  CHECKED_STATUS WriteEntryBatch(
+      const Slice& entry_batch_data,
+      LogEntryCompression compression = LogEntryCompression::kNone);
 
   // Makes sure the I/O buffers in the underlying writable file are flushed.
   CHECKED_STATUS Sync() {
@@ -463,6 +521,9 @@ class WritableLogSegment {
   // The offset where the last written entry ends.
   int64_t written_offset_;
 
+  // Buffer for compressed entry batch data, reused between writes.
+  faststring compression_buffer_;
+
   DISALLOW_COPY_AND_ASSIGN(WritableLogSegment);
 };
 
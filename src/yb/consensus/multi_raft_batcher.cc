@@ -0,0 +1,186 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/multi_raft_batcher.h"
+
+#include <algorithm>
+
+#include <gflags/gflags.h>
+
+#include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/consensus.proxy.h"
+
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/rpc_controller.h"
+#include "yb/rpc/scheduler.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/monotime.h"
+
+using namespace std::literals;
+
+DEFINE_bool(enable_multi_raft_heartbeat_batcher, false,
+            "Coalesce heartbeats from all leaders on this server to the same destination tablet "
+            "server into a single MultiRaftUpdateConsensus RPC.");
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, runtime);
+
+DEFINE_int32(multi_raft_heartbeat_batch_window_ms, 10,
+             "Maximum time a heartbeat waits for other heartbeats to the same tablet server "
+             "before the batch is sent.");
+TAG_FLAG(multi_raft_heartbeat_batch_window_ms, advanced);
+TAG_FLAG(multi_raft_heartbeat_batch_window_ms, runtime);
+
+DEFINE_int32(multi_raft_heartbeat_batch_size, 500,
+             "Batch of heartbeats is sent immediately once it contains this number of "
+             "heartbeats.");
+TAG_FLAG(multi_raft_heartbeat_batch_size, advanced);
+TAG_FLAG(multi_raft_heartbeat_batch_size, runtime);
+
+DECLARE_int32(consensus_rpc_timeout_ms);
+
+namespace yb {
+namespace consensus {
+
+struct MultiRaftHeartbeatBatcher::Batch {
+  MultiRaftConsensusRequestPB request;
+  MultiRaftConsensusResponsePB response;
+  rpc::RpcController controller;
+  std::vector<BatchEntry> entries;
+};
+
+MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(
+    const HostPort& hostport, rpc::ProxyCache* proxy_cache, rpc::Messenger* messenger)
+    : hostport_(hostport),
+      messenger_(messenger),
+      consensus_proxy_(std::make_unique<ConsensusServiceProxy>(proxy_cache, hostport)) {
+}
+
+MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() {
+  // Scheduled flush holds reference to the batcher, so nothing could be pending here.
+  DCHECK(!current_batch_);
+}
+
+void MultiRaftHeartbeatBatcher::AddRequestToBatch(const ConsensusRequestPB* request,
+                                                  ConsensusResponsePB* response,
+                                                  rpc::RpcController* controller,
+                                                  const rpc::ResponseCallback& callback) {
+  BatchPtr full_batch;
+  bool schedule_flush = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!current_batch_) {
+      current_batch_ = std::make_shared<Batch>();
+    }
+    *current_batch_->request.add_consensus_request() = *request;
+    current_batch_->entries.push_back(BatchEntry {
+      .request = request,
+      .response = response,
+      .controller = controller,
+      .callback = callback,
+    });
+    if (current_batch_->entries.size() >=
+            static_cast<size_t>(std::max(FLAGS_multi_raft_heartbeat_batch_size, 1))) {
+      full_batch = std::move(current_batch_);
+    } else if (!flush_scheduled_) {
+      flush_scheduled_ = true;
+      schedule_flush = true;
+    }
+  }
+
+  if (full_batch) {
+    SendBatch(full_batch);
+    return;
+  }
+
+  if (schedule_flush) {
+    messenger_->scheduler().Schedule(
+        [self = shared_from_this()](const Status& status) {
+          // Flush even if the scheduler is shutting down, so callbacks are always invoked.
+          self->FlushBatch();
+        },
+        FLAGS_multi_raft_heartbeat_batch_window_ms * 1ms);
+  }
+}
+
+void MultiRaftHeartbeatBatcher::FlushBatch() {
+  BatchPtr batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flush_scheduled_ = false;
+    batch = std::move(current_batch_);
+  }
+  if (batch) {
+    SendBatch(batch);
+  }
+}
+
+void MultiRaftHeartbeatBatcher::SendBatch(const BatchPtr& batch) {
+  batch->controller.set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+  batch->controller.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
+  consensus_proxy_->MultiRaftUpdateConsensusAsync(
+      batch->request, &batch->response, &batch->controller,
+      std::bind(&MultiRaftHeartbeatBatcher::ProcessBatchResponse, shared_from_this(), batch));
+}
+
+void MultiRaftHeartbeatBatcher::ProcessBatchResponse(const BatchPtr& batch) {
+  auto status = batch->controller.status();
+  if (status.ok() &&
+      batch->response.consensus_response().size() != batch->request.consensus_request().size()) {
+    status = STATUS_FORMAT(
+        IllegalState, "Wrong number of responses: $0, expected: $1",
+        batch->response.consensus_response().size(), batch->request.consensus_request().size());
+  }
+  if (!status.ok()) {
+    YB_LOG_EVERY_N_SECS(WARNING, 10)
+        << "MultiRaftUpdateConsensus to " << hostport_ << " failed: " << status
+        << ", sending " << batch->entries.size() << " heartbeats separately";
+    SendIndividually(batch);
+    return;
+  }
+
+  for (size_t i = 0; i != batch->entries.size(); ++i) {
+    auto& entry = batch->entries[i];
+    entry.response->Swap(batch->response.mutable_consensus_response(static_cast<int>(i)));
+    entry.callback();
+  }
+}
+
+void MultiRaftHeartbeatBatcher::SendIndividually(const BatchPtr& batch) {
+  for (auto& entry : batch->entries) {
+    entry.controller->set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+    consensus_proxy_->UpdateConsensusAsync(
+        *entry.request, entry.response, entry.controller, entry.callback);
+  }
+}
+
+MultiRaftManager::MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache)
+    : messenger_(messenger), proxy_cache_(proxy_cache) {
+}
+
+MultiRaftManager::~MultiRaftManager() {
+}
+
+MultiRaftHeartbeatBatcherPtr MultiRaftManager::AddOrGetBatcher(const HostPort& hostport) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& weak_batcher = batchers_[hostport];
+  auto result = weak_batcher.lock();
+  if (!result) {
+    result = std::make_shared<MultiRaftHeartbeatBatcher>(hostport, proxy_cache_, messenger_);
+    weak_batcher = result;
+  }
+  return result;
+}
+
+} // namespace consensus
+} // namespace yb
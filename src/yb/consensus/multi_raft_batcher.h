@@ -0,0 +1,115 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+#define YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/consensus/consensus_fwd.h"
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/rpc/response_callback.h"
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/net/net_util.h"
+
+namespace yb {
+namespace consensus {
+
+class ConsensusRequestPB;
+class ConsensusResponsePB;
+
+// Coalesces heartbeats that leaders hosted by this server send to replicas on the same
+// destination tablet server into a single MultiRaftUpdateConsensus RPC.
+//
+// Each heartbeat is delayed by at most multi_raft_heartbeat_batch_window_ms, and is flushed
+// earlier when its peer has new operations or committed index to replicate. Responses are
+// fanned out to the callers, so Peer processes them exactly as responses to its own
+// UpdateConsensus RPC. If the batch RPC fails, e.g. because the destination does not support
+// MultiRaftUpdateConsensus yet, every heartbeat of the batch is resent as a regular RPC, so the
+// caller's controller reflects the real status of its own request.
+class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
+ public:
+  MultiRaftHeartbeatBatcher(const HostPort& hostport,
+                            rpc::ProxyCache* proxy_cache,
+                            rpc::Messenger* messenger);
+
+  ~MultiRaftHeartbeatBatcher();
+
+  // Adds request to the current batch. Request, response and controller should stay alive until
+  // callback is invoked.
+  void AddRequestToBatch(const ConsensusRequestPB* request,
+                         ConsensusResponsePB* response,
+                         rpc::RpcController* controller,
+                         const rpc::ResponseCallback& callback);
+
+  // Detaches current batch and sends it.
+  void FlushBatch();
+
+ private:
+  struct BatchEntry {
+    const ConsensusRequestPB* request;
+    ConsensusResponsePB* response;
+    rpc::RpcController* controller;
+    rpc::ResponseCallback callback;
+  };
+
+  struct Batch;
+  typedef std::shared_ptr<Batch> BatchPtr;
+
+  void SendBatch(const BatchPtr& batch);
+
+  void ProcessBatchResponse(const BatchPtr& batch);
+
+  // Sends each request of the batch as a regular UpdateConsensus RPC.
+  void SendIndividually(const BatchPtr& batch);
+
+  const HostPort hostport_;
+  rpc::Messenger* const messenger_;
+  ConsensusServiceProxyPtr consensus_proxy_;
+
+  std::mutex mutex_;
+  BatchPtr current_batch_ GUARDED_BY(mutex_);
+  bool flush_scheduled_ GUARDED_BY(mutex_) = false;
+};
+
+// Keeps one MultiRaftHeartbeatBatcher per destination tablet server, shared by all tablet peers
+// of this server.
+class MultiRaftManager {
+ public:
+  MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache);
+
+  ~MultiRaftManager();
+
+  // Returns batcher for specified destination, creating it if necessary.
+  MultiRaftHeartbeatBatcherPtr AddOrGetBatcher(const HostPort& hostport);
+
+ private:
+  rpc::Messenger* const messenger_;
+  rpc::ProxyCache* const proxy_cache_;
+
+  std::mutex mutex_;
+  // Batcher is destroyed when there are no more peer proxies to its destination.
+  std::unordered_map<HostPort, std::weak_ptr<MultiRaftHeartbeatBatcher>, HostPortHash> batchers_
+      GUARDED_BY(mutex_);
+};
+
+} // namespace consensus
+} // namespace yb
+
+#endif // YB_CONSENSUS_MULTI_RAFT_BATCHER_H
@@ -13,18 +13,21 @@
 
 #include "yb/consensus/replicate_msgs_holder.h"
 
+#include "yb/rpc/rpc_controller.h"
+
 namespace yb {
 namespace consensus {
 
 ReplicateMsgsHolder::ReplicateMsgsHolder(
     google::protobuf::RepeatedPtrField<ReplicateMsg>* ops, ReplicateMsgs messages,
-    ScopedTrackedConsumption consumption)
-    : ops_(ops), messages_(std::move(messages)), consumption_(std::move(consumption)) {
+    ScopedTrackedConsumption consumption, std::vector<RefCntBuffer> serialized_ops)
+    : ops_(ops), messages_(std::move(messages)), consumption_(std::move(consumption)),
+      serialized_ops_(std::move(serialized_ops)) {
 }
 
 ReplicateMsgsHolder::ReplicateMsgsHolder(ReplicateMsgsHolder&& rhs)
     : ops_(rhs.ops_), messages_(std::move(rhs.messages_)),
-      consumption_(std::move(rhs.consumption_)) {
+      consumption_(std::move(rhs.consumption_)), serialized_ops_(std::move(rhs.serialized_ops_)) {
   rhs.ops_ = nullptr;
 }
 
@@ -33,6 +36,7 @@ void ReplicateMsgsHolder::operator=(ReplicateMsgsHolder&& rhs) {
   ops_ = rhs.ops_;
   messages_ = std::move(rhs.messages_);
   consumption_ = std::move(rhs.consumption_);
+  serialized_ops_ = std::move(rhs.serialized_ops_);
   rhs.ops_ = nullptr;
 }
 
@@ -48,6 +52,18 @@ void ReplicateMsgsHolder::Reset() {
 
   messages_.clear();
   consumption_ = ScopedTrackedConsumption();
+  serialized_ops_.clear();
+}
+
+void ReplicateMsgsHolder::MoveSerializedOps(rpc::RpcController* controller) {
+  if (!ops_ || ops_->empty() || serialized_ops_.size() != static_cast<size_t>(ops_->size())) {
+    return;
+  }
+  ops_->ExtractSubrange(0, ops_->size(), nullptr /* elements */);
+  for (auto& op : serialized_ops_) {
+    controller->AppendSerializedRequestFields(std::move(op));
+  }
+  serialized_ops_.clear();
 }
 
 }  // namespace consensus
@@ -18,7 +18,10 @@
 
 #include "yb/consensus/consensus_fwd.h"
 
+#include "yb/rpc/rpc_fwd.h"
+
 #include "yb/util/mem_tracker.h"
+#include "yb/util/ref_cnt_buffer.h"
 
 namespace yb {
 namespace consensus {
@@ -29,7 +32,7 @@ class ReplicateMsgsHolder {
 
   explicit ReplicateMsgsHolder(
       google::protobuf::RepeatedPtrField<ReplicateMsg>* ops, ReplicateMsgs messages,
-      ScopedTrackedConsumption consumption);
+      ScopedTrackedConsumption consumption, std::vector<RefCntBuffer> serialized_ops = {});
 
   ReplicateMsgsHolder(ReplicateMsgsHolder&& rhs);
   void operator=(ReplicateMsgsHolder&& rhs);
@@ -46,6 +49,11 @@ class ReplicateMsgsHolder {
     ops_ = nullptr;
   }
 
+  // Removes ops from the request and appends their serialized form to the controller's request
+  // instead, so they are sent without being serialized again. Does nothing if serialized form is
+  // not available for all ops.
+  void MoveSerializedOps(rpc::RpcController* controller);
+
  private:
   google::protobuf::RepeatedPtrField<ReplicateMsg>* ops_;
 
@@ -56,6 +64,9 @@ class ReplicateMsgsHolder {
   ReplicateMsgs messages_;
 
   ScopedTrackedConsumption consumption_;
+
+  // messages_ in the wire format of the ops field, shared with the log cache.
+  std::vector<RefCntBuffer> serialized_ops_;
 };
 
 }  // namespace consensus
@@ -25,9 +25,13 @@
 #include "yb/docdb/docdb.pb.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent.h"
+#include "yb/docdb/lock_batch.h"
 #include "yb/docdb/shared_lock_manager.h"
 #include "yb/docdb/transaction_dump.h"
+#include "yb/docdb/wait_queue.h"
 
+#include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/metrics.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/trace.h"
@@ -35,6 +39,18 @@
 using namespace std::literals;
 using namespace std::placeholders;
 
+DEFINE_bool(enable_wait_queues, false,
+            "Wait for conflicting transactions to be resolved in per tablet wait queue, instead of "
+            "aborting them. Falls back to priority based resolution when deadlock is detected.");
+TAG_FLAG(enable_wait_queues, runtime);
+TAG_FLAG(enable_wait_queues, advanced);
+
+DEFINE_int32(wait_queue_max_wait_ms, 1000,
+             "Max time that request could wait in wait queue, before falling back to priority "
+             "based conflict resolution.");
+TAG_FLAG(wait_queue_max_wait_ms, runtime);
+TAG_FLAG(wait_queue_max_wait_ms, advanced);
+
 namespace yb {
 namespace docdb {
 
@@ -94,6 +110,9 @@ class ConflictResolverContext {
 
   virtual TransactionId transaction_id() const = 0;
 
+  // Invoked when resolution is restarted from scratch, i.e. after waiting in wait queue.
+  virtual void Restart() = 0;
+
   virtual std::string ToString() const = 0;
 
   std::string LogPrefix() const {
@@ -108,10 +127,12 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
   ConflictResolver(const DocDB& doc_db,
                    TransactionStatusManager* status_manager,
                    PartialRangeKeyIntents partial_range_key_intents,
+                   const WaitQueueContext& wait_queue_context,
                    std::unique_ptr<ConflictResolverContext> context,
                    ResolutionCallback callback)
       : doc_db_(doc_db), status_manager_(*status_manager), request_scope_(status_manager),
-        partial_range_key_intents_(partial_range_key_intents), context_(std::move(context)),
+        partial_range_key_intents_(partial_range_key_intents),
+        wait_queue_context_(wait_queue_context), context_(std::move(context)),
         callback_(std::move(callback)) {}
 
   PartialRangeKeyIntents partial_range_key_intents() {
@@ -295,12 +316,92 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
       return true;
     }
 
+    if (VERIFY_RESULT(MaybeWaitForRemaining())) {
+      return false;
+    }
+
     RETURN_NOT_OK(context_->CheckPriority(this, RemainingTransactions()));
 
     AbortTransactions();
     return false;
   }
 
+  // Parks this resolver in the wait queue until all remaining transactions are resolved.
+  // In memory locks are released while waiting.
+  // Returns true if resolver was parked, false if priority based resolution should be used.
+  Result<bool> MaybeWaitForRemaining() {
+    auto* wait_queue = wait_queue_context_.wait_queue;
+    auto* lock_batch = wait_queue_context_.lock_batch;
+    if (!wait_queue || !lock_batch || wait_timed_out_ ||
+        !GetAtomicFlag(&FLAGS_enable_wait_queues)) {
+      return false;
+    }
+
+    TransactionIdSet blockers;
+    for (const auto& transaction : RemainingTransactions()) {
+      blockers.insert(transaction.id);
+    }
+    // Total wait time is limited, even when resolver is woken up and has to wait again.
+    if (wait_deadline_ == CoarseTimePoint()) {
+      wait_deadline_ = std::min(
+          CoarseMonoClock::now() + 1ms * GetAtomicFlag(&FLAGS_wait_queue_max_wait_ms),
+          wait_queue_context_.deadline);
+    }
+    // Resolver could be woken up and find the same conflict again, so deadline is checked before
+    // every wait, not only when queue is polled.
+    if (CoarseMonoClock::now() >= wait_deadline_) {
+      VLOG_WITH_PREFIX(3) << "Wait deadline passed";
+      wait_timed_out_ = true;
+      return false;
+    }
+
+    // Locks should be released before we are registered as waiter, otherwise we could be woken up
+    // before releasing them.
+    lock_batch->Unlock();
+    TRACE("Waiting for $0", yb::ToString(blockers));
+    // Resolver could be woken up before WaitOn returns, so its state should not be accessed after
+    // successful WaitOn.
+    auto status = wait_queue->WaitOn(
+        context_->transaction_id(), blockers, wait_deadline_,
+        [self = shared_from_this()](const Status& status) {
+          self->WaitDone(status);
+        });
+    if (status.ok()) {
+      return true;
+    }
+
+    VLOG_WITH_PREFIX(3) << "Cannot wait: " << status;
+    RETURN_NOT_OK(lock_batch->Relock(wait_queue_context_.deadline));
+    return false;
+  }
+
+  // Invoked by wait queue when resolver could continue, usually in tablet thread pool.
+  void WaitDone(const Status& status) {
+    VLOG_WITH_PREFIX(4) << "Wait done: " << status;
+    if (!status.ok() && !status.IsTimedOut()) {
+      InvokeCallback(status);
+      return;
+    }
+
+    auto relock_status = wait_queue_context_.lock_batch->Relock(wait_queue_context_.deadline);
+    if (!relock_status.ok()) {
+      InvokeCallback(relock_status);
+      return;
+    }
+
+    // After timeout we don't wait anymore, so priority based resolution will be used.
+    wait_timed_out_ = !status.ok();
+
+    // State of conflicting transactions could be changed while we were waiting, and new conflicts
+    // could appear. So resolution is restarted from scratch.
+    intent_iter_.Reset();
+    conflicts_.clear();
+    transactions_.clear();
+    remaining_transactions_ = 0;
+    context_->Restart();
+    Resolve();
+  }
+
   // Returns true when there are no conflicts left.
   Result<bool> CheckLocalCommits() {
     return DoCleanup([this](auto* transaction) -> Result<bool> {
@@ -467,6 +568,7 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
   TransactionStatusManager& status_manager_;
   RequestScope request_scope_;
   PartialRangeKeyIntents partial_range_key_intents_;
+  WaitQueueContext wait_queue_context_;
   std::unique_ptr<ConflictResolverContext> context_;
   ResolutionCallback callback_;
 
@@ -477,7 +579,12 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
   // Resolution state for all transactions. Resolved transactions are moved to the end of it.
   std::vector<TransactionData> transactions_;
   // Number of transactions that are not yet resolved. After successful resolution should be 0.
-  size_t remaining_transactions_;
+  size_t remaining_transactions_ = 0;
+
+  // Whether we already waited in wait queue until timeout.
+  bool wait_timed_out_ = false;
+  // Deadline for waiting in wait queue, set when resolver waits for the first time.
+  CoarseTimePoint wait_deadline_;
 
   std::atomic<int> pending_requests_{0};
 };
@@ -672,6 +779,10 @@ class ConflictResolverContextBase : public ConflictResolverContext {
     return conflicts_metric_;
   }
 
+  void Restart() override {
+    fetched_metadata_for_transactions_ = false;
+  }
+
  protected:
   CHECKED_STATUS CheckPriorityInternal(
       ConflictResolver* resolver,
@@ -959,6 +1070,7 @@ void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  const DocDB& doc_db,
                                  PartialRangeKeyIntents partial_range_key_intents,
                                  TransactionStatusManager* status_manager,
+                                 const WaitQueueContext& wait_queue_context,
                                  Counter* conflicts_metric,
                                  ResolutionCallback callback) {
   DCHECK(hybrid_time.is_valid());
@@ -966,7 +1078,8 @@ void ResolveTransactionConflicts(const DocOperations& doc_ops,
   auto context = std::make_unique<TransactionConflictResolverContext>(
       doc_ops, write_batch, hybrid_time, read_time, conflicts_metric);
   auto resolver = std::make_shared<ConflictResolver>(
-      doc_db, status_manager, partial_range_key_intents, std::move(context), std::move(callback));
+      doc_db, status_manager, partial_range_key_intents, wait_queue_context, std::move(context),
+      std::move(callback));
   // Resolve takes a self reference to extend lifetime.
   resolver->Resolve();
   TRACE("resolver->Resolve done");
@@ -977,13 +1090,15 @@ void ResolveOperationConflicts(const DocOperations& doc_ops,
                                const DocDB& doc_db,
                                PartialRangeKeyIntents partial_range_key_intents,
                                TransactionStatusManager* status_manager,
+                               const WaitQueueContext& wait_queue_context,
                                Counter* conflicts_metric,
                                ResolutionCallback callback) {
   TRACE("ResolveOperationConflicts");
   auto context = std::make_unique<OperationConflictResolverContext>(&doc_ops, resolution_ht,
                                                                     conflicts_metric);
   auto resolver = std::make_shared<ConflictResolver>(
-      doc_db, status_manager, partial_range_key_intents, std::move(context), std::move(callback));
+      doc_db, status_manager, partial_range_key_intents, wait_queue_context, std::move(context),
+      std::move(callback));
   // Resolve takes a self reference to extend lifetime.
   resolver->Resolve();
   TRACE("resolver->Resolve done");
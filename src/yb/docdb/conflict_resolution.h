@@ -39,16 +39,30 @@ namespace docdb {
 
 using ResolutionCallback = boost::function<void(const Result<HybridTime>&)>;
 
+// Parameters used to park conflict resolution in wait queue, instead of aborting conflicting
+// transactions.
+struct WaitQueueContext {
+  // Wait queue of the tablet, nullptr if waiting is not supported.
+  WaitQueue* wait_queue = nullptr;
+  // In memory locks held by the request. They are released while request waits.
+  LockBatch* lock_batch = nullptr;
+  // Deadline of the request.
+  CoarseTimePoint deadline;
+};
+
 // Resolves conflicts for write batch of transaction.
 // Read all intents that could conflict with intents generated by provided write_batch.
 // Forms set of conflicting transactions.
-// Tries to abort transactions with lower priority.
+// If wait queues are enabled, waits until conflicting transactions are resolved, unless
+// it would cause a deadlock.
+// Otherwise tries to abort transactions with lower priority.
 // If it conflicts with transaction with higher priority or committed one then error is returned.
 //
 // write_batch - values that would be written as part of transaction.
 // hybrid_time - current hybrid time.
 // db - db that contains tablet data.
 // status_manager - status manager that should be used during this conflict resolution.
+// wait_queue_context - wait queue related parameters.
 // conflicts_metric - transaction_conflicts metric to update.
 void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  const KeyValueWriteBatchPB& write_batch,
@@ -57,13 +71,14 @@ void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  const DocDB& doc_db,
                                  PartialRangeKeyIntents partial_range_key_intents,
                                  TransactionStatusManager* status_manager,
+                                 const WaitQueueContext& wait_queue_context,
                                  Counter* conflicts_metric,
                                  ResolutionCallback callback);
 
 // Resolves conflicts for doc operations.
 // Read all intents that could conflict with provided doc_ops.
 // Forms set of conflicting transactions.
-// Tries to abort conflicting transactions.
+// Waits for or tries to abort conflicting transactions.
 // If it conflicts with already committed transaction, then returns maximal commit time of such
 // transaction. So we could update local clock and apply those operations later than conflicting
 // transaction.
@@ -72,11 +87,13 @@ void ResolveTransactionConflicts(const DocOperations& doc_ops,
 // resolution_ht - current hybrid time. Used to request status of conflicting transactions.
 // db - db that contains tablet data.
 // status_manager - status manager that should be used during this conflict resolution.
+// wait_queue_context - wait queue related parameters.
 void ResolveOperationConflicts(const DocOperations& doc_ops,
                                HybridTime resolution_ht,
                                const DocDB& doc_db,
                                PartialRangeKeyIntents partial_range_key_intents,
                                TransactionStatusManager* status_manager,
+                               const WaitQueueContext& wait_queue_context,
                                Counter* conflicts_metric,
                                ResolutionCallback callback);
 
@@ -430,6 +430,68 @@ TEST_F(DocKeyTest, TestKeyMatching) {
   ASSERT_FALSE(may_match(EncodeSimpleSubDocKey(absent_key))) << "Key: " << absent_key;
 }
 
+TEST_F(DocKeyTest, TestRangePrefixKeyMatching) {
+  DocDbAwareRangePrefixFilterPolicy policy(
+      rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr, 2);
+  const auto* transformer = policy.GetKeyTransformer();
+  // Encoded doc key without trailing group end.
+  auto prefix = [](const DocKey& doc_key) {
+    auto result = doc_key.Encode().ToStringBuffer();
+    result.pop_back();
+    return result;
+  };
+  auto transform = [transformer](const DocKey& doc_key, int sub_key) {
+    auto key = SubDocKey(doc_key, PrimitiveValue(sub_key)).Encode();
+    return transformer->Transform(key.AsSlice()).ToBuffer();
+  };
+
+  const DocKey key1(PrimitiveValues("a", 1, "x"));
+  const DocKey key2(PrimitiveValues("a", 1, "y"));
+  const DocKey key3(PrimitiveValues("a", 2, "x"));
+  ASSERT_EQ(transform(key1, 1), transform(key2, 2));
+  ASSERT_NE(transform(key1, 1), transform(key3, 1));
+  ASSERT_EQ(prefix(DocKey(PrimitiveValues("a", 1))), transform(key1, 1));
+
+  // Keys with less range components should not be filtered.
+  ASSERT_EQ("", transform(DocKey(PrimitiveValues("a")), 1));
+  ASSERT_EQ("", transform(DocKey(), 1));
+
+  // Hashed keys are filtered by hashed components only.
+  const DocKey hashed_key1(0x1234, PrimitiveValues("h"), PrimitiveValues("a", 1));
+  const DocKey hashed_key2(0x1234, PrimitiveValues("h"), PrimitiveValues("b", 2));
+  ASSERT_EQ(transform(hashed_key1, 1), transform(hashed_key2, 1));
+  ASSERT_EQ(prefix(DocKey(0x1234, PrimitiveValues("h"), {})), transform(hashed_key1, 1));
+
+  ASSERT_EQ(std::string("DocKeyRangePrefix2Filter"), policy.Name());
+}
+
+TEST_F(DocKeyTest, TestCommonDocKeyComponentsPrefixSize) {
+  auto common_prefix = [](const DocKey& lhs, const DocKey& rhs) {
+    return CommonDocKeyComponentsPrefixSize(lhs.Encode().AsSlice(), rhs.Encode().AsSlice());
+  };
+  // Size of encoded doc key without trailing group end.
+  auto encoded_size = [](const DocKey& doc_key) {
+    return doc_key.Encode().size() - 1;
+  };
+
+  const DocKey key(PrimitiveValues("a", 1, "x"));
+  ASSERT_EQ(encoded_size(key), ASSERT_RESULT(common_prefix(key, key)));
+  ASSERT_EQ(encoded_size(DocKey(PrimitiveValues("a", 1))),
+            ASSERT_RESULT(common_prefix(key, DocKey(PrimitiveValues("a", 1, "y")))));
+  ASSERT_EQ(encoded_size(DocKey(PrimitiveValues("a", 1))),
+            ASSERT_RESULT(common_prefix(key, DocKey(PrimitiveValues("a", 1)))));
+  // Components "a" and "ab" share encoded bytes, but are different components.
+  ASSERT_EQ(0, ASSERT_RESULT(common_prefix(key, DocKey(PrimitiveValues("ab", 1, "x")))));
+
+  const DocKey hashed_key(0x1234, PrimitiveValues("h"), PrimitiveValues("a", 1));
+  ASSERT_EQ(encoded_size(DocKey(0x1234, PrimitiveValues("h"), PrimitiveValues("a"))),
+            ASSERT_RESULT(common_prefix(
+                hashed_key, DocKey(0x1234, PrimitiveValues("h"), PrimitiveValues("a", 2)))));
+  ASSERT_EQ(0, ASSERT_RESULT(common_prefix(
+      hashed_key, DocKey(0x1234, PrimitiveValues("g"), PrimitiveValues("a", 1)))));
+  ASSERT_EQ(0, ASSERT_RESULT(common_prefix(hashed_key, key)));
+}
+
 TEST_F(DocKeyTest, TestWriteId) {
   SubDocKey subdoc_key(DocKey({PrimitiveValue("a"), PrimitiveValue(135)}),
                        DocHybridTime(1000000, 4091, 135));
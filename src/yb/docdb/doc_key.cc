@@ -1114,6 +1114,46 @@ class HashedDocKeyUpToHashComponentsExtractor : public rocksdb::FilterPolicy::Ke
   HashedDocKeyUpToHashComponentsExtractor() = default;
 };
 
+class RangeComponentsPrefixExtractor : public rocksdb::FilterPolicy::KeyTransformer {
+ public:
+  explicit RangeComponentsPrefixExtractor(size_t num_range_components)
+      : num_range_components_(num_range_components) {}
+
+  // For encoded DocKey without hash code extracts prefix that contains num_range_components_
+  // range components. Returns empty key when there is less range components or key is not a valid
+  // DocKey, so such keys always match the filter.
+  Slice Transform(Slice key) const override {
+    DocKeyDecoder decoder(key);
+    auto prefix_size = DoTransform(&decoder);
+    if (!prefix_size.ok()) {
+      return Slice();
+    }
+    return Slice(key.data(), *prefix_size);
+  }
+
+ private:
+  Result<size_t> DoTransform(DocKeyDecoder* decoder) const {
+    const auto* start = decoder->left_input().data();
+    RETURN_NOT_OK(decoder->DecodeCotableId());
+    RETURN_NOT_OK(decoder->DecodePgtableId());
+    if (VERIFY_RESULT(decoder->DecodeHashCode())) {
+      // Hash-partitioned key is filtered by hashed components, the same as DocKeyV3Filter.
+      while (VERIFY_RESULT(ConsumePrimitiveValueFromKey(decoder->mutable_input()))) {
+      }
+      return decoder->ConsumedSizeFrom(start);
+    }
+    for (size_t i = 0; i != num_range_components_; ++i) {
+      if (decoder->GroupEnded()) {
+        return 0;
+      }
+      RETURN_NOT_OK(decoder->DecodePrimitiveValue());
+    }
+    return decoder->ConsumedSizeFrom(start);
+  }
+
+  const size_t num_range_components_;
+};
+
 } // namespace
 
 void DocDbAwareFilterPolicyBase::CreateFilter(
@@ -1158,6 +1198,24 @@ DocDbAwareV3FilterPolicy::GetKeyTransformer() const {
   return &DocKeyComponentsExtractor<DocKeyPart::kUpToHashOrFirstRange>::GetInstance();
 }
 
+constexpr size_t DocDbAwareRangePrefixFilterPolicy::kMaxRangeComponents;
+
+DocDbAwareRangePrefixFilterPolicy::DocDbAwareRangePrefixFilterPolicy(
+    size_t filter_block_size_bits, rocksdb::Logger* logger, size_t num_range_components)
+    : DocDbAwareFilterPolicyBase(filter_block_size_bits, logger),
+      name_(Format("DocKeyRangePrefix$0Filter", num_range_components)),
+      key_transformer_(new RangeComponentsPrefixExtractor(num_range_components)) {
+  DCHECK_GE(num_range_components, 1);
+  DCHECK_LE(num_range_components, kMaxRangeComponents);
+}
+
+DocDbAwareRangePrefixFilterPolicy::~DocDbAwareRangePrefixFilterPolicy() = default;
+
+const rocksdb::FilterPolicy::KeyTransformer*
+DocDbAwareRangePrefixFilterPolicy::GetKeyTransformer() const {
+  return key_transformer_.get();
+}
+
 DocKeyEncoderAfterTableIdStep DocKeyEncoder::CotableId(const Uuid& cotable_id) {
   if (!cotable_id.IsNil()) {
     std::string bytes;
@@ -1370,6 +1428,57 @@ Result<bool> HashedOrFirstRangeComponentsEqual(const Slice& lhs, const Slice& rh
   return rhs_decoder.GroupEnded();
 }
 
+Result<size_t> CommonDocKeyComponentsPrefixSize(const Slice& lhs, const Slice& rhs) {
+  DocKeyDecoder lhs_decoder(lhs);
+  DocKeyDecoder rhs_decoder(rhs);
+  size_t result = 0;
+  // Checks whether last decoded parts of lhs and rhs are equal, and if so extends result.
+  auto same_part = [&lhs, &rhs, &lhs_decoder, &rhs_decoder, &result] {
+    const auto lhs_consumed = lhs_decoder.ConsumedSizeFrom(lhs.data());
+    if (lhs_consumed != rhs_decoder.ConsumedSizeFrom(rhs.data()) ||
+        !strings::memeq(lhs.data() + result, rhs.data() + result, lhs_consumed - result)) {
+      return false;
+    }
+    result = lhs_consumed;
+    return true;
+  };
+
+  RETURN_NOT_OK(lhs_decoder.DecodeCotableId());
+  RETURN_NOT_OK(rhs_decoder.DecodeCotableId());
+  RETURN_NOT_OK(lhs_decoder.DecodePgtableId());
+  RETURN_NOT_OK(rhs_decoder.DecodePgtableId());
+  if (!same_part()) {
+    return result;
+  }
+
+  const bool hash_present = VERIFY_RESULT(lhs_decoder.DecodeHashCode(AllowSpecial::kTrue));
+  if (hash_present != VERIFY_RESULT(rhs_decoder.DecodeHashCode(AllowSpecial::kTrue))) {
+    return result;
+  }
+  if (hash_present) {
+    for (auto* decoder : {&lhs_decoder, &rhs_decoder}) {
+      while (!decoder->GroupEnded()) {
+        RETURN_NOT_OK(decoder->DecodePrimitiveValue(AllowSpecial::kTrue));
+      }
+      if (!decoder->left_input().empty()) {
+        RETURN_NOT_OK(decoder->ConsumeGroupEnd());
+      }
+    }
+    if (!same_part()) {
+      return result;
+    }
+  }
+
+  while (!lhs_decoder.GroupEnded() && !rhs_decoder.GroupEnded()) {
+    RETURN_NOT_OK(lhs_decoder.DecodePrimitiveValue(AllowSpecial::kTrue));
+    RETURN_NOT_OK(rhs_decoder.DecodePrimitiveValue(AllowSpecial::kTrue));
+    if (!same_part()) {
+      break;
+    }
+  }
+  return result;
+}
+
 bool DocKeyBelongsTo(Slice doc_key, const Schema& schema) {
   bool has_table_id = !doc_key.empty() &&
       (doc_key[0] == ValueTypeAsChar::kTableId || doc_key[0] == ValueTypeAsChar::kPgTableOid);
@@ -439,6 +439,10 @@ Result<bool> ClearRangeComponents(KeyBytes* out, AllowSpecial allow_special = Al
 // hashed components and first range components are equal and false otherwise.
 Result<bool> HashedOrFirstRangeComponentsEqual(const Slice& lhs, const Slice& rhs);
 
+// Returns size of the longest common prefix of encoded doc keys, that consists of whole doc key
+// components. Hashed components (together with hash code) are considered as single component.
+Result<size_t> CommonDocKeyComponentsPrefixSize(const Slice& lhs, const Slice& rhs);
+
 bool DocKeyBelongsTo(Slice doc_key, const Schema& schema);
 
 // Consumes single primitive value from start of slice.
@@ -893,6 +897,31 @@ class DocDbAwareV3FilterPolicy : public DocDbAwareFilterPolicyBase {
   const KeyTransformer* GetKeyTransformer() const override;
 };
 
+// This filter policy is intended for range-partitioned tables and takes into account specified
+// number of leading range components of the doc key. So lookups on range-partitioned tables that
+// specify several leading range components could skip SST files, even when first range component
+// has low cardinality.
+// Keys that have less range components always match the filter. Keys with hashed components are
+// handled in the same way as by DocDbAwareV3FilterPolicy.
+class DocDbAwareRangePrefixFilterPolicy : public DocDbAwareFilterPolicyBase {
+ public:
+  // Max number of range components that could be used by this filter policy.
+  static constexpr size_t kMaxRangeComponents = 8;
+
+  DocDbAwareRangePrefixFilterPolicy(
+      size_t filter_block_size_bits, rocksdb::Logger* logger, size_t num_range_components);
+
+  ~DocDbAwareRangePrefixFilterPolicy();
+
+  const char* Name() const override { return name_.c_str(); }
+
+  const KeyTransformer* GetKeyTransformer() const override;
+
+ private:
+  const std::string name_;
+  std::unique_ptr<const KeyTransformer> key_transformer_;
+};
+
 // Optional inclusive lower bound and exclusive upper bound for keys served by DocDB.
 // Could be used to split tablet without doing actual splitting of RocksDB files.
 // DocDBCompactionFilter also respects these bounds, so it will filter out non-relevant keys
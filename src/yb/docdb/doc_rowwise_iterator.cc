@@ -503,7 +503,10 @@ Status DocRowwiseIterator::Init(TableType table_type) {
       rocksdb::kDefaultQueryId,
       txn_op_context_,
       deadline_,
-      read_time_);
+      read_time_,
+      nullptr /* file_filter */,
+      nullptr /* iterate_upper_bound */,
+      &KeyBounds::kNoBounds);
   DocKeyEncoder(&iter_key_).Schema(schema_);
   row_key_ = iter_key_;
   row_hash_key_ = row_key_;
@@ -568,10 +571,19 @@ Status DocRowwiseIterator::DoInit(const T& doc_spec) {
       VERIFY_RESULT(HashedOrFirstRangeComponentsEqual(lower_doc_key, upper_doc_key));
   const auto mode = is_fixed_point_get ? BloomFilterMode::USE_BLOOM_FILTER
                                        : BloomFilterMode::DONT_USE_BLOOM_FILTER;
+  // Filter key should contain only components that are the same for all keys in the scanned range,
+  // because filter policy could use several leading range components.
+  auto key_for_filter = lower_doc_key.AsSlice();
+  if (is_fixed_point_get) {
+    key_for_filter = key_for_filter.Prefix(
+        VERIFY_RESULT(CommonDocKeyComponentsPrefixSize(lower_doc_key, upper_doc_key)));
+  }
 
+  const KeyBounds scan_bounds(lower_doc_key.AsSlice(), upper_doc_key.AsSlice());
   db_iter_ = CreateIntentAwareIterator(
-      doc_db_, mode, lower_doc_key.AsSlice(), doc_spec.QueryId(), txn_op_context_,
-      deadline_, read_time_, doc_spec.CreateFileFilter());
+      doc_db_, mode, key_for_filter, doc_spec.QueryId(), txn_op_context_,
+      deadline_, read_time_, doc_spec.CreateFileFilter(), nullptr /* iterate_upper_bound */,
+      &scan_bounds);
 
   row_ready_ = false;
 
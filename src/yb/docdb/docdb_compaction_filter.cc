@@ -357,6 +357,16 @@ unique_ptr<CompactionFilter> DocDBCompactionFilterFactory::CreateCompactionFilte
       key_bounds_);
 }
 
+Slice DocDBCompactionFilterFactory::SubcompactionBoundary(const Slice& user_key) const {
+  // Filter tracks overwrite hybrid times of the document while iterating over its subkeys, so all
+  // records of the same document should be processed by the same subcompaction.
+  auto doc_key_size = DocKey::EncodedSize(user_key, DocKeyPart::kWholeDocKey);
+  if (!doc_key_size.ok()) {
+    return Slice();
+  }
+  return user_key.Prefix(*doc_key_size);
+}
+
 const char* DocDBCompactionFilterFactory::Name() const {
   return "DocDBCompactionFilterFactory";
 }
@@ -168,6 +168,7 @@ class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
   ~DocDBCompactionFilterFactory() override;
   std::unique_ptr<rocksdb::CompactionFilter> CreateCompactionFilter(
       const rocksdb::CompactionFilter::Context& context) override;
+  Slice SubcompactionBoundary(const Slice& user_key) const override;
   const char* Name() const override;
 
  private:
@@ -28,9 +28,11 @@ class DocWriteBatch;
 class IntentAwareIterator;
 class KeyBytes;
 class KeyValueWriteBatchPB;
+class LockBatch;
 class PgsqlWriteOperation;
 class QLWriteOperation;
 class SubDocKey;
+class WaitQueue;
 
 struct ApplyTransactionState;
 struct DocDB;
@@ -14,6 +14,7 @@
 #include "yb/docdb/docdb_rocksdb_util.h"
 
 #include <thread>
+#include <limits>
 #include <memory>
 
 #include "yb/common/transaction.h"
@@ -77,6 +78,10 @@ DEFINE_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 1024 * 1024
              "Threshold beyond which compaction is considered large.");
 DEFINE_uint64(rocksdb_max_file_size_for_compaction, 0,
              "Maximal allowed file size to participate in RocksDB compaction. 0 - unlimited.");
+DEFINE_int32(rocksdb_max_subcompactions, 1,
+             "Maximal number of threads used by a single RocksDB compaction. Compaction input is "
+             "split into key ranges aligned to document boundaries, that are compacted in "
+             "parallel. 1 - no subcompactions.");
 DEFINE_int32(rocksdb_max_write_buffer_number, 2,
              "Maximum number of write buffers that are built up in memory.");
 
@@ -106,6 +111,17 @@ DEFINE_int32(max_nexts_to_avoid_seek, 2,
 
 DEFINE_bool(use_multi_level_index, true, "Whether to use multi-level data index.");
 
+DEFINE_bool(db_warm_up_index_on_open, true,
+            "Whether to load data index and upper levels of multi-level index to the metadata "
+            "block cache, when SST file is opened. Used only when metadata block cache is "
+            "enabled.");
+
+DEFINE_int32(max_range_components_in_bloom_filter, 1,
+             "Max number of leading range components of the primary key used by bloom filter of "
+             "range-partitioned tables. Actual number is limited by number of range columns in "
+             "the primary key. Lookups that don't specify all of those components could not use "
+             "bloom filter. 1 means that only first range component is used.");
+
 DEFINE_string(
     regular_tablets_data_block_key_value_encoding, "shared_prefix",
     "Key-value encoding to use for regular data blocks in RocksDB. Possible options: "
@@ -128,6 +144,21 @@ DEFINE_string(compression_type, "Snappy",
               "On-disk compression type to use in RocksDB."
               "By default, Snappy is used if supported.");
 
+DEFINE_int32(compression_level, -1,
+             "Compression level to use in RocksDB, -1 means default level of compression type. "
+             "Used by Zlib and ZSTD compression.");
+
+DEFINE_uint64(zstd_compression_max_dict_bytes, 0,
+              "Maximum size of dictionary used for ZSTD compression of data blocks of SST files "
+              "produced by compaction. Dictionary is stored in SST file, so larger dictionary "
+              "improves compression ratio for small blocks, but increases file size. "
+              "0 - dictionary is not used.");
+
+DEFINE_uint64(zstd_compression_max_train_bytes, 0,
+              "Maximum size of data blocks used to train ZSTD compression dictionary. If 0, then "
+              "raw content of the first data blocks is used as dictionary. Data blocks are kept "
+              "in memory during training.");
+
 DEFINE_int32(block_restart_interval, kDefaultBlockStartInterval,
              "Controls the number of keys to look at for computing the diff encoding.");
 
@@ -143,7 +174,8 @@ Result<rocksdb::CompressionType> GetConfiguredCompressionType(const std::string&
     rocksdb::kNoCompression,
     rocksdb::kSnappyCompression,
     rocksdb::kZlibCompression,
-    rocksdb::kLZ4Compression
+    rocksdb::kLZ4Compression,
+    rocksdb::kZSTD
   };
   for (const auto& compression_type : kValidRocksDBCompressionTypes) {
     if (flag_value == rocksdb::CompressionTypeToString(compression_type)) {
@@ -198,12 +230,26 @@ bool KeyValueEncodingFormatValidator(const char* flag_name, const std::string& f
   return ok;
 }
 
+// ZSTD dictionary options are stored as uint32_t in rocksdb::CompressionOptions.
+bool ZSTDCompressionBytesValidator(const char* flag_name, uint64_t value) {
+  if (value > std::numeric_limits<uint32_t>::max()) {
+    LOG(ERROR) << flag_name << ": " << value << " exceeds "
+               << std::numeric_limits<uint32_t>::max();
+    return false;
+  }
+  return true;
+}
+
 } // namespace
 
 __attribute__((unused))
 DEFINE_validator(compression_type, &CompressionTypeValidator);
 __attribute__((unused))
 DEFINE_validator(regular_tablets_data_block_key_value_encoding, &KeyValueEncodingFormatValidator);
+__attribute__((unused))
+DEFINE_validator(zstd_compression_max_dict_bytes, &ZSTDCompressionBytesValidator);
+__attribute__((unused))
+DEFINE_validator(zstd_compression_max_train_bytes, &ZSTDCompressionBytesValidator);
 
 using std::shared_ptr;
 using std::string;
@@ -342,12 +388,13 @@ unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time,
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter,
-    const Slice* iterate_upper_bound) {
+    const Slice* iterate_upper_bound,
+    const KeyBounds* scan_bounds) {
   // TODO(dtxn) do we need separate options for intents db?
   rocksdb::ReadOptions read_opts = PrepareReadOptions(doc_db.regular, bloom_filter_mode,
       user_key_for_filter, query_id, std::move(file_filter), iterate_upper_bound);
   return std::make_unique<IntentAwareIterator>(
-      doc_db, read_opts, deadline, read_time, txn_op_context);
+      doc_db, read_opts, deadline, read_time, txn_op_context, scan_bounds);
 }
 
 namespace {
@@ -501,6 +548,16 @@ PriorityThreadPool* GetGlobalPriorityThreadPool() {
 
 } // namespace
 
+size_t BloomFilterRangeComponents(const Schema& schema) {
+  if (schema.num_hash_key_columns() != 0) {
+    return 0;
+  }
+  const auto max_range_components = std::min<size_t>(
+      std::max(FLAGS_max_range_components_in_bloom_filter, 1),
+      DocDbAwareRangePrefixFilterPolicy::kMaxRangeComponents);
+  return std::min(schema.num_range_key_columns(), max_range_components);
+}
+
 rocksdb::Options TEST_AutoInitFromRocksDBFlags() {
   rocksdb::Options options;
   AutoInitFromRocksDBFlags(&options);
@@ -552,7 +609,8 @@ void InitRocksDBOptions(
     rocksdb::Options* options, const string& log_prefix,
     const shared_ptr<rocksdb::Statistics>& statistics,
     const tablet::TabletOptions& tablet_options,
-    rocksdb::BlockBasedTableOptions table_options) {
+    rocksdb::BlockBasedTableOptions table_options,
+    size_t bloom_filter_range_components) {
   AutoInitFromRocksDBFlags(options);
   SetLogPrefix(options, log_prefix);
   options->create_if_missing = true;
@@ -579,6 +637,13 @@ void InitRocksDBOptions(
   // Since the flag validator for FLAGS_compression_type will fail if the result of this call is not
   // OK, this CHECK_RESULT should never fail and is safe.
   options->compression = CHECK_RESULT(GetConfiguredCompressionType(FLAGS_compression_type));
+  options->compression_opts.level = FLAGS_compression_level;
+  if (options->compression == rocksdb::kZSTD) {
+    options->compression_opts.max_dict_bytes =
+        static_cast<uint32_t>(FLAGS_zstd_compression_max_dict_bytes);
+    options->compression_opts.zstd_max_train_bytes =
+        static_cast<uint32_t>(FLAGS_zstd_compression_max_train_bytes);
+  }
 
   options->listeners.insert(
       options->listeners.end(), tablet_options.listeners.begin(),
@@ -589,6 +654,9 @@ void InitRocksDBOptions(
     table_options.block_cache = tablet_options.block_cache;
     // Cache the bloom filters in the block cache.
     table_options.cache_index_and_filter_blocks = true;
+    // Index and filter blocks are stored in separate cache, when it is configured.
+    table_options.metadata_block_cache = tablet_options.metadata_block_cache;
+    table_options.warm_up_index_on_open = FLAGS_db_warm_up_index_on_open;
   } else {
     table_options.no_block_cache = true;
     table_options.cache_index_and_filter_blocks = false;
@@ -599,14 +667,30 @@ void InitRocksDBOptions(
   // Set our custom bloom filter that is docdb aware.
   if (FLAGS_use_docdb_aware_bloom_filter) {
     const auto filter_block_size_bits = table_options.filter_block_size * 8;
-    table_options.filter_policy = std::make_shared<const DocDbAwareV3FilterPolicy>(
-        filter_block_size_bits, options->info_log.get());
+    if (bloom_filter_range_components > 1) {
+      table_options.filter_policy = std::make_shared<const DocDbAwareRangePrefixFilterPolicy>(
+          filter_block_size_bits, options->info_log.get(), bloom_filter_range_components);
+    } else {
+      table_options.filter_policy = std::make_shared<const DocDbAwareV3FilterPolicy>(
+          filter_block_size_bits, options->info_log.get());
+    }
     table_options.supported_filter_policies =
         std::make_shared<rocksdb::BlockBasedTableOptions::FilterPoliciesMap>();
     AddSupportedFilterPolicy(std::make_shared<const DocDbAwareHashedComponentsFilterPolicy>(
             filter_block_size_bits, options->info_log.get()), &table_options);
     AddSupportedFilterPolicy(std::make_shared<const DocDbAwareV2FilterPolicy>(
             filter_block_size_bits, options->info_log.get()), &table_options);
+    // Number of range components used by filter could be changed, so files written with any of
+    // them should remain readable with filtering.
+    AddSupportedFilterPolicy(std::make_shared<const DocDbAwareV3FilterPolicy>(
+            filter_block_size_bits, options->info_log.get()), &table_options);
+    for (size_t num_range_components = 2;
+         num_range_components <= DocDbAwareRangePrefixFilterPolicy::kMaxRangeComponents;
+         ++num_range_components) {
+      AddSupportedFilterPolicy(std::make_shared<const DocDbAwareRangePrefixFilterPolicy>(
+              filter_block_size_bits, options->info_log.get(), num_range_components),
+          &table_options);
+    }
   }
 
   if (FLAGS_use_multi_level_index) {
@@ -644,6 +728,7 @@ void InitRocksDBOptions(
     options->compaction_options_universal.min_merge_width =
         FLAGS_rocksdb_universal_compaction_min_merge_width;
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
+    options->max_subcompactions = std::max(FLAGS_rocksdb_max_subcompactions, 1);
     if (FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec > 0) {
       options->rate_limiter.reset(
           rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec));
@@ -102,7 +102,8 @@ std::unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time,
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter = nullptr,
-    const Slice* iterate_upper_bound = nullptr);
+    const Slice* iterate_upper_bound = nullptr,
+    const KeyBounds* scan_bounds = nullptr);
 
 // Request RocksDB compaction and wait until it completes.
 CHECKED_STATUS ForceRocksDBCompact(rocksdb::DB* db);
@@ -114,14 +115,21 @@ rocksdb::BlockBasedTableOptions TEST_AutoInitFromRocksDbTableFlags();
 Result<rocksdb::KeyValueEncodingFormat> GetConfiguredKeyValueEncodingFormat(
     const std::string& flag_value);
 
+// Returns number of leading range components that bloom filter should use for the table with
+// specified schema. 0 is returned for hash-partitioned tables.
+size_t BloomFilterRangeComponents(const Schema& schema);
+
 // Initialize the RocksDB 'options'.
 // The 'statistics' object provided by the caller will be used by RocksDB to maintain the stats for
 // the tablet.
+// bloom_filter_range_components - number of leading range components used by bloom filter, see
+// BloomFilterRangeComponents. Values less than 2 select default filter policy.
 void InitRocksDBOptions(
     rocksdb::Options* options, const std::string& log_prefix,
     const std::shared_ptr<rocksdb::Statistics>& statistics,
     const tablet::TabletOptions& tablet_options,
-    rocksdb::BlockBasedTableOptions table_options = rocksdb::BlockBasedTableOptions());
+    rocksdb::BlockBasedTableOptions table_options = rocksdb::BlockBasedTableOptions(),
+    size_t bloom_filter_range_components = 0);
 
 // Sets logs prefix for RocksDB options. This will also reinitialize options->info_log.
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix);
@@ -107,6 +107,10 @@ class NonTransactionalStatusProvider: public TransactionStatusManager {
     return HybridTime::kMax;
   }
 
+  bool MayHaveIntentsInRange(const Slice& lower_bound, const Slice& upper_bound) const override {
+    return false;
+  }
+
   Result<HybridTime> WaitForSafeTime(HybridTime safe_time, CoarseTimePoint deadline) override {
     return STATUS(NotSupported, "WaitForSafeTime not implemented");
   }
@@ -31,6 +31,7 @@
 #include "yb/server/hybrid_clock.h"
 
 #include "yb/util/size_literals.h"
+#include "yb/util/stopwatch.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
 
@@ -63,6 +64,24 @@ class DocRowwiseIteratorTest : public DocDBTestBase {
   }
 };
 
+namespace {
+
+class IntentsRangeStatusManagerMock : public TransactionStatusManagerMock {
+ public:
+  bool MayHaveIntentsInRange(const Slice& lower_bound, const Slice& upper_bound) const override {
+    return may_have_intents_;
+  }
+
+  void set_may_have_intents(bool value) {
+    may_have_intents_ = value;
+  }
+
+ private:
+  bool may_have_intents_ = true;
+};
+
+} // namespace
+
 const KeyBytes DocRowwiseIteratorTest::kEncodedDocKey1(
     DocKey(PrimitiveValues("row1", 11111)).Encode());
 
@@ -1270,5 +1289,57 @@ TEST_F(DocRowwiseIteratorTest, ScanWithinTheSameTxn) {
   ASSERT_EQ(intents_db_options_.statistics->getTickerCount(rocksdb::Tickers::NUMBER_DB_SEEK), 3);
 }
 
+// Compares scan of non transactional rows with and without intents DB iterator.
+TEST_F(DocRowwiseIteratorTest, SkipIntentsIteratorBenchmark) {
+  constexpr int kNumRows = 10000;
+  constexpr int kIterations = 20;
+
+  for (int i = 0; i != kNumRows; ++i) {
+    const KeyBytes doc_key(DocKey(PrimitiveValues(Format("row$0", i), i)).Encode());
+    ASSERT_OK(SetPrimitive(
+        DocPath(doc_key, PrimitiveValue(40_ColId)), PrimitiveValue(i),
+        HybridTime::FromMicros(1000)));
+  }
+
+  IntentsRangeStatusManagerMock txn_status_manager;
+  const auto txn_context = TransactionOperationContext(
+      TransactionId::GenerateRandom(), &txn_status_manager);
+  const Schema &projection = kProjectionForIteratorTests;
+
+  auto scan = [&]() -> Result<int> {
+    DocRowwiseIterator iter(
+        projection, kSchemaForIteratorTests, txn_context, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000));
+    RETURN_NOT_OK(iter.Init(YQL_TABLE_TYPE));
+    QLTableRow row;
+    int result = 0;
+    while (VERIFY_RESULT(iter.HasNext())) {
+      RETURN_NOT_OK(iter.NextRow(&row));
+      ++result;
+    }
+    return result;
+  };
+
+  for (bool may_have_intents : {true, false}) {
+    txn_status_manager.set_may_have_intents(may_have_intents);
+    const auto seeks_before =
+        intents_db_options_.statistics->getTickerCount(rocksdb::Tickers::NUMBER_DB_SEEK);
+    Stopwatch sw;
+    sw.start();
+    for (int i = 0; i != kIterations; ++i) {
+      ASSERT_EQ(kNumRows, ASSERT_RESULT(scan()));
+    }
+    sw.stop();
+    const auto intents_seeks =
+        intents_db_options_.statistics->getTickerCount(rocksdb::Tickers::NUMBER_DB_SEEK) -
+        seeks_before;
+    LOG(INFO) << "May have intents: " << may_have_intents << ", time: "
+              << sw.elapsed().wall_millis() << "ms, intents DB seeks: " << intents_seeks;
+    if (!may_have_intents) {
+      ASSERT_EQ(0, intents_seeks);
+    }
+  }
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -30,10 +30,17 @@
 #include "yb/docdb/value.h"
 
 #include "yb/server/hybrid_clock.h"
+#include "yb/util/atomic.h"
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/flag_tags.h"
 
 using namespace std::literals;
 
+DEFINE_bool(skip_intents_iterator_without_intents_in_range, true,
+            "Don't create intents DB iterator when transaction participant knows that there are "
+            "no intents in the scanned range.");
+TAG_FLAG(skip_intents_iterator_without_intents_in_range, runtime);
+
 namespace yb {
 namespace docdb {
 
@@ -225,7 +232,8 @@ IntentAwareIterator::IntentAwareIterator(
     const rocksdb::ReadOptions& read_opts,
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time,
-    const TransactionOperationContextOpt& txn_op_context)
+    const TransactionOperationContextOpt& txn_op_context,
+    const KeyBounds* scan_bounds)
     : read_time_(read_time),
       encoded_read_time_read_(EncodeHybridTime(read_time_.read)),
       encoded_read_time_local_limit_(EncodeHybridTime(read_time_.local_limit)),
@@ -239,7 +247,14 @@ IntentAwareIterator::IntentAwareIterator(
           << ", txn_op_context: " << txn_op_context_;
 
   if (txn_op_context) {
-    if (txn_op_context->txn_status_manager.MinRunningHybridTime() != HybridTime::kMax) {
+    if (txn_op_context->txn_status_manager.MinRunningHybridTime() == HybridTime::kMax) {
+      VLOG(4) << "No transactions running";
+    } else if (scan_bounds &&
+               GetAtomicFlag(&FLAGS_skip_intents_iterator_without_intents_in_range) &&
+               !txn_op_context->txn_status_manager.MayHaveIntentsInRange(
+                   scan_bounds->lower.AsSlice(), scan_bounds->upper.AsSlice())) {
+      VLOG(4) << "No intents in range: " << scan_bounds->ToString();
+    } else {
       intent_iter_ = docdb::CreateRocksDBIterator(doc_db.intents,
                                                   doc_db.key_bounds,
                                                   docdb::BloomFilterMode::DONT_USE_BLOOM_FILTER,
@@ -247,8 +262,6 @@ IntentAwareIterator::IntentAwareIterator(
                                                   rocksdb::kDefaultQueryId,
                                                   nullptr /* file_filter */,
                                                   &intent_upperbound_);
-    } else {
-      VLOG(4) << "No transactions running";
     }
   }
   // WARNING: Is is important for regular DB iterator to be created after intents DB iterator,
@@ -60,12 +60,15 @@ struct FetchKeyResult {
 // HybridTime of subdoc_key in Seek* methods would be ignored.
 class IntentAwareIterator {
  public:
+  // scan_bounds - when specified, iterator is used only for keys in these bounds. So intents DB
+  // iterator is not created when transaction status manager knows that there are no intents there.
   IntentAwareIterator(
       const DocDB& doc_db,
       const rocksdb::ReadOptions& read_opts,
       CoarseTimePoint deadline,
       const ReadHybridTime& read_time,
-      const TransactionOperationContextOpt& txn_op_context);
+      const TransactionOperationContextOpt& txn_op_context,
+      const KeyBounds* scan_bounds = nullptr);
 
   IntentAwareIterator(const IntentAwareIterator& other) = delete;
   void operator=(const IntentAwareIterator& other) = delete;
@@ -44,10 +44,33 @@ LockBatch::~LockBatch() {
 
 void LockBatch::Reset() {
   if (!empty()) {
-    VLOG(1) << "Auto-unlocking a LockBatch with " << size() << " keys";
-    DCHECK_NOTNULL(data_.shared_lock_manager)->Unlock(data_.key_to_type);
+    if (!data_.unlocked) {
+      VLOG(1) << "Auto-unlocking a LockBatch with " << size() << " keys";
+      DCHECK_NOTNULL(data_.shared_lock_manager)->Unlock(data_.key_to_type);
+    }
     data_.key_to_type.clear();
+    data_.unlocked = false;
+  }
+}
+
+void LockBatch::Unlock() {
+  if (empty() || data_.unlocked) {
+    return;
+  }
+  VLOG(1) << "Temporarily unlocking a LockBatch with " << size() << " keys";
+  DCHECK_NOTNULL(data_.shared_lock_manager)->Unlock(data_.key_to_type);
+  data_.unlocked = true;
+}
+
+Status LockBatch::Relock(CoarseTimePoint deadline) {
+  if (!data_.unlocked) {
+    return Status::OK();
+  }
+  if (!data_.shared_lock_manager->Lock(&data_.key_to_type, deadline)) {
+    return STATUS_FORMAT(TryAgain, "Failed to reacquire locks until deadline: $0", deadline);
   }
+  data_.unlocked = false;
+  return Status::OK();
 }
 
 void LockBatch::MoveFrom(LockBatch* other) {
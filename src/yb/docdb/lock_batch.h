@@ -74,6 +74,13 @@ class LockBatch {
   // Unlocks this batch if it is non-empty.
   void Reset();
 
+  // Releases locks held by this batch, but keeps its content, so the same keys could be locked
+  // again using Relock. Used while a request is waiting for conflicting transactions.
+  void Unlock();
+
+  // Reacquires locks previously released by Unlock.
+  CHECKED_STATUS Relock(CoarseTimePoint deadline);
+
  private:
   void MoveFrom(LockBatch* other);
 
@@ -92,6 +99,9 @@ class LockBatch {
 
     SharedLockManager* shared_lock_manager = nullptr;
 
+    // Whether locks were temporarily released by Unlock.
+    bool unlocked = false;
+
     Status status;
   };
 
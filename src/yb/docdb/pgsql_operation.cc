@@ -31,6 +31,7 @@
 #include "yb/docdb/docdb_pgapi.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/pgsql_vectorized_aggregate.h"
 #include "yb/docdb/primitive_value_util.h"
 
 #include "yb/util/flag_tags.h"
@@ -51,6 +52,12 @@ DEFINE_bool(pgsql_consistent_transactional_paging, true,
             "be stale. The latter is preferable for long scans. The data returned for the first "
             "page of results is never stale regardless of this flag.");
 
+DEFINE_bool(ysql_enable_vectorized_aggregates, true,
+            "Evaluate simple pushed down aggregates (COUNT/SUM/MIN/MAX over numeric columns) "
+            "in batches of column values, instead of interpreting them row by row.");
+TAG_FLAG(ysql_enable_vectorized_aggregates, runtime);
+TAG_FLAG(ysql_enable_vectorized_aggregates, advanced);
+
 DEFINE_test_flag(int32, slowdown_pgsql_aggregate_read_ms, 0,
                  "If set > 0, slows down the response to pgsql aggregate read by this amount.");
 
@@ -917,6 +924,12 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const common::YQLStorageIf& ql_
 
   VTRACE(1, "Initialized iterator");
 
+  std::unique_ptr<PgsqlVectorizedAggregator> vectorized_aggregator;
+  if (request_.is_aggregate() && !request_.has_where_expr() &&
+      FLAGS_ysql_enable_vectorized_aggregates) {
+    vectorized_aggregator = PgsqlVectorizedAggregator::Make(request_, schema);
+  }
+
   // Set scan start time.
   bool scan_time_exceeded = false;
 
@@ -953,7 +966,9 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const common::YQLStorageIf& ql_
     }
     if (is_match) {
       match_count++;
-      if (request_.is_aggregate()) {
+      if (vectorized_aggregator) {
+        vectorized_aggregator->AddRow(row);
+      } else if (request_.is_aggregate()) {
         RETURN_NOT_OK(EvalAggregate(row));
       } else {
         RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
@@ -968,6 +983,9 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const common::YQLStorageIf& ql_
   }
 
   if (request_.is_aggregate() && match_count > 0) {
+    if (vectorized_aggregator) {
+      vectorized_aggregator->Finish(&aggr_result_);
+    }
     RETURN_NOT_OK(PopulateAggregate(row, result_buffer));
     ++fetched_rows;
   }
@@ -0,0 +1,231 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <limits>
+#include <random>
+
+#include "yb/bfpg/tserver_opcodes.h"
+
+#include "yb/common/pgsql_protocol.pb.h"
+#include "yb/common/ql_value.h"
+
+#include "yb/docdb/doc_expr.h"
+#include "yb/docdb/pgsql_vectorized_aggregate.h"
+
+#include "yb/util/random_util.h"
+#include "yb/util/stopwatch.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+const ColumnId kKeyColumn(10);
+const ColumnId kInt64Column(11);
+const ColumnId kDoubleColumn(12);
+const ColumnId kInt32Column(13);
+const ColumnId kFloatColumn(14);
+
+Schema MakeSchema() {
+  return Schema({ ColumnSchema("k", DataType::INT32, false, true),
+                  ColumnSchema("i64", DataType::INT64, true),
+                  ColumnSchema("d", DataType::DOUBLE, true),
+                  ColumnSchema("i32", DataType::INT32, true),
+                  ColumnSchema("f", DataType::FLOAT, true) },
+                { kKeyColumn, kInt64Column, kDoubleColumn, kInt32Column, kFloatColumn },
+                1);
+}
+
+void AddTarget(PgsqlReadRequestPB* req, bfpg::TSOpcode opcode, ColumnId column_id) {
+  auto* tscall = req->add_targets()->mutable_tscall();
+  tscall->set_opcode(static_cast<int32_t>(opcode));
+  tscall->add_operands()->set_column_id(column_id.rep());
+}
+
+PgsqlReadRequestPB MakeRequest() {
+  PgsqlReadRequestPB req;
+  req.set_is_aggregate(true);
+  // COUNT(*) is sent as COUNT of non null constant.
+  auto* count_all = req.add_targets()->mutable_tscall();
+  count_all->set_opcode(static_cast<int32_t>(bfpg::TSOpcode::kCount));
+  count_all->add_operands()->mutable_value()->set_int64_value(1);
+  AddTarget(&req, bfpg::TSOpcode::kCount, kInt64Column);
+  AddTarget(&req, bfpg::TSOpcode::kSumInt64, kInt64Column);
+  AddTarget(&req, bfpg::TSOpcode::kSumInt32, kInt32Column);
+  AddTarget(&req, bfpg::TSOpcode::kSumDouble, kDoubleColumn);
+  AddTarget(&req, bfpg::TSOpcode::kSumFloat, kFloatColumn);
+  AddTarget(&req, bfpg::TSOpcode::kMin, kInt32Column);
+  AddTarget(&req, bfpg::TSOpcode::kMax, kInt64Column);
+  AddTarget(&req, bfpg::TSOpcode::kMin, kDoubleColumn);
+  AddTarget(&req, bfpg::TSOpcode::kMax, kFloatColumn);
+  return req;
+}
+
+// Returns NaN or infinity of either sign.
+template <class T>
+T SpecialValue(std::mt19937_64* rng) {
+  switch (RandomUniformInt(0, 2, rng)) {
+    case 0: return std::numeric_limits<T>::quiet_NaN();
+    case 1: return std::numeric_limits<T>::infinity();
+    default: return -std::numeric_limits<T>::infinity();
+  }
+}
+
+// Floating point columns get special values (NaN, +-Inf) with special_percent probability.
+// When special values are used, first row always has NaN, since it is the initial MIN/MAX value.
+std::vector<QLTableRow> MakeRows(size_t num_rows, int null_percent, int special_percent = 0) {
+  std::vector<QLTableRow> rows(num_rows);
+  std::mt19937_64 rng(num_rows);
+  auto is_special = [&rng, special_percent](size_t row_idx) {
+    return special_percent != 0 &&
+           (row_idx == 0 || RandomUniformInt(0, 99, &rng) < special_percent);
+  };
+  for (size_t i = 0; i != num_rows; ++i) {
+    auto& row = rows[i];
+    QLValuePB value;
+    value.set_int32_value(static_cast<int32_t>(i));
+    row.AllocColumn(kKeyColumn, value);
+    auto is_null = [&rng, null_percent] {
+      return RandomUniformInt(0, 99, &rng) < null_percent;
+    };
+    if (!is_null()) {
+      value.set_int64_value(RandomUniformInt<int64_t>(-1000000000, 1000000000, &rng));
+      row.AllocColumn(kInt64Column, value);
+    }
+    if (!is_null()) {
+      value.set_double_value(
+          is_special(i) ? SpecialValue<double>(&rng) : RandomUniformReal(-1e6, 1e6, &rng));
+      row.AllocColumn(kDoubleColumn, value);
+    }
+    if (!is_null()) {
+      value.set_int32_value(RandomUniformInt<int32_t>(-1000000, 1000000, &rng));
+      row.AllocColumn(kInt32Column, value);
+    }
+    if (!is_null()) {
+      value.set_float_value(
+          is_special(i) ? SpecialValue<float>(&rng)
+                        : static_cast<float>(RandomUniformReal(-1e3, 1e3, &rng)));
+      row.AllocColumn(kFloatColumn, value);
+    }
+  }
+  return rows;
+}
+
+std::vector<QLExprResult> EvalRowByRow(
+    const PgsqlReadRequestPB& req, const Schema& schema, const std::vector<QLTableRow>& rows) {
+  DocExprExecutor executor;
+  std::vector<QLExprResult> result(req.targets().size());
+  for (const auto& row : rows) {
+    for (int i = 0; i != req.targets().size(); ++i) {
+      CHECK_OK(executor.EvalExpr(req.targets(i), row, result[i].Writer(), &schema));
+    }
+  }
+  return result;
+}
+
+std::vector<QLExprResult> EvalVectorized(
+    const PgsqlReadRequestPB& req, const Schema& schema, const std::vector<QLTableRow>& rows) {
+  auto aggregator = PgsqlVectorizedAggregator::Make(req, schema);
+  CHECK(aggregator);
+  for (const auto& row : rows) {
+    aggregator->AddRow(row);
+  }
+  std::vector<QLExprResult> result;
+  aggregator->Finish(&result);
+  return result;
+}
+
+} // namespace
+
+class PgsqlVectorizedAggregateTest : public YBTest {
+};
+
+TEST_F(PgsqlVectorizedAggregateTest, SameAsRowByRow) {
+  const auto schema = MakeSchema();
+  const auto req = MakeRequest();
+  // Row counts around batch size boundary, columns that are entirely NULL, and floating point
+  // columns with NaN and infinite values.
+  for (size_t num_rows : std::vector<size_t>{1, 7, PgsqlVectorizedAggregator::kBatchSize,
+                          PgsqlVectorizedAggregator::kBatchSize + 1, 5000}) {
+    for (int null_percent : {0, 30, 100}) {
+      for (int special_percent : {0, 1, 50}) {
+        auto rows = MakeRows(num_rows, null_percent, special_percent);
+        auto expected = EvalRowByRow(req, schema, rows);
+        auto actual = EvalVectorized(req, schema, rows);
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t i = 0; i != expected.size(); ++i) {
+          ASSERT_EQ(expected[i].Value().ShortDebugString(), actual[i].Value().ShortDebugString())
+              << "Target: " << i << ", rows: " << num_rows << ", null percent: " << null_percent
+              << ", special percent: " << special_percent;
+        }
+      }
+    }
+  }
+}
+
+TEST_F(PgsqlVectorizedAggregateTest, UnsupportedTargets) {
+  const auto schema = MakeSchema();
+
+  // SUM opcode does not match column type.
+  PgsqlReadRequestPB req;
+  AddTarget(&req, bfpg::TSOpcode::kSumInt32, kInt64Column);
+  ASSERT_FALSE(PgsqlVectorizedAggregator::Make(req, schema));
+
+  // Non aggregate function.
+  req.Clear();
+  AddTarget(&req, bfpg::TSOpcode::kNoOp, kInt64Column);
+  ASSERT_FALSE(PgsqlVectorizedAggregator::Make(req, schema));
+
+  // Plain column reference.
+  req.Clear();
+  req.add_targets()->set_column_id(kInt64Column.rep());
+  ASSERT_FALSE(PgsqlVectorizedAggregator::Make(req, schema));
+
+  // COUNT(NULL).
+  req.Clear();
+  auto* count_null = req.add_targets()->mutable_tscall();
+  count_null->set_opcode(static_cast<int32_t>(bfpg::TSOpcode::kCount));
+  count_null->add_operands()->mutable_value();
+  ASSERT_FALSE(PgsqlVectorizedAggregator::Make(req, schema));
+}
+
+// Compares throughput of vectorized aggregation with row by row evaluation.
+// Only logs timings, so it is disabled by default.
+TEST_F(PgsqlVectorizedAggregateTest, DISABLED_Benchmark) {
+  const auto schema = MakeSchema();
+  const auto req = MakeRequest();
+  const auto rows = MakeRows(100000, 10);
+  constexpr int kIterations = 10;
+
+  Stopwatch row_by_row_sw;
+  row_by_row_sw.start();
+  for (int i = 0; i != kIterations; ++i) {
+    EvalRowByRow(req, schema, rows);
+  }
+  row_by_row_sw.stop();
+
+  Stopwatch vectorized_sw;
+  vectorized_sw.start();
+  for (int i = 0; i != kIterations; ++i) {
+    EvalVectorized(req, schema, rows);
+  }
+  vectorized_sw.stop();
+
+  LOG(INFO) << "Row by row: " << row_by_row_sw.elapsed().wall_millis() << "ms, vectorized: "
+            << vectorized_sw.elapsed().wall_millis() << "ms";
+}
+
+} // namespace docdb
+} // namespace yb
@@ -0,0 +1,368 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/pgsql_vectorized_aggregate.h"
+
+#include <cmath>
+
+#include "yb/bfpg/tserver_opcodes.h"
+
+#include "yb/common/pgsql_protocol.pb.h"
+#include "yb/common/ql_value.h"
+
+#include "yb/gutil/macros.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+// Orders floating point values the same way as QLValue does, i.e. NaN is equal to NaN and greater
+// than any other value, including infinity.
+inline bool RealLess(double lhs, double rhs) {
+  if (std::isnan(rhs)) {
+    return !std::isnan(lhs);
+  }
+  return lhs < rhs;
+}
+
+} // namespace
+
+bool PgsqlVectorizedAggregator::ValueKindFromDataType(DataType data_type, ValueKind* kind) {
+  switch (data_type) {
+    case DataType::INT8:
+      *kind = ValueKind::kInt8;
+      return true;
+    case DataType::INT16:
+      *kind = ValueKind::kInt16;
+      return true;
+    case DataType::INT32:
+      *kind = ValueKind::kInt32;
+      return true;
+    case DataType::INT64:
+      *kind = ValueKind::kInt64;
+      return true;
+    case DataType::FLOAT:
+      *kind = ValueKind::kFloat;
+      return true;
+    case DataType::DOUBLE:
+      *kind = ValueKind::kDouble;
+      return true;
+    default:
+      return false;
+  }
+}
+
+std::unique_ptr<PgsqlVectorizedAggregator> PgsqlVectorizedAggregator::Make(
+    const PgsqlReadRequestPB& request, const Schema& schema) {
+  std::unique_ptr<PgsqlVectorizedAggregator> result(new PgsqlVectorizedAggregator);
+  for (const auto& target : request.targets()) {
+    if (!target.has_tscall() || target.tscall().operands_size() != 1) {
+      return nullptr;
+    }
+    const auto& operand = target.tscall().operands(0);
+    const auto opcode = static_cast<bfpg::TSOpcode>(target.tscall().opcode());
+    Aggregate aggregate;
+    aggregate.column_idx = 0;
+
+    if (opcode == bfpg::TSOpcode::kCount) {
+      if (operand.has_column_id()) {
+        aggregate.kind = AggregateKind::kCount;
+        aggregate.column_idx = result->ColumnIndex(ColumnId(operand.column_id()), ValueKind::kAny);
+      } else if (operand.has_value() && !QLValue::IsNull(operand.value())) {
+        aggregate.kind = AggregateKind::kCountAll;
+      } else {
+        return nullptr;
+      }
+      result->aggregates_.push_back(aggregate);
+      continue;
+    }
+
+    if (!operand.has_column_id()) {
+      return nullptr;
+    }
+    ColumnId column_id(operand.column_id());
+    auto column = schema.column_by_id(column_id);
+    if (!column.ok()) {
+      return nullptr;
+    }
+    ValueKind kind;
+    if (!ValueKindFromDataType(column->type()->main(), &kind)) {
+      return nullptr;
+    }
+
+    // SUM opcode determines type of the value that is extracted, so it should match column type.
+    ValueKind expected_kind = kind;
+    switch (opcode) {
+      case bfpg::TSOpcode::kSumInt8:
+        aggregate.kind = AggregateKind::kSumInt;
+        expected_kind = ValueKind::kInt8;
+        break;
+      case bfpg::TSOpcode::kSumInt16:
+        aggregate.kind = AggregateKind::kSumInt;
+        expected_kind = ValueKind::kInt16;
+        break;
+      case bfpg::TSOpcode::kSumInt32:
+        aggregate.kind = AggregateKind::kSumInt;
+        expected_kind = ValueKind::kInt32;
+        break;
+      case bfpg::TSOpcode::kSumInt64:
+        aggregate.kind = AggregateKind::kSumInt;
+        expected_kind = ValueKind::kInt64;
+        break;
+      case bfpg::TSOpcode::kSumFloat:
+        aggregate.kind = AggregateKind::kSumFloat;
+        expected_kind = ValueKind::kFloat;
+        break;
+      case bfpg::TSOpcode::kSumDouble:
+        aggregate.kind = AggregateKind::kSumDouble;
+        expected_kind = ValueKind::kDouble;
+        break;
+      case bfpg::TSOpcode::kMin:
+        aggregate.kind = AggregateKind::kMin;
+        break;
+      case bfpg::TSOpcode::kMax:
+        aggregate.kind = AggregateKind::kMax;
+        break;
+      default:
+        return nullptr;
+    }
+    if (kind != expected_kind) {
+      return nullptr;
+    }
+    aggregate.column_idx = result->ColumnIndex(column_id, kind);
+    result->aggregates_.push_back(aggregate);
+  }
+
+  return result;
+}
+
+size_t PgsqlVectorizedAggregator::ColumnIndex(ColumnId id, ValueKind kind) {
+  for (size_t i = 0; i != columns_.size(); ++i) {
+    auto& column = columns_[i];
+    if (column.id == id) {
+      // Column could be referenced by COUNT before its type is known.
+      if (column.kind == ValueKind::kAny) {
+        column.kind = kind;
+      }
+      return i;
+    }
+  }
+  columns_.push_back(Column {
+    .id = id,
+    .kind = kind,
+    .int_values = std::vector<int64_t>(kBatchSize),
+    .real_values = std::vector<double>(kBatchSize),
+    .not_null = std::vector<uint8_t>(kBatchSize),
+  });
+  return columns_.size() - 1;
+}
+
+void PgsqlVectorizedAggregator::AddRow(const QLTableRow& row) {
+  const auto idx = batch_size_;
+  for (auto& column : columns_) {
+    const auto* value = row.GetColumn(column.id.rep());
+    if (!value || QLValue::IsNull(*value)) {
+      column.not_null[idx] = 0;
+      column.int_values[idx] = 0;
+      column.real_values[idx] = 0;
+      continue;
+    }
+    column.not_null[idx] = 1;
+    switch (column.kind) {
+      case ValueKind::kInt8:
+        column.int_values[idx] = value->int8_value();
+        break;
+      case ValueKind::kInt16:
+        column.int_values[idx] = value->int16_value();
+        break;
+      case ValueKind::kInt32:
+        column.int_values[idx] = value->int32_value();
+        break;
+      case ValueKind::kInt64:
+        column.int_values[idx] = value->int64_value();
+        break;
+      case ValueKind::kFloat:
+        column.real_values[idx] = value->float_value();
+        break;
+      case ValueKind::kDouble:
+        column.real_values[idx] = value->double_value();
+        break;
+      case ValueKind::kAny:
+        break;
+    }
+  }
+  if (++batch_size_ == kBatchSize) {
+    ProcessBatch();
+  }
+}
+
+void PgsqlVectorizedAggregator::ProcessBatch() {
+  for (auto& aggregate : aggregates_) {
+    ProcessAggregate(&aggregate);
+  }
+  batch_size_ = 0;
+}
+
+void PgsqlVectorizedAggregator::ProcessAggregate(Aggregate* aggregate) {
+  const size_t size = batch_size_;
+  if (aggregate->kind == AggregateKind::kCountAll) {
+    aggregate->count += size;
+    return;
+  }
+
+  const auto& column = columns_[aggregate->column_idx];
+  const uint8_t* not_null = column.not_null.data();
+  const int64_t* ints = column.int_values.data();
+  const double* reals = column.real_values.data();
+
+  int64_t count = 0;
+  for (size_t i = 0; i != size; ++i) {
+    count += not_null[i];
+  }
+
+  switch (aggregate->kind) {
+    case AggregateKind::kCountAll: FALLTHROUGH_INTENDED;
+    case AggregateKind::kCount:
+      break;
+    case AggregateKind::kSumInt: {
+      // Null values are stored as zeros, so could be added unconditionally.
+      int64_t sum = 0;
+      for (size_t i = 0; i != size; ++i) {
+        sum += ints[i];
+      }
+      aggregate->int_value += sum;
+      break;
+    }
+    case AggregateKind::kSumFloat: {
+      // Floating point addition is not associative, so keep the same order as row by row
+      // evaluation. First value is assigned, not added, to keep sign of zero.
+      bool has_value = aggregate->count != 0;
+      float sum = aggregate->float_value;
+      for (size_t i = 0; i != size; ++i) {
+        if (not_null[i]) {
+          sum = has_value ? sum + static_cast<float>(reals[i]) : static_cast<float>(reals[i]);
+          has_value = true;
+        }
+      }
+      aggregate->float_value = sum;
+      break;
+    }
+    case AggregateKind::kSumDouble: {
+      bool has_value = aggregate->count != 0;
+      double sum = aggregate->double_value;
+      for (size_t i = 0; i != size; ++i) {
+        if (not_null[i]) {
+          sum = has_value ? sum + reals[i] : reals[i];
+          has_value = true;
+        }
+      }
+      aggregate->double_value = sum;
+      break;
+    }
+    case AggregateKind::kMin: FALLTHROUGH_INTENDED;
+    case AggregateKind::kMax: {
+      const bool is_min = aggregate->kind == AggregateKind::kMin;
+      bool has_value = aggregate->count != 0;
+      if (IsInteger(column.kind)) {
+        int64_t result = aggregate->int_value;
+        for (size_t i = 0; i != size; ++i) {
+          if (not_null[i] &&
+              (!has_value || (is_min ? result > ints[i] : result < ints[i]))) {
+            result = ints[i];
+            has_value = true;
+          }
+        }
+        aggregate->int_value = result;
+      } else {
+        double result = aggregate->double_value;
+        for (size_t i = 0; i != size; ++i) {
+          if (not_null[i] &&
+              (!has_value ||
+               (is_min ? RealLess(reals[i], result) : RealLess(result, reals[i])))) {
+            result = reals[i];
+            has_value = true;
+          }
+        }
+        aggregate->double_value = result;
+      }
+      break;
+    }
+  }
+
+  aggregate->count += count;
+}
+
+void PgsqlVectorizedAggregator::Finish(std::vector<QLExprResult>* aggr_result) {
+  if (batch_size_) {
+    ProcessBatch();
+  }
+
+  aggr_result->clear();
+  aggr_result->resize(aggregates_.size());
+  for (size_t i = 0; i != aggregates_.size(); ++i) {
+    const auto& aggregate = aggregates_[i];
+    auto writer = (*aggr_result)[i].Writer();
+    // Aggregate of NULL values is NULL, the same as in DocExprExecutor.
+    if (aggregate.count == 0) {
+      writer.SetNull();
+      continue;
+    }
+    auto& value = writer.NewValue();
+    switch (aggregate.kind) {
+      case AggregateKind::kCountAll: FALLTHROUGH_INTENDED;
+      case AggregateKind::kCount:
+        value.set_int64_value(aggregate.count);
+        break;
+      case AggregateKind::kSumInt:
+        value.set_int64_value(aggregate.int_value);
+        break;
+      case AggregateKind::kSumFloat:
+        value.set_float_value(aggregate.float_value);
+        break;
+      case AggregateKind::kSumDouble:
+        value.set_double_value(aggregate.double_value);
+        break;
+      case AggregateKind::kMin: FALLTHROUGH_INTENDED;
+      case AggregateKind::kMax:
+        switch (columns_[aggregate.column_idx].kind) {
+          case ValueKind::kInt8:
+            value.set_int8_value(static_cast<int8_t>(aggregate.int_value));
+            break;
+          case ValueKind::kInt16:
+            value.set_int16_value(static_cast<int16_t>(aggregate.int_value));
+            break;
+          case ValueKind::kInt32:
+            value.set_int32_value(static_cast<int32_t>(aggregate.int_value));
+            break;
+          case ValueKind::kInt64:
+            value.set_int64_value(aggregate.int_value);
+            break;
+          case ValueKind::kFloat:
+            value.set_float_value(static_cast<float>(aggregate.double_value));
+            break;
+          case ValueKind::kDouble:
+            value.set_double_value(aggregate.double_value);
+            break;
+          case ValueKind::kAny:
+            LOG(DFATAL) << "MIN/MAX over column of unknown type";
+            writer.SetNull();
+            break;
+        }
+        break;
+    }
+  }
+}
+
+} // namespace docdb
+} // namespace yb
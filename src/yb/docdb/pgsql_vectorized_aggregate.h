@@ -0,0 +1,120 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_PGSQL_VECTORIZED_AGGREGATE_H
+#define YB_DOCDB_PGSQL_VECTORIZED_AGGREGATE_H
+
+#include <memory>
+#include <vector>
+
+#include "yb/common/ql_expr.h"
+#include "yb/common/schema.h"
+
+namespace yb {
+
+class PgsqlReadRequestPB;
+
+namespace docdb {
+
+// Evaluates pushed down aggregates COUNT/SUM/MIN/MAX over plain columns of numeric types.
+//
+// Instead of interpreting aggregate expressions for every scanned row, values of referenced
+// columns are collected into per column vectors. When batch is full, aggregates are updated
+// using tight loops over those vectors, that could be vectorized by compiler.
+//
+// Produces exactly the same results as DocExprExecutor aggregate functions, including ordering
+// of NaN values by MIN/MAX.
+class PgsqlVectorizedAggregator {
+ public:
+  static constexpr size_t kBatchSize = 1024;
+
+  // Returns nullptr if some of request targets could not be evaluated by this aggregator.
+  static std::unique_ptr<PgsqlVectorizedAggregator> Make(
+      const PgsqlReadRequestPB& request, const Schema& schema);
+
+  // Adds values of row columns to current batch.
+  void AddRow(const QLTableRow& row);
+
+  // Processes pending batch and stores aggregate values to aggr_result, one entry per target.
+  void Finish(std::vector<QLExprResult>* aggr_result);
+
+  size_t num_columns() const {
+    return columns_.size();
+  }
+
+ private:
+  enum class ValueKind {
+    kInt8,
+    kInt16,
+    kInt32,
+    kInt64,
+    kFloat,
+    kDouble,
+    // Only null-ness of value is used.
+    kAny,
+  };
+
+  enum class AggregateKind {
+    kCountAll,
+    kCount,
+    kSumInt,
+    kSumFloat,
+    kSumDouble,
+    kMin,
+    kMax,
+  };
+
+  // Column values of current batch. Only one of int_values and real_values is used, depending
+  // on value kind. Null values are stored as zeros.
+  struct Column {
+    ColumnId id;
+    ValueKind kind;
+    std::vector<int64_t> int_values;
+    std::vector<double> real_values;
+    std::vector<uint8_t> not_null;
+  };
+
+  struct Aggregate {
+    AggregateKind kind;
+    // Index of column in columns_, not used by kCountAll.
+    size_t column_idx;
+    // Number of counted values, also used to determine whether aggregate is still NULL.
+    int64_t count = 0;
+    int64_t int_value = 0;
+    float float_value = 0;
+    double double_value = 0;
+  };
+
+  // Returns true and fills kind if values of specified type are supported by SUM/MIN/MAX.
+  static bool ValueKindFromDataType(DataType data_type, ValueKind* kind);
+
+  static bool IsInteger(ValueKind kind) {
+    return kind <= ValueKind::kInt64;
+  }
+
+  // Returns index of column in columns_, adding it if necessary.
+  size_t ColumnIndex(ColumnId id, ValueKind kind);
+
+  void ProcessBatch();
+
+  void ProcessAggregate(Aggregate* aggregate);
+
+  std::vector<Column> columns_;
+  std::vector<Aggregate> aggregates_;
+  size_t batch_size_ = 0;
+};
+
+} // namespace docdb
+} // namespace yb
+
+#endif // YB_DOCDB_PGSQL_VECTORIZED_AGGREGATE_H
@@ -11,6 +11,7 @@
 // under the License.
 //
 
+#include <array>
 #include <atomic>
 #include <future>
 #include <mutex>
@@ -33,6 +34,7 @@ using std::stack;
 using std::thread;
 
 DECLARE_bool(dump_lock_keys);
+DECLARE_int32(lock_manager_num_shards);
 
 namespace yb {
 namespace docdb {
@@ -185,6 +187,113 @@ TEST_F(SharedLockManagerTest, LockConflicts) {
   tp.Shutdown();
 }
 
+namespace {
+
+// Returns number of lock/unlock cycles performed.
+size_t RunLockUnlock(size_t num_shards, int num_threads, MonoDelta duration) {
+  SharedLockManager lm(num_shards);
+  std::atomic<bool> stop_requested{false};
+  std::atomic<size_t> total_ops{0};
+  const RefCntPrefix kTableKey("table"s);
+  std::vector<std::thread> threads;
+  for (int thread_idx = 0; thread_idx != num_threads; ++thread_idx) {
+    threads.emplace_back([&lm, &stop_requested, &total_ops, &kTableKey, thread_idx] {
+      size_t ops = 0;
+      while (!stop_requested.load(std::memory_order_acquire)) {
+        // Emulate small write: weak intent on common prefix and strong intents on own row.
+        LockBatchEntries entries = {
+          {kTableKey, IntentTypeSet({IntentType::kWeakRead, IntentType::kWeakWrite})},
+        };
+        for (int i = 0; i != 3; ++i) {
+          entries.push_back({
+              RefCntPrefix(Format("row_$0_$1_$2", thread_idx, ops % 64, i)),
+              IntentTypeSet({IntentType::kStrongRead, IntentType::kStrongWrite})});
+        }
+        LockBatch lb(&lm, std::move(entries), CoarseTimePoint::max());
+        CHECK_OK(lb.status());
+        ++ops;
+      }
+      total_ops.fetch_add(ops, std::memory_order_acq_rel);
+    });
+  }
+
+  std::this_thread::sleep_for(duration.ToSteadyDuration());
+  stop_requested.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return total_ops.load(std::memory_order_acquire);
+}
+
+} // namespace
+
+// Threads lock keys from small set in lock table with several shards. Checks that strong read
+// and write intents give exclusive access to the key, while strong read intents are shared.
+TEST_F(SharedLockManagerTest, ShardedLockTableContention) {
+  constexpr size_t kNumShards = 4;
+  constexpr int kThreads = 8;
+  constexpr int kKeys = 16;
+  constexpr int kIterations = 2000;
+
+  struct KeyState {
+    std::atomic<int> readers{0};
+    std::atomic<int> writers{0};
+  };
+
+  SharedLockManager lm(kNumShards);
+  std::array<KeyState, kKeys> states;
+  const RefCntPrefix kTableKey("table"s);
+  std::vector<std::thread> threads;
+  for (int thread_idx = 0; thread_idx != kThreads; ++thread_idx) {
+    threads.emplace_back([&lm, &states, &kTableKey, thread_idx] {
+      std::mt19937 rng(thread_idx);
+      for (int i = 0; i != kIterations; ++i) {
+        auto key_idx = rng() % kKeys;
+        bool exclusive = rng() % 2 == 0;
+        LockBatch lb(&lm, {
+            {kTableKey, IntentTypeSet({IntentType::kWeakRead, IntentType::kWeakWrite})},
+            {RefCntPrefix(Format("key_$0", key_idx)),
+             exclusive ? IntentTypeSet({IntentType::kStrongRead, IntentType::kStrongWrite})
+                       : IntentTypeSet({IntentType::kStrongRead})}},
+            CoarseTimePoint::max());
+        ASSERT_OK(lb.status());
+
+        auto& state = states[key_idx];
+        if (exclusive) {
+          ASSERT_EQ(state.writers.fetch_add(1, std::memory_order_acq_rel), 0);
+          ASSERT_EQ(state.readers.load(std::memory_order_acquire), 0);
+          std::this_thread::yield();
+          ASSERT_EQ(state.readers.load(std::memory_order_acquire), 0);
+          state.writers.fetch_sub(1, std::memory_order_acq_rel);
+        } else {
+          state.readers.fetch_add(1, std::memory_order_acq_rel);
+          ASSERT_EQ(state.writers.load(std::memory_order_acquire), 0);
+          std::this_thread::yield();
+          ASSERT_EQ(state.writers.load(std::memory_order_acquire), 0);
+          state.readers.fetch_sub(1, std::memory_order_acq_rel);
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Compares throughput of single shard lock table, i.e. single global mutex, with sharded one.
+TEST_F(SharedLockManagerTest, DISABLED_ShardedLockTableBenchmark) {
+  const auto kDuration = 2s;
+  for (int num_threads : {1, 2, 4, 8, 16, 32, 64}) {
+    auto single_shard_ops = RunLockUnlock(1, num_threads, kDuration);
+    auto sharded_ops = RunLockUnlock(FLAGS_lock_manager_num_shards, num_threads, kDuration);
+    LOG(INFO) << "Threads: " << num_threads
+              << ", single shard ops/s: " << single_shard_ops / ToSeconds(kDuration)
+              << ", " << FLAGS_lock_manager_num_shards << " shards ops/s: "
+              << sharded_ops / ToSeconds(kDuration);
+  }
+}
+
 TEST_F(SharedLockManagerTest, DumpKeys) {
   FLAGS_dump_lock_keys = true;
 
@@ -18,6 +18,8 @@
 #include <boost/range/adaptor/reversed.hpp>
 #include <glog/logging.h>
 
+#include "yb/gutil/port.h"
+
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/enums.h"
 #include "yb/util/logging.h"
@@ -27,6 +29,30 @@
 
 using std::string;
 
+DEFINE_int32(lock_manager_num_shards, 16,
+             "Number of shards in lock table of shared lock manager. Each shard has its own mutex, "
+             "so requests locking different keys of the same tablet don't contend on it.");
+
+namespace {
+
+// Every tablet allocates all shards, so the number of shards is limited to keep memory overhead
+// of lock manager small.
+constexpr int32_t kMaxLockManagerNumShards = 1024;
+
+bool ValidateLockManagerNumShards(const char* flagname, int32_t value) {
+  if (value <= 0 || value > kMaxLockManagerNumShards) {
+    LOG(ERROR) << "Expect " << flagname << " to be in range [1, " << kMaxLockManagerNumShards
+               << "], but " << value << " specified";
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+__attribute__((unused))
+DEFINE_validator(lock_manager_num_shards, &ValidateLockManagerNumShards);
+
 namespace yb {
 namespace docdb {
 
@@ -107,8 +133,10 @@ struct LockedBatchEntry {
 
   std::condition_variable cond_var;
 
-  // Refcounting for garbage collection. Can only be used while the global mutex is locked.
-  // Global mutex resides in lock manager and the same for all LockBatchEntries.
+  // Index of lock table shard that owns this entry. Entries are reused only within shard.
+  size_t shard_idx = 0;
+
+  // Refcounting for garbage collection. Can only be used while the shard mutex is locked.
   size_t ref_count = 0;
 
   // Number of holders for each type
@@ -130,32 +158,45 @@ struct LockedBatchEntry {
 
 class SharedLockManager::Impl {
  public:
+  explicit Impl(size_t num_shards)
+      : num_shards_(std::max<size_t>(num_shards, 1)), shards_(new Shard[num_shards_]) {
+  }
+
   MUST_USE_RESULT bool Lock(LockBatchEntries* key_to_intent_type, CoarseTimePoint deadline);
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
   ~Impl() {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    LOG_IF(DFATAL, !locks_.empty()) << "Locks not empty in dtor: " << yb::ToString(locks_);
+    for (size_t i = 0; i != num_shards_; ++i) {
+      auto& shard = shards_[i];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      LOG_IF(DFATAL, !shard.locks.empty())
+          << "Locks not empty in dtor: " << yb::ToString(shard.locks);
+    }
   }
 
  private:
   typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
-  // as the keys in the batch.
+  // Part of lock table, responsible for keys with the same hash modulo number of shards.
+  struct Shard {
+    // The shard mutex should be taken only for very short duration, with no blocking wait.
+    std::mutex mutex;
+
+    LockEntryMap locks GUARDED_BY(mutex);
+    // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
+    std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries GUARDED_BY(mutex);
+    std::vector<LockedBatchEntry*> free_lock_entries GUARDED_BY(mutex);
+  } CACHELINE_ALIGNED;
+
+  // Make sure the entries exist in the lock table and store pointers to them in the batch, so
+  // we can access them without holding the shard lock.
   void Reserve(LockBatchEntries* batch);
 
   // Update refcounts and maybe collect garbage.
   void Cleanup(const LockBatchEntries& key_to_intent_type);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
-
-  LockEntryMap locks_ GUARDED_BY(global_mutex_);
-  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
-  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries_ GUARDED_BY(global_mutex_);
-  std::vector<LockedBatchEntry*> free_lock_entries_ GUARDED_BY(global_mutex_);
+  const size_t num_shards_;
+  std::unique_ptr<Shard[]> shards_;
 };
 
 const std::array<LockState, kIntentTypeSetMapSize> kIntentTypeSetMask = GenerateByMask(
@@ -274,16 +315,19 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
 }
 
 void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
   for (auto& key_and_intent_type : *key_to_intent_type) {
-    auto& value = locks_[key_and_intent_type.key];
+    auto shard_idx = RefCntPrefixHash()(key_and_intent_type.key) % num_shards_;
+    auto& shard = shards_[shard_idx];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto& value = shard.locks[key_and_intent_type.key];
     if (!value) {
-      if (!free_lock_entries_.empty()) {
-        value = free_lock_entries_.back();
-        free_lock_entries_.pop_back();
+      if (!shard.free_lock_entries.empty()) {
+        value = shard.free_lock_entries.back();
+        shard.free_lock_entries.pop_back();
       } else {
-        lock_entries_.emplace_back(std::make_unique<LockedBatchEntry>());
-        value = lock_entries_.back().get();
+        shard.lock_entries.emplace_back(std::make_unique<LockedBatchEntry>());
+        value = shard.lock_entries.back().get();
+        value->shard_idx = shard_idx;
       }
     }
     value->ref_count++;
@@ -302,16 +346,20 @@ void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type)
 }
 
 void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
   for (const auto& item : key_to_intent_type) {
+    auto& shard = shards_[item.locked->shard_idx];
+    std::lock_guard<std::mutex> lock(shard.mutex);
     if (--(item.locked->ref_count) == 0) {
-      locks_.erase(item.key);
-      free_lock_entries_.push_back(item.locked);
+      shard.locks.erase(item.key);
+      shard.free_lock_entries.push_back(item.locked);
     }
   }
 }
 
-SharedLockManager::SharedLockManager() : impl_(new Impl) {
+SharedLockManager::SharedLockManager() : SharedLockManager(FLAGS_lock_manager_num_shards) {
+}
+
+SharedLockManager::SharedLockManager(size_t num_shards) : impl_(new Impl(num_shards)) {
 }
 
 SharedLockManager::~SharedLockManager() {}
@@ -34,9 +34,14 @@ namespace docdb {
 // - Multiple kStrongSerializableRead and kWeakSerializableRead
 // - Multiple kStrongSerializableWrite and kWeakSerializableWrite
 // - Multiple kWeakSnapshotWrite, kWeakSerializableRead, and kWeakSerializableWrite
+//
+// Lock table is split into shards by key hash, so concurrent requests that lock different keys
+// don't contend on the same mutex. Uncontended lock acquisition on already reserved entry is a
+// single compare-and-swap on its state.
 class SharedLockManager {
  public:
   SharedLockManager();
+  explicit SharedLockManager(size_t num_shards);
   ~SharedLockManager();
 
   // Attempt to lock a batch of keys. The call may be blocked waiting for other locks to be
@@ -0,0 +1,250 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <future>
+#include <thread>
+
+#include "yb/docdb/wait_queue.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+#include "yb/util/tsan_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace docdb {
+
+class WaitQueueTest : public YBTest {
+ protected:
+  WaitQueue queue_{"T test: "};
+};
+
+namespace {
+
+class WaitResult {
+ public:
+  WaitDoneCallback callback() {
+    return [this](const Status& status) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++num_calls_;
+      status_ = status;
+    };
+  }
+
+  size_t num_calls() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_calls_;
+  }
+
+  Status status() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return status_;
+  }
+
+ private:
+  std::mutex mutex_;
+  size_t num_calls_ = 0;
+  Status status_;
+};
+
+} // namespace
+
+TEST_F(WaitQueueTest, WakeUpWhenAllBlockersResolved) {
+  auto waiter = TransactionId::GenerateRandom();
+  auto blocker1 = TransactionId::GenerateRandom();
+  auto blocker2 = TransactionId::GenerateRandom();
+
+  WaitResult result;
+  ASSERT_OK(queue_.WaitOn(
+      waiter, {blocker1, blocker2}, CoarseTimePoint::max(), result.callback()));
+  ASSERT_EQ(queue_.TEST_NumWaiters(), 1);
+
+  queue_.SignalResolved(blocker1);
+  ASSERT_EQ(result.num_calls(), 0);
+
+  queue_.SignalResolved(blocker2);
+  ASSERT_EQ(result.num_calls(), 1);
+  ASSERT_OK(result.status());
+  ASSERT_FALSE(queue_.HasWaiters());
+
+  // Signaling already resolved transaction should be no op.
+  queue_.SignalResolved(blocker2);
+  ASSERT_EQ(result.num_calls(), 1);
+}
+
+TEST_F(WaitQueueTest, DetectDeadlock) {
+  auto txn1 = TransactionId::GenerateRandom();
+  auto txn2 = TransactionId::GenerateRandom();
+  auto txn3 = TransactionId::GenerateRandom();
+
+  WaitResult result1, result2;
+  ASSERT_OK(queue_.WaitOn(txn1, {txn2}, CoarseTimePoint::max(), result1.callback()));
+  ASSERT_OK(queue_.WaitOn(txn2, {txn3}, CoarseTimePoint::max(), result2.callback()));
+
+  // txn3 -> txn1 -> txn2 -> txn3 forms a cycle.
+  WaitResult result3;
+  ASSERT_NOK(queue_.WaitOn(txn3, {txn1}, CoarseTimePoint::max(), result3.callback()));
+  ASSERT_EQ(queue_.TEST_NumWaiters(), 2);
+
+  // Non transactional operation does not hold intents, so cannot be part of a cycle.
+  WaitResult result4;
+  ASSERT_OK(queue_.WaitOn(
+      TransactionId::Nil(), {txn1}, CoarseTimePoint::max(), result4.callback()));
+
+  queue_.SignalResolved(txn3);
+  ASSERT_EQ(result2.num_calls(), 1);
+  queue_.SignalResolved(txn2);
+  ASSERT_EQ(result1.num_calls(), 1);
+  queue_.SignalResolved(txn1);
+  ASSERT_EQ(result4.num_calls(), 1);
+  ASSERT_EQ(result3.num_calls(), 0);
+  ASSERT_FALSE(queue_.HasWaiters());
+}
+
+TEST_F(WaitQueueTest, Timeout) {
+  auto blocker = TransactionId::GenerateRandom();
+  auto now = CoarseMonoClock::now();
+
+  WaitResult result1, result2;
+  ASSERT_OK(queue_.WaitOn(
+      TransactionId::GenerateRandom(), {blocker}, now + 1s, result1.callback()));
+  ASSERT_OK(queue_.WaitOn(
+      TransactionId::GenerateRandom(), {blocker}, now + 1h, result2.callback()));
+
+  queue_.Poll(now + 2s);
+  ASSERT_EQ(result1.num_calls(), 1);
+  ASSERT_TRUE(result1.status().IsTimedOut()) << result1.status();
+  ASSERT_EQ(result2.num_calls(), 0);
+
+  queue_.StartShutdown();
+  ASSERT_EQ(result2.num_calls(), 1);
+  ASSERT_TRUE(result2.status().IsAborted()) << result2.status();
+
+  WaitResult result3;
+  ASSERT_NOK(queue_.WaitOn(
+      TransactionId::GenerateRandom(), {blocker}, now + 1h, result3.callback()));
+}
+
+namespace {
+
+// Emulates transaction participant, that signals wait queue about removed transaction only when
+// there are waiters.
+class Blockers {
+ public:
+  void Add(const TransactionId& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    active_.insert(id);
+  }
+
+  void Remove(const TransactionId& id, WaitQueue* queue) {
+    bool has_waiters;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      active_.erase(id);
+      has_waiters = queue->HasWaiters();
+    }
+    if (has_waiters) {
+      queue->SignalResolved(id);
+    }
+  }
+
+  bool IsActive(const TransactionId& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return active_.count(id) != 0;
+  }
+
+ private:
+  std::mutex mutex_;
+  TransactionIdSet active_;
+};
+
+} // namespace
+
+// Blocker is resolved after conflict was found, but before waiter is registered.
+TEST_F(WaitQueueTest, BlockerResolvedBeforeWait) {
+  Blockers blockers;
+  WaitQueue queue("T test: ", [&blockers](const TransactionId& id) {
+    return blockers.IsActive(id);
+  });
+
+  auto blocker = TransactionId::GenerateRandom();
+  blockers.Add(blocker);
+  // Nobody waits yet, so wait queue is not signaled.
+  blockers.Remove(blocker, &queue);
+
+  // Blocker that is not active would never be signaled, so waiter is rejected.
+  WaitResult result;
+  auto status = queue.WaitOn(
+      TransactionId::GenerateRandom(), {blocker}, CoarseTimePoint::max(), result.callback());
+  ASSERT_TRUE(status.IsNotFound()) << status;
+  ASSERT_EQ(result.num_calls(), 0);
+  ASSERT_FALSE(queue.HasWaiters());
+
+  // Concurrent resolution of blocker, while waiter is being registered.
+  constexpr int kIterations = 1000;
+  for (int i = 0; i != kIterations; ++i) {
+    auto id = TransactionId::GenerateRandom();
+    blockers.Add(id);
+    std::thread resolver([&blockers, &queue, id] {
+      blockers.Remove(id, &queue);
+    });
+    auto promise = std::make_shared<std::promise<Status>>();
+    auto status = queue.WaitOn(
+        TransactionId::GenerateRandom(), {id}, CoarseTimePoint::max(),
+        [promise](const Status& status) { promise->set_value(status); });
+    if (status.ok()) {
+      auto future = promise->get_future();
+      ASSERT_EQ(future.wait_for(10s * kTimeMultiplier), std::future_status::ready)
+          << "Lost wake up";
+      ASSERT_OK(future.get());
+    } else {
+      // Blocker was resolved before wait started.
+      ASSERT_TRUE(status.IsNotFound()) << status;
+    }
+    resolver.join();
+  }
+  ASSERT_FALSE(queue.HasWaiters());
+}
+
+TEST_F(WaitQueueTest, Executor) {
+  std::vector<std::pair<WaitDoneCallback, Status>> scheduled;
+  WaitQueue queue("T test: ", nullptr /* is_blocker_active */,
+                  [&scheduled](WaitDoneCallback callback, const Status& status) {
+                    scheduled.emplace_back(std::move(callback), status);
+                  });
+
+  auto blocker = TransactionId::GenerateRandom();
+  auto now = CoarseMonoClock::now();
+  WaitResult result1, result2;
+  ASSERT_OK(queue.WaitOn(TransactionId::GenerateRandom(), {blocker}, now + 1h, result1.callback()));
+  ASSERT_OK(queue.WaitOn(TransactionId::Nil(), {blocker}, now + 1s, result2.callback()));
+
+  queue.Poll(now + 2s);
+  queue.SignalResolved(blocker);
+  // Callbacks are not invoked on the signaling thread.
+  ASSERT_EQ(result1.num_calls(), 0);
+  ASSERT_EQ(result2.num_calls(), 0);
+  ASSERT_EQ(scheduled.size(), 2);
+
+  for (auto& callback_and_status : scheduled) {
+    callback_and_status.first(callback_and_status.second);
+  }
+  ASSERT_EQ(result1.num_calls(), 1);
+  ASSERT_OK(result1.status());
+  ASSERT_EQ(result2.num_calls(), 1);
+  ASSERT_TRUE(result2.status().IsTimedOut()) << result2.status();
+}
+
+} // namespace docdb
+} // namespace yb
@@ -0,0 +1,270 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/wait_queue.h"
+
+#include <algorithm>
+#include <deque>
+
+#include "yb/common/transaction_error.h"
+
+#include "yb/util/logging.h"
+#include "yb/util/tostring.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+void EraseSerialNo(
+    std::unordered_map<TransactionId, std::vector<int64_t>, TransactionIdHash>* map,
+    const TransactionId& id, int64_t serial_no) {
+  auto it = map->find(id);
+  if (it == map->end()) {
+    return;
+  }
+  auto& serial_nos = it->second;
+  serial_nos.erase(std::remove(serial_nos.begin(), serial_nos.end(), serial_no), serial_nos.end());
+  if (serial_nos.empty()) {
+    map->erase(it);
+  }
+}
+
+} // namespace
+
+struct WaitQueue::Waiter {
+  int64_t serial_no;
+  TransactionId id;
+  // Transactions that are not yet resolved.
+  TransactionIdSet blockers;
+  CoarseTimePoint deadline;
+  WaitDoneCallback callback;
+
+  std::string ToString() const {
+    return YB_STRUCT_TO_STRING(serial_no, id, blockers);
+  }
+};
+
+WaitQueue::WaitQueue(
+    const std::string& log_prefix, BlockerActiveFunctor is_blocker_active,
+    WaitQueueExecutor executor)
+    : log_prefix_(log_prefix), is_blocker_active_(std::move(is_blocker_active)),
+      executor_(std::move(executor)) {
+}
+
+WaitQueue::~WaitQueue() {
+  StartShutdown();
+}
+
+Status WaitQueue::WaitOn(
+    const TransactionId& waiter, const TransactionIdSet& blockers, CoarseTimePoint deadline,
+    WaitDoneCallback callback) {
+  DCHECK(!blockers.empty());
+
+  // Blocker that is not tracked by the participant will never be signaled, and waking up waiter
+  // right away would make it find the same conflict and wait again. So such blocker is left for
+  // regular, status tablet based, resolution.
+  if (is_blocker_active_) {
+    for (const auto& blocker : blockers) {
+      if (!is_blocker_active_(blocker)) {
+        return STATUS_FORMAT(NotFound, "Blocker is not tracked by wait queue: $0", blocker);
+      }
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RETURN_NOT_OK(RegisterWaiterUnlocked(waiter, blockers, deadline, std::move(callback)));
+  }
+
+  // Blocker could be resolved after caller found conflict with it, but before waiter was
+  // registered, so nobody would signal us. Waiter is already visible to HasWaiters, so blocker
+  // resolved after this check will signal it.
+  if (is_blocker_active_) {
+    for (const auto& blocker : blockers) {
+      if (!is_blocker_active_(blocker)) {
+        VLOG_WITH_PREFIX(4) << "Blocker resolved before waiter was registered: " << blocker;
+        SignalResolved(blocker);
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+Status WaitQueue::RegisterWaiterUnlocked(
+    const TransactionId& waiter, const TransactionIdSet& blockers, CoarseTimePoint deadline,
+    WaitDoneCallback callback) {
+  if (closing_) {
+    return STATUS(Aborted, "Wait queue is shutting down");
+  }
+
+  if (!waiter.IsNil() && IsReachableUnlocked(blockers, waiter)) {
+    VLOG_WITH_PREFIX(1) << "Deadlock detected, " << waiter << " waits for " << AsString(blockers);
+    return STATUS_EC_FORMAT(
+        TryAgain, TransactionError(TransactionErrorCode::kConflict),
+        "Deadlock detected, $0 waits for $1", waiter, blockers);
+  }
+
+  auto serial_no = ++next_serial_no_;
+  auto entry = std::make_shared<Waiter>(Waiter {
+    .serial_no = serial_no,
+    .id = waiter,
+    .blockers = blockers,
+    .deadline = deadline,
+    .callback = std::move(callback),
+  });
+  for (const auto& blocker : blockers) {
+    waiters_by_blocker_[blocker].push_back(serial_no);
+  }
+  if (!waiter.IsNil()) {
+    waiters_by_txn_[waiter].push_back(serial_no);
+  }
+  waiters_.emplace(serial_no, std::move(entry));
+  num_waiters_.fetch_add(1, std::memory_order_acq_rel);
+
+  VLOG_WITH_PREFIX(4) << "Waiting " << serial_no << ": " << waiter << " for "
+                      << AsString(blockers);
+  return Status::OK();
+}
+
+bool WaitQueue::IsReachableUnlocked(
+    const TransactionIdSet& sources, const TransactionId& target) {
+  TransactionIdSet visited;
+  std::deque<TransactionId> queue(sources.begin(), sources.end());
+  while (!queue.empty()) {
+    auto current = queue.front();
+    queue.pop_front();
+    if (current == target) {
+      return true;
+    }
+    if (!visited.insert(current).second) {
+      continue;
+    }
+    auto it = waiters_by_txn_.find(current);
+    if (it == waiters_by_txn_.end()) {
+      continue;
+    }
+    for (auto serial_no : it->second) {
+      auto waiter_it = waiters_.find(serial_no);
+      if (waiter_it == waiters_.end()) {
+        continue;
+      }
+      for (const auto& blocker : waiter_it->second->blockers) {
+        if (!visited.count(blocker)) {
+          queue.push_back(blocker);
+        }
+      }
+    }
+  }
+  return false;
+}
+
+void WaitQueue::RemoveWaiterUnlocked(const WaiterPtr& waiter) {
+  if (!waiter->id.IsNil()) {
+    EraseSerialNo(&waiters_by_txn_, waiter->id, waiter->serial_no);
+  }
+  for (const auto& blocker : waiter->blockers) {
+    EraseSerialNo(&waiters_by_blocker_, blocker, waiter->serial_no);
+  }
+  waiters_.erase(waiter->serial_no);
+  num_waiters_.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void WaitQueue::SignalResolved(const TransactionId& id) {
+  WaiterCallbacks callbacks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = waiters_by_blocker_.find(id);
+    if (it == waiters_by_blocker_.end()) {
+      return;
+    }
+    auto serial_nos = std::move(it->second);
+    waiters_by_blocker_.erase(it);
+    for (auto serial_no : serial_nos) {
+      auto waiter_it = waiters_.find(serial_no);
+      if (waiter_it == waiters_.end()) {
+        continue;
+      }
+      auto waiter = waiter_it->second;
+      waiter->blockers.erase(id);
+      if (waiter->blockers.empty()) {
+        VLOG_WITH_PREFIX(4) << "Wake up " << serial_no << ", resolved: " << id;
+        callbacks.emplace_back(std::move(waiter->callback), Status::OK());
+        RemoveWaiterUnlocked(waiter);
+      }
+    }
+  }
+
+  InvokeCallbacks(&callbacks);
+}
+
+void WaitQueue::Poll(CoarseTimePoint now) {
+  if (!HasWaiters()) {
+    return;
+  }
+
+  WaiterCallbacks callbacks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<WaiterPtr> expired;
+    for (const auto& serial_no_and_waiter : waiters_) {
+      if (serial_no_and_waiter.second->deadline <= now) {
+        expired.push_back(serial_no_and_waiter.second);
+      }
+    }
+    for (const auto& waiter : expired) {
+      VLOG_WITH_PREFIX(4) << "Wait timed out: " << waiter->ToString();
+      callbacks.emplace_back(
+          std::move(waiter->callback),
+          STATUS_FORMAT(TimedOut, "Timed out waiting for $0", waiter->blockers));
+      RemoveWaiterUnlocked(waiter);
+    }
+  }
+
+  InvokeCallbacks(&callbacks);
+}
+
+void WaitQueue::InvokeCallbacks(WaiterCallbacks* callbacks) {
+  for (auto& callback_and_status : *callbacks) {
+    if (executor_) {
+      executor_(std::move(callback_and_status.first), callback_and_status.second);
+    } else {
+      callback_and_status.first(callback_and_status.second);
+    }
+  }
+}
+
+void WaitQueue::StartShutdown() {
+  WaiterCallbacks callbacks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closing_ = true;
+    for (auto& serial_no_and_waiter : waiters_) {
+      callbacks.emplace_back(
+          std::move(serial_no_and_waiter.second->callback),
+          STATUS(Aborted, "Wait queue is shutting down"));
+    }
+    num_waiters_.fetch_sub(waiters_.size(), std::memory_order_acq_rel);
+    waiters_.clear();
+    waiters_by_blocker_.clear();
+    waiters_by_txn_.clear();
+  }
+
+  for (auto& callback_and_status : callbacks) {
+    callback_and_status.first(callback_and_status.second);
+  }
+}
+
+} // namespace docdb
+} // namespace yb
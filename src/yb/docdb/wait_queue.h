@@ -0,0 +1,151 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_WAIT_QUEUE_H
+#define YB_DOCDB_WAIT_QUEUE_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/common/transaction.h"
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/util/monotime.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace docdb {
+
+// Invoked when waiter could retry conflict resolution (status is OK), or when waiting failed
+// (timeout, shutdown).
+using WaitDoneCallback = std::function<void(const Status&)>;
+
+// Returns whether transaction could still block requests, i.e. it was not yet resolved, or
+// SignalResolved will be invoked for it.
+using BlockerActiveFunctor = std::function<bool(const TransactionId&)>;
+
+// Invokes callback with specified status, potentially in another thread. Should invoke callback
+// with error status if it could not be scheduled.
+using WaitQueueExecutor = std::function<void(WaitDoneCallback callback, const Status& status)>;
+
+// Per tablet queue of requests that are blocked by conflicting transactions.
+//
+// Instead of aborting conflicting transactions or failing the request, conflict resolution could
+// park the request in this queue until all transactions it conflicts with are either applied or
+// aborted. Then the request is woken up and resolves conflicts again.
+//
+// Queue maintains local waits-for graph, i.e. for each waiting transaction it knows set of
+// transactions that it waits for. So deadlock could be detected when waiter is added, in this case
+// the caller should fall back to priority based conflict resolution.
+//
+// Callbacks are never invoked while internal mutex is held. When executor is specified, callbacks
+// of woken up and timed out waiters are invoked using it, so heavy work of waiter, i.e. reacquiring
+// locks and resolving conflicts again, is not performed on the thread that resolved blocker.
+class WaitQueue {
+ public:
+  // is_blocker_active - used to check blockers before and after waiter is registered, could be
+  // null.
+  // executor - used to invoke callbacks, when null callbacks are invoked inline.
+  explicit WaitQueue(
+      const std::string& log_prefix, BlockerActiveFunctor is_blocker_active = nullptr,
+      WaitQueueExecutor executor = nullptr);
+  ~WaitQueue();
+
+  WaitQueue(const WaitQueue&) = delete;
+  void operator=(const WaitQueue&) = delete;
+
+  // Parks waiter until all blockers are resolved or deadline is reached.
+  // waiter - id of transaction that is waiting, Nil for non transactional operation.
+  // blockers - ids of transactions that waiter conflicts with, should not be empty.
+  //
+  // Returns OK if waiter was enqueued, in this case callback will be invoked exactly once.
+  // Callback could be invoked before this function returns, when blocker was resolved before
+  // waiter was registered.
+  // Returns error w/o invoking callback if waiting would form a cycle in waits-for graph, queue
+  // is shutting down, or some blocker is not known to be active, so it would not be signaled.
+  CHECKED_STATUS WaitOn(
+      const TransactionId& waiter, const TransactionIdSet& blockers, CoarseTimePoint deadline,
+      WaitDoneCallback callback);
+
+  // Notifies queue that specified transaction was applied or aborted, so it cannot block
+  // anybody anymore.
+  void SignalResolved(const TransactionId& id);
+
+  // Fails waiters whose deadline has passed.
+  void Poll(CoarseTimePoint now);
+
+  // Fails all waiters and rejects new ones.
+  void StartShutdown();
+
+  // Whether there are any waiters in the queue. Cheap, could be used to avoid SignalResolved
+  // overhead when nobody is waiting.
+  bool HasWaiters() const {
+    return num_waiters_.load(std::memory_order_acquire) != 0;
+  }
+
+  size_t TEST_NumWaiters() const {
+    return num_waiters_.load(std::memory_order_acquire);
+  }
+
+ private:
+  struct Waiter;
+  using WaiterPtr = std::shared_ptr<Waiter>;
+  using WaiterCallbacks = std::vector<std::pair<WaitDoneCallback, Status>>;
+
+  CHECKED_STATUS RegisterWaiterUnlocked(
+      const TransactionId& waiter, const TransactionIdSet& blockers, CoarseTimePoint deadline,
+      WaitDoneCallback callback) REQUIRES(mutex_);
+
+  // Returns true if `target` is reachable from any of `sources` in waits-for graph.
+  bool IsReachableUnlocked(const TransactionIdSet& sources, const TransactionId& target)
+      REQUIRES(mutex_);
+
+  void RemoveWaiterUnlocked(const WaiterPtr& waiter) REQUIRES(mutex_);
+
+  void InvokeCallbacks(WaiterCallbacks* callbacks);
+
+  const std::string& LogPrefix() const {
+    return log_prefix_;
+  }
+
+  const std::string log_prefix_;
+  const BlockerActiveFunctor is_blocker_active_;
+  const WaitQueueExecutor executor_;
+
+  std::mutex mutex_;
+  bool closing_ GUARDED_BY(mutex_) = false;
+  int64_t next_serial_no_ GUARDED_BY(mutex_) = 0;
+
+  // All parked waiters by serial no.
+  std::unordered_map<int64_t, WaiterPtr> waiters_ GUARDED_BY(mutex_);
+
+  // Serial nos of waiters blocked by transaction.
+  std::unordered_map<TransactionId, std::vector<int64_t>, TransactionIdHash> waiters_by_blocker_
+      GUARDED_BY(mutex_);
+
+  // Edges of waits-for graph, i.e. serial nos of waiters that were registered by transaction.
+  std::unordered_map<TransactionId, std::vector<int64_t>, TransactionIdHash> waiters_by_txn_
+      GUARDED_BY(mutex_);
+
+  std::atomic<size_t> num_waiters_{0};
+};
+
+} // namespace docdb
+} // namespace yb
+
+#endif // YB_DOCDB_WAIT_QUEUE_H
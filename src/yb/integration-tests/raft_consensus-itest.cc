@@ -89,11 +89,14 @@ DECLARE_int32(leader_lease_duration_ms);
 DECLARE_int32(ht_lease_duration_ms);
 DECLARE_int32(rpc_timeout);
 
+METRIC_DECLARE_entity(server);
 METRIC_DECLARE_entity(tablet);
 METRIC_DECLARE_counter(not_leader_rejections);
 METRIC_DECLARE_gauge_int64(raft_term);
 METRIC_DECLARE_counter(log_cache_disk_reads);
 METRIC_DECLARE_gauge_int64(log_cache_num_ops);
+METRIC_DECLARE_histogram(handler_latency_yb_consensus_ConsensusService_MultiRaftUpdateConsensus);
+METRIC_DECLARE_counter(multi_raft_consensus_requests);
 
 namespace yb {
 namespace tserver {
@@ -756,6 +759,77 @@ TEST_F(RaftConsensusITest, TestCatchupAfterOpsEvicted) {
   ASSERT_ALL_REPLICAS_AGREE(kNumWrites);
 }
 
+// Test that heartbeats of tablets with the same leader and follower tablet servers are coalesced
+// into MultiRaftUpdateConsensus, while committed index is still propagated without delay.
+TEST_F(RaftConsensusITest, MultiRaftHeartbeatBatching) {
+  constexpr int kNumExtraTablets = 6;
+  constexpr int kNumWrites = 100;
+  ASSERT_NO_FATALS(BuildAndStart({
+      "--enable_multi_raft_heartbeat_batcher=true"s,
+      "--raft_heartbeat_interval_ms=100"s,
+      "--multi_raft_heartbeat_batch_window_ms=200"s,
+      // Heartbeats are delayed by batch window, so make sure that it does not cause elections.
+      "--leader_failure_max_missed_heartbeat_periods=100"s,
+      "--leader_lease_duration_ms=8000"s,
+      "--ht_lease_duration_ms=8000"s}));
+
+  // Extra tablets, so each leader has several tablets with followers on the same tablet server.
+  client::TableHandle extra_table;
+  ASSERT_OK(extra_table.Create(
+      YBTableName(kTableName.namespace_type(), kTableName.namespace_name(), "extra-table"),
+      kNumExtraTablets, client::YBSchema(schema_), client_.get()));
+
+  ASSERT_NO_FATALS(WriteOpsToLeader(kNumWrites, 1_KB));
+  ASSERT_ALL_REPLICAS_AGREE(kNumWrites);
+
+  // Returns number of received MultiRaftUpdateConsensus RPCs and number of requests in them.
+  auto get_batch_stats = [this]() -> Result<std::pair<int64_t, int64_t>> {
+    std::pair<int64_t, int64_t> result(0, 0);
+    for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      auto* ts = cluster_->tablet_server(i);
+      result.first += VERIFY_RESULT(ts->GetInt64Metric(
+          &METRIC_ENTITY_server, "yb.tabletserver",
+          &METRIC_handler_latency_yb_consensus_ConsensusService_MultiRaftUpdateConsensus,
+          "total_count"));
+      result.second += VERIFY_RESULT(ts->GetInt64Metric(
+          &METRIC_ENTITY_server, "yb.tabletserver", &METRIC_multi_raft_consensus_requests,
+          "value"));
+    }
+    return result;
+  };
+
+  // Idle tablets send heartbeats only, they should be received in batches.
+  auto initial_stats = ASSERT_RESULT(get_batch_stats());
+  SleepFor(MonoDelta::FromSeconds(3));
+  auto stats = ASSERT_RESULT(get_batch_stats());
+  auto num_batches = stats.first - initial_stats.first;
+  auto num_batched_requests = stats.second - initial_stats.second;
+  LOG(INFO) << "Batches: " << num_batches << ", batched requests: " << num_batched_requests;
+  ASSERT_GT(num_batches, 0);
+  ASSERT_GT(num_batched_requests, num_batches * 3 / 2);
+
+  // Heartbeats could now be delayed for much longer than the wait below, so followers should learn
+  // committed index from requests that are not batched.
+  ASSERT_OK(cluster_->SetFlagOnTServers("multi_raft_heartbeat_batch_window_ms", "5000"));
+  TServerDetails* leader = nullptr;
+  ASSERT_OK(GetLeaderReplicaWithRetries(tablet_id_, &leader));
+  for (int i = 0; i != 5; ++i) {
+    ASSERT_NO_FATALS(WriteOpsToLeader(1, 1_KB));
+    auto committed_index = ASSERT_RESULT(GetLastOpIdForReplica(
+        tablet_id_, leader, consensus::COMMITTED_OPID, 10s)).index;
+    auto range = tablet_replicas_.equal_range(tablet_id_);
+    for (auto it = range.first; it != range.second; ++it) {
+      auto replica_committed_index = committed_index;
+      ASSERT_OK(WaitUntilCommittedOpIdIndexIsAtLeast(
+          &replica_committed_index, it->second, tablet_id_, 2s));
+    }
+  }
+
+  ASSERT_OK(cluster_->SetFlagOnTServers("multi_raft_heartbeat_batch_window_ms", "200"));
+  ASSERT_NO_FATALS(WriteOpsToLeader(kNumWrites, 1_KB));
+  ASSERT_ALL_REPLICAS_AGREE(kNumWrites);
+}
+
 Result<int64_t> RaftConsensusITest::GetNumLogCacheOpsReadFromDisk() {
   TServerDetails* leader = nullptr;
   RETURN_NOT_OK(GetLeaderReplicaWithRetries(tablet_id_, &leader));
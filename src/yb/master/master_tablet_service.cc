@@ -43,8 +43,10 @@ bool MasterTabletServiceImpl::GetTabletOrRespond(
     tserver::ReadResponsePB* resp,
     rpc::RpcContext* context,
     std::shared_ptr<tablet::AbstractTablet>* tablet,
-    tablet::TabletPeerPtr looked_up_tablet_peer) {
-  // Ignore looked_up_tablet_peer.
+    tablet::TabletPeerPtr looked_up_tablet_peer,
+    HybridTime* follower_safe_time) {
+  // Ignore looked_up_tablet_peer. System tablets are always read on the leader, so
+  // follower_safe_time is left unset.
 
   SCOPED_LEADER_SHARED_LOCK(l, master_->catalog_manager());
   if (!l.CheckIsInitializedAndIsLeaderOrRespondTServer(resp, context)) {
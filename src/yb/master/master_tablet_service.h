@@ -59,7 +59,8 @@ class MasterTabletServiceImpl : public yb::tserver::TabletServiceImpl {
       tserver::ReadResponsePB* resp,
       rpc::RpcContext* context,
       std::shared_ptr<tablet::AbstractTablet>* tablet,
-      tablet::TabletPeerPtr looked_up_tablet_peer) override;
+      tablet::TabletPeerPtr looked_up_tablet_peer,
+      HybridTime* follower_safe_time) override;
 
   Master *const master_;
   DISALLOW_COPY_AND_ASSIGN(MasterTabletServiceImpl);
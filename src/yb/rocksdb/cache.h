@@ -66,6 +66,13 @@ extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits);
 extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                                      bool strict_capacity_limit);
 
+// Create a new cache that uses CLOCK eviction instead of LRU. Lookups do not take exclusive lock,
+// and single touch entries are evicted before multi touch ones, the same way as in LRU cache, so
+// the hot working set survives large scans. Sharding and defaults are the same as for LRU cache.
+extern shared_ptr<Cache> NewClockCache(size_t capacity);
+extern shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits,
+                                       bool strict_capacity_limit = false);
+
 using QueryId = int64_t;
 // Query ids to represent values for the default query id.
 constexpr QueryId kDefaultQueryId = 0;
@@ -184,7 +191,9 @@ class Cache {
   virtual void ApplyToAllCacheEntries(void (*callback)(void*, size_t),
                                       bool thread_safe) = 0;
 
-  virtual void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) = 0;
+  virtual void SetMetrics(
+      const scoped_refptr<yb::MetricEntity>& entity,
+      yb::CacheMetricsKind kind = yb::CacheMetricsKind::kBlockCache) = 0;
 
   // Tries to evict specified amount of bytes from cache.
   virtual size_t Evict(size_t required) { return 0; }
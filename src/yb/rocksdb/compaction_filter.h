@@ -166,6 +166,11 @@ class CompactionFilterFactory {
   virtual std::unique_ptr<CompactionFilter> CreateCompactionFilter(
       const CompactionFilter::Context& context) = 0;
 
+  // Returns prefix of user_key that could be used as a boundary between subcompactions, or empty
+  // slice if there is no such prefix. Each subcompaction uses its own compaction filter, so filter
+  // that relies on seeing related keys together should not allow splitting them.
+  virtual Slice SubcompactionBoundary(const Slice& user_key) const { return user_key; }
+
   // Returns a name that identifies this compaction filter factory.
   virtual const char* Name() const = 0;
 };
@@ -586,7 +586,9 @@ bool Compaction::ShouldFormSubcompactions() const {
   if (cfd_->ioptions()->compaction_style == kCompactionStyleLevel) {
     return start_level_ == 0 && !IsOutputLevelEmpty();
   } else if (IsCompactionStyleUniversal()) {
-    return number_levels_ > 1 && output_level_ > 0;
+    // With single level, key ranges of output files produced by different subcompactions do not
+    // overlap, so they could be placed to level 0 together.
+    return number_levels_ == 1 || output_level_ > 0;
   } else {
     return false;
   }
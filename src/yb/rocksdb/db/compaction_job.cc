@@ -351,6 +351,11 @@ void CompactionJob::GenSubcompactionBoundaries() {
         for (size_t i = 0; i < num_files; i++) {
           bounds.emplace_back(flevel->files[i].smallest.key);
           bounds.emplace_back(flevel->files[i].largest.key);
+          if (out_lvl == 0) {
+            // When all files are in level 0, they usually cover the whole key range, so add
+            // keys that split each file into parts of the same size.
+            AddFileSplitKeys(flevel->files[i].fd, &bounds);
+          }
         }
       } else {
         // For all other levels add the smallest/largest key in the level to
@@ -401,9 +406,12 @@ void CompactionJob::GenSubcompactionBoundaries() {
 
   // Group the ranges into subcompactions
   const double min_file_fill_percent = 4.0 / 5;
-  uint64_t max_output_files = static_cast<uint64_t>(std::ceil(
-      sum / min_file_fill_percent /
-      cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl)));
+  const uint64_t max_file_size = cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl);
+  // Size of output files is not limited for level 0 of universal compaction, so each
+  // subcompaction produces a single file.
+  uint64_t max_output_files = max_file_size == std::numeric_limits<uint64_t>::max()
+      ? std::numeric_limits<uint64_t>::max()
+      : static_cast<uint64_t>(std::ceil(sum / min_file_fill_percent / max_file_size));
   uint64_t subcompactions =
       std::min({static_cast<uint64_t>(ranges.size()),
                 static_cast<uint64_t>(db_options_.max_subcompactions),
@@ -435,6 +443,63 @@ void CompactionJob::GenSubcompactionBoundaries() {
     // Only one range so its size is the total sum of sizes computed above
     sizes_.emplace_back(sum);
   }
+
+  AlignSubcompactionBoundaries();
+}
+
+void CompactionJob::AddFileSplitKeys(const FileDescriptor& fd, std::vector<Slice>* bounds) {
+  auto* cfd = compact_->compaction->column_family_data();
+  auto split_keys = GetFileSplitKeys(fd);
+  if (!split_keys.ok()) {
+    // Split keys are used only to balance subcompactions, so compaction could proceed without
+    // them.
+    RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+         "[%s] [JOB %d] Failed to get split keys of file %" PRIu64 ": %s",
+         cfd->GetName().c_str(), job_id_, fd.GetNumber(),
+         split_keys.status().ToString().c_str());
+    return;
+  }
+  for (auto& key : *split_keys) {
+    split_keys_.push_back(std::move(key));
+    bounds->emplace_back(split_keys_.back());
+  }
+}
+
+Result<std::vector<std::string>> CompactionJob::GetFileSplitKeys(const FileDescriptor& fd) {
+  auto* cfd = compact_->compaction->column_family_data();
+  auto trwh = VERIFY_RESULT(cfd->table_cache()->GetTableReader(
+      env_options_, cfd->internal_comparator(), fd, kDefaultQueryId, /* no_io =*/ false,
+      /* file_read_hist =*/ nullptr, /* skip_filters =*/ true));
+  return trwh.table_reader->GetSplitKeys(db_options_.max_subcompactions);
+}
+
+void CompactionJob::AlignSubcompactionBoundaries() {
+  auto* cfd = compact_->compaction->column_family_data();
+  const auto* factory = cfd->ioptions()->compaction_filter_factory;
+  if (factory == nullptr || cfd->ioptions()->compaction_filter != nullptr ||
+      boundaries_.empty()) {
+    return;
+  }
+  const Comparator* user_comparator = cfd->user_comparator();
+  std::vector<Slice> boundaries;
+  std::vector<uint64_t> sizes;
+  uint64_t size = 0;
+  for (size_t i = 0; i != boundaries_.size(); ++i) {
+    size += sizes_[i];
+    // Boundary prefixes are not decreasing, so subcompaction is merged with the next one when
+    // its boundary is not allowed or its range becomes empty.
+    auto boundary = factory->SubcompactionBoundary(boundaries_[i]);
+    if (boundary.empty() ||
+        (!boundaries.empty() && user_comparator->Compare(boundary, boundaries.back()) <= 0)) {
+      continue;
+    }
+    boundaries.push_back(boundary);
+    sizes.push_back(size);
+    size = 0;
+  }
+  sizes.push_back(size + sizes_.back());
+  boundaries_ = std::move(boundaries);
+  sizes_ = std::move(sizes);
 }
 
 Result<FileNumbersHolder> CompactionJob::Run() {
@@ -607,8 +672,13 @@ void CompactionJob::ProcessKeyValueCompaction(
 
   if (compaction_filter) {
     // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
-    // filter.
-    largest_user_frontier_ = compaction_filter->GetLargestUserFrontier();
+    // filter. Each subcompaction has its own filter, so the largest frontier is used.
+    auto frontier = compaction_filter->GetLargestUserFrontier();
+    if (frontier) {
+      std::lock_guard<std::mutex> lock(largest_user_frontier_mutex_);
+      UpdateUserFrontier(
+          &largest_user_frontier_, std::move(frontier), UpdateUserValueType::kLargest);
+    }
   }
 
   MergeHelper merge(
@@ -919,9 +989,33 @@ Status CompactionJob::InstallCompactionResults(
   // Add compaction outputs
   compaction->AddInputDeletions(compaction->edit());
 
+  // Outputs of subcompactions placed to level 0 have non overlapping key ranges, so they form a
+  // single sorted run. All of them get sequence number range of compaction inputs, so compaction
+  // picker could recognize them as a single sorted run, see InSameSortedRun.
+  // Sequence numbers of output keys could be zeroed, so input files are used to find the range.
+  bool single_sorted_run = false;
+  SequenceNumber smallest_seqno = kMaxSequenceNumber;
+  SequenceNumber largest_seqno = 0;
+  if (compaction->output_level() == 0 && compact_->sub_compact_states.size() > 1) {
+    single_sorted_run = true;
+    for (size_t i = 0; i != compaction->num_input_levels(); ++i) {
+      for (const auto* f : *compaction->inputs(i)) {
+        smallest_seqno = std::min(smallest_seqno, f->smallest.seqno);
+        largest_seqno = std::max(largest_seqno, f->largest.seqno);
+      }
+    }
+  }
+
   for (const auto& sub_compact : compact_->sub_compact_states) {
     for (const auto& out : sub_compact.outputs) {
-      compaction->edit()->AddFile(compaction->output_level(), out.meta);
+      if (!single_sorted_run) {
+        compaction->edit()->AddFile(compaction->output_level(), out.meta);
+        continue;
+      }
+      auto meta = out.meta;
+      meta.smallest.seqno = smallest_seqno;
+      meta.largest.seqno = largest_seqno;
+      compaction->edit()->AddFile(compaction->output_level(), meta);
     }
   }
   if (largest_user_frontier_) {
@@ -30,6 +30,7 @@
 #include <deque>
 #include <functional>
 #include <limits>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -110,6 +111,12 @@ class CompactionJob {
 
   void AggregateStatistics();
   void GenSubcompactionBoundaries();
+  // Adds keys that split file into parts of the same size to bounds.
+  void AddFileSplitKeys(const FileDescriptor& fd, std::vector<Slice>* bounds);
+  Result<std::vector<std::string>> GetFileSplitKeys(const FileDescriptor& fd);
+  // Merges subcompactions, which boundaries are not allowed by compaction filter factory
+  // (see CompactionFilterFactory::SubcompactionBoundary).
+  void AlignSubcompactionBoundaries();
 
   // update the thread status for starting a compaction.
   void ReportStartedCompaction(Compaction* compaction);
@@ -185,7 +192,11 @@ class CompactionJob {
   std::vector<Slice> boundaries_;
   // Stores the approx size of keys covered in the range of each subcompaction
   std::vector<uint64_t> sizes_;
+  // Storage for split keys of input files, that could be referenced by boundaries_.
+  std::deque<std::string> split_keys_;
 
+  // Protects largest_user_frontier_ while subcompactions are running.
+  std::mutex largest_user_frontier_mutex_;
   UserFrontierPtr largest_user_frontier_;
 };
 
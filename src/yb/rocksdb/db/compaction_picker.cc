@@ -1176,16 +1176,16 @@ bool UniversalCompactionPicker::NeedsCompaction(
 }
 
 struct UniversalCompactionPicker::SortedRun {
-  SortedRun(int _level, FileMetaData* _file, uint64_t _size,
+  SortedRun(int _level, std::vector<FileMetaData*> _files, uint64_t _size,
             uint64_t _compensated_file_size, bool _being_compacted)
       : level(_level),
-        file(_file),
+        files(std::move(_files)),
         size(_size),
         compensated_file_size(_compensated_file_size),
         being_compacted(_being_compacted) {
     assert(compensated_file_size > 0);
-    // Allowed either one of level and file.
-    assert((level != 0) != (file != nullptr));
+    // Allowed either one of level and files.
+    assert((level != 0) != !files.empty());
   }
 
   void Dump(char* out_buf, size_t out_buf_size,
@@ -1196,12 +1196,13 @@ struct UniversalCompactionPicker::SortedRun {
                     size_t sorted_run_count) const;
 
   int level;
-  // `file` Will be null for level > 0. For level = 0, the sorted run is
-  // for this file.
-  FileMetaData* file;
+  // `files` will be empty for level > 0. For level = 0, the sorted run is for these files.
+  // Usually it is a single file, but outputs of subcompactions form a single sorted run.
+  std::vector<FileMetaData*> files;
   // For level > 0, `size` and `compensated_file_size` are sum of sizes all
   // files in the level. `being_compacted` should be the same for all files
   // in a non-zero level. Use the value here.
+  // For level = 0, they are sum of sizes of all files of the sorted run.
   uint64_t size;
   uint64_t compensated_file_size;
   bool being_compacted;
@@ -1211,14 +1212,16 @@ void UniversalCompactionPicker::SortedRun::Dump(char* out_buf,
                                                 size_t out_buf_size,
                                                 bool print_path) const {
   if (level == 0) {
-    assert(file != nullptr);
+    assert(!files.empty());
+    const auto* file = files.front();
     if (file->fd.GetPathId() == 0 || !print_path) {
-      snprintf(out_buf, out_buf_size, "file %" PRIu64, file->fd.GetNumber());
+      snprintf(out_buf, out_buf_size, "file %" PRIu64 " (%" ROCKSDB_PRIszt " files)",
+               file->fd.GetNumber(), files.size());
     } else {
       snprintf(out_buf, out_buf_size, "file %" PRIu64
                                       "(path "
-                                      "%" PRIu32 ")",
-               file->fd.GetNumber(), file->fd.GetPathId());
+                                      "%" PRIu32 ") (%" ROCKSDB_PRIszt " files)",
+               file->fd.GetNumber(), file->fd.GetPathId(), files.size());
     }
   } else {
     snprintf(out_buf, out_buf_size, "level %d", level);
@@ -1228,13 +1231,13 @@ void UniversalCompactionPicker::SortedRun::Dump(char* out_buf,
 void UniversalCompactionPicker::SortedRun::DumpSizeInfo(
     char* out_buf, size_t out_buf_size, size_t sorted_run_count) const {
   if (level == 0) {
-    assert(file != nullptr);
+    assert(!files.empty());
     snprintf(out_buf, out_buf_size,
              "file %" PRIu64 "[%" ROCKSDB_PRIszt
-             "] "
+             "] (%" ROCKSDB_PRIszt " files) "
              "with size %" PRIu64 " (compensated size %" PRIu64 ")",
-             file->fd.GetNumber(), sorted_run_count, file->fd.GetTotalFileSize(),
-             file->compensated_file_size);
+             files.front()->fd.GetNumber(), sorted_run_count, files.size(), size,
+             compensated_file_size);
   } else {
     snprintf(out_buf, out_buf_size,
              "level %d[%" ROCKSDB_PRIszt
@@ -1251,12 +1254,34 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
   std::vector<std::vector<SortedRun>> ret(1);
   MarkL0FilesForDeletion(&vstorage, &ioptions);
 
-  for (FileMetaData* f : vstorage.LevelFiles(0)) {
-    // Any files that can be directly removed during compaction can be included, even if they
-    // exceed the "max file size for compaction."
-    if (f->fd.GetTotalFileSize() <= max_file_size || f->delete_after_compaction) {
-      ret.back().emplace_back(0, f, f->fd.GetTotalFileSize(), f->compensated_file_size,
-          f->being_compacted);
+  const auto& level0_files = vstorage.LevelFiles(0);
+  for (size_t i = 0; i != level0_files.size();) {
+    // Outputs of subcompactions have the same sequence number range and are adjacent in level 0,
+    // they are treated as a single sorted run.
+    size_t end = i + 1;
+    while (end != level0_files.size() && InSameSortedRun(*level0_files[i], *level0_files[end])) {
+      ++end;
+    }
+    std::vector<FileMetaData*> files(level0_files.begin() + i, level0_files.begin() + end);
+    i = end;
+
+    bool too_large = false;
+    bool being_compacted = false;
+    uint64_t total_size = 0;
+    uint64_t total_compensated_size = 0;
+    for (auto* f : files) {
+      // Any files that can be directly removed during compaction can be included, even if they
+      // exceed the "max file size for compaction."
+      if (f->fd.GetTotalFileSize() > max_file_size && !f->delete_after_compaction) {
+        too_large = true;
+      }
+      being_compacted = being_compacted || f->being_compacted;
+      total_size += f->fd.GetTotalFileSize();
+      total_compensated_size += f->compensated_file_size;
+    }
+    if (!too_large) {
+      ret.back().emplace_back(
+          0, std::move(files), total_size, total_compensated_size, being_compacted);
     // If last sequence is empty it means that there are multiple too-large-to-compact files in
     // a row. So we just don't start new sequence in this case.
     } else if (!ret.back().empty()) {
@@ -1290,7 +1315,9 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
       }
     }
     if (total_compensated_size > 0) {
-      ret.back().emplace_back(level, nullptr, total_size, total_compensated_size, being_compacted);
+      ret.back().emplace_back(
+          level, std::vector<FileMetaData*>(), total_size, total_compensated_size,
+          being_compacted);
     }
   }
 
@@ -1484,14 +1511,17 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::DoPickCompaction(
 
   size_t level_index = 0U;
   if (c->start_level() == 0) {
+    const FileMetaData* prev = nullptr;
     for (auto f : *c->inputs(0)) {
       DCHECK_LE(f->smallest.seqno, f->largest.seqno);
       if (is_first) {
         is_first = false;
-      } else {
+      } else if (!InSameSortedRun(*prev, *f)) {
+        // Outputs of subcompactions have the same sequence number range.
         DCHECK_GT(prev_smallest_seqno, f->largest.seqno);
       }
       prev_smallest_seqno = f->smallest.seqno;
+      prev = f;
     }
     level_index = 1U;
   }
@@ -1721,8 +1751,8 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   for (size_t i = start_index; i < first_index_after; i++) {
     auto& picking_sr = sorted_runs[i];
     if (picking_sr.level == 0) {
-      FileMetaData* picking_file = picking_sr.file;
-      inputs[0].files.push_back(picking_file);
+      inputs[0].files.insert(
+          inputs[0].files.end(), picking_sr.files.begin(), picking_sr.files.end());
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -1848,8 +1878,8 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
   for (size_t loop = start_index; loop < sorted_runs.size(); loop++) {
     auto& picking_sr = sorted_runs[loop];
     if (picking_sr.level == 0) {
-      FileMetaData* f = picking_sr.file;
-      inputs[0].files.push_back(f);
+      inputs[0].files.insert(
+          inputs[0].files.end(), picking_sr.files.begin(), picking_sr.files.end());
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
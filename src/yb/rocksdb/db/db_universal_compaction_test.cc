@@ -21,11 +21,22 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+
 #include "yb/rocksdb/db/db_test_util.h"
 #include "yb/rocksdb/port/stack_trace.h"
 #if !defined(ROCKSDB_LITE)
 #include "yb/rocksdb/util/sync_point.h"
 
+#include "yb/util/format.h"
+#include "yb/util/test_util.h"
+#include "yb/util/tsan_util.h"
+
+using namespace std::literals;
+
 namespace rocksdb {
 
 static std::string CompressibleString(Random* rnd, int len) {
@@ -127,6 +138,59 @@ class DelayFilterFactory : public CompactionFilterFactory {
  private:
   DBTestBase* db_test;
 };
+
+// Allows subcompaction boundaries only between documents, where document is key prefix before
+// '/'. Counts documents, that were processed by more than one compaction filter.
+class DocumentFilterFactory : public CompactionFilterFactory {
+ public:
+  class DocumentFilter : public CompactionFilter {
+   public:
+    explicit DocumentFilter(DocumentFilterFactory* factory) : factory_(factory) {}
+
+    FilterDecision Filter(int level, const Slice& key, const Slice& value,
+                          std::string* new_value, bool* value_changed) override {
+      factory_->KeyProcessed(key, this);
+      return FilterDecision::kKeep;
+    }
+
+    const char* Name() const override { return "DocumentFilter"; }
+
+   private:
+    DocumentFilterFactory* factory_;
+  };
+
+  std::unique_ptr<CompactionFilter> CreateCompactionFilter(
+      const CompactionFilter::Context& context) override {
+    ++num_filters_;
+    return std::make_unique<DocumentFilter>(this);
+  }
+
+  Slice SubcompactionBoundary(const Slice& user_key) const override {
+    auto pos = user_key.ToBuffer().find('/');
+    return pos == std::string::npos ? Slice() : user_key.Prefix(pos);
+  }
+
+  const char* Name() const override { return "DocumentFilterFactory"; }
+
+  void KeyProcessed(const Slice& key, CompactionFilter* filter) {
+    auto document = key.ToBuffer();
+    document.resize(document.find('/'));
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = document_filter_.emplace(document, filter).first;
+    if (it->second != filter) {
+      ++num_split_documents_;
+    }
+  }
+
+  int num_filters() const { return num_filters_; }
+  int num_split_documents() const { return num_split_documents_; }
+
+ private:
+  std::atomic<int> num_filters_{0};
+  std::mutex mutex_;
+  std::unordered_map<std::string, CompactionFilter*> document_filter_;
+  int num_split_documents_ = 0;
+};
 }  // namespace
 
 // Make sure we don't trigger a problem if the trigger conditon is given
@@ -1474,6 +1538,121 @@ TEST_F(DBTestUniversalCompaction, IncludeFilesSmallerThanThreshold) {
   GenerateFilesAndCheckCompactionResult(options, file_sizes, value_size, 1);
 }
 
+TEST_F(DBTestUniversalCompaction, SingleLevelSubcompactions) {
+  constexpr int kNumFiles = 4;
+  constexpr int kNumDocuments = 1000;
+  constexpr int kNumColumns = 3;
+  constexpr uint32_t kMaxSubcompactions = 4;
+
+  auto factory = std::make_shared<DocumentFilterFactory>();
+  Options options;
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.disable_auto_compactions = true;
+  options.write_buffer_size = 100_MB;
+  options.max_subcompactions = kMaxSubcompactions;
+  options.compaction_filter_factory = factory;
+  options = CurrentOptions(options);
+  DestroyAndReopen(options);
+
+  // Each file covers the whole key range, so boundaries are taken from split keys of files.
+  Random rnd(301);
+  for (int file = 0; file != kNumFiles; ++file) {
+    for (int doc = 0; doc != kNumDocuments; ++doc) {
+      for (int column = 0; column != kNumColumns; ++column) {
+        ASSERT_OK(Put(yb::Format("doc$0/$1", 10000 + doc, column), RandomString(&rnd, 100)));
+      }
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(kNumFiles, NumTableFilesAtLevel(0));
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  // Each subcompaction uses its own filter and produces its own file.
+  ASSERT_GT(factory->num_filters(), 1);
+  ASSERT_LE(factory->num_filters(), kMaxSubcompactions);
+  ASSERT_GT(NumTableFilesAtLevel(0), 1);
+  ASSERT_EQ(0, factory->num_split_documents());
+
+  for (int doc = 0; doc != kNumDocuments; ++doc) {
+    for (int column = 0; column != kNumColumns; ++column) {
+      ASSERT_NE("NOT_FOUND", Get(yb::Format("doc$0/$1", 10000 + doc, column)));
+    }
+  }
+}
+
+// Outputs of subcompactions should be treated as a single sorted run by compaction picker.
+// Otherwise they would be picked for compaction again and again.
+TEST_F(DBTestUniversalCompaction, SingleLevelSubcompactionsAutoCompaction) {
+  constexpr int kNumFiles = 12;
+  constexpr int kNumDocuments = 1000;
+  constexpr int kNumColumns = 3;
+  constexpr int kCompactionTrigger = 4;
+  constexpr uint32_t kMaxSubcompactions = 8;
+  const auto kTimeout = 60s * yb::kTimeMultiplier;
+
+  auto factory = std::make_shared<DocumentFilterFactory>();
+  Options options;
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.level0_file_num_compaction_trigger = kCompactionTrigger;
+  options.write_buffer_size = 100_MB;
+  options.max_subcompactions = kMaxSubcompactions;
+  options.compaction_filter_factory = factory;
+  options = CurrentOptions(options);
+  DestroyAndReopen(options);
+
+  std::atomic<int> num_compactions{0};
+  rocksdb::SyncPoint::GetInstance()->SetCallBack(
+      "CompactionJob::Run():End", [&num_compactions](void* arg) { ++num_compactions; });
+  rocksdb::SyncPoint::GetInstance()->EnableProcessing();
+
+  Random rnd(301);
+  for (int file = 0; file != kNumFiles; ++file) {
+    for (int doc = 0; doc != kNumDocuments; ++doc) {
+      for (int column = 0; column != kNumColumns; ++column) {
+        ASSERT_OK(Put(yb::Format("doc$0/$1", 10000 + doc, column), RandomString(&rnd, 100)));
+      }
+    }
+    ASSERT_OK(Flush());
+  }
+
+  // Endless compaction loop would never let compactions finish.
+  ASSERT_OK(yb::LoggedWaitFor(
+      [this] {
+        uint64_t pending = 0;
+        return db_->GetIntProperty(DB::Properties::kCompactionPending, &pending) &&
+               pending == 0 && dbfull()->TEST_NumTotalRunningCompactions() == 0;
+      },
+      kTimeout, "Waiting for compactions to finish"));
+  const int compactions_done = num_compactions.load();
+  LOG(INFO) << "Compactions: " << compactions_done << ", files: " << NumTableFilesAtLevel(0);
+  ASSERT_GT(compactions_done, 0);
+  ASSERT_LE(compactions_done, kNumFiles);
+
+  // Files produced by the same compaction share sequence number range.
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  std::set<std::pair<SequenceNumber, SequenceNumber>> sorted_runs;
+  for (const auto& file : files) {
+    sorted_runs.emplace(file.smallest.seqno, file.largest.seqno);
+  }
+  ASSERT_GT(files.size(), sorted_runs.size());
+  ASSERT_LT(sorted_runs.size(), kCompactionTrigger);
+
+  // Nothing left to compact, so no more compactions are started.
+  std::this_thread::sleep_for(1s);
+  ASSERT_EQ(compactions_done, num_compactions.load());
+  rocksdb::SyncPoint::GetInstance()->DisableProcessing();
+
+  for (int doc = 0; doc != kNumDocuments; ++doc) {
+    for (int column = 0; column != kNumColumns; ++column) {
+      ASSERT_NE("NOT_FOUND", Get(yb::Format("doc$0/$1", 10000 + doc, column)));
+    }
+  }
+}
+
 }  // namespace rocksdb
 
 #endif  // !defined(ROCKSDB_LITE)
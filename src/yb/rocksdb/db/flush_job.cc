@@ -264,6 +264,10 @@ Result<FileNumbersHolder> FlushJob::WriteLevel0Table(
 
       TEST_SYNC_POINT_CALLBACK("FlushJob::WriteLevel0Table:output_compression",
                                &output_compression_);
+      // Flushed files are short living, so do not spend time on building compression dictionary
+      // for them. Dictionary is only built for compaction outputs.
+      CompressionOptions compression_opts = cfd_->ioptions()->compression_opts;
+      compression_opts.max_dict_bytes = 0;
       s = BuildTable(dbname_,
                      db_options_.env,
                      *cfd_->ioptions(),
@@ -277,7 +281,7 @@ Result<FileNumbersHolder> FlushJob::WriteLevel0Table(
                      existing_snapshots_,
                      earliest_write_conflict_snapshot_,
                      output_compression_,
-                     cfd_->ioptions()->compression_opts,
+                     compression_opts,
                      mutable_cf_options_.paranoid_file_checks,
                      cfd_->internal_stats(),
                      db_options_.boundary_extractor.get(),
@@ -146,10 +146,16 @@ class VersionBuilder::Rep {
         auto f2 = level_files[i];
         if (level == 0) {
           assert(level_zero_cmp_(f1, f2));
+          const auto* icmp = vstorage->InternalComparator().get();
           assert(f1->largest.seqno > f2->largest.seqno ||
                  // We can have multiple files with seqno = 0 as a result of
                  // using DB::AddFile()
-                 (f1->largest.seqno == 0 && f2->largest.seqno == 0));
+                 (f1->largest.seqno == 0 && f2->largest.seqno == 0) ||
+                 // Subcompactions produce files with the same seqno range, but non
+                 // overlapping key ranges.
+                 (InSameSortedRun(*f1, *f2) &&
+                  (icmp->Compare(f1->largest.key, f2->smallest.key) < 0 ||
+                   icmp->Compare(f2->largest.key, f1->smallest.key) < 0)));
         } else {
           assert(level_nonzero_cmp_(f1, f2));
 
@@ -142,6 +142,16 @@ struct FileMetaData {
   std::string ToString() const;
 };
 
+// Returns true if both level 0 files were produced by the same compaction that was split into
+// subcompactions. Such files have non overlapping key ranges, so together they form a single
+// sorted run. They share the same sequence number range, see
+// CompactionJob::InstallCompactionResults.
+inline bool InSameSortedRun(const FileMetaData& lhs, const FileMetaData& rhs) {
+  // Files added by DB::AddFile have zero sequence numbers, but could overlap.
+  return lhs.largest.seqno != 0 &&
+         lhs.smallest.seqno == rhs.smallest.seqno && lhs.largest.seqno == rhs.largest.seqno;
+}
+
 class VersionEdit {
  public:
   VersionEdit() { Clear(); }
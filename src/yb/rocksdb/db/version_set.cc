@@ -1243,10 +1243,16 @@ void VersionStorageInfo::ComputeCompactionScore(
       // overwrites/deletions).
       int num_sorted_runs = 0;
       uint64_t total_size = 0;
+      const FileMetaData* prev = nullptr;
       for (auto* f : files_[level]) {
         if (!f->being_compacted) {
           total_size += f->compensated_file_size;
-          num_sorted_runs++;
+          // Outputs of subcompactions form a single sorted run in universal compaction.
+          if (compaction_style_ != kCompactionStyleUniversal || !prev ||
+              !InSameSortedRun(*prev, *f)) {
+            num_sorted_runs++;
+          }
+          prev = f;
         }
       }
       if (compaction_style_ == kCompactionStyleUniversal) {
@@ -1880,12 +1886,19 @@ void VersionStorageInfo::CalculateBaseBytes(const ImmutableCFOptions& ioptions,
   // Special logic to set number of sorted runs.
   // It is to match the previous behavior when all files are in L0.
   int num_l0_count = 0;
-  if (options.MaxFileSizeForCompaction() == std::numeric_limits<uint64_t>::max()) {
+  if (options.MaxFileSizeForCompaction() == std::numeric_limits<uint64_t>::max() &&
+      compaction_style_ != kCompactionStyleUniversal) {
     num_l0_count = static_cast<int>(files_[0].size());
   } else {
+    const FileMetaData* prev = nullptr;
     for (const auto& file : files_[0]) {
       if (file->fd.GetTotalFileSize() <= options.MaxFileSizeForCompaction()) {
-        ++num_l0_count;
+        // Outputs of subcompactions form a single sorted run in universal compaction.
+        if (compaction_style_ != kCompactionStyleUniversal || !prev ||
+            !InSameSortedRun(*prev, *file)) {
+          ++num_l0_count;
+        }
+        prev = file;
       }
     }
   }
@@ -94,7 +94,9 @@ enum CompressionType : char {
   kBZip2Compression = 0x3,
   kLZ4Compression = 0x4,
   kLZ4HCCompression = 0x5,
-  // zstd format is not finalized yet so it's subject to changes.
+  kZSTD = 0x7,
+  // Legacy value used before zstd format was finalized. Blocks use the same format as kZSTD and
+  // are still readable, but never use compression dictionary.
   kZSTDNotFinalCompression = 0x40,
 };
 
@@ -166,12 +168,28 @@ struct CompactionOptionsFIFO {
 
 // Compression options for different compression algorithms like Zlib
 struct CompressionOptions {
+  static constexpr int kDefaultCompressionLevel = -1;
+
   int window_bits;
   int level;
   int strategy;
-  CompressionOptions() : window_bits(-14), level(-1), strategy(0) {}
-  CompressionOptions(int wbits, int _lev, int _strategy)
-      : window_bits(wbits), level(_lev), strategy(_strategy) {}
+  // Maximum size of dictionary used to prime compression of data blocks. Dictionary is built
+  // from the first data blocks of SST file and stored in its meta block, so all data blocks of the
+  // file could use it. Only supported by kZSTD.
+  // Default: 0 - dictionary is not used.
+  uint32_t max_dict_bytes;
+  // Maximum size of data blocks used to train dictionary using zstd dictionary trainer. When 0,
+  // raw content of the first data blocks, limited by max_dict_bytes, is used as dictionary.
+  // Data blocks used for training are buffered in memory until dictionary is ready.
+  // Default: 0.
+  uint32_t zstd_max_train_bytes;
+  CompressionOptions()
+      : window_bits(-14), level(kDefaultCompressionLevel), strategy(0), max_dict_bytes(0),
+        zstd_max_train_bytes(0) {}
+  CompressionOptions(int wbits, int _lev, int _strategy, uint32_t _max_dict_bytes = 0,
+                     uint32_t _zstd_max_train_bytes = 0)
+      : window_bits(wbits), level(_lev), strategy(_strategy), max_dict_bytes(_max_dict_bytes),
+        zstd_max_train_bytes(_zstd_max_train_bytes) {}
 };
 
 enum UpdateStatus {    // Return status For inplace update callback
@@ -217,6 +217,10 @@ enum Tickers : uint32_t {
   COMPACTION_FILES_FILTERED,
   COMPACTION_FILES_NOT_FILTERED,
 
+  // # of times bloom filter was not checked, because lookup key does not contain all key
+  // components used by filter.
+  BLOOM_FILTER_NOT_APPLICABLE,
+
   // End of ticker enum.
   TICKER_ENUM_MAX,
 };
@@ -320,6 +324,8 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
 
     {COMPACTION_FILES_FILTERED, "rocksdb_compaction_files_filtered"},
     {COMPACTION_FILES_NOT_FILTERED, "rocksdb_compaction_files_not_filtered"},
+
+    {BLOOM_FILTER_NOT_APPLICABLE, "rocksdb_bloom_filter_not_applicable"},
 };
 
 /**
@@ -80,6 +80,17 @@ YB_DEFINE_ENUM(IndexType,
   (kMultiLevelBinarySearch)
 );
 
+YB_DEFINE_ENUM(DataBlockIndexType,
+  // Point lookups in data block use binary search over restart points.
+  (kDataBlockBinarySearch)
+
+  // Data block additionally contains hash index from user key to restart interval, that is used
+  // by point lookups. Blocks with hash index are readable only by versions that support it.
+  // Only DB::Get benefits from it, so it is not used by DocDB, which reads through iterators
+  // and whose keys end with hybrid time, so they are never looked up by exact match.
+  (kDataBlockBinaryAndHash)
+);
+
 // For advanced user only
 struct BlockBasedTableOptions {
   // @flush_block_policy_factory creates the instances of flush block policy.
@@ -124,6 +135,16 @@ struct BlockBasedTableOptions {
   // If NULL, rocksdb will not use a compressed block cache.
   std::shared_ptr<Cache> block_cache_compressed = nullptr;
 
+  // If non-NULL use the specified cache for index blocks, data index readers and filter blocks
+  // instead of block_cache. It has its own capacity, so scans over data blocks could not evict
+  // metadata that is required by point lookups. Ignored when block_cache is not used.
+  std::shared_ptr<Cache> metadata_block_cache = nullptr;
+
+  // Load data index and blocks of upper levels of multi-level index to the block cache when
+  // table is opened. Index blocks of the lowest level are not loaded, since they are comparable
+  // with the data size.
+  bool warm_up_index_on_open = false;
+
   // Approximate size of user data packed per block, in bytes. Note that the
   // block size specified here corresponds to uncompressed data.  The
   // actual size of the unit read from disk may be smaller if
@@ -168,6 +189,13 @@ struct BlockBasedTableOptions {
   KeyValueEncodingFormat data_block_key_value_encoding_format =
       KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix;
 
+  // Type of index inside data blocks.
+  DataBlockIndexType data_block_index_type = DataBlockIndexType::kDataBlockBinarySearch;
+
+  // Ratio of number of keys to number of hash buckets in data block hash index.
+  // Used only with kDataBlockBinaryAndHash.
+  double data_block_hash_table_util_ratio = 0.75;
+
   // If non-nullptr, use the specified filter policy for new SST files to reduce disk reads.
   // Many applications will benefit from passing the result of
   // NewBloomFilterPolicy() here.
@@ -150,7 +150,8 @@ void BlockIter::Prev() {
 void BlockIter::Initialize(
     const Comparator* comparator, const char* data,
     const KeyValueEncodingFormat key_value_encoding_format, uint32_t restarts,
-    uint32_t num_restarts, BlockHashIndex* hash_index, BlockPrefixIndex* prefix_index) {
+    uint32_t num_restarts, BlockHashIndex* hash_index, BlockPrefixIndex* prefix_index,
+    const DataBlockHashIndex* data_block_hash_index) {
   DCHECK(data_ == nullptr); // Ensure it is called only once
   DCHECK_GT(num_restarts, 0); // Ensure the param is valid
 
@@ -163,6 +164,7 @@ void BlockIter::Initialize(
   restart_index_ = num_restarts_;
   hash_index_ = hash_index;
   prefix_index_ = prefix_index;
+  data_block_hash_index_ = data_block_hash_index;
 }
 
 
@@ -193,6 +195,36 @@ void BlockIter::Seek(const Slice& target) {
   }
 }
 
+void BlockIter::SeekForGet(const Slice& target) {
+  if (data_block_hash_index_ == nullptr) {
+    Seek(target);
+    return;
+  }
+
+  auto entry = data_block_hash_index_->Lookup(ExtractUserKey(target));
+  if (entry == DataBlockHashIndex::kCollision) {
+    Seek(target);
+    return;
+  }
+
+  PERF_TIMER_GUARD(block_seek_nanos);
+  if (entry == DataBlockHashIndex::kNoEntry) {
+    // User key is not present in this block, but the following user keys could be present in the
+    // next block, if all keys in this block are smaller than target. So we scan the last restart
+    // interval to distinguish these cases.
+    entry = static_cast<uint8_t>(num_restarts_ - 1);
+  } else if (entry >= num_restarts_) {
+    CorruptionError(yb::Format(
+        "Bad restart index in data block hash index: $0, num restarts: $1", entry, num_restarts_));
+    return;
+  }
+
+  SeekToRestartPoint(entry);
+  // Linear search (within restart block) for first key >= target.
+  while (ParseNextKey() && Compare(key_.GetKey(), target) < 0) {
+  }
+}
+
 void BlockIter::SeekToFirst() {
   if (data_ == nullptr) {  // Not init yet
     return;
@@ -488,7 +520,7 @@ bool BlockIter::PrefixSeek(const Slice& target, uint32_t* index) {
 
 uint32_t Block::NumRestarts() const {
   assert(size_ >= kMinBlockSize);
-  return DecodeFixed32(data_ + size_ - sizeof(uint32_t));
+  return num_restarts_;
 }
 
 Block::Block(BlockContents&& contents)
@@ -497,15 +529,23 @@ Block::Block(BlockContents&& contents)
       size_(contents_.data.size()) {
   if (size_ < sizeof(uint32_t)) {
     size_ = 0;  // Error marker
-  } else {
-    restart_offset_ =
-        static_cast<uint32_t>(size_) - (1 + NumRestarts()) * sizeof(uint32_t);
-    if (restart_offset_ > size_ - sizeof(uint32_t)) {
-      // The size is too small for NumRestarts() and therefore
-      // restart_offset_ wrapped around.
-      size_ = 0;
-    }
+    return;
+  }
+
+  bool has_hash_index = false;
+  num_restarts_ = DataBlockHashIndex::UnpackFooter(
+      DecodeFixed32(data_ + size_ - sizeof(uint32_t)), &has_hash_index);
+  size_t restarts_end = size_ - sizeof(uint32_t);
+  if (has_hash_index && !data_block_hash_index_.Initialize(data_, restarts_end, &restarts_end)) {
+    size_ = 0;
+    return;
+  }
+  if (num_restarts_ * sizeof(uint32_t) > restarts_end) {
+    // The size is too small for NumRestarts().
+    size_ = 0;
+    return;
   }
+  restart_offset_ = static_cast<uint32_t>(restarts_end - num_restarts_ * sizeof(uint32_t));
 }
 
 InternalIterator* Block::NewIterator(
@@ -532,13 +572,15 @@ InternalIterator* Block::NewIterator(
         total_order_seek ? nullptr : hash_index_.get();
     BlockPrefixIndex* prefix_index_ptr =
         total_order_seek ? nullptr : prefix_index_.get();
+    const DataBlockHashIndex* data_block_hash_index_ptr =
+        data_block_hash_index_.Valid() ? &data_block_hash_index_ : nullptr;
 
     if (iter != nullptr) {
       iter->Initialize(cmp, data_, key_value_encoding_format, restart_offset_, num_restarts,
-                    hash_index_ptr, prefix_index_ptr);
+                    hash_index_ptr, prefix_index_ptr, data_block_hash_index_ptr);
     } else {
       iter = new BlockIter(cmp, data_, key_value_encoding_format, restart_offset_, num_restarts,
-                           hash_index_ptr, prefix_index_ptr);
+                           hash_index_ptr, prefix_index_ptr, data_block_hash_index_ptr);
     }
   }
 
@@ -568,7 +610,7 @@ yb::Result<Slice> Block::GetMiddleKey(
     const KeyValueEncodingFormat key_value_encoding_format) const {
   if (size_ < kMinBlockSize) {
     return BadBlockContentsError();
-  } else if (size_ == kMinBlockSize) {
+  } else if (restart_offset_ == 0) {
     return STATUS(Incomplete, "Empty block");
   }
 
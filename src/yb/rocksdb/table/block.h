@@ -35,6 +35,7 @@
 #include "yb/rocksdb/db/dbformat.h"
 #include "yb/rocksdb/table/block_prefix_index.h"
 #include "yb/rocksdb/table/block_hash_index.h"
+#include "yb/rocksdb/table/data_block_hash_index.h"
 #include "yb/rocksdb/table/format.h"
 #include "yb/rocksdb/table/internal_iterator.h"
 
@@ -65,6 +66,10 @@ class Block {
     return size_;
   }
   uint32_t NumRestarts() const;
+
+  bool HasDataBlockHashIndex() const {
+    return data_block_hash_index_.Valid();
+  }
   CompressionType compression_type() const {
     return contents_.compression_type;
   }
@@ -109,6 +114,8 @@ class Block {
   const char* data_;            // contents_.data.data()
   size_t size_;                 // contents_.data.size()
   uint32_t restart_offset_;     // Offset in data_ of restart array
+  uint32_t num_restarts_ = 0;
+  DataBlockHashIndex data_block_hash_index_;
   std::unique_ptr<BlockHashIndex> hash_index_;
   std::unique_ptr<BlockPrefixIndex> prefix_index_;
 
@@ -128,22 +135,25 @@ class BlockIter : public InternalIterator {
         restart_index_(0),
         status_(Status::OK()),
         hash_index_(nullptr),
-        prefix_index_(nullptr) {}
+        prefix_index_(nullptr),
+        data_block_hash_index_(nullptr) {}
 
   BlockIter(
       const Comparator* comparator, const char* data,
       KeyValueEncodingFormat key_value_encoding_format, uint32_t restarts, uint32_t num_restarts,
-      BlockHashIndex* hash_index, BlockPrefixIndex* prefix_index)
+      BlockHashIndex* hash_index, BlockPrefixIndex* prefix_index,
+      const DataBlockHashIndex* data_block_hash_index = nullptr)
       : BlockIter() {
     Initialize(
         comparator, data, key_value_encoding_format, restarts, num_restarts, hash_index,
-        prefix_index);
+        prefix_index, data_block_hash_index);
   }
 
   void Initialize(
       const Comparator* comparator, const char* data,
       KeyValueEncodingFormat key_value_encoding_format, uint32_t restarts, uint32_t num_restarts,
-      BlockHashIndex* hash_index, BlockPrefixIndex* prefix_index);
+      BlockHashIndex* hash_index, BlockPrefixIndex* prefix_index,
+      const DataBlockHashIndex* data_block_hash_index = nullptr);
 
   void SetStatus(Status s) {
     status_ = s;
@@ -166,6 +176,12 @@ class BlockIter : public InternalIterator {
 
   virtual void Seek(const Slice& target) override;
 
+  // Point lookup version of Seek, target should be an internal key.
+  // If data block hash index is present and target user key is in the block, positions iterator
+  // at the same entry as Seek. Otherwise iterator could be positioned at some entry with a larger
+  // user key, or become invalid if all entries in the block are less than target.
+  void SeekForGet(const Slice& target);
+
   virtual void SeekToFirst() override;
 
   virtual void SeekToLast() override;
@@ -197,6 +213,7 @@ class BlockIter : public InternalIterator {
   Status status_;
   BlockHashIndex* hash_index_;
   BlockPrefixIndex* prefix_index_;
+  const DataBlockHashIndex* data_block_hash_index_;
 
   inline int Compare(const Slice& a, const Slice& b) const {
     return comparator_->Compare(a, b);
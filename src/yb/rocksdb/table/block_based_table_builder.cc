@@ -27,6 +27,7 @@
 #include <inttypes.h>
 #include <stdio.h>
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -106,10 +107,12 @@ bool GoodCompressionRatio(size_t compressed_size, size_t raw_size) {
 }
 
 // format_version is the block format as defined in include/rocksdb/table.h
+// compression_dict is only used by kZSTD compression.
 Slice CompressBlock(const Slice& raw,
                     const CompressionOptions& compression_options,
                     CompressionType* type, uint32_t format_version,
-                    std::string* compressed_output) {
+                    std::string* compressed_output,
+                    const ZSTDCompressionDict* compression_dict) {
   if (*type == kNoCompression) {
     return raw;
   }
@@ -160,6 +163,13 @@ Slice CompressBlock(const Slice& raw,
         return *compressed_output;
       }
       break;     // fall back to no compression.
+    case kZSTD:
+      if (ZSTD_Compress(compression_options, raw.cdata(), raw.size(),
+                        compressed_output, compression_dict) &&
+          GoodCompressionRatio(compressed_output->size(), raw.size())) {
+        return *compressed_output;
+      }
+      break;     // fall back to no compression.
     case kZSTDNotFinalCompression:
       if (ZSTD_Compress(compression_options, raw.cdata(), raw.size(),
                         compressed_output) &&
@@ -304,6 +314,24 @@ struct BlockBasedTableBuilder::Rep {
 
   yb::MemTrackerPtr mem_tracker;
 
+  // When compression dictionary is enabled, data blocks are buffered in memory until enough data
+  // is collected to build dictionary. Then buffered blocks are compressed using this dictionary and
+  // written to file, see BlockBasedTableBuilder::EnterUnbuffered.
+  struct BufferedDataBlock {
+    std::string contents;
+    // Keys of block entries, used to update filter and index when block is written to file.
+    std::vector<std::string> keys;
+  };
+
+  bool buffered = false;
+  std::vector<BufferedDataBlock> buffered_data_blocks;
+  std::vector<std::string> current_block_keys;
+  size_t buffered_data_size = 0;
+  size_t buffered_data_limit = 0;
+  std::string compression_dict;
+  // Digested compression_dict, used to compress data blocks.
+  std::unique_ptr<ZSTDCompressionDict> zstd_compression_dict;
+
   bool TEST_skip_writing_key_value_encoding_format_ = false;
 
   Rep(const ImmutableCFOptions& _ioptions,
@@ -318,6 +346,10 @@ struct BlockBasedTableBuilder::Rep {
       const bool skip_filters);
 
   bool is_split_sst() const { return data_writer != metadata_writer; }
+
+  // Offset in data file where current data block would be written. Buffered blocks are not written
+  // yet, so their uncompressed size is accounted instead.
+  uint64_t logical_data_offset() const { return data_writer->offset + buffered_data_size; }
 };
 
 Status BlockBasedTableBuilder::BlockBasedTablePropertiesCollector::Finish(
@@ -361,7 +393,9 @@ BlockBasedTableBuilder::Rep::Rep(
           _ioptions, table_options, filter_type)),
       data_block_builder(
           table_options.block_restart_interval,
-          table_options.data_block_key_value_encoding_format, table_options.use_delta_encoding),
+          table_options.data_block_key_value_encoding_format, table_options.use_delta_encoding,
+          table_options.data_block_index_type == DataBlockIndexType::kDataBlockBinaryAndHash
+              ? table_options.data_block_hash_table_util_ratio : 0),
       internal_prefix_transform(_ioptions.prefix_extractor),
       filter_key_transformer(table_opt.filter_policy ?
           table_opt.filter_policy->GetKeyTransformer() : nullptr),
@@ -385,6 +419,12 @@ BlockBasedTableBuilder::Rep::Rep(
         "BlockBasedTableBuilder", _ioptions.mem_tracker);
   }
 
+  if (compression_type == kZSTD && compression_opts.max_dict_bytes > 0 && ZSTD_Supported()) {
+    buffered = true;
+    buffered_data_limit = std::max<size_t>(
+        compression_opts.max_dict_bytes, compression_opts.zstd_max_train_bytes);
+  }
+
   metadata_writer = std::make_shared<FileWriterWithOffsetAndCachePrefix>();
   metadata_writer->writer = metadata_file;
   if (data_file != nullptr) {
@@ -462,12 +502,32 @@ void BlockBasedTableBuilder::Add(const Slice& key, const Slice& value) {
     FlushDataBlock(key);
   }
 
+  if (r->buffered) {
+    // Filter and index are updated when buffered block is written to file.
+    r->current_block_keys.push_back(key.ToBuffer());
+  } else {
+    AddKeyToFilterAndIndex(key);
+  }
+
+  r->last_key.assign(key.cdata(), key.size());
+  r->data_block_builder.Add(key, value);
+  r->props.num_entries++;
+  r->props.raw_key_size += key.size();
+  r->props.raw_value_size += value.size();
+
+  NotifyCollectTableCollectorsOnAdd(key, value, r->logical_data_offset(),
+      r->table_properties_collectors,
+      r->ioptions.info_log);
+}
+
+void BlockBasedTableBuilder::AddKeyToFilterAndIndex(const Slice& key) {
+  Rep* const r = rep_;
   if (r->filter_block_builder != nullptr) {
     const Slice user_key = ExtractUserKey(key);
     const Slice filter_key = r->filter_key_transformer ?
         r->filter_key_transformer->Transform(user_key) : user_key;
     if (!filter_key.empty() &&
-        (r->props.num_entries == 0 ||
+        (r->last_filter_key.empty() ||
          BytewiseComparator()->Compare(r->last_filter_key, filter_key) != 0)) {
       // No need to insert duplicate keys into Bloom filter.
       if (r->filter_block_builder->ShouldFlush()) {
@@ -478,31 +538,45 @@ void BlockBasedTableBuilder::Add(const Slice& key, const Slice& value) {
     }
   }
 
-  r->last_key.assign(key.cdata(), key.size());
-  r->data_block_builder.Add(key, value);
-  r->props.num_entries++;
-  r->props.raw_key_size += key.size();
-  r->props.raw_value_size += value.size();
-
   r->data_index_builder->OnKeyAdded(key);
-
-  NotifyCollectTableCollectorsOnAdd(key, value, r->data_writer->offset,
-      r->table_properties_collectors,
-      r->ioptions.info_log);
 }
 
 void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   Rep* const r = rep_;
   assert(!r->closed);
   if (!ok()) return;
-  size_t data_block_size = 0;
 
+  if (r->buffered) {
+    if (!r->data_block_builder.empty()) {
+      const Slice contents = r->data_block_builder.Finish();
+      r->buffered_data_size += contents.size();
+      r->buffered_data_blocks.push_back(Rep::BufferedDataBlock {
+        .contents = contents.ToBuffer(),
+        .keys = std::move(r->current_block_keys),
+      });
+      r->current_block_keys.clear();
+      r->data_block_builder.Reset();
+    }
+    if (r->buffered_data_size >= r->buffered_data_limit) {
+      EnterUnbuffered(next_block_first_key);
+    }
+    return;
+  }
+
+  size_t data_block_size = 0;
   if (!r->data_block_builder.empty()) {
     data_block_size = WriteBlock(&r->data_block_builder, &r->data_pending_handle,
-        r->data_writer.get());
+        r->data_writer.get(), r->zstd_compression_dict.get());
   }
   if (!ok()) return;
 
+  DataBlockWritten(data_block_size, next_block_first_key);
+}
+
+void BlockBasedTableBuilder::DataBlockWritten(
+    size_t data_block_size, const Slice& next_block_first_key) {
+  Rep* const r = rep_;
+
   if (!r->table_options.skip_table_builder_flush) {
     r->status = r->data_writer->writer->Flush();
   }
@@ -542,6 +616,57 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   }
 }
 
+void BlockBasedTableBuilder::EnterUnbuffered(const Slice& next_block_first_key) {
+  Rep* const r = rep_;
+  DCHECK(r->buffered);
+  r->buffered = false;
+
+  const auto& opts = r->compression_opts;
+  if (opts.zstd_max_train_bytes > 0 && ZSTD_TrainDictionarySupported()) {
+    std::string samples;
+    std::vector<size_t> sample_lens;
+    for (const auto& block : r->buffered_data_blocks) {
+      if (samples.size() + block.contents.size() > opts.zstd_max_train_bytes) {
+        break;
+      }
+      samples.append(block.contents);
+      sample_lens.push_back(block.contents.size());
+    }
+    r->compression_dict = ZSTD_TrainDictionary(samples, sample_lens, opts.max_dict_bytes);
+  } else {
+    // Use raw content of the first data blocks as dictionary.
+    for (const auto& block : r->buffered_data_blocks) {
+      const size_t left = opts.max_dict_bytes - r->compression_dict.size();
+      if (left == 0) {
+        break;
+      }
+      r->compression_dict.append(block.contents, 0, std::min(left, block.contents.size()));
+    }
+  }
+  if (!r->compression_dict.empty()) {
+    r->zstd_compression_dict = std::make_unique<ZSTDCompressionDict>(r->compression_dict, opts);
+  }
+
+  auto blocks = std::move(r->buffered_data_blocks);
+  r->buffered_data_blocks.clear();
+  r->buffered_data_size = 0;
+  for (size_t i = 0; i != blocks.size(); ++i) {
+    auto& block = blocks[i];
+    for (const auto& key : block.keys) {
+      AddKeyToFilterAndIndex(key);
+    }
+    const auto data_block_size = WriteBlock(
+        block.contents, &r->data_pending_handle, r->data_writer.get(),
+        r->zstd_compression_dict.get());
+    if (!ok()) return;
+    r->last_key = block.keys.back();
+    DataBlockWritten(
+        data_block_size,
+        i + 1 != blocks.size() ? Slice(blocks[i + 1].keys.front()) : next_block_first_key);
+    if (!ok()) return;
+  }
+}
+
 void BlockBasedTableBuilder::FlushFilterBlock(const Slice* const next_block_first_filter_key) {
   Rep* const r = rep_;
   assert(!r->closed);
@@ -572,15 +697,17 @@ void BlockBasedTableBuilder::FlushFilterBlock(const Slice* const next_block_firs
 
 size_t BlockBasedTableBuilder::WriteBlock(BlockBuilder* block,
                                           BlockHandle* handle,
-                                          FileWriterWithOffsetAndCachePrefix* writer_info) {
-  size_t block_size = WriteBlock(block->Finish(), handle, writer_info);
+                                          FileWriterWithOffsetAndCachePrefix* writer_info,
+                                          const ZSTDCompressionDict* compression_dict) {
+  size_t block_size = WriteBlock(block->Finish(), handle, writer_info, compression_dict);
   block->Reset();
   return block_size;
 }
 
 size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
     BlockHandle* handle,
-    FileWriterWithOffsetAndCachePrefix* writer_info) {
+    FileWriterWithOffsetAndCachePrefix* writer_info,
+    const ZSTDCompressionDict* compression_dict) {
   // File format contains a sequence of blocks where each block has:
   //    block_data: uint8[n]
   //    type: uint8
@@ -593,7 +720,7 @@ size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
   if (raw_block_contents.size() < kCompressionSizeLimit) {
     block_contents =
         CompressBlock(raw_block_contents, r->compression_opts, &type,
-                      r->table_options.format_version, &r->compressed_output);
+                      r->table_options.format_version, &r->compressed_output, compression_dict);
   } else {
     RecordTick(r->ioptions.statistics, NUMBER_BLOCK_NOT_COMPRESSED);
     type = kNoCompression;
@@ -714,6 +841,10 @@ Status BlockBasedTableBuilder::Finish() {
   if (!r->data_block_builder.empty()) {
     FlushDataBlock(end_slice);  // no more data block
   }
+  if (r->buffered) {
+    // Not enough data to fill the buffer, build dictionary from what we have.
+    EnterUnbuffered(end_slice);
+  }
   if (r->filter_block_builder != nullptr) {
     FlushFilterBlock(nullptr);  // no more filter block
   }
@@ -740,6 +871,14 @@ Status BlockBasedTableBuilder::Finish() {
     meta_index_builder.Add(item.first, block_handle);
   }
 
+  if (ok() && !r->compression_dict.empty()) {
+    BlockHandle compression_dict_block_handle;
+    WriteRawBlock(
+        r->compression_dict, kNoCompression, &compression_dict_block_handle,
+        r->metadata_writer.get());
+    meta_index_builder.Add(block_based_table::kCompressionDictBlock, compression_dict_block_handle);
+  }
+
   if (ok()) {
     if (r->filter_block_builder != nullptr) {
       // Add mapping from "<filter_block_prefix>.Name" to location of either filter block or
@@ -862,8 +1001,9 @@ uint64_t BlockBasedTableBuilder::NumEntries() const {
 }
 
 uint64_t BlockBasedTableBuilder::TotalFileSize() const {
-  return rep_->is_split_sst() ? rep_->metadata_writer->offset + rep_->data_writer->offset :
-      rep_->metadata_writer->offset;
+  // Buffered data blocks are not compressed yet, so this is an upper estimate.
+  return (rep_->is_split_sst() ? rep_->metadata_writer->offset + rep_->data_writer->offset :
+      rep_->metadata_writer->offset) + rep_->buffered_data_size;
 }
 
 uint64_t BlockBasedTableBuilder::BaseFileSize() const {
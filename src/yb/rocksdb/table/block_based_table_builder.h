@@ -40,6 +40,7 @@ namespace rocksdb {
 class BlockBuilder;
 class BlockHandle;
 class WritableFile;
+class ZSTDCompressionDict;
 struct BlockBasedTableOptions;
 
 extern const uint64_t kBlockBasedTableMagicNumber;
@@ -111,10 +112,12 @@ class BlockBasedTableBuilder : public TableBuilder {
   // Call block's Finish() method and then write the finalize block contents to
   // file. Returns number of bytes written to file.
   size_t WriteBlock(BlockBuilder* block, BlockHandle* handle,
-                    FileWriterWithOffsetAndCachePrefix* writer_info);
+                    FileWriterWithOffsetAndCachePrefix* writer_info,
+                    const ZSTDCompressionDict* compression_dict = nullptr);
   // Directly write block content to the file. Returns number of bytes written to file.
   size_t WriteBlock(const Slice& block_contents, BlockHandle* handle,
-      FileWriterWithOffsetAndCachePrefix* writer_info);
+      FileWriterWithOffsetAndCachePrefix* writer_info,
+      const ZSTDCompressionDict* compression_dict = nullptr);
   size_t WriteRawBlock(const Slice& data, CompressionType, BlockHandle* handle,
       FileWriterWithOffsetAndCachePrefix* writer_info);
   Status InsertBlockInCache(const Slice& block_contents,
@@ -132,6 +135,16 @@ class BlockBasedTableBuilder : public TableBuilder {
   // REQUIRES: Finish(), Abandon() have not been called.
   void FlushDataBlock(const Slice& next_block_first_key);
 
+  // Updates filter, index and table properties after data block was written to file.
+  void DataBlockWritten(size_t data_block_size, const Slice& next_block_first_key);
+
+  // Adds key of data block entry to filter and index.
+  void AddKeyToFilterAndIndex(const Slice& key);
+
+  // Builds compression dictionary from buffered data blocks, then writes them to file compressed
+  // with this dictionary. Subsequent data blocks are written to file directly.
+  void EnterUnbuffered(const Slice& next_block_first_key);
+
   // Flush the current filter block into disk. next_block_first_filter_key should be nullptr if this
   // is the last block written to disk.
   // REQUIRES: Finish(), Abandon() have not been called.
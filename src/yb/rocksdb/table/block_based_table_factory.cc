@@ -46,6 +46,7 @@ BlockBasedTableFactory::BlockBasedTableFactory(
   }
   if (table_options_.no_block_cache) {
     table_options_.block_cache.reset();
+    table_options_.metadata_block_cache.reset();
   } else if (table_options_.block_cache == nullptr) {
     table_options_.block_cache = NewLRUCache(8 << 20);
   }
@@ -165,6 +166,17 @@ std::string BlockBasedTableFactory::GetPrintableTableOptions() const {
              table_options_.block_cache_compressed->GetCapacity());
     ret.append(buffer);
   }
+  snprintf(buffer, kBufferSize, "  metadata_block_cache: %p\n",
+           table_options_.metadata_block_cache.get());
+  ret.append(buffer);
+  if (table_options_.metadata_block_cache) {
+    snprintf(buffer, kBufferSize, "  metadata_block_cache_size: %" ROCKSDB_PRIszt "\n",
+             table_options_.metadata_block_cache->GetCapacity());
+    ret.append(buffer);
+  }
+  snprintf(buffer, kBufferSize, "  warm_up_index_on_open: %d\n",
+           table_options_.warm_up_index_on_open);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  block_size: %" ROCKSDB_PRIszt "\n",
            table_options_.block_size);
   ret.append(buffer);
@@ -177,6 +189,12 @@ std::string BlockBasedTableFactory::GetPrintableTableOptions() const {
   snprintf(buffer, kBufferSize, "  index_block_restart_interval: %d\n",
            table_options_.index_block_restart_interval);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  data_block_index_type: %d\n",
+           yb::to_underlying(table_options_.data_block_index_type));
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  data_block_hash_table_util_ratio: %lf\n",
+           table_options_.data_block_hash_table_util_ratio);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  filter_policy: %s\n",
            table_options_.filter_policy == nullptr ?
              "nullptr" : table_options_.filter_policy->Name());
@@ -23,6 +23,8 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -54,6 +56,7 @@
 #include "yb/rocksdb/table/two_level_iterator.h"
 
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/compression.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/perf_context_imp.h"
 #include "yb/rocksdb/util/stop_watch.h"
@@ -192,7 +195,10 @@ struct BlockBasedTable::Rep {
         filter_type(FilterType::kNoFilter),
         whole_key_filtering(_table_opt.whole_key_filtering),
         prefix_filtering(true),
-        data_index_load_mode(data_index_load_mode_) {
+        data_index_load_mode(data_index_load_mode_),
+        metadata_block_cache(
+            _table_opt.metadata_block_cache && _table_opt.block_cache
+                ? _table_opt.metadata_block_cache.get() : _table_opt.block_cache.get()) {
     if (ioptions.block_based_table_mem_tracker) {
       mem_tracker = ioptions.block_based_table_mem_tracker;
     } else if (ioptions.mem_tracker) {
@@ -240,6 +246,13 @@ struct BlockBasedTable::Rep {
 
   DataIndexLoadMode data_index_load_mode = static_cast<DataIndexLoadMode>(0);
   yb::MemTrackerPtr mem_tracker;
+
+  // Cache for data index readers, index blocks and filter blocks. It is the same as block cache
+  // unless separate metadata block cache is specified.
+  Cache* const metadata_block_cache;
+
+  // Digested dictionary used to compress data blocks, null if dictionary was not used.
+  std::unique_ptr<ZSTDUncompressionDict> compression_dict;
 };
 
 // BlockEntryIteratorState doesn't actually store any iterator state and is only used as an adapter
@@ -332,6 +345,16 @@ BlockBasedTable::FileReaderWithCachePrefix* BlockBasedTable::GetBlockReader(Bloc
   FATAL_INVALID_ENUM_VALUE(BlockType, block_type);
 }
 
+Cache* BlockBasedTable::GetBlockCache(BlockType block_type) const {
+  switch (block_type) {
+    case BlockType::kData:
+      return rep_->table_options.block_cache.get();
+    case BlockType::kIndex:
+      return rep_->metadata_block_cache;
+  }
+  FATAL_INVALID_ENUM_VALUE(BlockType, block_type);
+}
+
 BloomFilterAwareFileFilter::BloomFilterAwareFileFilter(
     const ReadOptions& read_options, const Slice& user_key)
     : read_options_(read_options), user_key_(user_key.ToBuffer()) {}
@@ -341,6 +364,7 @@ bool BloomFilterAwareFileFilter::Filter(TableReader* reader) const {
   if (table->rep_->filter_type == FilterType::kFixedSizeFilter) {
     const auto filter_key = table->GetFilterKeyFromUserKey(user_key_);
     if (filter_key.empty()) {
+      RecordTick(table->rep_->ioptions.statistics, BLOOM_FILTER_NOT_APPLICABLE);
       return true;
     }
     auto filter_entry = table->GetFilter(read_options_.query_id,
@@ -352,7 +376,7 @@ bool BloomFilterAwareFileFilter::Filter(TableReader* reader) const {
       // Record that the bloom filter was useful.
       RecordTick(table->rep_->ioptions.statistics, BLOOM_FILTER_USEFUL);
     }
-    filter_entry.Release(table->rep_->table_options.block_cache.get());
+    filter_entry.Release(table->rep_->metadata_block_cache);
     return use_file;
   } else {
     // For non fixed-size filters - take file into account. We are only using fixed-size bloom
@@ -425,6 +449,8 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
 
   RETURN_NOT_OK(new_table->SetupFilter(meta_iter.get()));
 
+  RETURN_NOT_OK(new_table->ReadCompressionDictBlock(meta_iter.get()));
+
   if (data_index_load_mode == DataIndexLoadMode::PRELOAD_ON_OPEN) {
     // Will use block cache for data index access?
     if (table_options.cache_index_and_filter_blocks) {
@@ -462,7 +488,7 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
         case FilterType::kBlockBasedFilter: {
           // Hack: Call GetFilter() to implicitly add filter to the block_cache
           auto filter_entry = new_table->GetFilter(kDefaultQueryId);
-          filter_entry.Release(table_options.block_cache.get());
+          filter_entry.Release(rep->metadata_block_cache);
           corrupted_filter_type = false;
           break;
         }
@@ -511,6 +537,17 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
   rep->data_index_iterator_state = std::make_unique<BlockEntryIteratorState>(
       new_table.get(), ReadOptions::kDefault, skip_filters_for_index, BlockType::kIndex);
 
+  if (table_options.warm_up_index_on_open && rep->metadata_block_cache) {
+    // Table could be used without warm up, so just log failure.
+    auto status = new_table->WarmUpIndex();
+    if (!status.ok()) {
+      RLOG(InfoLogLevel::WARN_LEVEL, rep->ioptions.info_log,
+          "Failed to warm up index of %s: %s",
+          rep->base_reader_with_cache_prefix->reader->file()->filename().c_str(),
+          status.ToString().c_str());
+    }
+  }
+
   *table_reader = std::move(new_table);
 
   return Status::OK();
@@ -570,6 +607,29 @@ Status BlockBasedTable::ReadPropertiesBlock(InternalIterator* meta_iter) {
   return Status::OK();
 }
 
+Status BlockBasedTable::ReadCompressionDictBlock(InternalIterator* meta_iter) {
+  BlockHandle compression_dict_handle;
+  if (!FindMetaBlock(
+          meta_iter, block_based_table::kCompressionDictBlock, &compression_dict_handle).ok()) {
+    // Compression dictionary was not used for this file.
+    return Status::OK();
+  }
+  BlockContents compression_dict_block;
+  auto s = ReadBlockContents(
+      rep_->base_reader_with_cache_prefix->reader.get(), rep_->footer, ReadOptions::kDefault,
+      compression_dict_handle, &compression_dict_block, rep_->ioptions.env,
+      rep_->mem_tracker, true /* do_uncompress */);
+  if (!s.ok()) {
+    RLOG(InfoLogLevel::WARN_LEVEL, rep_->ioptions.info_log,
+        "Encountered error while reading compression dictionary block: %s",
+        s.ToString().c_str());
+    return s;
+  }
+  // Dictionary is digested once per file, its content is copied, so block could be released.
+  rep_->compression_dict = std::make_unique<ZSTDUncompressionDict>(compression_dict_block.data);
+  return s;
+}
+
 Status BlockBasedTable::SetupFilter(InternalIterator* meta_iter) {
   // Find filter handle and filter type.
   if (!rep_->filter_policy) {
@@ -756,7 +816,8 @@ Status BlockBasedTable::GetDataBlockFromCache(
     Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
     const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
     uint32_t format_version, BlockType block_type,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker,
+    const ZSTDUncompressionDict* compression_dict) {
   Status s;
   Block* compressed_block = nullptr;
   Cache::Handle* block_cache_compressed_handle = nullptr;
@@ -800,7 +861,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
   // Retrieve the uncompressed contents into a new buffer
   BlockContents contents;
   s = UncompressBlockContents(compressed_block->data(), compressed_block->size(), &contents,
-                              format_version, mem_tracker);
+                              format_version, mem_tracker, compression_dict);
 
   // Insert uncompressed block into block cache
   if (s.ok()) {
@@ -828,7 +889,8 @@ Status BlockBasedTable::PutDataBlockToCache(
     Cache* block_cache, Cache* block_cache_compressed,
     const ReadOptions& read_options, Statistics* statistics,
     CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker,
+    const ZSTDUncompressionDict* compression_dict) {
   assert(raw_block->compression_type() == kNoCompression ||
          block_cache_compressed != nullptr);
 
@@ -837,7 +899,7 @@ Status BlockBasedTable::PutDataBlockToCache(
   BlockContents contents;
   if (raw_block->compression_type() != kNoCompression) {
     s = UncompressBlockContents(raw_block->data(), raw_block->size(), &contents,
-                                format_version, mem_tracker);
+                                format_version, mem_tracker, compression_dict);
   }
   if (!s.ok()) {
     delete raw_block;
@@ -991,7 +1053,7 @@ BlockBasedTable::CachableEntry<FilterBlockReader> BlockBasedTable::GetFilter(
 
   PERF_TIMER_GUARD(read_filter_block_nanos);
 
-  Cache* block_cache = rep_->table_options.block_cache.get();
+  Cache* block_cache = rep_->metadata_block_cache;
   if (rep_->filter_policy == nullptr /* do not use filter */ ||
       block_cache == nullptr /* no block cache at all */) {
     // If we get here, we have:
@@ -1087,7 +1149,7 @@ yb::Result<BlockBasedTable::CachableEntry<IndexReader>> BlockBasedTable::GetInde
   PERF_TIMER_GUARD(read_index_block_nanos);
 
   const bool no_io = read_options.read_tier == kBlockCacheTier;
-  Cache* const block_cache = rep_->table_options.block_cache.get();
+  Cache* const block_cache = rep_->metadata_block_cache;
 
   if (block_cache && (rep_->data_index_load_mode == DataIndexLoadMode::USE_CACHE ||
       rep_->table_options.cache_index_and_filter_blocks)) {
@@ -1152,13 +1214,38 @@ InternalIterator* BlockBasedTable::NewIndexIterator(
   if (index_reader_result->cache_handle) {
     auto iter = new_iter ? new_iter : input_iter;
     iter->RegisterCleanup(
-        &ReleaseCachedEntry, rep_->table_options.block_cache.get(),
-        index_reader_result->cache_handle);
+        &ReleaseCachedEntry, rep_->metadata_block_cache, index_reader_result->cache_handle);
   }
 
   return new_iter;
 }
 
+Status BlockBasedTable::WarmUpIndex() {
+  ReadOptions read_options;
+  // Index is expected to be accessed by many queries, so put it directly to multi touch cache.
+  read_options.query_id = kInMultiTouchId;
+  auto index_reader = VERIFY_RESULT(GetIndexReader(read_options));
+  Status status;
+  // Index blocks of the lowest level address data blocks directly and their total size is
+  // comparable with the data size, so only upper levels are loaded.
+  if (index_reader.value->num_levels() > 2) {
+    std::unique_ptr<InternalIterator> top_level_iter(index_reader.value->NewTopLevelIterator());
+    for (top_level_iter->SeekToFirst(); top_level_iter->Valid(); top_level_iter->Next()) {
+      std::unique_ptr<InternalIterator> block_iter(
+          NewDataBlockIterator(read_options, top_level_iter->value(), BlockType::kIndex));
+      status = block_iter->status();
+      if (!status.ok()) {
+        break;
+      }
+    }
+    if (status.ok()) {
+      status = top_level_iter->status();
+    }
+  }
+  index_reader.Release(rep_->metadata_block_cache);
+  return status;
+}
+
 // Convert an index iterator value (i.e., an encoded BlockHandle)
 // into an iterator over the contents of the corresponding block.
 // If input_iter is null, new a iterator
@@ -1168,7 +1255,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   PERF_TIMER_GUARD(new_table_block_iter_nanos);
 
   const bool no_io = (ro.read_tier == kBlockCacheTier);
-  Cache* block_cache = rep_->table_options.block_cache.get();
+  Cache* block_cache = GetBlockCache(block_type);
   Cache* block_cache_compressed =
       rep_->table_options.block_cache_compressed.get();
   CachableEntry<Block> block;
@@ -1189,6 +1276,9 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   }
 
   FileReaderWithCachePrefix* reader = GetBlockReader(block_type);
+  // Compression dictionary is only used for data blocks.
+  const ZSTDUncompressionDict* compression_dict =
+      block_type == BlockType::kData ? rep_->compression_dict.get() : nullptr;
 
   // If either block cache is enabled, we'll try to read from it.
   if (block_cache != nullptr || block_cache_compressed != nullptr) {
@@ -1209,7 +1299,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
 
     s = GetDataBlockFromCache(
         key, ckey, block_cache, block_cache_compressed, statistics, ro, &block,
-        rep_->table_options.format_version, block_type, rep_->mem_tracker);
+        rep_->table_options.format_version, block_type, rep_->mem_tracker, compression_dict);
 
     if (block.value == nullptr && !no_io && ro.fill_cache) {
       std::unique_ptr<Block> raw_block;
@@ -1217,13 +1307,14 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
         StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
         s = block_based_table::ReadBlockFromFile(
             reader->reader.get(), rep_->footer, ro, handle, &raw_block, rep_->ioptions.env,
-            rep_->mem_tracker, block_cache_compressed == nullptr);
+            rep_->mem_tracker, block_cache_compressed == nullptr, compression_dict);
       }
 
       if (s.ok()) {
         s = PutDataBlockToCache(key, ckey, block_cache, block_cache_compressed,
                                 ro, statistics, &block, raw_block.release(),
-                                rep_->table_options.format_version, rep_->mem_tracker);
+                                rep_->table_options.format_version, rep_->mem_tracker,
+                                compression_dict);
       }
     }
   }
@@ -1242,7 +1333,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
     std::unique_ptr<Block> block_value;
     s = block_based_table::ReadBlockFromFile(
         reader->reader.get(), rep_->footer, ro, handle, &block_value, rep_->ioptions.env,
-        rep_->mem_tracker);
+        rep_->mem_tracker, true /* do_uncompress */, compression_dict);
     if (s.ok()) {
       block.value = block_value.release();
     }
@@ -1363,7 +1454,7 @@ bool BlockBasedTable::PrefixMayMatch(const Slice& internal_key) {
     RecordTick(statistics, BLOOM_FILTER_PREFIX_USEFUL);
   }
 
-  filter_entry.Release(rep_->table_options.block_cache.get());
+  filter_entry.Release(rep_->metadata_block_cache);
   return may_match;
 }
 
@@ -1411,6 +1502,7 @@ Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& intern
       filter_entry =
           GetFilter(read_options.query_id, read_options.read_tier == kBlockCacheTier, &filter_key);
     } else {
+      RecordTick(rep_->ioptions.statistics, BLOOM_FILTER_NOT_APPLICABLE);
       skip_filters = true;
     }
   }
@@ -1467,7 +1559,7 @@ Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& intern
       }
 
       // Call the *saver function on each entry/block until it returns false
-      for (biter.Seek(internal_key); biter.Valid(); biter.Next()) {
+      for (biter.SeekForGet(internal_key); biter.Valid(); biter.Next()) {
         ParsedInternalKey parsed_key;
         if (!ParseInternalKey(biter.key(), &parsed_key)) {
           s = STATUS(Corruption, Slice());
@@ -1485,7 +1577,7 @@ Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& intern
     }
   }
 
-  filter_entry.Release(rep_->table_options.block_cache.get());
+  filter_entry.Release(rep_->metadata_block_cache);
   return s;
 }
 
@@ -1552,7 +1644,8 @@ bool BlockBasedTable::TEST_KeyInCache(const ReadOptions& options,
   Slice ckey;
 
   s = GetDataBlockFromCache(cache_key, ckey, block_cache, nullptr, nullptr, options, &block,
-      rep_->table_options.format_version, BlockType::kData, rep_->mem_tracker);
+      rep_->table_options.format_version, BlockType::kData, rep_->mem_tracker,
+      rep_->compression_dict.get());
   assert(s.ok());
   bool in_cache = block.value != nullptr;
   if (in_cache) {
@@ -1915,7 +2008,7 @@ yb::Result<std::string> BlockBasedTable::GetMiddleKey() {
 
   // TODO: remove this trick after https://github.com/yugabyte/yugabyte-db/issues/4720 is resolved.
   auto se = yb::ScopeExit([this, &index_reader] {
-    index_reader.Release(rep_->table_options.block_cache.get());
+    index_reader.Release(rep_->metadata_block_cache);
   });
 
   const auto index_middle_key = VERIFY_RESULT(index_reader.value->GetMiddleKey());
@@ -1933,4 +2026,54 @@ yb::Result<std::string> BlockBasedTable::GetMiddleKey() {
   return iter->key().ToBuffer();
 }
 
+yb::Result<std::vector<std::string>> BlockBasedTable::GetSplitKeys(size_t num_parts) {
+  std::vector<std::string> result;
+  if (num_parts <= 1) {
+    return result;
+  }
+  auto index_reader = VERIFY_RESULT(GetIndexReader(ReadOptions::kDefault));
+  auto se = yb::ScopeExit([this, &index_reader] {
+    index_reader.Release(rep_->metadata_block_cache);
+  });
+
+  // Entries of the top level index address roughly the same amount of data, so split keys are
+  // picked from it without reading lower index levels.
+  std::unique_ptr<InternalIterator> index_iter(
+      index_reader.value->num_levels() > 1 ? index_reader.value->NewTopLevelIterator()
+                                           : index_reader.value->NewIterator());
+  size_t num_entries = 0;
+  for (index_iter->SeekToFirst(); index_iter->Valid(); index_iter->Next()) {
+    ++num_entries;
+  }
+  RETURN_NOT_OK(index_iter->status());
+  if (num_entries < 2) {
+    return result;
+  }
+  num_parts = std::min(num_parts, num_entries);
+
+  // Keys from the index could be shortened (see GetMiddleKey), so they are replaced with the
+  // first key actually stored in SST file after them.
+  std::unique_ptr<InternalIterator> iter(
+      NewIterator(ReadOptions::kDefault, nullptr, /* skip_filters =*/ true));
+  size_t next_part = 1;
+  size_t entry_idx = 0;
+  for (index_iter->SeekToFirst(); index_iter->Valid() && next_part < num_parts;
+       index_iter->Next(), ++entry_idx) {
+    if (entry_idx < next_part * num_entries / num_parts) {
+      continue;
+    }
+    ++next_part;
+    iter->Seek(index_iter->key());
+    if (!iter->Valid()) {
+      break;
+    }
+    if (result.empty() || iter->key() != Slice(result.back())) {
+      result.push_back(iter->key().ToBuffer());
+    }
+  }
+  RETURN_NOT_OK(index_iter->status());
+  RETURN_NOT_OK(iter->status());
+  return result;
+}
+
 }  // namespace rocksdb
@@ -54,6 +54,7 @@ class Iterator;
 class TableCache;
 class TableReader;
 class WritableFile;
+class ZSTDUncompressionDict;
 struct BlockBasedTableOptions;
 struct EnvOptions;
 struct ReadOptions;
@@ -189,6 +190,8 @@ class BlockBasedTable : public TableReader {
 
   yb::Result<std::string> GetMiddleKey() override;
 
+  yb::Result<std::vector<std::string>> GetSplitKeys(size_t num_parts) override;
+
   ~BlockBasedTable();
 
   bool TEST_filter_block_preloaded() const;
@@ -252,7 +255,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
       const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
       uint32_t format_version, BlockType block_type,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const ZSTDUncompressionDict* compression_dict);
 
   // Put a raw block (maybe compressed) to the corresponding block caches.
   // This method will perform decompression against raw_block if needed and then
@@ -267,7 +271,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed,
       const ReadOptions& read_options, Statistics* statistics,
       CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const ZSTDUncompressionDict* compression_dict);
 
   // Calls (*handle_result)(arg, ...) repeatedly, starting with the entry found
   // after a call to Seek(key), until handle_result returns false.
@@ -292,6 +297,9 @@ class BlockBasedTable : public TableReader {
 
   CHECKED_STATUS SetupFilter(InternalIterator* meta_iter);
 
+  // Loads dictionary used to compress data blocks, if it is present in the file.
+  CHECKED_STATUS ReadCompressionDictBlock(InternalIterator* meta_iter);
+
   // Read the meta block from sst.
   static CHECKED_STATUS ReadMetaBlock(
       Rep* rep, std::unique_ptr<Block>* meta_block, std::unique_ptr<InternalIterator>* iter);
@@ -310,6 +318,12 @@ class BlockBasedTable : public TableReader {
   FileReaderWithCachePrefix* GetBlockReader(BlockType block_type);
   KeyValueEncodingFormat GetKeyValueEncodingFormat(BlockType block_type);
 
+  // Returns block cache that is used for blocks of specified type.
+  Cache* GetBlockCache(BlockType block_type) const;
+
+  // Loads data index and blocks of upper levels of multi-level index to the block cache.
+  CHECKED_STATUS WarmUpIndex();
+
   explicit BlockBasedTable(Rep* rep) : rep_(rep) {}
 
   // Helper functions for DumpTable()
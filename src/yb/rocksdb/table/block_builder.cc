@@ -44,6 +44,8 @@
 //     restarts: uint32[num_restarts]
 //     num_restarts: uint32
 // restarts[i] contains the offset within the block of the ith restart point.
+// If hash index is enabled, it is stored between restarts and num_restarts, and the highest bit
+// of num_restarts is set (see DataBlockHashIndex).
 
 #include "yb/rocksdb/table/block_builder.h"
 
@@ -63,7 +65,7 @@ namespace rocksdb {
 
 BlockBuilder::BlockBuilder(
     int block_restart_interval, const KeyValueEncodingFormat key_value_encoding_format,
-    const bool use_delta_encoding)
+    const bool use_delta_encoding, const double hash_index_util_ratio)
     : block_restart_interval_(block_restart_interval),
       use_delta_encoding_(use_delta_encoding),
       key_value_encoding_format_(key_value_encoding_format),
@@ -72,6 +74,7 @@ BlockBuilder::BlockBuilder(
       finished_(false) {
   assert(block_restart_interval_ >= 1);
   restarts_.push_back(0);       // First restart point is at offset 0
+  hash_index_builder_.Initialize(hash_index_util_ratio);
 }
 
 void BlockBuilder::Reset() {
@@ -81,6 +84,7 @@ void BlockBuilder::Reset() {
   counter_ = 0;
   finished_ = false;
   last_key_.clear();
+  hash_index_builder_.Reset();
 }
 
 size_t BlockBuilder::CurrentSizeEstimate() const {
@@ -89,6 +93,9 @@ size_t BlockBuilder::CurrentSizeEstimate() const {
     // Restarts haven't been flushed to buffer yet.
     size += restarts_.size() * sizeof(uint32_t) +    // Restart array.
             sizeof(uint32_t);                        // Restart array length.
+    if (hash_index_builder_.Valid()) {
+      size += hash_index_builder_.EstimateSize();
+    }
   }
   return size;
 }
@@ -336,7 +343,13 @@ Slice BlockBuilder::Finish() {
   for (size_t i = 0; i < restarts_.size(); i++) {
     PutFixed32(&buffer_, restarts_[i]);
   }
-  PutFixed32(&buffer_, static_cast<uint32_t>(restarts_.size()));
+  auto footer = static_cast<uint32_t>(restarts_.size());
+  if (hash_index_builder_.Valid() &&
+      restarts_.size() <= DataBlockHashIndex::kMaxRestartSupportedByHashIndex) {
+    hash_index_builder_.Finish(&buffer_);
+    footer |= DataBlockHashIndex::kHashIndexFlag;
+  }
+  PutFixed32(&buffer_, footer);
   finished_ = true;
   return Slice(buffer_);
 }
@@ -375,6 +388,14 @@ void BlockBuilder::Add(const Slice& key, const Slice& value) {
     }
   }
 
+  if (hash_index_builder_.Valid()) {
+    // Versions of the same user key within restart interval are indexed once.
+    const auto user_key = ExtractUserKey(key);
+    if (counter_ == 0 || prev_key_piece.empty() || ExtractUserKey(prev_key_piece) != user_key) {
+      hash_index_builder_.Add(user_key, static_cast<uint32_t>(restarts_.size() - 1));
+    }
+  }
+
   DVLOG_WITH_FUNC(4) << "key: " << Slice(key).ToDebugHexString() << " size: " << key.size()
                     << " offset: " << buffer_.size() << " counter: " << counter_;
 
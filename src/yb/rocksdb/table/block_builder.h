@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "yb/rocksdb/types.h"
+#include "yb/rocksdb/table/data_block_hash_index.h"
 
 #include "yb/util/slice.h"
 
@@ -38,9 +39,13 @@ class BlockBuilder {
   BlockBuilder(const BlockBuilder&) = delete;
   void operator=(const BlockBuilder&) = delete;
 
+  // hash_index_util_ratio - if positive, hash index from user key to restart interval is built,
+  // see DataBlockHashIndex. Should be used only for data blocks, since keys are expected to be
+  // internal keys.
   explicit BlockBuilder(int block_restart_interval,
                         KeyValueEncodingFormat key_value_encoding_format,
-                        bool use_delta_encoding = true);
+                        bool use_delta_encoding = true,
+                        double hash_index_util_ratio = 0);
 
   // Reset the contents as if the BlockBuilder was just constructed.
   void Reset();
@@ -78,6 +83,7 @@ class BlockBuilder {
   int                   counter_;   // Number of entries emitted since restart
   bool                  finished_;  // Has Finish() been called?
   std::string           last_key_;
+  DataBlockHashIndexBuilder hash_index_builder_;
 };
 
 }  // namespace rocksdb
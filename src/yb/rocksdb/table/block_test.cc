@@ -660,6 +660,108 @@ TEST_F(BlockTest, EncodeThreeSharedParts) {
   }
 }
 
+namespace {
+
+// Builds data block from user keys, each user key has specified number of versions with sequence
+// numbers from num_versions down to 1.
+std::string BuildDataBlock(
+    const KeyValueEncodingFormat key_value_encoding_format, const std::vector<std::string>& keys,
+    int num_versions, double hash_index_util_ratio) {
+  BlockBuilder builder(
+      /* block_restart_interval = */ 4, key_value_encoding_format,
+      /* use_delta_encoding = */ true, hash_index_util_ratio);
+  for (const auto& key : keys) {
+    for (int seq = num_versions; seq > 0; --seq) {
+      builder.Add(InternalKey(key, seq, kTypeValue).Encode(), key + std::to_string(seq));
+    }
+  }
+  return builder.Finish().ToBuffer();
+}
+
+// Checks that SeekForGet finds the same entry as Seek, when entry has target user key.
+void CheckSeekForGet(
+    const KeyValueEncodingFormat key_value_encoding_format, const Comparator* comparator,
+    Block* block, const Slice& user_key, SequenceNumber seq) {
+  const auto target = InternalKey(user_key, seq, kValueTypeForSeek);
+  std::unique_ptr<InternalIterator> seek_iter(
+      block->NewIterator(comparator, key_value_encoding_format));
+  BlockIter get_iter;
+  block->NewIterator(comparator, key_value_encoding_format, &get_iter);
+
+  seek_iter->Seek(target.Encode());
+  get_iter.SeekForGet(target.Encode());
+  ASSERT_OK(get_iter.status());
+  if (seek_iter->Valid() && ExtractUserKey(seek_iter->key()) == user_key) {
+    ASSERT_TRUE(get_iter.Valid()) << user_key.ToDebugString() << "@" << seq;
+    ASSERT_EQ(seek_iter->key(), get_iter.key());
+    ASSERT_EQ(seek_iter->value(), get_iter.value());
+  } else if (get_iter.Valid()) {
+    ASSERT_NE(ExtractUserKey(get_iter.key()), user_key);
+    ASSERT_GT(comparator->Compare(get_iter.key(), target.Encode()), 0);
+  } else {
+    // Iterator could become invalid only if all keys in the block are less than target.
+    ASSERT_FALSE(seek_iter->Valid());
+  }
+}
+
+} // namespace
+
+TEST_F(BlockTest, DataBlockHashIndex) {
+  constexpr int kNumKeys = 200;
+  constexpr int kNumVersions = 3;
+  InternalKeyComparator comparator(BytewiseComparator());
+
+  std::vector<std::string> keys;
+  for (int i = 0; i < kNumKeys; ++i) {
+    // Only even keys are present in block.
+    keys.push_back("k" + GetPaddedNum(i * 2));
+  }
+
+  for (auto key_value_encoding_format : kKeyValueEncodingFormatList) {
+    for (double util_ratio : {0.0, 0.75, 4.0}) {
+      BlockContents contents;
+      const auto data = BuildDataBlock(key_value_encoding_format, keys, kNumVersions, util_ratio);
+      contents.data = data;
+      contents.cachable = false;
+      Block block(std::move(contents));
+      ASSERT_EQ(block.HasDataBlockHashIndex(), util_ratio > 0);
+
+      // Iteration should not be affected by hash index.
+      std::unique_ptr<InternalIterator> iter(
+          block.NewIterator(&comparator, key_value_encoding_format));
+      int count = 0;
+      for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+        ++count;
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(count, kNumKeys * kNumVersions);
+
+      for (int i = -1; i <= kNumKeys * 2; ++i) {
+        const auto user_key = "k" + GetPaddedNum(i);
+        for (SequenceNumber seq = 0; seq <= kNumVersions + 1; ++seq) {
+          ASSERT_NO_FATALS(CheckSeekForGet(
+              key_value_encoding_format, &comparator, &block, user_key, seq));
+        }
+      }
+    }
+  }
+}
+
+TEST_F(BlockTest, DataBlockHashIndexTooManyRestarts) {
+  std::vector<std::string> keys;
+  for (uint32_t i = 0; i < DataBlockHashIndex::kMaxRestartSupportedByHashIndex * 4 + 1; ++i) {
+    keys.push_back("k" + GetPaddedNum(i));
+  }
+  BlockContents contents;
+  const auto data = BuildDataBlock(
+      KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix, keys, /* num_versions = */ 1, 0.75);
+  contents.data = data;
+  contents.cachable = false;
+  Block block(std::move(contents));
+  ASSERT_FALSE(block.HasDataBlockHashIndex());
+  ASSERT_EQ(block.NumRestarts(), DataBlockHashIndex::kMaxRestartSupportedByHashIndex + 1);
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char **argv) {
@@ -0,0 +1,93 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/table/data_block_hash_index.h"
+
+#include <algorithm>
+
+#include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/hash.h"
+
+#include "yb/util/cast.h"
+#include "yb/util/logging.h"
+
+namespace rocksdb {
+
+constexpr uint8_t DataBlockHashIndex::kNoEntry;
+constexpr uint8_t DataBlockHashIndex::kCollision;
+constexpr uint32_t DataBlockHashIndex::kMaxRestartSupportedByHashIndex;
+constexpr uint32_t DataBlockHashIndex::kHashIndexFlag;
+
+bool DataBlockHashIndex::Initialize(const char* data, size_t size, size_t* map_offset) {
+  if (size < sizeof(uint32_t)) {
+    return false;
+  }
+  const auto num_buckets = DecodeFixed32(data + size - sizeof(uint32_t));
+  if (num_buckets == 0 || num_buckets > size - sizeof(uint32_t)) {
+    return false;
+  }
+  *map_offset = size - sizeof(uint32_t) - num_buckets;
+  buckets_ = pointer_cast<const uint8_t*>(data + *map_offset);
+  num_buckets_ = num_buckets;
+  return true;
+}
+
+uint8_t DataBlockHashIndex::Lookup(const Slice& user_key) const {
+  return buckets_[GetSliceHash(user_key) % num_buckets_];
+}
+
+void DataBlockHashIndexBuilder::Initialize(double util_ratio) {
+  valid_ = util_ratio > 0;
+  util_ratio_ = util_ratio;
+}
+
+void DataBlockHashIndexBuilder::Add(const Slice& user_key, uint32_t restart_index) {
+  if (restart_index >= DataBlockHashIndex::kMaxRestartSupportedByHashIndex) {
+    valid_ = false;
+    return;
+  }
+  hash_and_restart_index_.emplace_back(
+      GetSliceHash(user_key), static_cast<uint8_t>(restart_index));
+}
+
+uint32_t DataBlockHashIndexBuilder::NumBuckets() const {
+  // Odd number of buckets gives better distribution of hashes.
+  return static_cast<uint32_t>(hash_and_restart_index_.size() / util_ratio_) | 1;
+}
+
+size_t DataBlockHashIndexBuilder::EstimateSize() const {
+  return NumBuckets() + sizeof(uint32_t);
+}
+
+void DataBlockHashIndexBuilder::Finish(std::string* buffer) {
+  DCHECK(valid_);
+  const auto num_buckets = NumBuckets();
+  std::vector<uint8_t> buckets(num_buckets, DataBlockHashIndex::kNoEntry);
+  for (const auto& hash_and_restart_index : hash_and_restart_index_) {
+    auto& bucket = buckets[hash_and_restart_index.first % num_buckets];
+    if (bucket == DataBlockHashIndex::kNoEntry) {
+      bucket = hash_and_restart_index.second;
+    } else if (bucket != hash_and_restart_index.second) {
+      bucket = DataBlockHashIndex::kCollision;
+    }
+  }
+  buffer->append(pointer_cast<const char*>(buckets.data()), buckets.size());
+  PutFixed32(buffer, num_buckets);
+}
+
+void DataBlockHashIndexBuilder::Reset() {
+  valid_ = util_ratio_ > 0;
+  hash_and_restart_index_.clear();
+}
+
+}  // namespace rocksdb
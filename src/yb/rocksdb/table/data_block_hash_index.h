@@ -0,0 +1,105 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_ROCKSDB_TABLE_DATA_BLOCK_HASH_INDEX_H
+#define YB_ROCKSDB_TABLE_DATA_BLOCK_HASH_INDEX_H
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "yb/util/slice.h"
+
+namespace rocksdb {
+
+// Optional hash index appended to data block, that maps user key to restart interval containing
+// it. It allows point lookup (BlockBasedTable::Get) to avoid binary search over restart points.
+//
+// Data block layout with hash index:
+//   <entries>
+//   restarts: uint32[num_restarts]
+//   buckets: uint8[num_buckets]
+//   num_buckets: uint32
+//   footer: uint32 - num_restarts with the highest bit set.
+//
+// Blocks without hash index have footer equal to num_restarts, and the highest bit is never set
+// for them, so old SST files are read as before.
+//
+// Each bucket contains either restart index of the only user key hashed to this bucket,
+// kNoEntry if there are no such keys, or kCollision if there are several keys from different
+// restart intervals, or a key that spans several restart intervals. In the latter case reader
+// falls back to binary search.
+class DataBlockHashIndex {
+ public:
+  static constexpr uint8_t kNoEntry = 255;
+  static constexpr uint8_t kCollision = 254;
+  static constexpr uint32_t kMaxRestartSupportedByHashIndex = 253;
+  static constexpr uint32_t kHashIndexFlag = 1u << 31;
+
+  // Splits block footer into number of restarts and whether block has hash index.
+  static uint32_t UnpackFooter(uint32_t footer, bool* has_hash_index) {
+    *has_hash_index = (footer & kHashIndexFlag) != 0;
+    return footer & ~kHashIndexFlag;
+  }
+
+  // Initializes index from block data, where size is offset of the block footer.
+  // Returns false if data is corrupted. Otherwise sets *map_offset to the start of buckets.
+  bool Initialize(const char* data, size_t size, size_t* map_offset);
+
+  // Returns restart index for user_key, kNoEntry or kCollision.
+  uint8_t Lookup(const Slice& user_key) const;
+
+  bool Valid() const {
+    return buckets_ != nullptr;
+  }
+
+  uint32_t num_buckets() const {
+    return num_buckets_;
+  }
+
+ private:
+  const uint8_t* buckets_ = nullptr;
+  uint32_t num_buckets_ = 0;
+};
+
+class DataBlockHashIndexBuilder {
+ public:
+  // util_ratio - expected ratio of number of keys to number of buckets.
+  void Initialize(double util_ratio);
+
+  bool Valid() const {
+    return valid_;
+  }
+
+  void Add(const Slice& user_key, uint32_t restart_index);
+
+  // Appends buckets and number of buckets to buffer.
+  void Finish(std::string* buffer);
+
+  // Estimated size of data that will be appended by Finish.
+  size_t EstimateSize() const;
+
+  void Reset();
+
+ private:
+  uint32_t NumBuckets() const;
+
+  bool valid_ = false;
+  double util_ratio_ = 0;
+  std::vector<std::pair<uint32_t, uint8_t>> hash_and_restart_index_;
+};
+
+}  // namespace rocksdb
+
+#endif // YB_ROCKSDB_TABLE_DATA_BLOCK_HASH_INDEX_H
@@ -40,6 +40,7 @@ class MemTracker;
 namespace rocksdb {
 
 class Block;
+class ZSTDUncompressionDict;
 struct ReadOptions;
 
 // the length of the magic number in bytes.
@@ -250,13 +251,16 @@ struct BlockContents {
 
 // Read the block identified by "handle" from "file".  On failure
 // return non-OK.  On success fill *result and return OK.
+// compression_dict is used to uncompress block, it should be the same dictionary that was used to
+// compress it.
 extern Status ReadBlockContents(RandomAccessFileReader* file,
                                 const Footer& footer,
                                 const ReadOptions& options,
                                 const BlockHandle& handle,
                                 BlockContents* contents, Env* env,
                                 const std::shared_ptr<yb::MemTracker>& mem_tracker,
-                                bool do_uncompress);
+                                bool do_uncompress,
+                                const ZSTDUncompressionDict* compression_dict = nullptr);
 
 // The 'data' points to the raw block contents read in from file.
 // This method allocates a new heap buffer and the raw block
@@ -268,7 +272,8 @@ extern Status ReadBlockContents(RandomAccessFileReader* file,
 extern Status UncompressBlockContents(const char* data, size_t n,
                                       BlockContents* contents,
                                       uint32_t compress_format_version,
-                                      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+                                      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                                      const ZSTDUncompressionDict* compression_dict = nullptr);
 
 // Implementation details follow.  Clients should ignore,
 
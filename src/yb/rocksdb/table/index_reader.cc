@@ -305,6 +305,11 @@ InternalIterator* MultiLevelIndexReader::NewIterator(
       index_iterator_state, top_level_iter, num_levels_, top_level_iter != iter);
 }
 
+InternalIterator* MultiLevelIndexReader::NewTopLevelIterator() {
+  return top_level_index_block_->NewIndexIterator(
+      comparator_.get(), nullptr /* iter */, true /* total_order_seek */);
+}
+
 Result<Slice> MultiLevelIndexReader::GetMiddleKey() {
   return top_level_index_block_->GetMiddleKey(kIndexBlockKeyValueEncodingFormat);
 }
@@ -62,6 +62,13 @@ class IndexReader {
   // written into the index (see ShortenedIndexBuilder).
   virtual Result<Slice> GetMiddleKey() = 0;
 
+  // Number of index levels, including top level.
+  virtual int num_levels() const { return 1; }
+
+  // For multi-level index returns new iterator over top level index block, values of which are
+  // handles of index blocks of the next level. Returns nullptr for single level index.
+  virtual InternalIterator* NewTopLevelIterator() { return nullptr; }
+
   // The size of the index.
   virtual size_t size() const = 0;
   // Memory usage of the index block
@@ -201,6 +208,10 @@ class MultiLevelIndexReader : public IndexReader {
 
   Result<Slice> GetMiddleKey() override;
 
+  int num_levels() const override { return num_levels_; }
+
+  InternalIterator* NewTopLevelIterator() override;
+
  private:
   size_t size() const override { return top_level_index_block_->size(); }
 
@@ -25,6 +25,8 @@
 #define YB_ROCKSDB_TABLE_TABLE_READER_H
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "yb/util/slice.h"
 
@@ -120,6 +122,12 @@ class TableReader {
   virtual yb::Result<std::string> GetMiddleKey() {
     return STATUS(NotSupported, "GetMiddleKey() not supported");
   }
+
+  // Returns up to num_parts - 1 keys in increasing order, that divide SST file into num_parts
+  // parts of roughly the same size. Could return less keys for small files.
+  virtual yb::Result<std::vector<std::string>> GetSplitKeys(size_t num_parts) {
+    return STATUS(NotSupported, "GetSplitKeys() not supported");
+  }
 };
 
 }  // namespace rocksdb
@@ -277,6 +277,8 @@ DEFINE_bool(through_db, false, "If enable, a DB instance will be created and "
 DEFINE_bool(mmap_read, true, "Whether use mmap read");
 DEFINE_string(table_factory, "block_based",
               "Table factory to use: `block_based` (default) or `plain_table`.");
+DEFINE_bool(data_block_hash_index, false,
+            "Whether to build hash index in data blocks of block based table.");
 DEFINE_string(time_unit, "microsecond",
               "The time unit used for measuring performance. User can specify "
               "`microsecond` (default) or `nanosecond`");
@@ -310,7 +312,12 @@ int main(int argc, char** argv) {
     options.prefix_extractor.reset(rocksdb::NewFixedPrefixTransform(
         FLAGS_prefix_len));
   } else if (FLAGS_table_factory == "block_based") {
-    tf.reset(new rocksdb::BlockBasedTableFactory());
+    rocksdb::BlockBasedTableOptions table_options;
+    if (FLAGS_data_block_hash_index) {
+      table_options.data_block_index_type =
+          rocksdb::DataBlockIndexType::kDataBlockBinaryAndHash;
+    }
+    tf.reset(new rocksdb::BlockBasedTableFactory(table_options));
   } else {
     fprintf(stderr, "Invalid table type %s\n", FLAGS_table_factory.c_str());
   }
@@ -302,7 +302,7 @@ class TableConstructor: public Constructor {
                             internal_comparator,
                             int_tbl_prop_collector_factories,
                             options.compression,
-                            CompressionOptions(),
+                            options.compression_opts,
                             /* skip_filters */ false),
         TablePropertiesCollectorFactory::Context::kUnknownColumnFamily,
         file_writer_.get()));
@@ -578,6 +578,8 @@ static std::vector<TestArgs> GenerateArgList() {
     compression_types.emplace_back(kLZ4HCCompression, true);
   }
   if (ZSTD_Supported()) {
+    compression_types.emplace_back(kZSTD, false);
+    compression_types.emplace_back(kZSTD, true);
     compression_types.emplace_back(kZSTDNotFinalCompression, false);
     compression_types.emplace_back(kZSTDNotFinalCompression, true);
   }
@@ -2028,6 +2030,52 @@ TEST_F(BlockBasedTableTest, BlockCacheLeak) {
   }
 }
 
+TEST_F(BlockBasedTableTest, MetadataBlockCache) {
+  Options opt;
+  auto ikc = std::make_shared<test::PlainInternalKeyComparator>(opt.comparator);
+  opt.compression = kNoCompression;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 256;
+  table_options.index_type = IndexType::kMultiLevelBinarySearch;
+  table_options.min_keys_per_index_block = 2;
+  table_options.index_block_size = 64;
+  table_options.cache_index_and_filter_blocks = true;
+  table_options.block_cache = NewLRUCache((16 * 1024 * 1024) / FLAGS_cache_single_touch_ratio);
+  table_options.metadata_block_cache =
+      NewLRUCache((16 * 1024 * 1024) / FLAGS_cache_single_touch_ratio);
+  table_options.warm_up_index_on_open = true;
+  opt.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  TableConstructor c(BytewiseComparator());
+  for (int i = 1000; i != 2000; ++i) {
+    c.Add("k" + std::to_string(i), std::string(100, 'x'));
+  }
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  const ImmutableCFOptions ioptions(opt);
+  c.Finish(opt, ioptions, table_options, ikc, &keys, &kvmap);
+
+  // Only index is loaded on open, and it goes to metadata block cache.
+  ASSERT_EQ(0, table_options.block_cache->GetUsage());
+  const auto warmed_up_usage = table_options.metadata_block_cache->GetUsage();
+  ASSERT_GT(warmed_up_usage, 0);
+
+  {
+    unique_ptr<InternalIterator> iter(c.NewIterator());
+    size_t num_keys = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ++num_keys;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(keys.size(), num_keys);
+  }
+
+  // Data blocks are stored in block cache, while index blocks of the lowest level are stored in
+  // metadata block cache.
+  ASSERT_GT(table_options.block_cache->GetUsage(), 0);
+  ASSERT_GT(table_options.metadata_block_cache->GetUsage(), warmed_up_usage);
+}
+
 // Plain table is not supported in ROCKSDB_LITE
 #ifndef ROCKSDB_LITE
 TEST_F(PlainTableTest, BasicPlainTableProperties) {
@@ -2179,6 +2227,182 @@ TEST_F(GeneralTableTest, ApproximateOffsetOfCompressed) {
   }
 }
 
+namespace {
+
+// Builds table with small data blocks, similar to DocDB ones, and returns total size of data
+// blocks. Also checks that all entries could be read back.
+uint64_t BuildTableWithCompressionDict(
+    uint32_t max_dict_bytes, uint32_t zstd_max_train_bytes) {
+  Random rnd(301);
+  TableConstructor c(BytewiseComparator());
+  std::string random_tmp;
+  std::string compressible_tmp;
+  for (int i = 0; i != 20000; ++i) {
+    char key[64];
+    snprintf(key, sizeof(key), "table_id_%04d_row_%08d_column_%02d", i % 7, i, i % 13);
+    const auto random_part = RandomString(&rnd, 8, &random_tmp);
+    const auto compressible_part = CompressibleString(&rnd, 0.5, 32, &compressible_tmp);
+    c.Add(key, "value_" + std::to_string(i % 1000) + random_part.ToBuffer() +
+        compressible_part.ToBuffer());
+  }
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  Options options;
+  auto ikc = std::make_shared<test::PlainInternalKeyComparator>(options.comparator);
+  options.compression = kZSTD;
+  options.compression_opts.max_dict_bytes = max_dict_bytes;
+  options.compression_opts.zstd_max_train_bytes = zstd_max_train_bytes;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1024;
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options, ikc, &keys, &kvmap);
+
+  std::unique_ptr<InternalIterator> iter(c.NewIterator());
+  iter->SeekToFirst();
+  for (const auto& kv : kvmap) {
+    EXPECT_TRUE(iter->Valid());
+    EXPECT_EQ(kv.first, iter->key().ToBuffer());
+    EXPECT_EQ(kv.second, iter->value().ToBuffer());
+    iter->Next();
+  }
+  EXPECT_FALSE(iter->Valid());
+  EXPECT_OK(iter->status());
+
+  return c.GetTableProperties().data_size;
+}
+
+} // namespace
+
+TEST_F(GeneralTableTest, ZstdCompressionDictionary) {
+  if (!ZSTD_Supported()) {
+    fprintf(stderr, "skipping zstd compression dictionary tests\n");
+    return;
+  }
+
+  const auto no_dict_size = BuildTableWithCompressionDict(0, 0);
+  const auto raw_dict_size = BuildTableWithCompressionDict(16 * 1024, 0);
+  LOG(INFO) << "Data size without dictionary: " << no_dict_size
+            << ", with raw dictionary: " << raw_dict_size;
+  ASSERT_LT(raw_dict_size, no_dict_size);
+
+  if (ZSTD_TrainDictionarySupported()) {
+    const auto trained_dict_size = BuildTableWithCompressionDict(16 * 1024, 256 * 1024);
+    LOG(INFO) << "Data size with trained dictionary: " << trained_dict_size;
+    // Dictionary training could fail on unlucky samples, in this case dictionary is not used.
+    ASSERT_LE(trained_dict_size, no_dict_size);
+  }
+}
+
+namespace {
+
+// Records file size reported to collector for every added entry.
+class FileSizeRecordingCollector : public IntTblPropCollector {
+ public:
+  explicit FileSizeRecordingCollector(std::vector<uint64_t>* file_sizes)
+      : file_sizes_(file_sizes) {}
+
+  Status Finish(UserCollectedProperties* /* properties */) override {
+    return Status::OK();
+  }
+
+  const char* Name() const override {
+    return "FileSizeRecordingCollector";
+  }
+
+  Status InternalAdd(
+      const Slice& /* key */, const Slice& /* value */, uint64_t file_size) override {
+    file_sizes_->push_back(file_size);
+    return Status::OK();
+  }
+
+  UserCollectedProperties GetReadableProperties() const override {
+    return UserCollectedProperties();
+  }
+
+ private:
+  std::vector<uint64_t>* file_sizes_;
+};
+
+class FileSizeRecordingCollectorFactory : public IntTblPropCollectorFactory {
+ public:
+  explicit FileSizeRecordingCollectorFactory(std::vector<uint64_t>* file_sizes)
+      : file_sizes_(file_sizes) {}
+
+  IntTblPropCollector* CreateIntTblPropCollector(uint32_t /* column_family_id */) override {
+    return new FileSizeRecordingCollector(file_sizes_);
+  }
+
+  const char* Name() const override {
+    return "FileSizeRecordingCollectorFactory";
+  }
+
+ private:
+  std::vector<uint64_t>* file_sizes_;
+};
+
+} // namespace
+
+// Data blocks are buffered until compression dictionary is built, collectors should still see
+// offsets that grow with added data.
+TEST_F(GeneralTableTest, ZstdCompressionDictionaryCollectorOffsets) {
+  if (!ZSTD_Supported()) {
+    fprintf(stderr, "skipping zstd compression dictionary tests\n");
+    return;
+  }
+
+  constexpr size_t kNumEntries = 2000;
+  constexpr uint32_t kMaxDictBytes = 16 * 1024;
+  Options options;
+  options.compression = kZSTD;
+  options.compression_opts.max_dict_bytes = kMaxDictBytes;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1024;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  const ImmutableCFOptions ioptions(options);
+  auto ikc = std::make_shared<InternalKeyComparator>(options.comparator);
+
+  std::vector<uint64_t> file_sizes;
+  IntTblPropCollectorFactories int_tbl_prop_collector_factories;
+  int_tbl_prop_collector_factories.emplace_back(
+      std::make_unique<FileSizeRecordingCollectorFactory>(&file_sizes));
+  unique_ptr<WritableFileWriter> file_writer(
+      test::GetWritableFileWriter(new test::StringSink()));
+  std::unique_ptr<TableBuilder> builder(ioptions.table_factory->NewTableBuilder(
+      TableBuilderOptions(ioptions,
+                          ikc,
+                          int_tbl_prop_collector_factories,
+                          options.compression,
+                          options.compression_opts,
+                          /* skip_filters */ false),
+      TablePropertiesCollectorFactory::Context::kUnknownColumnFamily,
+      file_writer.get()));
+
+  Random rnd(301);
+  std::string value;
+  size_t added_bytes = 0;
+  size_t last_buffered_entry = 0;
+  for (size_t i = 0; i != kNumEntries; ++i) {
+    char key[32];
+    snprintf(key, sizeof(key), "row_%08zu", i);
+    InternalKey ikey(key, kMaxSequenceNumber, kTypeValue);
+    builder->Add(ikey.Encode(), RandomString(&rnd, 100, &value));
+    ASSERT_OK(builder->status());
+    added_bytes += ikey.Encode().size() + value.size();
+    if (added_bytes < kMaxDictBytes / 2) {
+      last_buffered_entry = i;
+    }
+  }
+  ASSERT_OK(builder->Finish());
+
+  ASSERT_EQ(file_sizes.size(), kNumEntries);
+  for (size_t i = 1; i != file_sizes.size(); ++i) {
+    ASSERT_LE(file_sizes[i - 1], file_sizes[i]) << "Entry: " << i;
+  }
+  // Nothing was written to file while this entry was added, but several blocks were already
+  // completed.
+  ASSERT_GT(file_sizes[last_buffered_entry], 0);
+}
+
 TEST_F(HarnessTest, Randomized) {
 #if defined(THREAD_SANITIZER)
   static constexpr int kMaxNumEntries = 200;
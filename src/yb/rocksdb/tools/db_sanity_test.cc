@@ -196,7 +196,7 @@ class SanityTestZSTDCompression : public SanityTest {
  public:
   explicit SanityTestZSTDCompression(const std::string& path)
       : SanityTest(path) {
-    options_.compression = kZSTDNotFinalCompression;
+    options_.compression = kZSTD;
   }
   Options GetOptions() const override { return options_; }
   std::string Name() const override { return "ZSTDCompression"; }
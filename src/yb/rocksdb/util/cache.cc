@@ -995,9 +995,10 @@ class ShardedLRUCache : public Cache {
     }
   }
 
-  virtual void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) override {
+  virtual void SetMetrics(
+      const scoped_refptr<yb::MetricEntity>& entity, yb::CacheMetricsKind kind) override {
     int num_shards = 1 << num_shard_bits_;
-    metrics_ = std::make_shared<yb::CacheMetrics>(entity);
+    metrics_ = std::make_shared<yb::CacheMetrics>(entity, kind);
     for (int s = 0; s < num_shards; s++) {
       shards_[s].SetMetrics(metrics_);
     }
@@ -32,6 +32,10 @@ int main() {
 #include <inttypes.h>
 #include <sys/types.h>
 #include <stdio.h>
+
+#include <algorithm>
+#include <atomic>
+
 #include <gflags/gflags.h>
 
 #include "yb/rocksdb/db.h"
@@ -60,13 +64,33 @@ DEFINE_int32(lookup_percent, 50,
              "Ratio of lookup to total workload (expressed as a percentage)");
 DEFINE_int32(erase_percent, 10,
              "Ratio of erase to total workload (expressed as a percentage)");
+DEFINE_int32(scan_percent, 0,
+             "Ratio of scans to total workload (expressed as a percentage). Scan reads "
+             "scan_length consecutive keys, inserting missing ones, like iterator does with "
+             "data blocks.");
+DEFINE_int32(scan_length, 1000, "Number of keys read by a single scan.");
+DEFINE_int32(hot_key_percent, 100,
+             "Lookups access only this percent of the key space, scans access the whole key "
+             "space. Lookups insert missing keys when it is less than 100.");
+DEFINE_string(cache_type, "lru", "Cache implementation to use: lru or clock.");
 
 namespace rocksdb {
 
 class CacheBench;
 namespace {
 void deleter(const Slice& key, void* value) {
-    delete reinterpret_cast<char *>(value);
+    delete[] reinterpret_cast<char *>(value);
+}
+
+std::shared_ptr<Cache> NewCache() {
+  if (FLAGS_cache_type == "clock") {
+    return NewClockCache(FLAGS_cache_size, FLAGS_num_shard_bits);
+  }
+  if (FLAGS_cache_type != "lru") {
+    fprintf(stderr, "Unknown cache type: %s\n", FLAGS_cache_type.c_str());
+    exit(1);
+  }
+  return NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits);
 }
 
 // State shared by all concurrent executions of the same benchmark.
@@ -145,7 +169,7 @@ struct ThreadState {
 class CacheBench {
  public:
   CacheBench() :
-      cache_(NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits)),
+      cache_(NewCache()),
       num_threads_(FLAGS_threads) {}
 
   ~CacheBench() {}
@@ -157,7 +181,7 @@ class CacheBench {
       // Cast uint64* to be char*, data would be copied to cache
       Slice key(reinterpret_cast<char*>(&rand_key), 8);
       // do insert
-      cache_->Insert(key, new char[10], 1, &deleter);
+      cache_->Insert(key, kInMultiTouchId, new char[10], 1, &deleter);
     }
   }
 
@@ -194,6 +218,13 @@ class CacheBench {
       uint32_t qps = static_cast<uint32_t>(
           static_cast<double>(FLAGS_threads * FLAGS_ops_per_thread) / elapsed);
       fprintf(stdout, "Complete in %.3f s; QPS = %u\n", elapsed, qps);
+      const auto hits = hits_.load();
+      const auto lookups = hits + misses_.load();
+      const auto point_hits = point_hits_.load();
+      const auto point_lookups = point_hits + point_misses_.load();
+      fprintf(stdout, "Hit ratio: %.4f, point lookup hit ratio: %.4f\n",
+              lookups ? static_cast<double>(hits) / lookups : 0.0,
+              point_lookups ? static_cast<double>(point_hits) / point_lookups : 0.0);
     }
     return true;
   }
@@ -201,6 +232,13 @@ class CacheBench {
  private:
   std::shared_ptr<Cache> cache_;
   uint32_t num_threads_;
+  // Each operation is executed as separate query, so entries accessed by several operations are
+  // considered multi touch, while entries accessed only by one scan are not.
+  std::atomic<QueryId> last_query_id_{0};
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> point_hits_{0};
+  std::atomic<uint64_t> point_misses_{0};
 
   static void ThreadBody(void* v) {
     ThreadState* thread = reinterpret_cast<ThreadState*>(v);
@@ -227,24 +265,52 @@ class CacheBench {
     }
   }
 
+  // Looks up key and inserts it on miss, when read_through is true. Returns true on hit.
+  bool Read(uint64_t key_value, QueryId query_id, bool read_through) {
+    // Cast uint64* to be char*, data would be copied to cache
+    Slice key(reinterpret_cast<char*>(&key_value), 8);
+    auto handle = cache_->Lookup(key, query_id);
+    if (handle) {
+      cache_->Release(handle);
+      ++hits_;
+      return true;
+    }
+    ++misses_;
+    if (read_through) {
+      cache_->Insert(key, query_id, new char[10], 1, &deleter);
+    }
+    return false;
+  }
+
   void OperateCache(ThreadState* thread) {
+    const uint64_t hot_keys = std::max<uint64_t>(FLAGS_max_key * FLAGS_hot_key_percent / 100, 1);
+    const bool read_through = FLAGS_hot_key_percent < 100;
     for (uint64_t i = 0; i < FLAGS_ops_per_thread; i++) {
-      uint64_t rand_key = thread->rnd.Next() % FLAGS_max_key;
+      const QueryId query_id = ++last_query_id_;
+      int32_t prob_op = thread->rnd.Uniform(100);
+      if (prob_op < FLAGS_scan_percent) {
+        // do scan
+        uint64_t start = thread->rnd.Next() % FLAGS_max_key;
+        for (int32_t j = 0; j != FLAGS_scan_length; ++j) {
+          Read((start + j) % FLAGS_max_key, query_id, true /* read_through */);
+        }
+        continue;
+      }
+      prob_op -= FLAGS_scan_percent;
+      uint64_t rand_key = thread->rnd.Next() % hot_keys;
       // Cast uint64* to be char*, data would be copied to cache
       Slice key(reinterpret_cast<char*>(&rand_key), 8);
-      int32_t prob_op = thread->rnd.Uniform(100);
-      if (prob_op >= 0 && prob_op < FLAGS_insert_percent) {
+      if (prob_op < FLAGS_insert_percent) {
         // do insert
-        cache_->Insert(key, new char[10], 1, &deleter);
-      } else if (prob_op -= FLAGS_insert_percent &&
-                 prob_op < FLAGS_lookup_percent) {
+        cache_->Insert(key, query_id, new char[10], 1, &deleter);
+      } else if ((prob_op -= FLAGS_insert_percent) < FLAGS_lookup_percent) {
         // do lookup
-        auto handle = cache_->Lookup(key);
-        if (handle) {
-          cache_->Release(handle);
+        if (Read(rand_key, query_id, read_through)) {
+          ++point_hits_;
+        } else {
+          ++point_misses_;
         }
-      } else if (prob_op -= FLAGS_lookup_percent &&
-                 prob_op < FLAGS_erase_percent) {
+      } else if ((prob_op -= FLAGS_lookup_percent) < FLAGS_erase_percent) {
         // do erase
         cache_->Erase(key);
       }
@@ -261,6 +327,10 @@ class CacheBench {
     printf("Insert percentage   : %d%%\n", FLAGS_insert_percent);
     printf("Lookup percentage   : %d%%\n", FLAGS_lookup_percent);
     printf("Erase percentage    : %d%%\n", FLAGS_erase_percent);
+    printf("Scan percentage     : %d%%\n", FLAGS_scan_percent);
+    printf("Scan length         : %d\n", FLAGS_scan_length);
+    printf("Hot key percentage  : %d%%\n", FLAGS_hot_key_percent);
+    printf("Cache type          : %s\n", FLAGS_cache_type.c_str());
     printf("----------------------------\n");
   }
 };
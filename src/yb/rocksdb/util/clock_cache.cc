@@ -0,0 +1,650 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include "yb/rocksdb/cache.h"
+#include "yb/rocksdb/statistics.h"
+#include "yb/rocksdb/util/autovector.h"
+#include "yb/rocksdb/util/hash.h"
+#include "yb/rocksdb/util/statistics.h"
+
+#include "yb/util/locks.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/random_util.h"
+#include "yb/util/shared_lock.h"
+
+DECLARE_double(cache_single_touch_ratio);
+
+namespace rocksdb {
+
+namespace {
+
+// CLOCK cache implementation.
+//
+// Entries of each shard are kept in a ring, that is swept by the clock hand during eviction.
+// Each entry has usage counter, that is incremented on hit and decremented when the hand passes
+// the entry. Entry is evicted when the hand finds it with zero counter and without external
+// references.
+//
+// Scan resistance is provided in the same way as by LRU cache. Entry is considered single touch
+// until it is accessed by query other than the one that inserted it. Single touch entries never
+// get non zero usage counter, so they are evicted on the first pass of the hand. When single touch
+// entries occupy more than FLAGS_cache_single_touch_ratio of the capacity, multi touch entries are
+// not aged by the hand, so scans could not flush the hot working set.
+//
+// Lookup and Release do not take exclusive lock. Lookup takes shared lock, so it does not block
+// other lookups, and Release only decrements the reference counter. Exclusive lock is taken only
+// to modify the shard, i.e. by Insert, Erase and eviction.
+
+// Max value of entry usage counter, i.e. number of passes of the clock hand that multi touch
+// entry could survive without being accessed.
+constexpr uint8_t kMaxUsage = 3;
+
+constexpr size_t kInitialNumBuckets = 16;
+
+struct ClockHandle {
+  void* value;
+  void (*deleter)(const Slice&, void* value);
+  ClockHandle* next_hash = nullptr;
+  size_t charge;
+  // Position of the entry in the clock ring.
+  size_t clock_index = 0;
+  uint32_t hash;
+  // Query id that added the value to the cache.
+  QueryId query_id;
+  // Number of references to this entry, the cache itself is counted as 1 while entry is in cache.
+  std::atomic<uint32_t> refs;
+  std::atomic<uint8_t> usage;
+  // Modified only under shared or exclusive lock of the shard while entry is in cache.
+  std::atomic<bool> multi_touch;
+  std::string key;
+
+  ClockHandle(const Slice& key_, uint32_t hash_, QueryId query_id_, void* value_, size_t charge_,
+              void (*deleter_)(const Slice&, void* value), uint32_t refs_, bool multi_touch_)
+      : value(value_), deleter(deleter_), charge(charge_), hash(hash_), query_id(query_id_),
+        refs(refs_), usage(multi_touch_ ? 1 : 0), multi_touch(multi_touch_),
+        key(key_.cdata(), key_.size()) {}
+
+  void Free() {
+    (*deleter)(key, value);
+    delete this;
+  }
+
+  SubCacheType GetSubCacheType() const {
+    return multi_touch.load(std::memory_order_relaxed) ? MULTI_TOUCH : SINGLE_TOUCH;
+  }
+};
+
+void Unref(ClockHandle* e) {
+  if (e->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    e->Free();
+  }
+}
+
+class ClockCacheShard {
+ public:
+  ClockCacheShard() : buckets_(kInitialNumBuckets) {}
+
+  ~ClockCacheShard() {
+    for (auto* e : ring_) {
+      Unref(e);
+    }
+  }
+
+  void SetCapacity(size_t capacity) {
+    autovector<ClockHandle*> evicted;
+    {
+      std::lock_guard<yb::rw_spinlock> lock(mutex_);
+      capacity_ = capacity;
+      EvictUnlocked(capacity, &evicted);
+    }
+    UnrefAll(evicted);
+  }
+
+  void SetStrictCapacityLimit(bool strict_capacity_limit) {
+    std::lock_guard<yb::rw_spinlock> lock(mutex_);
+    strict_capacity_limit_ = strict_capacity_limit;
+  }
+
+  void SetMetrics(std::shared_ptr<yb::CacheMetrics> metrics) {
+    std::lock_guard<yb::rw_spinlock> lock(mutex_);
+    metrics_ = std::move(metrics);
+  }
+
+  Status Insert(const Slice& key, uint32_t hash, QueryId query_id, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value), Cache::Handle** handle,
+                Statistics* statistics);
+
+  Cache::Handle* Lookup(const Slice& key, uint32_t hash, QueryId query_id,
+                        Statistics* statistics);
+
+  void Erase(const Slice& key, uint32_t hash);
+
+  size_t Evict(size_t required);
+
+  size_t GetUsage() const {
+    return usage_.load(std::memory_order_relaxed);
+  }
+
+  size_t GetPinnedUsage() const {
+    yb::SharedLock<yb::rw_spinlock> lock(mutex_);
+    size_t result = 0;
+    for (auto* e : ring_) {
+      if (e->refs.load(std::memory_order_relaxed) > 1) {
+        result += e->charge;
+      }
+    }
+    return result;
+  }
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) {
+    if (thread_safe) {
+      mutex_.lock_shared();
+    }
+    for (auto* e : ring_) {
+      callback(e->value, e->charge);
+    }
+    if (thread_safe) {
+      mutex_.unlock_shared();
+    }
+  }
+
+  std::pair<size_t, size_t> TEST_GetIndividualUsages() {
+    const auto multi_touch_usage = multi_touch_usage_.load(std::memory_order_relaxed);
+    return {GetUsage() - multi_touch_usage, multi_touch_usage};
+  }
+
+ private:
+  ClockHandle** FindPointer(const Slice& key, uint32_t hash) {
+    ClockHandle** ptr = &buckets_[hash & (buckets_.size() - 1)];
+    while (*ptr != nullptr && ((*ptr)->hash != hash || key != Slice((*ptr)->key))) {
+      ptr = &(*ptr)->next_hash;
+    }
+    return ptr;
+  }
+
+  // Adds entry, which key is not present in the shard.
+  void AddUnlocked(ClockHandle* e);
+
+  // Removes entry from hash table and clock ring. Reference of the cache is not released.
+  void RemoveUnlocked(ClockHandle* e);
+
+  // Removes entry from clock ring and updates usage.
+  void RemoveFromRingUnlocked(ClockHandle* e);
+
+  // Evicts entries without external references until usage does not exceed target_usage.
+  void EvictUnlocked(size_t target_usage, autovector<ClockHandle*>* evicted);
+
+  // Marks entry as accessed by another query.
+  void Touch(ClockHandle* e);
+
+  void ResizeUnlocked();
+
+  static void UnrefAll(const autovector<ClockHandle*>& handles) {
+    for (auto* e : handles) {
+      Unref(e);
+    }
+  }
+
+  mutable yb::rw_spinlock mutex_;
+  std::vector<ClockHandle*> buckets_;
+  std::vector<ClockHandle*> ring_;
+  size_t hand_ = 0;
+  size_t capacity_ = 0;
+  bool strict_capacity_limit_ = false;
+  std::shared_ptr<yb::CacheMetrics> metrics_;
+  // Usages are modified only under exclusive lock, or under shared lock while entry is promoted
+  // to multi touch, but are read without lock.
+  std::atomic<size_t> usage_{0};
+  std::atomic<size_t> multi_touch_usage_{0};
+};
+
+void ClockCacheShard::AddUnlocked(ClockHandle* e) {
+  auto** ptr = FindPointer(e->key, e->hash);
+  DCHECK(*ptr == nullptr);
+  *ptr = e;
+  e->clock_index = ring_.size();
+  ring_.push_back(e);
+  usage_.fetch_add(e->charge, std::memory_order_relaxed);
+  const bool multi_touch = e->multi_touch.load(std::memory_order_relaxed);
+  if (multi_touch) {
+    multi_touch_usage_.fetch_add(e->charge, std::memory_order_relaxed);
+  }
+  if (metrics_) {
+    metrics_->inserts->Increment();
+    metrics_->cache_usage->IncrementBy(e->charge);
+    (multi_touch ? metrics_->multi_touch_cache_usage : metrics_->single_touch_cache_usage)
+        ->IncrementBy(e->charge);
+  }
+  if (ring_.size() > buckets_.size()) {
+    ResizeUnlocked();
+  }
+}
+
+void ClockCacheShard::RemoveUnlocked(ClockHandle* e) {
+  auto** ptr = FindPointer(e->key, e->hash);
+  DCHECK_EQ(*ptr, e);
+  *ptr = e->next_hash;
+  e->next_hash = nullptr;
+  RemoveFromRingUnlocked(e);
+}
+
+void ClockCacheShard::RemoveFromRingUnlocked(ClockHandle* e) {
+  // Move last entry to the place of removed one, so the hand will check it on the next step.
+  auto* last = ring_.back();
+  ring_[e->clock_index] = last;
+  last->clock_index = e->clock_index;
+  ring_.pop_back();
+
+  usage_.fetch_sub(e->charge, std::memory_order_relaxed);
+  const bool multi_touch = e->multi_touch.load(std::memory_order_relaxed);
+  if (multi_touch) {
+    multi_touch_usage_.fetch_sub(e->charge, std::memory_order_relaxed);
+  }
+  if (metrics_) {
+    metrics_->cache_usage->DecrementBy(e->charge);
+    (multi_touch ? metrics_->multi_touch_cache_usage : metrics_->single_touch_cache_usage)
+        ->DecrementBy(e->charge);
+  }
+}
+
+void ClockCacheShard::ResizeUnlocked() {
+  std::vector<ClockHandle*> new_buckets(buckets_.size() * 2);
+  const auto mask = new_buckets.size() - 1;
+  for (auto* head : buckets_) {
+    while (head != nullptr) {
+      auto* next = head->next_hash;
+      auto& bucket = new_buckets[head->hash & mask];
+      head->next_hash = bucket;
+      bucket = head;
+      head = next;
+    }
+  }
+  buckets_.swap(new_buckets);
+}
+
+void ClockCacheShard::EvictUnlocked(size_t target_usage, autovector<ClockHandle*>* evicted) {
+  const auto single_touch_capacity =
+      static_cast<size_t>(FLAGS_cache_single_touch_ratio * capacity_);
+  // Every entry without external references is evicted after at most kMaxUsage + 1 passes of
+  // the hand, so this limit is only reached when the rest of entries are pinned.
+  size_t steps_left = (kMaxUsage + 1) * ring_.size();
+  size_t usage = usage_.load(std::memory_order_relaxed);
+  while (usage > target_usage && !ring_.empty() && steps_left-- > 0) {
+    if (hand_ >= ring_.size()) {
+      hand_ = 0;
+    }
+    auto* e = ring_[hand_];
+    if (e->refs.load(std::memory_order_acquire) != 1) {
+      // Entry is referenced externally, so could not be evicted.
+      ++hand_;
+      continue;
+    }
+    if (e->multi_touch.load(std::memory_order_relaxed)) {
+      const auto single_touch_usage = usage - multi_touch_usage_.load(std::memory_order_relaxed);
+      if (single_touch_usage > single_touch_capacity) {
+        // Single touch entries should be evicted first, do not age hot entries.
+        ++hand_;
+        continue;
+      }
+      const auto entry_usage = e->usage.load(std::memory_order_relaxed);
+      if (entry_usage > 0) {
+        e->usage.store(entry_usage - 1, std::memory_order_relaxed);
+        ++hand_;
+        continue;
+      }
+    }
+    // Hand is not advanced, since last entry of the ring is moved to this place.
+    RemoveUnlocked(e);
+    usage -= e->charge;
+    evicted->push_back(e);
+    if (metrics_) {
+      metrics_->evictions->Increment();
+    }
+  }
+}
+
+void ClockCacheShard::Touch(ClockHandle* e) {
+  if (!e->multi_touch.load(std::memory_order_relaxed)) {
+    if (FLAGS_cache_single_touch_ratio >= 1) {
+      // There is no multi touch cache.
+      return;
+    }
+    if (!e->multi_touch.exchange(true, std::memory_order_relaxed)) {
+      multi_touch_usage_.fetch_add(e->charge, std::memory_order_relaxed);
+      if (metrics_) {
+        metrics_->single_touch_cache_usage->DecrementBy(e->charge);
+        metrics_->multi_touch_cache_usage->IncrementBy(e->charge);
+      }
+    }
+  }
+  auto entry_usage = e->usage.load(std::memory_order_relaxed);
+  while (entry_usage < kMaxUsage &&
+         !e->usage.compare_exchange_weak(entry_usage, entry_usage + 1,
+                                         std::memory_order_relaxed)) {
+  }
+}
+
+Status ClockCacheShard::Insert(
+    const Slice& key, uint32_t hash, QueryId query_id, void* value, size_t charge,
+    void (*deleter)(const Slice& key, void* value), Cache::Handle** handle,
+    Statistics* statistics) {
+  const bool multi_touch =
+      query_id == kInMultiTouchId || FLAGS_cache_single_touch_ratio == 0;
+  // One reference from the cache and one for the returned handle.
+  auto* e = new ClockHandle(key, hash, query_id, value, charge, deleter, handle ? 2 : 1,
+                            multi_touch);
+  autovector<ClockHandle*> released;
+  Status s;
+  {
+    std::lock_guard<yb::rw_spinlock> lock(mutex_);
+    EvictUnlocked(capacity_ > charge ? capacity_ - charge : 0, &released);
+    if (strict_capacity_limit_ && GetUsage() + charge > capacity_) {
+      if (handle == nullptr) {
+        // Value is cleaned up by the cache, when handle is not requested.
+        e->refs.store(0, std::memory_order_relaxed);
+        e->Free();
+      } else {
+        delete e;
+        *handle = nullptr;
+      }
+      s = STATUS(Incomplete, "Insert failed due to CLOCK cache being full.");
+    } else {
+      auto** ptr = FindPointer(key, hash);
+      auto* old = *ptr;
+      if (old != nullptr) {
+        // Replace old entry in the hash chain, it will be freed when last reference is released.
+        *ptr = old->next_hash;
+        old->next_hash = nullptr;
+        RemoveFromRingUnlocked(old);
+        released.push_back(old);
+      }
+      AddUnlocked(e);
+      if (handle != nullptr) {
+        *handle = reinterpret_cast<Cache::Handle*>(e);
+      }
+    }
+    if (statistics != nullptr) {
+      if (s.ok()) {
+        RecordTick(statistics, BLOCK_CACHE_ADD);
+        RecordTick(statistics, BLOCK_CACHE_BYTES_WRITE, charge);
+        if (multi_touch) {
+          RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_ADD);
+          RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE, charge);
+        } else {
+          RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_ADD);
+          RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_BYTES_WRITE, charge);
+        }
+      } else {
+        RecordTick(statistics, BLOCK_CACHE_ADD_FAILURES);
+      }
+    }
+  }
+  // Free outside of the lock.
+  UnrefAll(released);
+  return s;
+}
+
+Cache::Handle* ClockCacheShard::Lookup(
+    const Slice& key, uint32_t hash, QueryId query_id, Statistics* statistics) {
+  ClockHandle* e;
+  {
+    yb::SharedLock<yb::rw_spinlock> lock(mutex_);
+    e = *FindPointer(key, hash);
+    if (e != nullptr) {
+      e->refs.fetch_add(1, std::memory_order_relaxed);
+      // Repeated accesses by the query that inserted entry, for instance by scan, do not make it
+      // hot.
+      if (query_id != e->query_id || query_id == kInMultiTouchId) {
+        Touch(e);
+      }
+    }
+  }
+
+  if (statistics != nullptr) {
+    if (e != nullptr) {
+      RecordTick(statistics, BLOCK_CACHE_HIT);
+      RecordTick(statistics, BLOCK_CACHE_BYTES_READ, e->charge);
+      if (e->GetSubCacheType() == SubCacheType::SINGLE_TOUCH) {
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_HIT);
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_BYTES_READ, e->charge);
+      } else {
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_HIT);
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_BYTES_READ, e->charge);
+      }
+    } else {
+      RecordTick(statistics, BLOCK_CACHE_MISS);
+    }
+  }
+  if (metrics_ != nullptr) {
+    metrics_->lookups->Increment();
+    if (e != nullptr) {
+      metrics_->cache_hits->Increment();
+    } else {
+      metrics_->cache_misses->Increment();
+    }
+  }
+  return reinterpret_cast<Cache::Handle*>(e);
+}
+
+void ClockCacheShard::Erase(const Slice& key, uint32_t hash) {
+  ClockHandle* e;
+  {
+    std::lock_guard<yb::rw_spinlock> lock(mutex_);
+    e = *FindPointer(key, hash);
+    if (e != nullptr) {
+      RemoveUnlocked(e);
+    }
+  }
+  if (e != nullptr) {
+    Unref(e);
+  }
+}
+
+size_t ClockCacheShard::Evict(size_t required) {
+  autovector<ClockHandle*> evicted;
+  {
+    std::lock_guard<yb::rw_spinlock> lock(mutex_);
+    const auto usage = GetUsage();
+    EvictUnlocked(usage > required ? usage - required : 0, &evicted);
+  }
+  size_t result = 0;
+  for (auto* e : evicted) {
+    result += e->charge;
+  }
+  UnrefAll(evicted);
+  return result;
+}
+
+constexpr int kNumShardBits = 4;
+
+class ShardedClockCache : public Cache {
+ public:
+  ShardedClockCache(size_t capacity, int num_shard_bits, bool strict_capacity_limit)
+      : num_shard_bits_(num_shard_bits),
+        shards_(new ClockCacheShard[1 << num_shard_bits]),
+        capacity_(capacity),
+        strict_capacity_limit_(strict_capacity_limit) {
+    for (int s = 0; s != num_shards(); ++s) {
+      shards_[s].SetStrictCapacityLimit(strict_capacity_limit);
+    }
+    SetCapacity(capacity);
+  }
+
+  void SetCapacity(size_t capacity) override {
+    const size_t per_shard = (capacity + (num_shards() - 1)) / num_shards();
+    std::lock_guard<std::mutex> lock(capacity_mutex_);
+    for (int s = 0; s != num_shards(); ++s) {
+      shards_[s].SetCapacity(per_shard);
+    }
+    capacity_ = capacity;
+  }
+
+  Status Insert(const Slice& key, const QueryId query_id, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value),
+                Handle** handle, Statistics* statistics) override {
+    DCHECK(IsValidQueryId(query_id));
+    // Queries with no cache query ids are not cached.
+    if (query_id == kNoCacheQueryId) {
+      return Status::OK();
+    }
+    const uint32_t hash = HashSlice(key);
+    return shards_[Shard(hash)].Insert(
+        key, hash, query_id, value, charge, deleter, handle, statistics);
+  }
+
+  Handle* Lookup(const Slice& key, const QueryId query_id, Statistics* statistics) override {
+    DCHECK(IsValidQueryId(query_id));
+    if (query_id == kNoCacheQueryId) {
+      return nullptr;
+    }
+    const uint32_t hash = HashSlice(key);
+    return shards_[Shard(hash)].Lookup(key, hash, query_id, statistics);
+  }
+
+  void Release(Handle* handle) override {
+    if (handle != nullptr) {
+      Unref(reinterpret_cast<ClockHandle*>(handle));
+    }
+  }
+
+  void Erase(const Slice& key) override {
+    const uint32_t hash = HashSlice(key);
+    shards_[Shard(hash)].Erase(key, hash);
+  }
+
+  void* Value(Handle* handle) override {
+    return reinterpret_cast<ClockHandle*>(handle)->value;
+  }
+
+  uint64_t NewId() override {
+    return last_id_.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  size_t Evict(size_t bytes_to_evict) override {
+    size_t total_evicted = 0;
+    // Start at random shard.
+    auto index = Shard(yb::RandomUniformInt<uint32_t>());
+    for (int i = 0; bytes_to_evict > total_evicted && i != num_shards(); ++i) {
+      total_evicted += shards_[index].Evict(bytes_to_evict - total_evicted);
+      index = (index + 1) & (num_shards() - 1);
+    }
+    return total_evicted;
+  }
+
+  size_t GetCapacity() const override {
+    return capacity_;
+  }
+
+  bool HasStrictCapacityLimit() const override {
+    return strict_capacity_limit_;
+  }
+
+  size_t GetUsage() const override {
+    size_t usage = 0;
+    for (int s = 0; s != num_shards(); ++s) {
+      usage += shards_[s].GetUsage();
+    }
+    return usage;
+  }
+
+  size_t GetUsage(Handle* handle) const override {
+    return reinterpret_cast<ClockHandle*>(handle)->charge;
+  }
+
+  size_t GetPinnedUsage() const override {
+    size_t usage = 0;
+    for (int s = 0; s != num_shards(); ++s) {
+      usage += shards_[s].GetPinnedUsage();
+    }
+    return usage;
+  }
+
+  SubCacheType GetSubCacheType(Handle* e) const override {
+    return reinterpret_cast<ClockHandle*>(e)->GetSubCacheType();
+  }
+
+  void DisownData() override {
+    shards_.release();
+  }
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) override {
+    for (int s = 0; s != num_shards(); ++s) {
+      shards_[s].ApplyToAllCacheEntries(callback, thread_safe);
+    }
+  }
+
+  void SetMetrics(
+      const scoped_refptr<yb::MetricEntity>& entity, yb::CacheMetricsKind kind) override {
+    auto metrics = std::make_shared<yb::CacheMetrics>(entity, kind);
+    for (int s = 0; s != num_shards(); ++s) {
+      shards_[s].SetMetrics(metrics);
+    }
+  }
+
+  std::vector<std::pair<size_t, size_t>> TEST_GetIndividualUsages() override {
+    std::vector<std::pair<size_t, size_t>> cache_sizes;
+    cache_sizes.reserve(num_shards());
+    for (int s = 0; s != num_shards(); ++s) {
+      cache_sizes.emplace_back(shards_[s].TEST_GetIndividualUsages());
+    }
+    return cache_sizes;
+  }
+
+ private:
+  static uint32_t HashSlice(const Slice& s) {
+    return Hash(s.data(), s.size(), 0);
+  }
+
+  static bool IsValidQueryId(const QueryId query_id) {
+    return query_id >= 0 || query_id == kInMultiTouchId || query_id == kNoCacheQueryId;
+  }
+
+  int num_shards() const {
+    return 1 << num_shard_bits_;
+  }
+
+  uint32_t Shard(uint32_t hash) const {
+    // Note, hash >> 32 yields hash in gcc, not the zero we expect!
+    return (num_shard_bits_ > 0) ? (hash >> (32 - num_shard_bits_)) : 0;
+  }
+
+  const int num_shard_bits_;
+  std::unique_ptr<ClockCacheShard[]> shards_;
+  std::mutex capacity_mutex_;
+  std::atomic<size_t> capacity_;
+  const bool strict_capacity_limit_;
+  std::atomic<uint64_t> last_id_{0};
+};
+
+}  // namespace
+
+std::shared_ptr<Cache> NewClockCache(size_t capacity) {
+  return NewClockCache(capacity, kNumShardBits, false);
+}
+
+std::shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits,
+                                     bool strict_capacity_limit) {
+  if (num_shard_bits >= 20) {
+    return nullptr;  // the cache cannot be sharded into too many fine pieces
+  }
+  return std::make_shared<ShardedClockCache>(capacity, num_shard_bits, strict_capacity_limit);
+}
+
+}  // namespace rocksdb
@@ -0,0 +1,280 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "yb/rocksdb/cache.h"
+#include "yb/rocksdb/util/coding.h"
+
+#include "yb/util/random_util.h"
+#include "yb/util/test_macros.h"
+
+namespace rocksdb {
+
+namespace {
+
+std::string EncodeKey(int k) {
+  std::string result;
+  PutFixed32(&result, k);
+  return result;
+}
+
+int DecodeKey(const Slice& k) {
+  return DecodeFixed32(k.data());
+}
+
+void* EncodeValue(uintptr_t v) {
+  return reinterpret_cast<void*>(v);
+}
+
+int DecodeValue(void* v) {
+  return static_cast<int>(reinterpret_cast<uintptr_t>(v));
+}
+
+constexpr QueryId kTestQueryId = 1;
+
+} // namespace
+
+class ClockCacheTest : public testing::Test {
+ public:
+  static ClockCacheTest* current_;
+
+  static void Deleter(const Slice& key, void* v) {
+    current_->deleted_keys_.push_back(DecodeKey(key));
+    current_->deleted_values_.push_back(DecodeValue(v));
+  }
+
+  static void NoopDeleter(const Slice& key, void* v) {}
+
+  ClockCacheTest() {
+    current_ = this;
+  }
+
+ protected:
+  // Single shard, so capacity is not split between shards.
+  void CreateCache(size_t capacity, bool strict_capacity_limit = false) {
+    cache_ = NewClockCache(capacity, 0 /* num_shard_bits */, strict_capacity_limit);
+  }
+
+  int Lookup(int key, QueryId query_id = kTestQueryId) {
+    Cache::Handle* handle = cache_->Lookup(EncodeKey(key), query_id);
+    const int r = (handle == nullptr) ? -1 : DecodeValue(cache_->Value(handle));
+    if (handle != nullptr) {
+      cache_->Release(handle);
+    }
+    return r;
+  }
+
+  CHECKED_STATUS Insert(int key, int value, QueryId query_id = kTestQueryId, int charge = 1) {
+    return cache_->Insert(EncodeKey(key), query_id, EncodeValue(value), charge,
+                          &ClockCacheTest::Deleter);
+  }
+
+  void Erase(int key) {
+    cache_->Erase(EncodeKey(key));
+  }
+
+  std::vector<int> deleted_keys_;
+  std::vector<int> deleted_values_;
+  std::shared_ptr<Cache> cache_;
+};
+
+ClockCacheTest* ClockCacheTest::current_;
+
+TEST_F(ClockCacheTest, HitAndMiss) {
+  CreateCache(100);
+  ASSERT_EQ(-1, Lookup(100));
+
+  ASSERT_OK(Insert(100, 101));
+  ASSERT_EQ(101, Lookup(100));
+  ASSERT_EQ(-1, Lookup(200));
+
+  ASSERT_OK(Insert(200, 201));
+  ASSERT_EQ(101, Lookup(100));
+  ASSERT_EQ(201, Lookup(200));
+
+  // Replacing value frees the old one.
+  ASSERT_OK(Insert(100, 102));
+  ASSERT_EQ(102, Lookup(100));
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(100, deleted_keys_[0]);
+  ASSERT_EQ(101, deleted_values_[0]);
+  ASSERT_EQ(2U, cache_->GetUsage());
+}
+
+TEST_F(ClockCacheTest, Erase) {
+  CreateCache(100);
+  Erase(200);
+  ASSERT_EQ(0U, deleted_keys_.size());
+
+  ASSERT_OK(Insert(100, 101));
+  ASSERT_OK(Insert(200, 201));
+  Erase(100);
+  ASSERT_EQ(-1, Lookup(100));
+  ASSERT_EQ(201, Lookup(200));
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(100, deleted_keys_[0]);
+  ASSERT_EQ(101, deleted_values_[0]);
+  ASSERT_EQ(1U, cache_->GetUsage());
+}
+
+TEST_F(ClockCacheTest, EntriesArePinned) {
+  CreateCache(100);
+  ASSERT_OK(Insert(100, 101));
+  Cache::Handle* h1 = cache_->Lookup(EncodeKey(100), kTestQueryId);
+  ASSERT_EQ(101, DecodeValue(cache_->Value(h1)));
+  ASSERT_EQ(1U, cache_->GetPinnedUsage());
+
+  ASSERT_OK(Insert(100, 102));
+  Cache::Handle* h2 = cache_->Lookup(EncodeKey(100), kTestQueryId);
+  ASSERT_EQ(102, DecodeValue(cache_->Value(h2)));
+  ASSERT_EQ(0U, deleted_keys_.size());
+
+  cache_->Release(h1);
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(101, deleted_values_[0]);
+
+  Erase(100);
+  ASSERT_EQ(-1, Lookup(100));
+  ASSERT_EQ(1U, deleted_keys_.size());
+
+  cache_->Release(h2);
+  ASSERT_EQ(2U, deleted_keys_.size());
+  ASSERT_EQ(102, deleted_values_[1]);
+  ASSERT_EQ(0U, cache_->GetPinnedUsage());
+}
+
+TEST_F(ClockCacheTest, PinnedEntriesAreNotEvicted) {
+  CreateCache(10);
+  Cache::Handle* handle;
+  ASSERT_OK(cache_->Insert(EncodeKey(1), kTestQueryId, EncodeValue(1), 1,
+                           &ClockCacheTest::Deleter, &handle));
+  for (int i = 2; i != 100; ++i) {
+    ASSERT_OK(Insert(i, i));
+  }
+  ASSERT_EQ(1, Lookup(1));
+  ASSERT_LE(cache_->GetUsage(), 10U);
+  cache_->Release(handle);
+}
+
+TEST_F(ClockCacheTest, StrictCapacityLimit) {
+  CreateCache(5, true /* strict_capacity_limit */);
+  std::vector<Cache::Handle*> handles(5);
+  for (int i = 0; i != 5; ++i) {
+    ASSERT_OK(cache_->Insert(EncodeKey(i), kTestQueryId, EncodeValue(i), 1,
+                             &ClockCacheTest::NoopDeleter, &handles[i]));
+  }
+  // All entries are pinned, so there is no room for the new one.
+  Cache::Handle* handle = nullptr;
+  auto s = cache_->Insert(EncodeKey(10), kTestQueryId, EncodeValue(10), 1,
+                          &ClockCacheTest::NoopDeleter, &handle);
+  ASSERT_TRUE(s.IsIncomplete()) << s;
+  ASSERT_EQ(nullptr, handle);
+
+  for (auto* h : handles) {
+    cache_->Release(h);
+  }
+  ASSERT_OK(Insert(10, 10));
+  ASSERT_EQ(10, Lookup(10));
+}
+
+// Hot entries accessed by different queries should survive scan that is larger than the cache.
+TEST_F(ClockCacheTest, ScanResistance) {
+  constexpr int kCapacity = 100;
+  constexpr int kNumHot = 50;
+  CreateCache(kCapacity);
+
+  for (int i = 0; i != kNumHot; ++i) {
+    ASSERT_OK(Insert(i, i));
+    // Access by another query promotes entry to multi touch.
+    ASSERT_EQ(i, Lookup(i, kTestQueryId + 1));
+  }
+
+  // Repeated accesses by the same query, i.e. scan, do not promote entries.
+  constexpr QueryId kScanQueryId = 1000;
+  for (int i = kNumHot; i != kNumHot + 10 * kCapacity; ++i) {
+    ASSERT_OK(Insert(i, i, kScanQueryId));
+    ASSERT_EQ(i, Lookup(i, kScanQueryId));
+  }
+
+  for (int i = 0; i != kNumHot; ++i) {
+    ASSERT_EQ(i, Lookup(i)) << "Hot key evicted by scan: " << i;
+  }
+  auto usages = cache_->TEST_GetIndividualUsages();
+  ASSERT_EQ(1U, usages.size());
+  ASSERT_EQ(static_cast<size_t>(kNumHot), usages[0].second);
+  ASSERT_LE(usages[0].first + usages[0].second, static_cast<size_t>(kCapacity));
+}
+
+TEST_F(ClockCacheTest, SetCapacity) {
+  CreateCache(100);
+  for (int i = 0; i != 100; ++i) {
+    ASSERT_OK(Insert(i, i));
+  }
+  ASSERT_EQ(100U, cache_->GetUsage());
+  cache_->SetCapacity(50);
+  ASSERT_EQ(50U, cache_->GetCapacity());
+  ASSERT_EQ(50U, cache_->GetUsage());
+  ASSERT_EQ(50U, deleted_keys_.size());
+}
+
+TEST_F(ClockCacheTest, Concurrent) {
+  constexpr int kNumThreads = 8;
+  constexpr int kNumKeys = 1000;
+  constexpr int kOpsPerThread = 20000;
+  cache_ = NewClockCache(kNumKeys / 2, 2 /* num_shard_bits */);
+
+  std::atomic<int> mismatches{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kNumThreads; ++t) {
+    threads.emplace_back([this, t, &mismatches] {
+      for (int i = 0; i != kOpsPerThread; ++i) {
+        const int key = yb::RandomUniformInt(0, kNumKeys - 1);
+        const auto encoded_key = EncodeKey(key);
+        const QueryId query_id = t + 1;
+        Cache::Handle* handle = cache_->Lookup(encoded_key, query_id);
+        if (handle == nullptr) {
+          auto s = cache_->Insert(encoded_key, query_id, EncodeValue(key), 1,
+                                  &ClockCacheTest::NoopDeleter, &handle);
+          if (!s.ok()) {
+            continue;
+          }
+        }
+        if (DecodeValue(cache_->Value(handle)) != key) {
+          ++mismatches;
+        }
+        cache_->Release(handle);
+        if (i % 100 == 0) {
+          cache_->Erase(encoded_key);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(0, mismatches.load());
+  ASSERT_EQ(0U, cache_->GetPinnedUsage());
+}
+
+}  // namespace rocksdb
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
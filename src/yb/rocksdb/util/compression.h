@@ -25,11 +25,15 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/util/coding.h"
 
+#include "yb/gutil/macros.h"
+
 #ifdef SNAPPY
 #include <snappy.h>
 #endif
@@ -49,6 +53,9 @@
 
 #if defined(ZSTD)
 #include <zstd.h>
+#if ZSTD_VERSION_NUMBER >= 10103 // v1.1.3+
+#include <zdict.h>
+#endif
 #endif
 
 namespace rocksdb {
@@ -102,6 +109,7 @@ inline bool CompressionTypeSupported(CompressionType compression_type) {
       return LZ4_Supported();
     case kLZ4HCCompression:
       return LZ4_Supported();
+    case kZSTD: FALLTHROUGH_INTENDED;
     case kZSTDNotFinalCompression:
       return ZSTD_Supported();
     default:
@@ -124,8 +132,10 @@ inline std::string CompressionTypeToString(CompressionType compression_type) {
       return "LZ4";
     case kLZ4HCCompression:
       return "LZ4HC";
-    case kZSTDNotFinalCompression:
+    case kZSTD:
       return "ZSTD";
+    case kZSTDNotFinalCompression:
+      return "ZSTDNotFinal";
     default:
       assert(false);
       return "";
@@ -620,8 +630,106 @@ inline bool LZ4HC_Compress(const CompressionOptions& opts,
   return false;
 }
 
+// Maps default compression level to the zstd one, since negative levels are valid for zstd.
+// 3 is the value of ZSTD_CLEVEL_DEFAULT, which is not exposed by old versions.
+inline int ZSTD_Level(const CompressionOptions& opts) {
+  return opts.level == CompressionOptions::kDefaultCompressionLevel ? 3 : opts.level;
+}
+
+#ifdef ZSTD
+namespace compression {
+
+struct ZSTDCCtxDeleter {
+  void operator()(ZSTD_CCtx* context) const {
+    ZSTD_freeCCtx(context);
+  }
+};
+
+struct ZSTDDCtxDeleter {
+  void operator()(ZSTD_DCtx* context) const {
+    ZSTD_freeDCtx(context);
+  }
+};
+
+// Contexts are reused by all blocks compressed or uncompressed by the same thread, so their
+// buffers are not allocated for each block.
+inline ZSTD_CCtx* ThreadLocalZSTDCCtx() {
+  static thread_local std::unique_ptr<ZSTD_CCtx, ZSTDCCtxDeleter> context(ZSTD_createCCtx());
+  return context.get();
+}
+
+inline ZSTD_DCtx* ThreadLocalZSTDDCtx() {
+  static thread_local std::unique_ptr<ZSTD_DCtx, ZSTDDCtxDeleter> context(ZSTD_createDCtx());
+  return context.get();
+}
+
+} // namespace compression
+#endif
+
+// Dictionary used to compress data blocks of a single file. It is digested once when created,
+// instead of loading raw dictionary for each compressed block.
+class ZSTDCompressionDict {
+ public:
+  ZSTDCompressionDict(const Slice& dict, const CompressionOptions& opts) {
+#ifdef ZSTD
+    cdict_ = ZSTD_createCDict(dict.data(), dict.size(), ZSTD_Level(opts));
+#endif
+  }
+
+  ~ZSTDCompressionDict() {
+#ifdef ZSTD
+    ZSTD_freeCDict(cdict_);
+#endif
+  }
+
+#ifdef ZSTD
+  const ZSTD_CDict* cdict() const {
+    return cdict_;
+  }
+#endif
+
+ private:
+#ifdef ZSTD
+  ZSTD_CDict* cdict_ = nullptr;
+#endif
+
+  DISALLOW_COPY_AND_ASSIGN(ZSTDCompressionDict);
+};
+
+// Dictionary used to uncompress data blocks of a single file, see ZSTDCompressionDict.
+class ZSTDUncompressionDict {
+ public:
+  explicit ZSTDUncompressionDict(const Slice& dict) {
+#ifdef ZSTD
+    ddict_ = ZSTD_createDDict(dict.data(), dict.size());
+#endif
+  }
+
+  ~ZSTDUncompressionDict() {
+#ifdef ZSTD
+    ZSTD_freeDDict(ddict_);
+#endif
+  }
+
+#ifdef ZSTD
+  const ZSTD_DDict* ddict() const {
+    return ddict_;
+  }
+#endif
+
+ private:
+#ifdef ZSTD
+  ZSTD_DDict* ddict_ = nullptr;
+#endif
+
+  DISALLOW_COPY_AND_ASSIGN(ZSTDUncompressionDict);
+};
+
+// compression_dict is used to prime compression, the same dictionary should be passed to
+// ZSTD_Uncompress.
 inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
-                          size_t length, ::std::string* output) {
+                          size_t length, ::std::string* output,
+                          const ZSTDCompressionDict* compression_dict = nullptr) {
 #ifdef ZSTD
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -633,9 +741,23 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
 
   size_t compressBound = ZSTD_compressBound(length);
   output->resize(static_cast<size_t>(output_header_len + compressBound));
-  size_t outlen = ZSTD_compress(&(*output)[output_header_len], compressBound,
-                                input, length, opts.level);
-  if (outlen == 0) {
+  auto* context = compression::ThreadLocalZSTDCCtx();
+  if (!context) {
+    return false;
+  }
+  size_t outlen;
+  if (!compression_dict) {
+    outlen = ZSTD_compressCCtx(
+        context, &(*output)[output_header_len], compressBound, input, length, ZSTD_Level(opts));
+  } else {
+    if (!compression_dict->cdict()) {
+      return false;
+    }
+    outlen = ZSTD_compress_usingCDict(
+        context, &(*output)[output_header_len], compressBound, input, length,
+        compression_dict->cdict());
+  }
+  if (outlen == 0 || ZSTD_isError(outlen)) {
     return false;
   }
   output->resize(output_header_len + outlen);
@@ -645,7 +767,8 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
 }
 
 inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
-                             int* decompress_size) {
+                             int* decompress_size,
+                             const ZSTDUncompressionDict* uncompression_dict = nullptr) {
 #ifdef ZSTD
   uint32_t output_len = 0;
   if (!compression::GetDecompressedSizeInfo(&input_data, &input_length,
@@ -653,14 +776,57 @@ inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
     return nullptr;
   }
 
-  char* output = new char[output_len];
-  size_t actual_output_length =
-      ZSTD_decompress(output, output_len, input_data, input_length);
-  assert(actual_output_length == output_len);
+  auto* context = compression::ThreadLocalZSTDDCtx();
+  if (!context) {
+    return nullptr;
+  }
+  std::unique_ptr<char[]> output(new char[output_len]);
+  size_t actual_output_length;
+  if (!uncompression_dict) {
+    actual_output_length = ZSTD_decompressDCtx(
+        context, output.get(), output_len, input_data, input_length);
+  } else {
+    if (!uncompression_dict->ddict()) {
+      return nullptr;
+    }
+    actual_output_length = ZSTD_decompress_usingDDict(
+        context, output.get(), output_len, input_data, input_length, uncompression_dict->ddict());
+  }
+  if (ZSTD_isError(actual_output_length) || actual_output_length != output_len) {
+    return nullptr;
+  }
   *decompress_size = static_cast<int>(actual_output_length);
-  return output;
+  return output.release();
 #endif
   return nullptr;
 }
 
+inline bool ZSTD_TrainDictionarySupported() {
+#if defined(ZSTD) && ZSTD_VERSION_NUMBER >= 10103
+  return true;
+#endif
+  return false;
+}
+
+// Trains zstd dictionary of at most max_dict_bytes from samples, that are concatenated in
+// samples buffer, with sizes of individual samples specified by sample_lens.
+// Returns empty string if dictionary could not be trained, for instance when there are too few
+// samples.
+inline std::string ZSTD_TrainDictionary(const std::string& samples,
+                                        const std::vector<size_t>& sample_lens,
+                                        size_t max_dict_bytes) {
+#if defined(ZSTD) && ZSTD_VERSION_NUMBER >= 10103
+  std::string dict_data(max_dict_bytes, '\0');
+  size_t dict_len = ZDICT_trainFromBuffer(
+      &dict_data[0], max_dict_bytes, samples.data(), sample_lens.data(),
+      static_cast<unsigned>(sample_lens.size()));
+  if (ZDICT_isError(dict_len)) {
+    return std::string();
+  }
+  dict_data.resize(dict_len);
+  return dict_data;
+#endif
+  return std::string();
+}
+
 }  // namespace rocksdb
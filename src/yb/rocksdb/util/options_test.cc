@@ -1892,7 +1892,11 @@ TEST_F(OptionsParserTest, BlockBasedTableOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(BlockBasedTableOptions, flush_block_policy_factory),
       BLACKLIST_ENTRY(BlockBasedTableOptions, block_cache),
       BLACKLIST_ENTRY(BlockBasedTableOptions, block_cache_compressed),
+      BLACKLIST_ENTRY(BlockBasedTableOptions, metadata_block_cache),
+      BLACKLIST_ENTRY(BlockBasedTableOptions, warm_up_index_on_open),
       BLACKLIST_ENTRY(BlockBasedTableOptions, data_block_key_value_encoding_format),
+      BLACKLIST_ENTRY(BlockBasedTableOptions, data_block_index_type),
+      BLACKLIST_ENTRY(BlockBasedTableOptions, data_block_hash_table_util_ratio),
       BLACKLIST_ENTRY(BlockBasedTableOptions, filter_policy),
       BLACKLIST_ENTRY(BlockBasedTableOptions, supported_filter_policies),
   };
@@ -20,20 +20,74 @@
 
 #include <zlib.h>
 
+#ifdef ZSTD
+#include <zstd.h>
+#endif
+
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/algorithm/string/trim.hpp>
 #include <boost/preprocessor/cat.hpp>
 #include <boost/range/iterator_range.hpp>
 
+#include "yb/gutil/strings/split.h"
+
 #include "yb/rpc/circular_read_buffer.h"
 #include "yb/rpc/outbound_data.h"
 #include "yb/rpc/refined_stream.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/monotime.h"
+#include "yb/util/net/net_util.h"
+#include "yb/util/net/sockaddr.h"
 #include "yb/util/size_literals.h"
 
 using namespace std::literals;
 
 DEFINE_int32(stream_compression_algo, 0, "Algorithm used for stream compression. "
-                                         "0 - no compression, 1 - gzip, 2 - snappy, 3 - lz4.");
+                                         "0 - no compression, 1 - gzip, 2 - snappy, 3 - lz4, "
+                                         "4 - zstd.");
+
+DEFINE_string(stream_compression_uncompressed_networks, "",
+              "Comma separated list of networks in CIDR notation, e.g. 10.1.0.0/16. Outbound "
+              "connections to addresses from these networks are not compressed, so compression "
+              "could be enabled only for links between regions.");
+TAG_FLAG(stream_compression_uncompressed_networks, advanced);
+TAG_FLAG(stream_compression_uncompressed_networks, runtime);
+
+DEFINE_int32(stream_compression_zstd_level, 3,
+             "Compression level used by zstd stream compression.");
+TAG_FLAG(stream_compression_zstd_level, advanced);
+TAG_FLAG(stream_compression_zstd_level, runtime);
+
+DEFINE_int32(stream_compression_min_size_bytes, 256,
+             "Data smaller than this size is sent uncompressed by zstd stream compression.");
+TAG_FLAG(stream_compression_min_size_bytes, advanced);
+TAG_FLAG(stream_compression_min_size_bytes, runtime);
+
+DEFINE_double(stream_compression_max_ratio, 0.9,
+              "When data compressed by zstd stream compression is larger than this fraction of its "
+              "original size, the next stream_compression_bypass_sends sends on the connection "
+              "are not compressed.");
+TAG_FLAG(stream_compression_max_ratio, advanced);
+TAG_FLAG(stream_compression_max_ratio, runtime);
+
+DEFINE_int32(stream_compression_bypass_sends, 32,
+             "Number of sends that are not compressed after zstd stream compression could not "
+             "compress data well enough.");
+TAG_FLAG(stream_compression_bypass_sends, advanced);
+TAG_FLAG(stream_compression_bypass_sends, runtime);
+
+DEFINE_int32(stream_compression_fallback_ms, 10 * 60 * 1000,
+             "When a server does not acknowledge zstd stream compression, e.g. it runs an older "
+             "version, connections to it are not compressed for this number of milliseconds.");
+TAG_FLAG(stream_compression_fallback_ms, advanced);
+TAG_FLAG(stream_compression_fallback_ms, runtime);
+
+DEFINE_test_flag(bool, stream_compression_reject_zstd, false,
+                 "Server does not accept zstd stream compression, like an older server.");
 
 namespace yb {
 namespace rpc {
@@ -59,6 +113,15 @@ class Compressor {
   // Connection header associated with this compressor.
   virtual OutboundDataPtr ConnectionHeader() = 0;
 
+  // Whether the server sends connection header back to acknowledge that it supports this
+  // compressor. The client does not send data until acknowledgement is received.
+  virtual bool RequiresAck() const {
+    return false;
+  }
+
+  // Compressor identifier, the last byte of the connection header.
+  virtual char Id() const = 0;
+
   virtual ~Compressor() = default;
 };
 
@@ -152,6 +215,10 @@ class ZlibCompressor : public Compressor {
     return GetConnectionHeader<ZlibCompressor>();
   }
 
+  char Id() const override {
+    return kId;
+  }
+
   CHECKED_STATUS Init() override {
     memset(&deflate_stream_, 0, sizeof(deflate_stream_));
     int res = deflateInit(&deflate_stream_, /* level= */ Z_DEFAULT_COMPRESSION);
@@ -387,6 +454,10 @@ class SnappyCompressor : public Compressor {
     return GetConnectionHeader<SnappyCompressor>();
   }
 
+  char Id() const override {
+    return kId;
+  }
+
   CHECKED_STATUS Init() override {
     return Status::OK();
   }
@@ -669,6 +740,10 @@ class LZ4Compressor : public Compressor {
     return GetConnectionHeader<LZ4Compressor>();
   }
 
+  char Id() const override {
+    return kId;
+  }
+
   CHECKED_STATUS Init() override {
     return Status::OK();
   }
@@ -723,8 +798,246 @@ class LZ4Compressor : public Compressor {
   ScopedTrackedConsumption consumption_;
 };
 
+#if defined(ZSTD) && ZSTD_VERSION_NUMBER >= 10400
+
+// ZSTD stream is split into chunks, each one contains data of a single send and starts with a
+// 4 bytes header. The highest bit of the header tells whether the chunk is compressed, the other
+// bits contain chunk length.
+// Compressed chunks are produced by the same compression stream, flushed at the end of each chunk,
+// so they share history. Small data and data sent after a chunk that was not compressed well are
+// sent uncompressed, to avoid spending CPU on data that does not benefit from compression.
+constexpr size_t kZstdHeaderLen = 4;
+constexpr uint32_t kZstdCompressedFlag = 1U << 31;
+// Limit window size, since each connection has its own compression and decompression contexts.
+constexpr int kZstdWindowLog = 18;
+
+class ZstdCompressor : public Compressor {
+ public:
+  static constexpr char kId = 'Z';
+  static constexpr int kIndex = 4;
+  static constexpr size_t kHeaderLen = kZstdHeaderLen;
+
+  explicit ZstdCompressor(MemTrackerPtr mem_tracker) {
+    if (mem_tracker) {
+      consumption_ = ScopedTrackedConsumption(std::move(mem_tracker), 0);
+    }
+  }
+
+  ~ZstdCompressor() {
+    ZSTD_freeCCtx(cctx_);
+    ZSTD_freeDCtx(dctx_);
+  }
+
+  OutboundDataPtr ConnectionHeader() override {
+    return GetConnectionHeader<ZstdCompressor>();
+  }
+
+  char Id() const override {
+    return kId;
+  }
+
+  bool RequiresAck() const override {
+    return true;
+  }
+
+  CHECKED_STATUS Init() override {
+    cctx_ = ZSTD_createCCtx();
+    dctx_ = ZSTD_createDCtx();
+    if (!cctx_ || !dctx_) {
+      return STATUS(RuntimeError, "Cannot create zstd context");
+    }
+    RETURN_NOT_OK(CheckResult(ZSTD_CCtx_setParameter(
+        cctx_, ZSTD_c_compressionLevel, FLAGS_stream_compression_zstd_level)));
+    RETURN_NOT_OK(CheckResult(ZSTD_CCtx_setParameter(cctx_, ZSTD_c_windowLog, kZstdWindowLog)));
+    RETURN_NOT_OK(CheckResult(ZSTD_DCtx_setParameter(dctx_, ZSTD_d_windowLogMax, kZstdWindowLog)));
+    UpdateConsumption();
+    return Status::OK();
+  }
+
+  std::string ToString() const override {
+    return "Zstd";
+  }
+
+  CHECKED_STATUS Compress(
+      const SmallRefCntBuffers& input, RefinedStream* stream, OutboundDataPtr data) override {
+    auto input_size = TotalLen(input);
+    if (input_size < static_cast<size_t>(FLAGS_stream_compression_min_size_bytes) ||
+        bypass_sends_left_ > 0) {
+      if (bypass_sends_left_ > 0) {
+        --bypass_sends_left_;
+      }
+      return SendUncompressed(input, input_size, stream, std::move(data));
+    }
+
+    RefCntBuffer output(kHeaderLen + ZSTD_compressBound(input_size));
+    ZSTD_outBuffer out_buffer = { output.data() + kHeaderLen, output.size() - kHeaderLen, 0 };
+    for (auto it = input.begin(); it != input.end();) {
+      const auto& buf = *it++;
+      ZSTD_inBuffer in_buffer = { buf.data(), buf.size(), 0 };
+      auto mode = it == input.end() ? ZSTD_e_flush : ZSTD_e_continue;
+      for (;;) {
+        auto res = ZSTD_compressStream2(cctx_, &out_buffer, &in_buffer, mode);
+        RETURN_NOT_OK(CheckResult(res));
+        if (in_buffer.pos == in_buffer.size && (mode == ZSTD_e_continue || res == 0)) {
+          break;
+        }
+        if (out_buffer.pos == out_buffer.size) {
+          return STATUS_FORMAT(
+              RuntimeError, "Not enough space for compressed data: $0", out_buffer.size);
+        }
+      }
+    }
+
+    // Compression context allocates its buffers during the first compression.
+    UpdateConsumption();
+    if (out_buffer.pos > input_size * FLAGS_stream_compression_max_ratio) {
+      bypass_sends_left_ = FLAGS_stream_compression_bypass_sends;
+    }
+    BigEndian::Store32(output.data(), static_cast<uint32_t>(out_buffer.pos) | kZstdCompressedFlag);
+    output.Shrink(kHeaderLen + out_buffer.pos);
+    return stream->SendToLower(std::make_shared<SingleBufferOutboundData>(
+        std::move(output), std::move(data)));
+  }
+
+  Result<ReadBufferFull> Decompress(StreamReadBuffer* inp, StreamReadBuffer* out) override {
+    auto out_vecs = VERIFY_RESULT(out->PrepareAppend());
+    auto out_it = out_vecs.begin();
+    size_t consumed = 0;
+    size_t appended = 0;
+
+    // Decompressor could keep data that did not fit into output during previous call.
+    if (flush_pending_) {
+      Slice input;
+      RETURN_NOT_OK(DecompressSlice(&input, &out_it, out_vecs.end(), &appended));
+    }
+    for (const auto& iov : inp->AppendedVecs()) {
+      Slice input(static_cast<char*>(iov.iov_base), iov.iov_len);
+      RETURN_NOT_OK(DecompressSlice(&input, &out_it, out_vecs.end(), &appended));
+      consumed += iov.iov_len - input.size();
+      if (!input.empty()) {
+        break;
+      }
+    }
+
+    out->DataAppended(appended);
+    inp->Consume(consumed, Slice());
+    UpdateConsumption();
+    return ReadBufferFull(out->Full());
+  }
+
+ private:
+  // Tracks memory allocated by zstd contexts, it depends on window size and grows on first use.
+  void UpdateConsumption() {
+    if (!consumption_) {
+      return;
+    }
+    int64_t consumption = ZSTD_sizeof_CCtx(cctx_) + ZSTD_sizeof_DCtx(dctx_);
+    if (consumption != consumption_.consumption()) {
+      consumption_.Reset(consumption);
+    }
+  }
+
+  // Decompresses input to output io vecs, starting from out_it. Stops when input is fully
+  // consumed or there is no more space in output.
+  template <class It>
+  CHECKED_STATUS DecompressSlice(Slice* input, It* out_it, It out_end, size_t* appended) {
+    while (*out_it != out_end) {
+      if ((*out_it)->iov_len == 0) {
+        ++*out_it;
+        continue;
+      }
+      if (chunk_left_ == 0 && !flush_pending_) {
+        // Header could be split between several input buffers.
+        if (input->empty()) {
+          break;
+        }
+        auto len = std::min(kHeaderLen - header_size_, input->size());
+        memcpy(header_ + header_size_, input->data(), len);
+        input->remove_prefix(len);
+        header_size_ += len;
+        if (header_size_ < kHeaderLen) {
+          break;
+        }
+        header_size_ = 0;
+        auto header = BigEndian::Load32(header_);
+        chunk_compressed_ = (header & kZstdCompressedFlag) != 0;
+        chunk_left_ = header & ~kZstdCompressedFlag;
+        continue;
+      }
+      if (!chunk_compressed_) {
+        if (input->empty()) {
+          break;
+        }
+        auto len = std::min({chunk_left_, input->size(), (*out_it)->iov_len});
+        memcpy((*out_it)->iov_base, input->data(), len);
+        input->remove_prefix(len);
+        IoVecRemovePrefix(len, &**out_it);
+        chunk_left_ -= len;
+        *appended += len;
+        continue;
+      }
+      // Decompressor could keep decompressed data that did not fit into output, so it should
+      // be called even when there is no more input.
+      if (input->empty() && !flush_pending_) {
+        break;
+      }
+      ZSTD_inBuffer in_buffer = { input->data(), std::min(chunk_left_, input->size()), 0 };
+      ZSTD_outBuffer out_buffer = { (*out_it)->iov_base, (*out_it)->iov_len, 0 };
+      RETURN_NOT_OK(CheckResult(ZSTD_decompressStream(dctx_, &out_buffer, &in_buffer)));
+      if (in_buffer.pos == 0 && out_buffer.pos == 0 && !flush_pending_) {
+        return STATUS(RuntimeError, "Decompression does not make progress");
+      }
+      input->remove_prefix(in_buffer.pos);
+      chunk_left_ -= in_buffer.pos;
+      IoVecRemovePrefix(out_buffer.pos, &**out_it);
+      *appended += out_buffer.pos;
+      flush_pending_ = out_buffer.pos == out_buffer.size;
+    }
+    return Status::OK();
+  }
+
+  static CHECKED_STATUS CheckResult(size_t res) {
+    if (ZSTD_isError(res)) {
+      return STATUS_FORMAT(RuntimeError, "Zstd failed: $0", ZSTD_getErrorName(res));
+    }
+    return Status::OK();
+  }
+
+  CHECKED_STATUS SendUncompressed(
+      const SmallRefCntBuffers& input, size_t input_size, RefinedStream* stream,
+      OutboundDataPtr data) {
+    RefCntBuffer output(kHeaderLen + input_size);
+    BigEndian::Store32(output.data(), static_cast<uint32_t>(input_size));
+    auto* pos = output.data() + kHeaderLen;
+    for (const auto& buf : input) {
+      memcpy(pos, buf.data(), buf.size());
+      pos += buf.size();
+    }
+    return stream->SendToLower(std::make_shared<SingleBufferOutboundData>(
+        std::move(output), std::move(data)));
+  }
+
+  ZSTD_CCtx* cctx_ = nullptr;
+  ZSTD_DCtx* dctx_ = nullptr;
+  int bypass_sends_left_ = 0;
+
+  // Decompression state.
+  char header_[kHeaderLen];
+  size_t header_size_ = 0;
+  size_t chunk_left_ = 0;
+  bool chunk_compressed_ = false;
+  bool flush_pending_ = false;
+
+  ScopedTrackedConsumption consumption_;
+};
+
+#define YB_ZSTD_COMPRESSION_ALGORITHM (Zstd)
+#else
+#define YB_ZSTD_COMPRESSION_ALGORITHM
+#endif
+
 #undef LZ4
-#define YB_COMPRESSION_ALGORITHMS (Zlib)(Snappy)(LZ4)
+#define YB_COMPRESSION_ALGORITHMS (Zlib)(Snappy)(LZ4) YB_ZSTD_COMPRESSION_ALGORITHM
 
 #define YB_CREATE_COMPRESSOR_CASE(r, data, name) \
   case BOOST_PP_CAT(name, Compressor)::data: \
@@ -738,11 +1051,93 @@ BOOST_PP_SEQ_FOR_EACH(YB_CREATE_COMPRESSOR_CASE, kId, YB_COMPRESSION_ALGORITHMS)
   }
 }
 
-std::unique_ptr<Compressor> CreateOutboundCompressor(MemTrackerPtr mem_tracker) {
-  auto algo = FLAGS_stream_compression_algo;
-  if (!algo) {
-    return nullptr;
+template <class Bytes>
+bool HasPrefix(const Bytes& address, const Bytes& network, size_t prefix_len) {
+  for (size_t i = 0; i != address.size() && prefix_len > 0; ++i) {
+    auto bits = std::min<size_t>(prefix_len, 8);
+    uint8_t mask = 0xff << (8 - bits);
+    if ((address[i] ^ network[i]) & mask) {
+      return false;
+    }
+    prefix_len -= bits;
+  }
+  return true;
+}
+
+// Checks whether address belongs to network specified in CIDR notation.
+Result<bool> IsInNetwork(const IpAddress& address, const std::string& network) {
+  auto pos = network.find('/');
+  auto network_address = VERIFY_RESULT(ParseIpAddress(network.substr(0, pos)));
+  size_t max_prefix_len = network_address.is_v4() ? 32 : 128;
+  size_t prefix_len = max_prefix_len;
+  if (pos != std::string::npos) {
+    auto prefix_str = network.substr(pos + 1);
+    char* end = nullptr;
+    prefix_len = strtoul(prefix_str.c_str(), &end, 10);
+    if (prefix_str.empty() || *end || prefix_len > max_prefix_len) {
+      return STATUS_FORMAT(InvalidArgument, "Invalid network: $0", network);
+    }
+  }
+  if (address.is_v4() != network_address.is_v4()) {
+    return false;
+  }
+  if (address.is_v4()) {
+    return HasPrefix(address.to_v4().to_bytes(), network_address.to_v4().to_bytes(), prefix_len);
+  }
+  return HasPrefix(address.to_v6().to_bytes(), network_address.to_v6().to_bytes(), prefix_len);
+}
+
+bool IsUncompressedAddress(const IpAddress& address) {
+  std::vector<std::string> networks = strings::Split(
+      FLAGS_stream_compression_uncompressed_networks, ",", strings::SkipWhitespace());
+  for (const auto& network : networks) {
+    auto result = IsInNetwork(address, boost::trim_copy(network));
+    if (!result.ok()) {
+      YB_LOG_EVERY_N_SECS(WARNING, 10) << "Bad stream_compression_uncompressed_networks: "
+                                       << result.status();
+      continue;
+    }
+    if (*result) {
+      return true;
+    }
   }
+  return false;
+}
+
+// Remote endpoints that closed connection without acknowledging compression, with the time until
+// which connections to them are not compressed.
+class UnacknowledgedEndpoints {
+ public:
+  void Add(const Endpoint& endpoint) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    endpoints_[endpoint] =
+        CoarseMonoClock::now() + FLAGS_stream_compression_fallback_ms * 1ms;
+  }
+
+  bool Contains(const Endpoint& endpoint) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = endpoints_.find(endpoint);
+    if (it == endpoints_.end()) {
+      return false;
+    }
+    if (it->second <= CoarseMonoClock::now()) {
+      endpoints_.erase(it);
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<Endpoint, CoarseTimePoint, EndpointHash> endpoints_;
+};
+
+UnacknowledgedEndpoints& unacknowledged_endpoints() {
+  static UnacknowledgedEndpoints result;
+  return result;
+}
+
+std::unique_ptr<Compressor> DoCreateOutboundCompressor(int algo, MemTrackerPtr mem_tracker) {
   switch (algo) {
 BOOST_PP_SEQ_FOR_EACH(YB_CREATE_COMPRESSOR_CASE, kIndex, YB_COMPRESSION_ALGORITHMS)
     default:
@@ -751,9 +1146,34 @@ BOOST_PP_SEQ_FOR_EACH(YB_CREATE_COMPRESSOR_CASE, kIndex, YB_COMPRESSION_ALGORITH
   }
 }
 
+std::unique_ptr<Compressor> CreateOutboundCompressor(
+    const Endpoint& remote, MemTrackerPtr mem_tracker) {
+  auto algo = FLAGS_stream_compression_algo;
+  if (!algo || IsUncompressedAddress(remote.address())) {
+    return nullptr;
+  }
+  auto result = DoCreateOutboundCompressor(algo, std::move(mem_tracker));
+  if (result && result->RequiresAck() && unacknowledged_endpoints().Contains(remote)) {
+    YB_LOG_EVERY_N_SECS(INFO, 60) << "Not compressing connection to " << remote
+                                  << ", since it did not acknowledge " << result->ToString();
+    return nullptr;
+  }
+  return result;
+}
+
 class CompressedRefiner : public StreamRefiner {
  public:
-  CompressedRefiner() = default;
+  explicit CompressedRefiner(const Endpoint& remote) : remote_(remote) {}
+
+  ~CompressedRefiner() {
+    if (waiting_ack_) {
+      // Server closed connection without acknowledging compression, most likely because it does
+      // not support it. So fall back to the plain stream for following connections.
+      LOG(INFO) << "Server " << remote_ << " did not acknowledge " << compressor_->ToString()
+                << " stream compression";
+      unacknowledged_endpoints().Add(remote_);
+    }
+  }
 
  private:
   void Start(RefinedStream* stream) override {
@@ -773,10 +1193,17 @@ class CompressedRefiner : public StreamRefiner {
     const auto* bytes = static_cast<const uint8_t*>(data[0].iov_base);
     if (bytes[0] == 'Y' && bytes[1] == 'B') {
       compressor_ = CreateCompressor(bytes[2], stream_->buffer_tracker());
+      if (compressor_ && compressor_->RequiresAck() &&
+          FLAGS_TEST_stream_compression_reject_zstd) {
+        compressor_.reset();
+      }
       if (compressor_) {
         RETURN_NOT_OK(compressor_->Init());
         RETURN_NOT_OK(stream_->StartHandshake());
         stream_->ReadBuffer().Consume(kHeaderLen, Slice());
+        if (compressor_->RequiresAck()) {
+          RETURN_NOT_OK(stream_->SendToLower(compressor_->ConnectionHeader()));
+        }
         return Status::OK();
       }
     }
@@ -793,17 +1220,52 @@ class CompressedRefiner : public StreamRefiner {
 
   CHECKED_STATUS Handshake() override {
     if (stream_->local_side() == LocalSide::kClient) {
-      compressor_ = CreateOutboundCompressor(stream_->buffer_tracker());
+      if (waiting_ack_) {
+        return ProcessAck();
+      }
+      compressor_ = CreateOutboundCompressor(remote_, stream_->buffer_tracker());
       if (!compressor_) {
         return stream_->Established(RefinedStreamState::kDisabled);
       }
       RETURN_NOT_OK(compressor_->Init());
       RETURN_NOT_OK(stream_->SendToLower(compressor_->ConnectionHeader()));
+      if (compressor_->RequiresAck()) {
+        waiting_ack_ = true;
+        return Status::OK();
+      }
     }
 
     return stream_->Established(RefinedStreamState::kEnabled);
   }
 
+  // Checks that the server sent back the same connection header, i.e. it supports the compressor.
+  CHECKED_STATUS ProcessAck() {
+    constexpr size_t kHeaderLen = 3;
+
+    // Header could be split between several buffers.
+    char header[kHeaderLen];
+    size_t header_size = 0;
+    for (const auto& iov : stream_->ReadBuffer().AppendedVecs()) {
+      auto len = std::min(kHeaderLen - header_size, iov.iov_len);
+      memcpy(header + header_size, iov.iov_base, len);
+      header_size += len;
+      if (header_size == kHeaderLen) {
+        break;
+      }
+    }
+    if (header_size < kHeaderLen) {
+      return Status::OK();
+    }
+    if (header[0] != 'Y' || header[1] != 'B' || header[2] != compressor_->Id()) {
+      return STATUS_FORMAT(
+          NetworkError, "Unexpected compressed stream acknowledgement: $0",
+          Slice(header, kHeaderLen).ToDebugHexString());
+    }
+    stream_->ReadBuffer().Consume(kHeaderLen, Slice());
+    waiting_ack_ = false;
+    return stream_->Established(RefinedStreamState::kEnabled);
+  }
+
   Result<ReadBufferFull> Read(StreamReadBuffer* out) override {
     VLOG_WITH_PREFIX(4) << __func__;
 
@@ -822,8 +1284,11 @@ class CompressedRefiner : public StreamRefiner {
     return stream_->LogPrefix();
   }
 
+  const Endpoint remote_;
   RefinedStream* stream_ = nullptr;
   std::unique_ptr<Compressor> compressor_ = nullptr;
+  // Client sent connection header and waits for the server to acknowledge it.
+  bool waiting_ack_ = false;
 };
 
 } // namespace
@@ -837,7 +1302,7 @@ StreamFactoryPtr CompressedStreamFactory(
     StreamFactoryPtr lower_layer_factory, const MemTrackerPtr& buffer_tracker) {
   return std::make_shared<RefinedStreamFactory>(
       std::move(lower_layer_factory), buffer_tracker, [](const StreamCreateData& data) {
-    return std::make_unique<CompressedRefiner>();
+    return std::make_unique<CompressedRefiner>(data.remote);
   });
 }
 
@@ -36,6 +36,9 @@ LocalOutboundCall::LocalOutboundCall(
 
 Status LocalOutboundCall::SetRequestParam(
     const google::protobuf::Message& req, const MemTrackerPtr& mem_tracker) {
+  if (controller()->has_serialized_request_fields()) {
+    return STATUS(NotSupported, "Local call does not support serialized request fields");
+  }
   req_ = &req;
   return Status::OK();
 }
@@ -375,6 +375,7 @@ void Messenger::ShutdownAcceptor() {
 rpc::ThreadPool& Messenger::ThreadPool(ServicePriority priority) {
   switch (priority) {
     case ServicePriority::kNormal:
+    case ServicePriority::kLow:
       return *normal_thread_pool_;
     case ServicePriority::kHigh:
       auto high_priority_thread_pool = high_priority_thread_pool_.get();
@@ -207,6 +207,10 @@ void OutboundCall::NotifyTransferred(const Status& status, Connection* conn) {
 void OutboundCall::Serialize(boost::container::small_vector_base<RefCntBuffer>* output) {
   output->push_back(std::move(buffer_));
   buffer_consumption_ = ScopedTrackedConsumption();
+  for (auto& buffer : serialized_request_fields_) {
+    output->push_back(std::move(buffer));
+  }
+  serialized_request_fields_.clear();
 }
 
 Status OutboundCall::SetRequestParam(
@@ -214,10 +218,18 @@ Status OutboundCall::SetRequestParam(
   using serialization::SerializeHeader;
   using serialization::SerializeMessage;
 
+  // Fields serialized by the caller are sent as is after the message, without copying.
+  serialized_request_fields_ = std::move(controller_->serialized_request_fields_);
+  controller_->serialized_request_fields_.clear();
+  size_t fields_size = 0;
+  for (const auto& buffer : serialized_request_fields_) {
+    fields_size += buffer.size();
+  }
+
   size_t message_size = 0;
   auto status = SerializeMessage(message,
                                  /* param_buf */ nullptr,
-                                 /* additional_size */ 0,
+                                 /* additional_size */ static_cast<int>(fields_size),
                                  /* use_cached_size */ false,
                                  /* offset */ 0,
                                  &message_size);
@@ -236,9 +248,9 @@ Status OutboundCall::SetRequestParam(
       kMsgLengthPrefixLength                            // Int prefix for the total length.
       + CodedOutputStream::VarintSize32(header_pb_len)  // Varint delimiter for header PB.
       + header_pb_len;                                  // Length for the header PB itself.
-  size_t total_size = header_size + message_size;
+  size_t total_size = header_size + message_size + fields_size;
 
-  buffer_ = RefCntBuffer(total_size);
+  buffer_ = RefCntBuffer(header_size + message_size);
   uint8_t* dst = buffer_.udata();
 
   // 1. The length for the whole request, not including the 4-byte
@@ -262,9 +274,10 @@ Status OutboundCall::SetRequestParam(
   }
 
   RETURN_NOT_OK(SerializeMessage(
-      message, &buffer_, /* additional_size */ 0, /* use_cached_size */ true, header_size));
+      message, &buffer_, /* additional_size */ static_cast<int>(fields_size),
+      /* use_cached_size */ true, header_size));
   if (method_metrics_) {
-    IncrementCounterBy(method_metrics_->request_bytes, buffer_.size());
+    IncrementCounterBy(method_metrics_->request_bytes, total_size);
   }
   return Status::OK();
 }
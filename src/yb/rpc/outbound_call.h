@@ -400,6 +400,10 @@ class OutboundCall : public RpcCall {
   // Consumption of buffer_.
   ScopedTrackedConsumption buffer_consumption_;
 
+  // Serialized request fields provided by the caller, sent after buffer_. They are shared with
+  // the caller, so their memory is not tracked by the call.
+  std::vector<RefCntBuffer> serialized_request_fields_;
+
   // Once a response has been received for this call, contains that response.
   CallResponse call_response_;
 
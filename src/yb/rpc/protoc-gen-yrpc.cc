@@ -563,10 +563,7 @@ class CodeGenerator : public ::google::protobuf::compiler::CodeGenerator {
           "      auto rpc_context = yb_call->IsLocalCall() ?\n"
           "          ::yb::rpc::RpcContext(\n"
           "              std::static_pointer_cast<::yb::rpc::LocalYBInboundCall>(yb_call)) :\n"
-          "          ::yb::rpc::RpcContext(\n"
-          "              yb_call, \n"
-          "              std::make_shared<$request$>(),\n"
-          "              std::make_shared<$response$>());\n"
+          "          ::yb::rpc::RpcContext::Create<$request$, $response$>(yb_call);\n"
           "      if (!rpc_context.responded()) {\n"
           "        const auto* req = static_cast<const $request$*>(rpc_context.request_pb());\n"
           "        auto* resp = static_cast<$response$*>(rpc_context.response_pb());\n"
@@ -40,6 +40,8 @@
 #include "yb/util/countdown_latch.h"
 #include "yb/util/test_util.h"
 
+DECLARE_bool(rpc_skip_drained_socket_syscalls);
+
 using namespace std::literals; // NOLINT
 
 using std::string;
@@ -55,6 +57,10 @@ class RpcBench : public RpcTestBase {
  protected:
   friend class ClientThread;
 
+  // Runs client threads that send calls to the server for the specified time and logs
+  // throughput and CPU usage.
+  void RunClients(std::chrono::steady_clock::duration duration);
+
   HostPort server_hostport_;
   std::atomic<bool> should_run_{true};
 };
@@ -99,21 +105,7 @@ class ClientThread {
   int request_count_;
 };
 
-
-// Test making successful RPC calls.
-TEST_F(RpcBench, BenchmarkCalls) {
-  TestServerOptions options;
-  options.n_worker_threads = 1;
-
-  // Set up server.
-  StartTestServerWithGeneratedCode(&server_hostport_);
-
-  // Set up client.
-  LOG(INFO) << "Connecting to " << server_hostport_;
-  MessengerOptions client_options = kDefaultClientMessengerOptions;
-  client_options.n_reactors = 2;
-  auto client_messenger = CreateAutoShutdownMessengerHolder("Client", client_options);
-
+void RpcBench::RunClients(std::chrono::steady_clock::duration duration) {
   Stopwatch sw(Stopwatch::ALL_THREADS);
   sw.start();
 
@@ -129,7 +121,7 @@ TEST_F(RpcBench, BenchmarkCalls) {
     threads.push_back(std::move(thr));
   }
 
-  std::this_thread::sleep_for(10s);
+  std::this_thread::sleep_for(duration);
   should_run_.store(false, std::memory_order_release);
 
   int total_reqs = 0;
@@ -149,6 +141,38 @@ TEST_F(RpcBench, BenchmarkCalls) {
   LOG(INFO) << "Sys CPU per req:  " << sys_cpu_micros_per_req << "us";
 }
 
+
+// Test making successful RPC calls.
+TEST_F(RpcBench, BenchmarkCalls) {
+  TestServerOptions options;
+  options.n_worker_threads = 1;
+
+  // Set up server.
+  StartTestServerWithGeneratedCode(&server_hostport_);
+
+  // Set up client.
+  LOG(INFO) << "Connecting to " << server_hostport_;
+  MessengerOptions client_options = kDefaultClientMessengerOptions;
+  client_options.n_reactors = 2;
+  auto client_messenger = CreateAutoShutdownMessengerHolder("Client", client_options);
+
+  RunClients(10s);
+}
+
+// Compares calls with and without skipping recv/send after a short read or write, on the same
+// server.
+TEST_F(RpcBench, BenchmarkSkipDrainedSocketSyscalls) {
+  google::FlagSaver flag_saver;
+  StartTestServerWithGeneratedCode(&server_hostport_);
+
+  for (auto skip : {false, true}) {
+    FLAGS_rpc_skip_drained_socket_syscalls = skip;
+    LOG(INFO) << "rpc_skip_drained_socket_syscalls: " << skip;
+    should_run_.store(true, std::memory_order_release);
+    RunClients(10s);
+  }
+}
+
 } // namespace rpc
 } // namespace yb
 
@@ -43,6 +43,10 @@
 
 #include <gtest/gtest.h>
 
+#ifdef ZSTD
+#include <zstd.h>
+#endif
+
 #if defined(TCMALLOC_ENABLED)
 #include <gperftools/heap-profiler.h>
 #endif
@@ -60,6 +64,7 @@
 #include "yb/util/countdown_latch.h"
 #include "yb/util/env.h"
 #include "yb/util/logging_test_util.h"
+#include "yb/util/random_util.h"
 #include "yb/util/test_util.h"
 
 #include "yb/util/memory/memory_usage_test_util.h"
@@ -74,12 +79,19 @@ DEFINE_int32(rpc_test_connection_keepalive_num_iterations, 1,
   "Number of iterations in TestRpc.TestConnectionKeepalive");
 
 DECLARE_bool(TEST_pause_calculator_echo_request);
+DECLARE_bool(TEST_stream_compression_reject_zstd);
 DECLARE_bool(binary_call_parser_reject_on_mem_tracker_hard_limit);
 DECLARE_bool(enable_rpc_keepalive);
+DECLARE_bool(rpc_service_pool_scheduling);
+DECLARE_bool(rpc_skip_drained_socket_syscalls);
 DECLARE_int32(num_connections_to_server);
+DECLARE_int32(rpc_queue_overload_interval_ms);
 DECLARE_int32(rpc_throttle_threshold_bytes);
 DECLARE_int32(stream_compression_algo);
+DECLARE_int32(stream_compression_bypass_sends);
+DECLARE_int32(stream_compression_min_size_bytes);
 DECLARE_int64(memory_limit_hard_bytes);
+DECLARE_string(stream_compression_uncompressed_networks);
 DECLARE_string(vmodule);
 DECLARE_uint64(rpc_connection_timeout_ms);
 DECLARE_uint64(rpc_read_buffer_size);
@@ -785,6 +797,61 @@ TEST_F(TestRpc, QueueTimeout) {
   ASSERT_EQ(counter->value(), kCalls - 1);
 }
 
+// Send calls with different timeouts to a single busy worker thread, and check that they are
+// handled in the order of their deadlines instead of the order of their arrival.
+TEST_F(TestRpc, EarliestDeadlineFirst) {
+  FLAGS_rpc_service_pool_scheduling = true;
+  // Avoid switching to newest first order when test is slow.
+  FLAGS_rpc_queue_overload_interval_ms = 60000;
+  const MonoDelta kBusySleep = 500ms;
+  const std::vector<int> kTimeoutsSec = {3, 5, 1, 4, 2};
+
+  TestServerOptions options;
+  options.n_worker_threads = 1;
+  HostPort server_addr;
+  StartTestServerWithGeneratedCode(&server_addr, options);
+
+  auto client_messenger = CreateAutoShutdownMessengerHolder("Client");
+  Proxy p(client_messenger.get(), server_addr);
+
+  const auto* method = CalculatorServiceMethods::SleepMethod();
+
+  struct Call {
+    rpc_test::SleepRequestPB req;
+    rpc_test::SleepResponsePB resp;
+    RpcController controller;
+  };
+  std::vector<Call> calls(kTimeoutsSec.size() + 1);
+  CountDownLatch latch(calls.size());
+  std::mutex mutex;
+  std::vector<int> handled_timeouts;
+
+  for (size_t i = 0; i != calls.size(); ++i) {
+    auto& call = calls[i];
+    // The first call occupies the worker thread, while others are queued.
+    auto timeout_sec = i == 0 ? 10 : kTimeoutsSec[i - 1];
+    call.req.set_sleep_micros(i == 0 ? kBusySleep.ToMicroseconds() : 0);
+    call.controller.set_timeout(timeout_sec * 1s);
+    p.AsyncRequest(method, /* method_metrics= */ nullptr, call.req, &call.resp, &call.controller,
+        [&latch, &call, &mutex, &handled_timeouts, timeout_sec] {
+      EXPECT_OK(call.controller.status());
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        handled_timeouts.push_back(timeout_sec);
+      }
+      latch.CountDown();
+    });
+    if (i == 0) {
+      std::this_thread::sleep_for((kBusySleep / 5).ToSteadyDuration());
+    }
+  }
+
+  latch.Wait();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_EQ(handled_timeouts, std::vector<int>({10, 1, 2, 3, 4, 5}));
+}
+
 struct DisconnectShare {
   Proxy proxy;
   size_t left;
@@ -905,6 +972,146 @@ TEST_F(TestRpc, DumpTimedOutCall) {
   thread.join();
 }
 
+namespace {
+
+YB_STRONGLY_TYPED_BOOL(Paused);
+
+// Relays single TCP connection to target server. Data is passed in chunks of limited size with
+// delay between them, so receiver gets short reads that drain its socket, followed by more data
+// arriving later. Relaying data from client could be paused, so client fills its socket send
+// buffer.
+class TcpRelay {
+ public:
+  TcpRelay(size_t chunk_size, std::chrono::milliseconds chunk_delay, Paused paused)
+      : chunk_size_(chunk_size), chunk_delay_(chunk_delay), paused_(paused) {}
+
+  ~TcpRelay() {
+    stop_.store(true, std::memory_order_release);
+    if (accept_thread_.joinable()) {
+      accept_thread_.join();
+    }
+    if (reverse_thread_.joinable()) {
+      reverse_thread_.join();
+    }
+  }
+
+  // Accepts connection on listen_sock in background and relays it to target.
+  CHECKED_STATUS Start(Socket* listen_sock, const HostPort& target) {
+    Endpoint target_endpoint;
+    RETURN_NOT_OK(EndpointFromHostPort(target, &target_endpoint));
+    RETURN_NOT_OK(server_.Init(0));
+    RETURN_NOT_OK(server_.Connect(target_endpoint));
+    RETURN_NOT_OK(server_.SetRecvTimeout(100ms));
+    // Also limits time that accept waits for connection.
+    RETURN_NOT_OK(listen_sock->SetRecvTimeout(10s * kTimeMultiplier));
+
+    accept_thread_ = std::thread([this, listen_sock] {
+      Endpoint remote;
+      auto status = listen_sock->Accept(&client_, &remote, 0);
+      if (!status.ok()) {
+        LOG(WARNING) << "Accept failed: " << status;
+        return;
+      }
+      CHECK_OK(client_.SetRecvTimeout(100ms));
+      reverse_thread_ = std::thread([this] {
+        Forward(&server_, &client_, /* pausable= */ false);
+      });
+      Forward(&client_, &server_, /* pausable= */ true);
+    });
+    return Status::OK();
+  }
+
+  void Resume() {
+    paused_.store(false, std::memory_order_release);
+  }
+
+ private:
+  void Forward(Socket* from, Socket* to, bool pausable) {
+    std::vector<uint8_t> buffer(chunk_size_);
+    while (!stop_.load(std::memory_order_acquire)) {
+      if (pausable && paused_.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(10ms);
+        continue;
+      }
+      auto received = from->Recv(buffer.data(), static_cast<int32_t>(buffer.size()));
+      if (!received.ok()) {
+        if (received.status().IsTryAgain()) {
+          continue;
+        }
+        break;
+      }
+      size_t written = 0;
+      auto deadline = MonoTime::Now() + 10s * kTimeMultiplier;
+      if (!to->BlockingWrite(buffer.data(), *received, &written, deadline).ok()) {
+        break;
+      }
+      std::this_thread::sleep_for(chunk_delay_);
+    }
+  }
+
+  const size_t chunk_size_;
+  const std::chrono::milliseconds chunk_delay_;
+  std::atomic<bool> paused_;
+  std::atomic<bool> stop_{false};
+  Socket client_;
+  Socket server_;
+  std::thread accept_thread_;
+  std::thread reverse_thread_;
+};
+
+void TestEchoViaRelay(
+    RpcTestBase* test, size_t chunk_size, std::chrono::milliseconds chunk_delay, Paused paused,
+    size_t data_size) {
+  HostPort server_hostport;
+  test->StartTestServerWithGeneratedCode(&server_hostport);
+
+  HostPort relay_hostport;
+  Socket listen_sock;
+  ASSERT_OK(test->StartFakeServer(&listen_sock, &relay_hostport));
+  TcpRelay relay(chunk_size, chunk_delay, paused);
+  ASSERT_OK(relay.Start(&listen_sock, server_hostport));
+
+  auto client_messenger = test->CreateAutoShutdownMessengerHolder("Client");
+  ProxyCache proxy_cache(client_messenger.get());
+  CalculatorServiceProxy proxy(
+      &proxy_cache, relay_hostport, client_messenger->DefaultProtocol());
+
+  rpc_test::EchoRequestPB req;
+  req.set_data(RandomHumanReadableString(data_size));
+  rpc_test::EchoResponsePB resp;
+  RpcController controller;
+  controller.set_timeout(60s * kTimeMultiplier);
+  CountDownLatch latch(1);
+  proxy.EchoAsync(req, &resp, &controller, latch.CountDownCallback());
+
+  if (paused) {
+    // Request does not fit into socket buffers, so it cannot be sent completely while relay
+    // does not read it.
+    ASSERT_FALSE(latch.WaitFor(500ms));
+    relay.Resume();
+  }
+
+  latch.Wait();
+  ASSERT_OK(controller.status());
+  ASSERT_EQ(req.data(), resp.data());
+}
+
+} // namespace
+
+// Request and response arrive in small chunks, so both sides see short reads that drain the
+// socket, and have to continue reading when the next chunk arrives.
+TEST_F(TestRpc, PartialReadThenMoreData) {
+  FLAGS_rpc_skip_drained_socket_syscalls = true;
+  TestEchoViaRelay(this, 1_KB, 1ms, Paused::kFalse, 256_KB);
+}
+
+// Relay does not read request until client fills its socket send buffer, so client write is
+// partial and has to continue when socket becomes writable.
+TEST_F(TestRpc, PartialWriteOnFullSocketBuffer) {
+  FLAGS_rpc_skip_drained_socket_syscalls = true;
+  TestEchoViaRelay(this, 64_KB, 0ms, Paused::kTrue, 32_MB);
+}
+
 #if defined(TCMALLOC_ENABLED)
 
 namespace {
@@ -1214,8 +1421,7 @@ class TestRpcCompression : public RpcTestBase, public testing::WithParamInterfac
     auto builder = CreateMessengerBuilder(name, options);
     builder.SetListenProtocol(CompressedStreamProtocol());
     builder.AddStreamFactory(
-        CompressedStreamProtocol(),
-        CompressedStreamFactory(TcpStream::Factory(), MemTracker::GetRootTracker()));
+        CompressedStreamProtocol(), CompressedStreamFactory(TcpStream::Factory(), buffer_tracker_));
     return EXPECT_RESULT(builder.Build());
   }
 
@@ -1226,6 +1432,8 @@ class TestRpcCompression : public RpcTestBase, public testing::WithParamInterfac
       return CreateCompressedMessenger(name, options);
     }, f);
   }
+
+  MemTrackerPtr buffer_tracker_ = MemTracker::GetRootTracker();
 };
 
 TEST_P(TestRpcCompression, Simple) {
@@ -1253,7 +1461,11 @@ TEST_P(TestRpcCompression, CantAllocateReadBuffer) {
   RunCompressionTest(&TestCantAllocateReadBuffer, SetupServerForTestCantAllocateReadBuffer());
 }
 
-void TestCompression(CalculatorServiceProxy* proxy, const MetricEntityPtr& metric_entity) {
+YB_STRONGLY_TYPED_BOOL(ExpectCompressed);
+
+void TestCompression(
+    CalculatorServiceProxy* proxy, const MetricEntityPtr& metric_entity,
+    ExpectCompressed expect_compressed = ExpectCompressed::kTrue) {
   constexpr size_t kStringLen = 4_KB;
 
   size_t prev_sent = 0;
@@ -1278,9 +1490,14 @@ void TestCompression(CalculatorServiceProxy* proxy, const MetricEntityPtr& metri
       LOG(INFO) << "Sent: " << sent << ", received: " << received;
 
       ASSERT_GT(sent, 10); // Check that metric even work.
-      ASSERT_LE(sent, kStringLen / 5); // Check that compression work.
       ASSERT_GT(received, 10); // Check that metric even work.
-      ASSERT_LE(received, kStringLen / 5); // Check that compression work.
+      if (expect_compressed) {
+        ASSERT_LE(sent, kStringLen / 5); // Check that compression work.
+        ASSERT_LE(received, kStringLen / 5); // Check that compression work.
+      } else {
+        ASSERT_GT(sent, kStringLen);
+        ASSERT_GT(received, kStringLen);
+      }
       break;
     }
 
@@ -1295,16 +1512,136 @@ TEST_P(TestRpcCompression, Compression) {
   });
 }
 
+// Connections to addresses from uncompressed networks should not be compressed.
+TEST_P(TestRpcCompression, UncompressedNetworks) {
+  FLAGS_stream_compression_uncompressed_networks = "10.0.0.0/8, 127.0.0.0/8";
+  RunCompressionTest([this](CalculatorServiceProxy* proxy) {
+    TestCompression(proxy, metric_entity(), ExpectCompressed::kFalse);
+  });
+}
+
+// Server that does not support compression requiring acknowledgement closes the connection, then
+// the client should fall back to the plain stream.
+TEST_P(TestRpcCompression, Unacknowledged) {
+  // Only zstd requires acknowledgement.
+  if (GetParam() != 4) {
+    return;
+  }
+  FLAGS_TEST_stream_compression_reject_zstd = true;
+  RunCompressionTest([this](CalculatorServiceProxy* proxy) {
+    ASSERT_OK(WaitFor([proxy] {
+      RpcController controller;
+      controller.set_timeout(1s * kTimeMultiplier);
+      rpc_test::EchoRequestPB req;
+      req.set_data("ping");
+      rpc_test::EchoResponsePB resp;
+      return proxy->Echo(req, &resp, &controller).ok();
+    }, 10s * kTimeMultiplier, "Echo with plain stream"));
+    TestCompression(proxy, metric_entity(), ExpectCompressed::kFalse);
+  });
+}
+
+// Chunk headers of compressed stream should be handled when they are split between read buffers.
+TEST_P(TestRpcCompression, SplitHeaders) {
+  FLAGS_rpc_read_buffer_size = 131;
+  FLAGS_stream_compression_min_size_bytes = 64;
+  RunCompressionTest([](CalculatorServiceProxy* proxy) {
+    std::mt19937_64 rng(42);
+    for (size_t len = 1; len < 2_KB; len += 37) {
+      RpcController controller;
+      controller.set_timeout(5s * kTimeMultiplier);
+      rpc_test::EchoRequestPB req;
+      req.set_data(RandomHumanReadableString(len, &rng));
+      rpc_test::EchoResponsePB resp;
+      ASSERT_OK(proxy->Echo(req, &resp, &controller));
+      ASSERT_EQ(req.data(), resp.data());
+    }
+  });
+}
+
+// Memory used by zstd contexts should be tracked by buffer tracker.
+TEST_P(TestRpcCompression, ZstdMemoryTracking) {
+  if (GetParam() != 4) {
+    return;
+  }
+  // Make read buffers small, so tracked memory is mostly used by zstd contexts.
+  FLAGS_rpc_read_buffer_size = 128;
+  buffer_tracker_ = MemTracker::CreateTracker("compressed_stream");
+  RunCompressionTest([this](CalculatorServiceProxy* proxy) {
+    TestCompression(proxy, metric_entity());
+    LOG(INFO) << "Tracked memory: " << buffer_tracker_->consumption();
+    // Each zstd decompression context keeps at least its window.
+    ASSERT_GT(buffer_tracker_->consumption(), 1 << 18);
+  });
+}
+
+// Zstd should send data smaller than stream_compression_min_size_bytes uncompressed.
+TEST_P(TestRpcCompression, ZstdMinSize) {
+  if (GetParam() != 4) {
+    return;
+  }
+  FLAGS_stream_compression_min_size_bytes = 64_KB;
+  RunCompressionTest([this](CalculatorServiceProxy* proxy) {
+    TestCompression(proxy, metric_entity(), ExpectCompressed::kFalse);
+  });
+}
+
+// Sends incompressible data over each connection, so zstd compressor switches to bypass mode.
+void SendIncompressible(CalculatorServiceProxy* proxy) {
+  std::mt19937_64 rng(42);
+  for (int i = 0; i != FLAGS_num_connections_to_server; ++i) {
+    RpcController controller;
+    controller.set_timeout(5s * kTimeMultiplier);
+    rpc_test::EchoRequestPB req;
+    req.set_data(RandomString(4_KB, &rng));
+    rpc_test::EchoResponsePB resp;
+    ASSERT_OK(proxy->Echo(req, &resp, &controller));
+    ASSERT_EQ(req.data(), resp.data());
+  }
+}
+
+// After data that was not compressed well, zstd should not compress the following sends.
+TEST_P(TestRpcCompression, ZstdRatioBypass) {
+  if (GetParam() != 4) {
+    return;
+  }
+  FLAGS_stream_compression_bypass_sends = 1000;
+  RunCompressionTest([this](CalculatorServiceProxy* proxy) {
+    ASSERT_NO_FATALS(SendIncompressible(proxy));
+    TestCompression(proxy, metric_entity(), ExpectCompressed::kFalse);
+  });
+}
+
+// Without bypass, compressible data after incompressible should be compressed again.
+TEST_P(TestRpcCompression, ZstdNoRatioBypass) {
+  if (GetParam() != 4) {
+    return;
+  }
+  FLAGS_stream_compression_bypass_sends = 0;
+  RunCompressionTest([this](CalculatorServiceProxy* proxy) {
+    ASSERT_NO_FATALS(SendIncompressible(proxy));
+    TestCompression(proxy, metric_entity());
+  });
+}
+
 std::string CompressionName(const testing::TestParamInfo<int>& info) {
   switch (info.param) {
     case 1: return "Zlib";
     case 2: return "Snappy";
     case 3: return "LZ4";
+    case 4: return "Zstd";
   }
   return Format("Unknown compression $0", info.param);
 }
 
-INSTANTIATE_TEST_CASE_P(, TestRpcCompression, testing::Range(1, 4), CompressionName);
+#if defined(ZSTD) && ZSTD_VERSION_NUMBER >= 10400
+constexpr int kNumCompressionAlgorithms = 4;
+#else
+constexpr int kNumCompressionAlgorithms = 3;
+#endif
+
+INSTANTIATE_TEST_CASE_P(
+    , TestRpcCompression, testing::Range(1, kNumCompressionAlgorithms + 1), CompressionName);
 
 class TestRpcSecureCompression : public TestRpcSecure {
  public:
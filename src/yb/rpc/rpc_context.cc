@@ -47,12 +47,19 @@
 #include "yb/util/metrics.h"
 #include "yb/util/trace.h"
 #include "yb/util/debug/trace_event.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/jsonwriter.h"
 #include "yb/util/pb_util.h"
 
 using google::protobuf::Message;
 DECLARE_int32(rpc_max_message_size);
 
+DEFINE_bool(rpc_use_call_arena, true,
+            "Allocate request and response of inbound calls in a protobuf arena, that is freed "
+            "when the call completes.");
+TAG_FLAG(rpc_use_call_arena, advanced);
+TAG_FLAG(rpc_use_call_arena, runtime);
+
 namespace yb {
 namespace rpc {
 
@@ -89,6 +96,20 @@ scoped_refptr<debug::ConvertableToTraceFormat> TracePb(const Message& msg) {
 }
 }  // anonymous namespace
 
+CallArena::CallArena() : arena_([this] {
+      google::protobuf::ArenaOptions options;
+      options.initial_block = initial_block_;
+      options.initial_block_size = sizeof(initial_block_);
+      // Write and read batches could be large, so avoid a lot of small blocks for them.
+      options.max_block_size = 64_KB;
+      return options;
+    }()) {
+}
+
+bool RpcContext::UseCallArena() {
+  return GetAtomicFlag(&FLAGS_rpc_use_call_arena);
+}
+
 RpcContext::~RpcContext() {
   if (call_ && !responded_) {
     LOG(DFATAL) << "RpcContext is destroyed, but response has not been sent, for call: "
@@ -121,6 +142,13 @@ RpcContext::RpcContext(std::shared_ptr<LocalYBInboundCall> call)
                            "request", TracePb(*request_pb_));
 }
 
+std::shared_ptr<google::protobuf::Message> RpcContext::SharedRequest() const {
+  if (call_->IsLocalCall()) {
+    return nullptr;
+  }
+  return std::const_pointer_cast<google::protobuf::Message>(request_pb_);
+}
+
 void RpcContext::RespondSuccess() {
   if (response_pb_->ByteSize() > FLAGS_rpc_max_message_size) {
     RespondFailure(STATUS_FORMAT(InvalidArgument, "RPC message too long: $0 vs $1",
@@ -33,10 +33,14 @@
 #define YB_RPC_RPC_CONTEXT_H
 
 #include <string>
+#include <type_traits>
+
+#include <google/protobuf/arena.h>
 
 #include "yb/rpc/rpc_header.pb.h"
 #include "yb/rpc/service_if.h"
 #include "yb/util/ref_cnt_buffer.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status.h"
 
 namespace google {
@@ -59,6 +63,41 @@ namespace rpc {
 
 class YBInboundCall;
 
+// Protobuf arena that holds request and response of an inbound call, so a request with many nested
+// messages is parsed without allocating each of them separately, and all of them are freed at once.
+// The first block of the arena is allocated together with the arena itself.
+class CallArena {
+ public:
+  CallArena();
+
+  CallArena(const CallArena&) = delete;
+  void operator=(const CallArena&) = delete;
+
+  template <class T>
+  T* NewMessage() {
+    return NewMessage<T>(std::integral_constant<
+        bool, google::protobuf::Arena::is_arena_constructable<T>::value>());
+  }
+
+ private:
+  template <class T>
+  T* NewMessage(std::true_type) {
+    return google::protobuf::Arena::CreateMessage<T>(&arena_);
+  }
+
+  // Message does not support arenas, so only the message itself is allocated in the arena.
+  template <class T>
+  T* NewMessage(std::false_type) {
+    return google::protobuf::Arena::Create<T>(&arena_);
+  }
+
+  static constexpr size_t kInitialBlockSize = 2_KB;
+
+  // Should be declared before arena_, since it is used by arena_ until its destruction.
+  alignas(8) char initial_block_[kInitialBlockSize];
+  google::protobuf::Arena arena_;
+};
+
 // The context provided to a generated ServiceIf. This provides
 // methods to respond to the RPC. In the future, this will also
 // include methods to access information about the caller: e.g
@@ -74,6 +113,22 @@ class RpcContext {
              std::shared_ptr<google::protobuf::Message> response_pb);
   explicit RpcContext(std::shared_ptr<LocalYBInboundCall> call);
 
+  // Create an RpcContext with request and response allocated in the CallArena, that is destroyed
+  // with both of them. This is called only from generated code and is not a public API.
+  template <class RequestPB, class ResponsePB>
+  static RpcContext Create(std::shared_ptr<YBInboundCall> call) {
+    if (!UseCallArena()) {
+      return RpcContext(
+          std::move(call), std::make_shared<RequestPB>(), std::make_shared<ResponsePB>());
+    }
+    auto arena = std::make_shared<CallArena>();
+    auto* request = arena->NewMessage<RequestPB>();
+    auto* response = arena->NewMessage<ResponsePB>();
+    return RpcContext(
+        std::move(call), std::shared_ptr<google::protobuf::Message>(arena, request),
+        std::shared_ptr<google::protobuf::Message>(arena, response));
+  }
+
   RpcContext(RpcContext&& rhs) = default;
 
   RpcContext(const RpcContext&) = delete;
@@ -182,6 +237,10 @@ class RpcContext {
   std::string requestor_string() const;
 
   const google::protobuf::Message *request_pb() const { return request_pb_.get(); }
+
+  // Returns request with shared ownership, so it could be used after the call is responded,
+  // without being copied. Returns nullptr for a local call, since its request belongs to the caller.
+  std::shared_ptr<google::protobuf::Message> SharedRequest() const;
   google::protobuf::Message *response_pb() const { return response_pb_.get(); }
 
   // Return an upper bound on the client timeout deadline. This does not
@@ -208,6 +267,8 @@ class RpcContext {
   std::string ToString() const;
 
  private:
+  static bool UseCallArena();
+
   std::shared_ptr<YBInboundCall> call_;
   std::shared_ptr<const google::protobuf::Message> request_pb_;
   std::shared_ptr<google::protobuf::Message> response_pb_;
@@ -72,6 +72,7 @@ void RpcController::Swap(RpcController* other) {
   std::swap(allow_local_calls_in_curr_thread_, other->allow_local_calls_in_curr_thread_);
   std::swap(call_, other->call_);
   std::swap(invoke_callback_mode_, other->invoke_callback_mode_);
+  std::swap(serialized_request_fields_, other->serialized_request_fields_);
 }
 
 void RpcController::Reset() {
@@ -80,6 +81,7 @@ void RpcController::Reset() {
     CHECK(finished());
   }
   call_.reset();
+  serialized_request_fields_.clear();
 }
 
 bool RpcController::finished() const {
@@ -133,6 +135,10 @@ MonoDelta RpcController::timeout() const {
   return timeout_;
 }
 
+void RpcController::AppendSerializedRequestFields(RefCntBuffer buffer) {
+  serialized_request_fields_.push_back(std::move(buffer));
+}
+
 int32_t RpcController::call_id() const {
   if (call_) {
     return call_->call_id();
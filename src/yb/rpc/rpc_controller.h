@@ -33,6 +33,7 @@
 #define YB_RPC_RPC_CONTROLLER_H
 
 #include <memory>
+#include <vector>
 
 #include <glog/logging.h>
 
@@ -40,6 +41,7 @@
 #include "yb/rpc/rpc_fwd.h"
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/status.h"
 
 namespace yb {
@@ -149,6 +151,18 @@ class RpcController {
   // Return the configured timeout.
   MonoDelta timeout() const;
 
+  // Appends already serialized fields to the request of the next call made with this controller.
+  // They are sent right after the fields of the request message, so the server parses them as
+  // part of the request. Buffers are referenced by the outbound call instead of being copied, so
+  // the same buffer could be sent by several calls, e.g. to different destinations.
+  //
+  // Not supported by local calls.
+  void AppendSerializedRequestFields(RefCntBuffer buffer);
+
+  bool has_serialized_request_fields() const {
+    return !serialized_request_fields_.empty();
+  }
+
   // Returns the slice pointing to the i-th sidecar upon success.
   //
   // Should only be called if the call's finished, but the controller has not
@@ -172,6 +186,9 @@ class RpcController {
   bool allow_local_calls_in_curr_thread_ = false;
   InvokeCallbackMode invoke_callback_mode_ = InvokeCallbackMode::kThreadPoolNormal;
 
+  // Taken by the outbound call of the next request.
+  std::vector<RefCntBuffer> serialized_request_fields_;
+
   DISALLOW_COPY_AND_ASSIGN(RpcController);
 };
 
@@ -116,7 +116,9 @@ typedef int64_t ScheduledTaskId;
 constexpr ScheduledTaskId kInvalidTaskId = -1;
 constexpr size_t kMinBufferForSidecarSlices = 16;
 
-YB_DEFINE_ENUM(ServicePriority, (kNormal)(kHigh));
+// Low priority services, like remote bootstrap or CDC, share thread pool with normal priority
+// services, but could have a limited number of running calls.
+YB_DEFINE_ENUM(ServicePriority, (kNormal)(kHigh)(kLow));
 
 } // namespace rpc
 } // namespace yb
@@ -33,11 +33,18 @@
 #include "yb/rpc/service_pool.h"
 
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <vector>
 
 #include <boost/asio/strand.hpp>
+#include <boost/multi_index/composite_key.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/mem_fun.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
 
 #include <cds/container/basket_queue.h>
 #include <cds/gc/dhp.h>
@@ -45,6 +52,7 @@
 #include <glog/logging.h>
 
 #include "yb/gutil/ref_counted.h"
+#include "yb/gutil/thread_annotations.h"
 
 #include "yb/rpc/inbound_call.h"
 #include "yb/rpc/scheduler.h"
@@ -75,6 +83,28 @@ DEFINE_int64(backpressure_recovery_period_ms, 600000,
              "for this duration (in ms)");
 TAG_FLAG(backpressure_recovery_period_ms, advanced);
 TAG_FLAG(backpressure_recovery_period_ms, runtime);
+DEFINE_bool(rpc_service_pool_scheduling, false,
+            "Handle calls queued to a service in the order of their client deadlines, and newest "
+            "first while the service is overloaded, instead of the order of their arrival. "
+            "Applied to services that are registered after the flag is set.");
+TAG_FLAG(rpc_service_pool_scheduling, advanced);
+DEFINE_int32(rpc_queue_overload_target_ms, 5,
+             "Service is considered overloaded when each of its calls waited in the queue longer "
+             "than this time during rpc_queue_overload_interval_ms. Used only when "
+             "rpc_service_pool_scheduling is set.");
+TAG_FLAG(rpc_queue_overload_target_ms, advanced);
+TAG_FLAG(rpc_queue_overload_target_ms, runtime);
+DEFINE_int32(rpc_queue_overload_interval_ms, 100,
+             "Interval used to detect whether service is overloaded. Used only when "
+             "rpc_service_pool_scheduling is set.");
+TAG_FLAG(rpc_queue_overload_interval_ms, advanced);
+TAG_FLAG(rpc_queue_overload_interval_ms, runtime);
+DEFINE_int32(rpc_low_priority_service_max_running_calls, 2,
+             "Max number of calls to a single low priority service, like remote bootstrap or CDC, "
+             "that are handled by worker threads at the same time. 0 means no limit. Used only "
+             "when rpc_service_pool_scheduling is set.");
+TAG_FLAG(rpc_low_priority_service_max_running_calls, advanced);
+TAG_FLAG(rpc_low_priority_service_max_running_calls, runtime);
 DEFINE_test_flag(bool, enable_backpressure_mode_for_testing, false,
             "For testing purposes. Enables the rpc's to be considered timed out in the queue even "
             "when we have not had any backpressure in the recent past.");
@@ -120,8 +150,11 @@ class ServicePoolImpl final : public InboundCallHandler {
                   ThreadPool* thread_pool,
                   Scheduler* scheduler,
                   ServiceIfPtr service,
-                  const scoped_refptr<MetricEntity>& entity)
+                  const scoped_refptr<MetricEntity>& entity,
+                  ServicePriority priority)
       : max_queued_calls_(max_tasks),
+        priority_(priority),
+        scheduling_enabled_(FLAGS_rpc_service_pool_scheduling),
         thread_pool_(*thread_pool),
         scheduler_(*scheduler),
         service_(std::move(service)),
@@ -191,6 +224,18 @@ class ServicePoolImpl final : public InboundCallHandler {
       ScheduleCheckTimeout(call_deadline);
     }
 
+    if (scheduling_enabled_) {
+      // Task does not handle its own call, but the best one from scheduled_calls_ at the moment
+      // it is executed. So there is always a task for each call in scheduled_calls_.
+      std::lock_guard<std::mutex> lock(scheduling_mutex_);
+      scheduled_calls_.insert(ScheduledCall {
+        .deadline = call_deadline,
+        .serial_no = ++last_serial_no_,
+        .enqueue_time = CoarseMonoClock::now(),
+        .call = call,
+      });
+    }
+
     thread_pool_.Enqueue(task);
   }
 
@@ -227,7 +272,25 @@ class ServicePoolImpl final : public InboundCallHandler {
         CoarseMonoClock::Now().time_since_epoch(), std::memory_order_release);
   }
 
-  void Failure(const InboundCallPtr& call, const Status& status) override {
+  void Failure(const InboundCallPtr& input_call, const Status& status) override {
+    auto call = input_call;
+    if (scheduling_enabled_) {
+      // Task failed, so fail one of the scheduled calls, preferably the call of this task.
+      std::lock_guard<std::mutex> lock(scheduling_mutex_);
+      auto& calls_by_ptr = scheduled_calls_.get<CallTag>();
+      auto it = calls_by_ptr.find(call.get());
+      if (it != calls_by_ptr.end()) {
+        calls_by_ptr.erase(it);
+      } else {
+        auto& calls_by_serial_no = scheduled_calls_.get<SerialNoTag>();
+        if (calls_by_serial_no.empty()) {
+          return;
+        }
+        call = calls_by_serial_no.begin()->call;
+        calls_by_serial_no.erase(calls_by_serial_no.begin());
+      }
+    }
+
     if (!call->TryStartProcessing()) {
       return;
     }
@@ -249,6 +312,47 @@ class ServicePoolImpl final : public InboundCallHandler {
   }
 
   void Handle(InboundCallPtr incoming) override {
+    if (!scheduling_enabled_) {
+      HandleCall(std::move(incoming));
+      return;
+    }
+
+    const auto max_running_calls = priority_ == ServicePriority::kLow
+        ? GetAtomicFlag(&FLAGS_rpc_low_priority_service_max_running_calls) : 0;
+    std::vector<InboundCallPtr> expired_calls;
+    std::unique_lock<std::mutex> lock(scheduling_mutex_);
+    if (max_running_calls > 0 && running_calls_ >= max_running_calls) {
+      // Worker thread is released, and the call is picked by one of the running handlers when
+      // it completes.
+      ++deferred_tasks_;
+      return;
+    }
+    ++running_calls_;
+    for (;;) {
+      incoming = PopScheduledCall(&expired_calls);
+      if (incoming || !expired_calls.empty()) {
+        lock.unlock();
+        for (const auto& call : expired_calls) {
+          TimedOut(call.get(), kTimedOutInQueue, rpcs_timed_out_in_queue_.get());
+        }
+        expired_calls.clear();
+        if (incoming) {
+          HandleCall(std::move(incoming));
+        }
+        lock.lock();
+      }
+      if (deferred_tasks_ == 0 || scheduled_calls_.empty()) {
+        // Deferred task could have nothing to handle, when its call was dropped as expired.
+        deferred_tasks_ = 0;
+        break;
+      }
+      --deferred_tasks_;
+    }
+    --running_calls_;
+  }
+
+  // Handles the specified call, regardless of the calls that are waiting in the queue.
+  void HandleCall(InboundCallPtr incoming) {
     incoming->RecordHandlingStarted(incoming_queue_time_);
     ADOPT_TRACE(incoming->trace());
 
@@ -276,6 +380,58 @@ class ServicePoolImpl final : public InboundCallHandler {
   }
 
  private:
+  // Picks the next call to handle. Calls are picked in the order of their deadlines, but while
+  // the service is overloaded, calls are picked newest first. So new calls still meet their
+  // deadlines, instead of all calls waiting in the queue until they are almost expired.
+  // Calls whose deadline has already passed are moved to expired_calls.
+  InboundCallPtr PopScheduledCall(std::vector<InboundCallPtr>* expired_calls)
+      REQUIRES(scheduling_mutex_) {
+    auto& calls_by_deadline = scheduled_calls_.get<DeadlineTag>();
+    auto& calls_by_serial_no = scheduled_calls_.get<SerialNoTag>();
+    while (!calls_by_serial_no.empty()) {
+      auto now = CoarseMonoClock::now();
+      UpdateOverloaded(now - calls_by_serial_no.begin()->enqueue_time, now);
+      InboundCallPtr call;
+      if (overloaded_) {
+        auto it = std::prev(calls_by_serial_no.end());
+        call = it->call;
+        calls_by_serial_no.erase(it);
+      } else {
+        auto it = calls_by_deadline.begin();
+        call = it->call;
+        calls_by_deadline.erase(it);
+      }
+      if (!call->ClientTimedOut()) {
+        return call;
+      }
+      expired_calls->push_back(std::move(call));
+    }
+    return nullptr;
+  }
+
+  // Service is considered overloaded during the next interval, when the oldest queued call waited
+  // longer than target during the whole previous interval, i.e. the queue does not drain.
+  void UpdateOverloaded(CoarseDuration queue_delay, CoarseTimePoint now)
+      REQUIRES(scheduling_mutex_) {
+    min_queue_delay_ = std::min(min_queue_delay_, queue_delay);
+    if (overload_interval_end_ == CoarseTimePoint()) {
+      overload_interval_end_ = now + FLAGS_rpc_queue_overload_interval_ms * 1ms;
+      return;
+    }
+    if (now < overload_interval_end_) {
+      return;
+    }
+    bool overloaded = min_queue_delay_ > FLAGS_rpc_queue_overload_target_ms * 1ms;
+    if (overloaded != overloaded_) {
+      YB_LOG_EVERY_N_SECS(INFO, 10)
+          << LogPrefix() << (overloaded ? "Overloaded" : "No longer overloaded")
+          << ", min queue delay: " << MonoDelta(min_queue_delay_);
+      overloaded_ = overloaded;
+    }
+    min_queue_delay_ = CoarseDuration::max();
+    overload_interval_end_ = now + FLAGS_rpc_queue_overload_interval_ms * 1ms;
+  }
+
   void TimedOut(InboundCall* call, const char* error_message, Counter* metric) {
     if (call->RespondTimedOutIfPending(error_message)) {
       metric->Increment();
@@ -402,6 +558,8 @@ class ServicePoolImpl final : public InboundCallHandler {
   }
 
   const size_t max_queued_calls_;
+  const ServicePriority priority_;
+  const bool scheduling_enabled_;
   ThreadPool& thread_pool_;
   Scheduler& scheduler_;
   ServiceIfPtr service_;
@@ -450,6 +608,55 @@ class ServicePoolImpl final : public InboundCallHandler {
 
   std::priority_queue<QueuedCheckDeadline> check_timeout_queue_;
 
+  struct ScheduledCall {
+    CoarseTimePoint deadline;
+    int64_t serial_no;
+    CoarseTimePoint enqueue_time;
+    InboundCallPtr call;
+
+    InboundCall* call_ptr() const {
+      return call.get();
+    }
+  };
+
+  class DeadlineTag;
+  class SerialNoTag;
+  class CallTag;
+
+  std::mutex scheduling_mutex_;
+
+  // Calls waiting to be handled, used only when scheduling_enabled_.
+  boost::multi_index_container<
+    ScheduledCall,
+    boost::multi_index::indexed_by<
+      boost::multi_index::ordered_unique<
+        boost::multi_index::tag<DeadlineTag>,
+        boost::multi_index::composite_key<
+          ScheduledCall,
+          boost::multi_index::member<ScheduledCall, CoarseTimePoint, &ScheduledCall::deadline>,
+          boost::multi_index::member<ScheduledCall, int64_t, &ScheduledCall::serial_no>
+        >
+      >,
+      boost::multi_index::ordered_unique<
+        boost::multi_index::tag<SerialNoTag>,
+        boost::multi_index::member<ScheduledCall, int64_t, &ScheduledCall::serial_no>
+      >,
+      boost::multi_index::hashed_unique<
+        boost::multi_index::tag<CallTag>,
+        boost::multi_index::const_mem_fun<ScheduledCall, InboundCall*, &ScheduledCall::call_ptr>
+      >
+    >
+  > scheduled_calls_ GUARDED_BY(scheduling_mutex_);
+
+  int64_t last_serial_no_ GUARDED_BY(scheduling_mutex_) = 0;
+  // Number of worker threads that are handling calls of this service.
+  int running_calls_ GUARDED_BY(scheduling_mutex_) = 0;
+  // Number of tasks that were not executed because of the running calls limit.
+  int deferred_tasks_ GUARDED_BY(scheduling_mutex_) = 0;
+  bool overloaded_ GUARDED_BY(scheduling_mutex_) = false;
+  CoarseDuration min_queue_delay_ GUARDED_BY(scheduling_mutex_) = CoarseDuration::max();
+  CoarseTimePoint overload_interval_end_ GUARDED_BY(scheduling_mutex_);
+
   std::atomic<bool> closing_ = {false};
   CountDownLatch shutdown_complete_latch_{1};
   std::string log_prefix_;
@@ -459,9 +666,10 @@ ServicePool::ServicePool(size_t max_tasks,
                          ThreadPool* thread_pool,
                          Scheduler* scheduler,
                          ServiceIfPtr service,
-                         const scoped_refptr<MetricEntity>& metric_entity)
+                         const scoped_refptr<MetricEntity>& metric_entity,
+                         ServicePriority priority)
     : impl_(new ServicePoolImpl(
-        max_tasks, thread_pool, scheduler, std::move(service), metric_entity)) {
+        max_tasks, thread_pool, scheduler, std::move(service), metric_entity, priority)) {
 }
 
 ServicePool::~ServicePool() {
@@ -480,7 +688,7 @@ void ServicePool::QueueInboundCall(InboundCallPtr call) {
 }
 
 void ServicePool::Handle(InboundCallPtr call) {
-  impl_->Handle(std::move(call));
+  impl_->HandleCall(std::move(call));
 }
 
 void ServicePool::FillEndpoints(RpcEndpointMap* map) {
@@ -65,7 +65,8 @@ class ServicePool : public RpcService {
               ThreadPool* thread_pool,
               Scheduler* scheduler,
               ServiceIfPtr service,
-              const scoped_refptr<MetricEntity>& metric_entity);
+              const scoped_refptr<MetricEntity>& metric_entity,
+              ServicePriority priority = ServicePriority::kNormal);
   virtual ~ServicePool();
 
   void StartShutdown() override;
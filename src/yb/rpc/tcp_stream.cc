@@ -29,6 +29,13 @@ DECLARE_uint64(rpc_connection_timeout_ms);
 DEFINE_test_flag(int32, delay_connect_ms, 0,
                  "Delay connect in tests for specified amount of milliseconds.");
 
+DEFINE_bool(rpc_skip_drained_socket_syscalls, true,
+            "Do not repeat recv/send on a socket after a short read or write in the same readiness "
+            "event, since such a call would only fail with EAGAIN. Wait for the next event "
+            "from the reactor instead.");
+TAG_FLAG(rpc_skip_drained_socket_syscalls, advanced);
+TAG_FLAG(rpc_skip_drained_socket_syscalls, runtime);
+
 METRIC_DEFINE_simple_counter(
   server, tcp_bytes_sent, "Bytes sent over TCP connections", yb::MetricUnit::kBytes);
 
@@ -40,7 +47,8 @@ namespace rpc {
 
 namespace {
 
-const size_t kMaxIov = 16;
+// Number of buffers sent by a single writev, small calls consist of several buffers each.
+const size_t kMaxIov = 64;
 
 }
 
@@ -162,6 +170,7 @@ TcpStream::FillIovResult TcpStream::FillIov(iovec* out) {
   int index = 0;
   size_t offset = send_position_;
   bool only_heartbeats = true;
+  size_t total_bytes = 0;
   for (auto& data : sending_) {
     const auto wrapped_data = data.data;
     if (wrapped_data && !wrapped_data->IsHeartbeat()) {
@@ -181,14 +190,15 @@ TcpStream::FillIovResult TcpStream::FillIov(iovec* out) {
 
       out[index].iov_base = bytes.data() + offset;
       out[index].iov_len = bytes.size() - offset;
+      total_bytes += out[index].iov_len;
       offset = 0;
       if (++index == kMaxIov) {
-        return FillIovResult{index, only_heartbeats};
+        return FillIovResult{index, only_heartbeats, total_bytes};
       }
     }
   }
 
-  return FillIovResult{index, only_heartbeats};
+  return FillIovResult{index, only_heartbeats, total_bytes};
 }
 
 Status TcpStream::DoWrite() {
@@ -250,6 +260,12 @@ Status TcpStream::DoWrite() {
         context_->Transferred(data, Status::OK());
       }
     }
+
+    if (static_cast<size_t>(written) < fill_result.bytes &&
+        FLAGS_rpc_skip_drained_socket_syscalls) {
+      // Socket send buffer is full, the rest is sent when the socket becomes writable.
+      break;
+    }
   }
 
   return Status::OK();
@@ -313,7 +329,8 @@ Status TcpStream::ReadHandler() {
   context_->UpdateLastRead();
 
   for (;;) {
-    auto received = Receive();
+    bool drained = false;
+    auto received = Receive(&drained);
     if (PREDICT_FALSE(!received.ok())) {
       if (Errno(received.status()) == ESHUTDOWN) {
         VLOG_WITH_PREFIX(1) << "Shut down by remote end.";
@@ -332,13 +349,13 @@ Status TcpStream::ReadHandler() {
     if (!continue_receiving.ok()) {
       return continue_receiving.status();
     }
-    if (!continue_receiving.get()) {
+    if (!continue_receiving.get() || drained) {
       return Status::OK();
     }
   }
 }
 
-Result<bool> TcpStream::Receive() {
+Result<bool> TcpStream::Receive(bool* drained) {
   auto iov = ReadBuffer().PrepareAppend();
   if (!iov.ok()) {
     VLOG_WITH_PREFIX(3) << "ReadBuffer().PrepareAppend() error: " << iov.status();
@@ -381,6 +398,13 @@ Result<bool> TcpStream::Receive() {
 
   IncrementCounterBy(bytes_received_counter_, *nread);
   ReadBuffer().DataAppended(*nread);
+  if (FLAGS_rpc_skip_drained_socket_syscalls) {
+    size_t capacity = 0;
+    for (const auto& vec : *iov) {
+      capacity += vec.iov_len;
+    }
+    *drained = static_cast<size_t>(*nread) < capacity;
+  }
   return *nread != 0;
 }
 
@@ -70,6 +70,8 @@ class TcpStream : public Stream {
   struct FillIovResult {
     int len;
     bool only_heartbeats;
+    // Total number of bytes in filled iovecs.
+    size_t bytes;
   };
 
   CHECKED_STATUS Start(bool connect, ev::loop_ref* loop, StreamContext* context) override;
@@ -100,7 +102,9 @@ class TcpStream : public Stream {
   CHECKED_STATUS ReadHandler();
   CHECKED_STATUS WriteHandler(bool just_connected);
 
-  Result<bool> Receive();
+  // Returns whether any data was received. Sets *drained to true when the socket had less data
+  // than the free space of the read buffer, so the next receive would fail with EAGAIN.
+  Result<bool> Receive(bool* drained);
   // Try to parse received data and process it.
   Result<bool> TryProcessReceived();
 
@@ -33,6 +33,7 @@
 #ifndef YB_TABLET_OPERATIONS_OPERATION_H
 #define YB_TABLET_OPERATIONS_OPERATION_H
 
+#include <memory>
 #include <mutex>
 #include <string>
 
@@ -263,8 +264,15 @@ class OperationBase : public Base {
     return request_holder_.get();
   }
 
+  // Uses request that is shared with its owner, for instance with the RPC call that received it,
+  // so the request is not copied. Such request is not released to the replicate message.
+  void UseSharedRequest(std::shared_ptr<Request> request) {
+    shared_request_ = std::move(request);
+    request_.store(shared_request_.get(), std::memory_order_release);
+  }
+
   Request* mutable_request() {
-    return request_holder_.get();
+    return request_holder_ ? request_holder_.get() : shared_request_.get();
   }
 
   Request* ReleaseRequest() {
@@ -299,8 +307,13 @@ class OperationBase : public Base {
     request_.store(request, std::memory_order_release);
   }
 
+  const std::shared_ptr<Request>& shared_request() const {
+    return shared_request_;
+  }
+
  private:
   std::unique_ptr<Request> request_holder_;
+  std::shared_ptr<Request> shared_request_;
   std::atomic<const Request*> request_;
 };
 
@@ -201,6 +201,22 @@ HybridTime WriteOperation::WriteHybridTime() const {
   return Operation::WriteHybridTime();
 }
 
+consensus::ReplicateMsgPtr WriteOperation::NewReplicateMsg() {
+  auto request = shared_request();
+  if (!request) {
+    return OperationBase::NewReplicateMsg();
+  }
+  consensus::ReplicateMsgPtr result(
+      new consensus::ReplicateMsg, [request](consensus::ReplicateMsg* msg) {
+    // The request is owned by the shared pointer captured here, not by the message.
+    msg->unsafe_arena_release_write_request();
+    delete msg;
+  });
+  result->set_op_type(consensus::WRITE_OP);
+  result->unsafe_arena_set_allocated_write_request(request.get());
+  return result;
+}
+
 void WriteOperation::SetTablet(Tablet* tablet) {
   Operation::SetTablet(tablet);
   if (!request()->has_tablet_id()) {
@@ -147,6 +147,10 @@ class WriteOperation : public OperationBase<OperationType::kWrite, tserver::Writ
 
   void SetTablet(Tablet* tablet) override;
 
+  // When the request is shared with the RPC call, the replicate message references it instead of
+  // owning a copy, and keeps the request alive until the message is destroyed.
+  consensus::ReplicateMsgPtr NewReplicateMsg() override;
+
   bool use_mvcc() const override {
     return true;
   }
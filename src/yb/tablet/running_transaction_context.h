@@ -14,6 +14,8 @@
 #ifndef YB_TABLET_RUNNING_TRANSACTION_CONTEXT_H
 #define YB_TABLET_RUNNING_TRANSACTION_CONTEXT_H
 
+#include "yb/docdb/wait_queue.h"
+
 #include "yb/rpc/rpc.h"
 
 #include "yb/tablet/transaction_participant.h"
@@ -31,14 +33,26 @@ class MinRunningNotifier {
     satisfied_ = true;
   }
 
+  // Remembers transaction that was removed from participant, so requests waiting for it are
+  // woken up after participant mutex is released.
+  void TransactionRemoved(docdb::WaitQueue* wait_queue, const TransactionId& id) {
+    wait_queue_ = wait_queue;
+    removed_transactions_.push_back(id);
+  }
+
   ~MinRunningNotifier() {
     if (satisfied_ && applier_) {
       applier_->MinRunningHybridTimeSatisfied();
     }
+    for (const auto& id : removed_transactions_) {
+      wait_queue_->SignalResolved(id);
+    }
   }
  private:
   bool satisfied_ = false;
   TransactionIntentApplier* applier_;
+  docdb::WaitQueue* wait_queue_ = nullptr;
+  std::vector<TransactionId> removed_transactions_;
 };
 
 class RunningTransaction;
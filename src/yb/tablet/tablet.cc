@@ -112,6 +112,7 @@
 #include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_retention_policy.h"
 #include "yb/tablet/transaction_coordinator.h"
+#include "yb/tablet/transaction_intents_ranges.h"
 #include "yb/tablet/transaction_participant.h"
 #include "yb/tablet/operations/change_metadata_operation.h"
 #include "yb/tablet/operations/truncate_operation.h"
@@ -1205,6 +1206,14 @@ Status Tablet::PrepareTransactionWriteBatch(
                          PgsqlError(YBPgErrorCode::YB_PG_T_R_SERIALIZATION_FAILURE));
   }
 
+  if (!put_batch.write_pairs().empty()) {
+    // Range should be known to participant before intents are written, so readers that don't see
+    // it would not see intents also.
+    std::string lower, upper;
+    GetIntentsRange(put_batch, &lower, &upper);
+    transaction_participant()->AddIntentsRange(transaction_id, lower, upper);
+  }
+
   auto isolation_level = prepare_batch_data->first;
   auto& last_batch_data = prepare_batch_data->second;
   yb::docdb::PrepareTransactionWriteBatch(
@@ -2109,6 +2118,21 @@ Status Tablet::WaitForFlush() {
   return Status::OK();
 }
 
+bool Tablet::HasFlushInProgress(FlushFlags flags) const {
+  auto scoped_read_operation = CreateNonAbortableScopedRWOperation();
+  if (!scoped_read_operation.ok()) {
+    return false;
+  }
+
+  for (auto* db : {HasFlags(flags, FlushFlags::kRegular) ? regular_db_.get() : nullptr,
+                   HasFlags(flags, FlushFlags::kIntents) ? intents_db_.get() : nullptr}) {
+    if (db && db->GetFlushAbility() == rocksdb::FlushAbility::kAlreadyFlushing) {
+      return true;
+    }
+  }
+  return false;
+}
+
 Status Tablet::ImportData(const std::string& source_dir) {
   // We import only regular records, so don't have to deal with intents here.
   return regular_db_->Import(source_dir);
@@ -3553,7 +3577,8 @@ class DocWriteOperation : public std::enable_shared_from_this<DocWriteOperation>
       auto now = tablet_.clock()->Now();
       docdb::ResolveOperationConflicts(
           operation_->doc_ops(), now, tablet_.doc_db(), partial_range_key_intents,
-          transaction_participant, tablet_.metrics()->transaction_conflicts.get(),
+          transaction_participant, MakeWaitQueueContext(transaction_participant),
+          tablet_.metrics()->transaction_conflicts.get(),
           [self = shared_from_this(), now](const Result<HybridTime>& result) {
             if (!result.ok()) {
               self->InvokeCallback(result.status());
@@ -3589,7 +3614,8 @@ class DocWriteOperation : public std::enable_shared_from_this<DocWriteOperation>
         operation_->doc_ops(), *write_batch, tablet_.clock()->Now(),
         read_time_ ? read_time_.read : HybridTime::kMax,
         tablet_.doc_db(), partial_range_key_intents,
-        transaction_participant, tablet_.metrics()->transaction_conflicts.get(),
+        transaction_participant, MakeWaitQueueContext(transaction_participant),
+        tablet_.metrics()->transaction_conflicts.get(),
         [self = shared_from_this()](const Result<HybridTime>& result) {
           if (!result.ok()) {
             self->InvokeCallback(result.status());
@@ -3603,6 +3629,14 @@ class DocWriteOperation : public std::enable_shared_from_this<DocWriteOperation>
     return Status::OK();
   }
 
+  docdb::WaitQueueContext MakeWaitQueueContext(TransactionParticipant* transaction_participant) {
+    return docdb::WaitQueueContext {
+      .wait_queue = transaction_participant ? transaction_participant->wait_queue() : nullptr,
+      .lock_batch = &prepare_result_.lock_batch,
+      .deadline = operation_->deadline(),
+    };
+  }
+
   void NonTransactionalConflictsResolved(HybridTime now, HybridTime result) {
     if (now != result) {
       tablet_.clock()->Update(result);
@@ -4098,8 +4132,12 @@ void Tablet::ListenNumSSTFilesChanged(std::function<void()> listener) {
 void Tablet::InitRocksDBOptions(
     rocksdb::Options* options, const std::string& log_prefix,
     rocksdb::BlockBasedTableOptions table_options) {
+  // Colocated tablet contains keys of several tables, so filter could not depend on schema.
+  const auto bloom_filter_range_components =
+      metadata_->colocated() ? 0 : docdb::BloomFilterRangeComponents(*metadata_->schema());
   docdb::InitRocksDBOptions(
-      options, log_prefix, regulardb_statistics_, tablet_options_, std::move(table_options));
+      options, log_prefix, regulardb_statistics_, tablet_options_, std::move(table_options),
+      bloom_filter_range_components);
 }
 
 rocksdb::Env& Tablet::rocksdb_env() const {
@@ -418,6 +418,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   CHECKED_STATUS WaitForFlush();
 
+  // Returns true if any of RocksDBs specified by flags has memtable that is being flushed.
+  bool HasFlushInProgress(FlushFlags flags = FlushFlags::kAll) const;
+
   // Prepares the transaction context for the alter schema operation.
   // An error will be returned if the specified schema is invalid (e.g.
   // key mismatch, or missing IDs)
@@ -45,6 +45,7 @@
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tserver/tserver.pb.h"
 #include "yb/util/logging.h"
+#include "yb/util/mem_tracker.h"
 #include "yb/util/path_util.h"
 #include "yb/util/random_util.h"
 #include "yb/util/tostring.h"
@@ -53,6 +54,7 @@
 
 DECLARE_bool(skip_flushed_entries);
 DECLARE_int32(retryable_request_timeout_secs);
+DECLARE_int32(tablet_bootstrap_read_ahead_segments);
 
 using std::shared_ptr;
 using std::string;
@@ -222,6 +224,7 @@ class BootstrapTest : public LogTestBase {
       .listener = listener.get(),
       .append_pool = log_thread_pool_.get(),
       .allocation_pool = log_thread_pool_.get(),
+      .read_ahead_pool = log_thread_pool_.get(),
       .retryable_requests = nullptr,
       .test_hooks = test_hooks_
     };
@@ -283,6 +286,40 @@ TEST_F(BootstrapTest, TestBootstrap) {
   IterateTabletRows(tablet.get(), &results);
 }
 
+// Tests replay of a log with multiple segments, that are read ahead of the segment being replayed.
+TEST_F(BootstrapTest, TestReadAheadSegments) {
+  FLAGS_tablet_bootstrap_read_ahead_segments = 2;
+  BuildLog();
+
+  constexpr int kNumSegments = 5;
+  constexpr int kOpsPerSegment = 3;
+  for (int segment = 0; segment != kNumSegments; ++segment) {
+    for (int i = 0; i != kOpsPerSegment; ++i) {
+      const auto key = static_cast<int>(current_index_);
+      const auto op_id = MakeOpId(1, current_index_++);
+      AppendReplicateBatch(op_id, op_id, {TupleForAppend(key, key, "read ahead")});
+    }
+    ASSERT_OK(RollLog());
+  }
+
+  // Keep read ahead tracker alive, to check its consumption after bootstrap.
+  auto read_ahead_tracker = MemTracker::FindOrCreateTracker("BootstrapReadAhead");
+
+  TabletPtr tablet;
+  ConsensusBootstrapInfo boot_info;
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+  ASSERT_EQ(0, boot_info.orphaned_replicates.size());
+  ASSERT_EQ(kNumSegments * kOpsPerSegment, boot_info.last_committed_id.index());
+
+  vector<string> results;
+  IterateTabletRows(tablet.get(), &results);
+  ASSERT_EQ(kNumSegments * kOpsPerSegment, results.size());
+
+  // Segments were read ahead, and their memory was released after replay.
+  ASSERT_GT(read_ahead_tracker->peak_consumption(), 0);
+  ASSERT_EQ(0, read_ahead_tracker->consumption());
+}
+
 // Tests attempting a local bootstrap of a tablet that was in the middle of a remote bootstrap
 // before "crashing".
 TEST_F(BootstrapTest, TestIncompleteRemoteBootstrap) {
@@ -32,6 +32,8 @@
 #include "yb/tablet/tablet_bootstrap.h"
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <future>
 #include <map>
 #include <memory>
@@ -79,9 +81,11 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/opid.h"
 #include "yb/util/logging.h"
+#include "yb/util/mem_tracker.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status.h"
 #include "yb/util/stopwatch.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/env_util.h"
 #include "yb/consensus/log_index.h"
 #include "yb/docdb/consensus_frontier.h"
@@ -114,6 +118,16 @@ DEFINE_bool(skip_flushed_entries, true,
 
 DECLARE_int32(retryable_request_timeout_secs);
 
+DEFINE_int32(tablet_bootstrap_read_ahead_segments, 1,
+             "Number of WAL segments that tablet bootstrap reads and decodes on separate threads "
+             "ahead of the segment being replayed. 0 to read segments on the replay thread.");
+TAG_FLAG(tablet_bootstrap_read_ahead_segments, advanced);
+
+DEFINE_int64(tablet_bootstrap_read_ahead_bytes, 256_MB,
+             "Limit on total size of WAL segments that are read ahead of replay by all tablets "
+             "bootstrapped concurrently.");
+TAG_FLAG(tablet_bootstrap_read_ahead_bytes, advanced);
+
 DEFINE_uint64(transaction_status_tablet_log_segment_size_bytes, 4_MB,
               "The segment size for transaction status tablet log roll-overs, in bytes.");
 DEFINE_test_flag(int32, tablet_bootstrap_delay_ms, 0,
@@ -453,6 +467,51 @@ bool WriteOpHasTransaction(const ReplicateMsg& replicate) {
   return false;
 }
 
+// Read of log segment, that could be started on a thread pool ahead of replay.
+// When replay needs segment that is not being read yet, it reads it on its own thread, so replay
+// does not wait for a task queued in the pool, that could be busy with bootstrapping tablets.
+class SegmentRead {
+ public:
+  SegmentRead(scoped_refptr<ReadableLogSegment> segment, ScopedTrackedConsumption consumption)
+      : segment_(std::move(segment)), consumption_(std::move(consumption)) {}
+
+  // Invoked by thread pool task.
+  void Run() {
+    if (started_.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+    auto result = segment_->ReadEntries();
+    std::lock_guard<std::mutex> lock(mutex_);
+    result_ = std::move(result);
+    done_ = true;
+    cond_.notify_all();
+  }
+
+  log::ReadEntriesResult Get() {
+    if (!started_.exchange(true, std::memory_order_acq_rel)) {
+      return segment_->ReadEntries();
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return done_; });
+    return std::move(result_);
+  }
+
+  // Prevents queued task from reading segment that will not be replayed.
+  void Cancel() {
+    started_.store(true, std::memory_order_release);
+  }
+
+ private:
+  scoped_refptr<ReadableLogSegment> segment_;
+  // Memory reserved for segment read ahead of replay.
+  ScopedTrackedConsumption consumption_;
+  std::atomic<bool> started_{false};
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool done_ = false;
+  log::ReadEntriesResult result_;
+};
+
 }  // anonymous namespace
 
 YB_STRONGLY_TYPED_BOOL(NeedsRecovery);
@@ -477,6 +536,12 @@ class TabletBootstrap {
         listener_(data.listener),
         append_pool_(data.append_pool),
         allocation_pool_(data.allocation_pool),
+        read_ahead_pool_(data.read_ahead_pool),
+        read_ahead_mem_tracker_(
+            read_ahead_pool_ ? MemTracker::FindOrCreateTracker(
+                                   FLAGS_tablet_bootstrap_read_ahead_bytes, "BootstrapReadAhead",
+                                   mem_tracker_)
+                             : nullptr),
       skip_wal_rewrite_(FLAGS_skip_wal_rewrite) ,
         test_hooks_(data.test_hooks) {
   }
@@ -1236,13 +1301,51 @@ class TabletBootstrap {
     // Find the earliest log segment we need to read, so the rest can be ignored.
     auto iter = FLAGS_skip_flushed_entries ? SkipFlushedEntries(&segments) : segments.begin();
 
+    // Segments are read and decoded ahead of replay using bootstrap thread pool, so IO and parsing
+    // of the following segments overlap with applying entries of the current one. Memory of
+    // segments read ahead is limited by read ahead mem tracker, shared by all tablets.
+    const size_t read_ahead_segments =
+        read_ahead_pool_ ? std::max(FLAGS_tablet_bootstrap_read_ahead_segments, 0) : 0;
+    std::deque<std::shared_ptr<SegmentRead>> segment_reads;
+    auto cancel_segment_reads = ScopeExit([&segment_reads] {
+      for (const auto& read : segment_reads) {
+        read->Cancel();
+      }
+    });
+    auto read_iter = iter;
+    auto start_segment_reads = [&] {
+      // The segment that is replayed next is always read, possibly on the replay thread.
+      if (segment_reads.empty() && read_iter != segments.end()) {
+        segment_reads.push_back(std::make_shared<SegmentRead>(
+            *read_iter, ScopedTrackedConsumption()));
+        ++read_iter;
+      }
+      while (read_iter != segments.end() && segment_reads.size() <= read_ahead_segments) {
+        const auto size = (**read_iter).file_size();
+        if (!read_ahead_mem_tracker_->TryConsume(size)) {
+          break;
+        }
+        auto read = std::make_shared<SegmentRead>(
+            *read_iter,
+            ScopedTrackedConsumption(read_ahead_mem_tracker_, size, AlreadyConsumed::kTrue));
+        ++read_iter;
+        // When task could not be submitted, segment is read on the replay thread.
+        WARN_NOT_OK(read_ahead_pool_->SubmitFunc([read] { read->Run(); }),
+                    "Failed to submit segment read");
+        segment_reads.push_back(std::move(read));
+      }
+    };
+
     yb::OpId last_committed_op_id;
     yb::OpId last_read_entry_op_id;
     RestartSafeCoarseTimePoint last_entry_time;
     for (; iter != segments.end(); ++iter) {
       const scoped_refptr<ReadableLogSegment>& segment = *iter;
 
-      auto read_result = segment->ReadEntries();
+      start_segment_reads();
+      auto segment_read = std::move(segment_reads.front());
+      segment_reads.pop_front();
+      auto read_result = segment_read->Get();
       last_committed_op_id = std::max(last_committed_op_id, read_result.committed_op_id);
       if (!read_result.entries.empty()) {
         last_read_entry_op_id = yb::OpId::FromPB(read_result.entries.back()->replicate().id());
@@ -1611,6 +1714,12 @@ class TabletBootstrap {
 
   ThreadPool* allocation_pool_;
 
+  // Thread pool used to read log segments ahead of replay, null if read ahead is disabled.
+  ThreadPool* read_ahead_pool_;
+
+  // Tracks memory of log segments read ahead of replay by all tablets.
+  MemTrackerPtr read_ahead_mem_tracker_;
+
   // Statistics on the replay of entries in the log.
   struct Stats {
     std::string ToString() const;
@@ -165,6 +165,9 @@ struct BootstrapTabletData {
   TabletStatusListener* listener = nullptr;
   ThreadPool* append_pool = nullptr;
   ThreadPool* allocation_pool = nullptr;
+  // Pool used to read log segments ahead of replay. Segments are read on the bootstrap thread
+  // when it is not specified.
+  ThreadPool* read_ahead_pool = nullptr;
   consensus::RetryableRequests* retryable_requests = nullptr;
 
   std::shared_ptr<TabletBootstrapTestHooksIf> test_hooks = nullptr;
@@ -46,6 +46,8 @@ YB_STRONGLY_TYPED_BOOL(IsDropTable);
 // Common for all tablets within TabletManager.
 struct TabletOptions {
   std::shared_ptr<rocksdb::Cache> block_cache;
+  // Cache for index and filter blocks, could be nullptr.
+  std::shared_ptr<rocksdb::Cache> metadata_block_cache;
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor;
   std::vector<std::shared_ptr<rocksdb::EventListener>> listeners;
   yb::Env* env = Env::Default();
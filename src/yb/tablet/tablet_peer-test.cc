@@ -46,6 +46,7 @@
 #include "yb/consensus/opid_util.h"
 #include "yb/gutil/macros.h"
 #include "yb/rpc/messenger.h"
+#include "yb/rpc/rpc_context.h"
 #include "yb/server/clock.h"
 #include "yb/server/logical_clock.h"
 #include "yb/tablet/operations/operation.h"
@@ -62,6 +63,7 @@ METRIC_DECLARE_entity(table);
 METRIC_DECLARE_entity(tablet);
 
 DECLARE_int32(log_min_seconds_to_retain);
+DECLARE_int64(TEST_max_wal_size_to_replay_bytes);
 
 DECLARE_bool(quick_leader_election_on_create);
 
@@ -170,7 +172,8 @@ class TabletPeerTest : public YBTabletTest {
                                            tablet_metric_entity_,
                                            raft_pool_.get(),
                                            tablet_prepare_pool_.get(),
-                                           nullptr /* retryable_requests */));
+                                           nullptr /* retryable_requests */,
+                                           nullptr /* multi_raft_manager */));
   }
 
   CHECKED_STATUS StartPeer(const ConsensusBootstrapInfo& info) {
@@ -416,6 +419,77 @@ TEST_F(TabletPeerTest, TestActiveOperationPreventsLogGC) {
   ASSERT_EQ(5, segments.size());
 }
 
+// Ensure that log GC flushes the tablet each time the log that would be replayed by bootstrap
+// exceeds the limit.
+TEST_F(TabletPeerTest, FlushIfReplayTooLarge) {
+  FLAGS_log_min_seconds_to_retain = 0;
+  FLAGS_TEST_max_wal_size_to_replay_bytes = 1;
+  ConsensusBootstrapInfo info;
+  ASSERT_OK(StartPeer(info));
+
+  auto* tablet = tablet_peer_->tablet();
+  for (int i = 0; i != 3; ++i) {
+    ASSERT_OK(ExecuteInsertsAndRollLogs(2));
+    auto last_index = tablet_peer_->log_->GetLatestEntryOpId().index;
+    auto flushed_op_id = ASSERT_RESULT(tablet->MaxPersistentOpId()).regular;
+    ASSERT_LT(flushed_op_id.index, last_index);
+
+    ASSERT_OK(tablet_peer_->RunLogGC());
+    ASSERT_OK(tablet->WaitForFlush());
+    flushed_op_id = ASSERT_RESULT(tablet->MaxPersistentOpId()).regular;
+    ASSERT_EQ(flushed_op_id.index, last_index) << "Iteration: " << i;
+    ASSERT_FALSE(tablet->HasFlushInProgress());
+
+    // Nothing new to flush, so log GC should not request flush again.
+    ASSERT_OK(tablet_peer_->RunLogGC());
+    ASSERT_FALSE(tablet->HasFlushInProgress());
+  }
+}
+
+// Write request that is shared with the RPC call arena should be replicated without being copied.
+TEST_F(TabletPeerTest, SharedWriteRequest) {
+  ConsensusBootstrapInfo info;
+  ASSERT_OK(StartPeer(info));
+
+  auto arena = std::make_shared<rpc::CallArena>();
+  std::shared_ptr<WriteRequestPB> request(arena, arena->NewMessage<WriteRequestPB>());
+  GenerateSequentialInsertRequest(request.get());
+  // The arena should be kept alive by the request only.
+  arena.reset();
+
+  {
+    WriteResponsePB resp;
+    WriteOperation operation(
+        /* leader_term */ 1, CoarseTimePoint::max(), tablet_peer_.get(), tablet_peer_->tablet(),
+        &resp);
+    operation.UseSharedRequest(request);
+    ASSERT_EQ(operation.request(), request.get());
+    ASSERT_EQ(operation.mutable_request(), request.get());
+
+    auto use_count = request.use_count();
+    auto replicate_msg = operation.NewReplicateMsg();
+    ASSERT_EQ(replicate_msg->op_type(), consensus::WRITE_OP);
+    ASSERT_EQ(&replicate_msg->write_request(), request.get());
+    ASSERT_EQ(request.use_count(), use_count + 1);
+
+    // Destroying the message should not destroy the request it references.
+    replicate_msg.reset();
+    ASSERT_EQ(request.use_count(), use_count);
+    ASSERT_EQ(request->tablet_id(), tablet()->tablet_id());
+  }
+
+  WriteResponsePB resp;
+  auto operation = std::make_unique<WriteOperation>(
+      /* leader_term */ 1, CoarseTimePoint::max(), tablet_peer_.get(), tablet_peer_->tablet(),
+      &resp);
+  operation->UseSharedRequest(std::move(request));
+  CountDownLatch rpc_latch(1);
+  operation->set_completion_callback(MakeLatchOperationCompletionCallback(&rpc_latch, &resp));
+  tablet_peer_->WriteAsync(std::move(operation));
+  rpc_latch.Wait();
+  ASSERT_FALSE(resp.has_error()) << resp.ShortDebugString();
+}
+
 TEST_F(TabletPeerTest, TestGCEmptyLog) {
   ConsensusBootstrapInfo info;
   ASSERT_OK(tablet_peer_->Start(info));
@@ -79,9 +79,11 @@
 #include "yb/tablet/operations/write_operation.h"
 #include "yb/tablet/operations/update_txn_operation.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/metrics.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/threadpool.h"
 #include "yb/util/trace.h"
@@ -100,6 +102,16 @@ DEFINE_int32(cdc_min_replicated_index_considered_stale_secs, 900,
 
 DEFINE_bool(propagate_safe_time, true, "Propagate safe time to read from leader to followers");
 
+DEFINE_int64(max_wal_size_to_replay_mb, 1024,
+             "Tablet is flushed when the size of its WAL that would be replayed by bootstrap, i.e. "
+             "WAL written after the last flush, exceeds this value. So restart time is bounded "
+             "regardless of write rate. 0 to disable.");
+TAG_FLAG(max_wal_size_to_replay_mb, advanced);
+TAG_FLAG(max_wal_size_to_replay_mb, runtime);
+
+DEFINE_test_flag(int64, max_wal_size_to_replay_bytes, 0,
+                 "If positive, overrides max_wal_size_to_replay_mb with the limit in bytes.");
+
 DECLARE_int32(ysql_transaction_abort_timeout_ms);
 
 namespace yb {
@@ -186,7 +198,8 @@ Status TabletPeer::InitTabletPeer(
     const scoped_refptr<MetricEntity>& tablet_metric_entity,
     ThreadPool* raft_pool,
     ThreadPool* tablet_prepare_pool,
-    consensus::RetryableRequests* retryable_requests) {
+    consensus::RetryableRequests* retryable_requests,
+    consensus::MultiRaftManager* multi_raft_manager) {
   DCHECK(tablet) << "A TabletPeer must be provided with a Tablet";
   DCHECK(log) << "A TabletPeer must be provided with a Log";
 
@@ -267,7 +280,8 @@ Status TabletPeer::InitTabletPeer(
         mark_dirty_clbk_,
         tablet_->table_type(),
         raft_pool,
-        retryable_requests);
+        retryable_requests,
+        multi_raft_manager);
     has_consensus_.store(true, std::memory_order_release);
 
     tablet_->SetHybridTimeLeaseProvider(std::bind(&TabletPeer::HybridTimeLease, this, _1, _2));
@@ -715,6 +729,7 @@ Status TabletPeer::RunLogGC() {
   if (!s.ok()) {
     LOG_WITH_PREFIX(WARNING) << "Unable to reset cdc min replicated index " << s;
   }
+  FlushIfReplayTooLarge();
   int64_t min_log_index;
   if (VLOG_IS_ON(2)) {
     std::string details;
@@ -921,6 +936,53 @@ Result<int64_t> TabletPeer::GetEarliestNeededLogIndex(std::string* details) cons
   return min_index;
 }
 
+void TabletPeer::FlushIfReplayTooLarge() {
+  const int64_t max_replay_size = FLAGS_TEST_max_wal_size_to_replay_bytes > 0
+      ? FLAGS_TEST_max_wal_size_to_replay_bytes
+      : GetAtomicFlag(&FLAGS_max_wal_size_to_replay_mb) * 1_MB;
+  // Transaction status tablet does not bound replay by flushed op id, see
+  // GetEarliestNeededLogIndex.
+  if (max_replay_size <= 0 ||
+      tablet_->table_type() == TableType::TRANSACTION_STATUS_TABLE_TYPE) {
+    return;
+  }
+
+  auto max_persistent_op_id = tablet_->MaxPersistentOpId(true /* invalid_if_no_new_data */);
+  if (!max_persistent_op_id.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Failed to get max persistent op id: "
+                             << max_persistent_op_id.status();
+    return;
+  }
+  // Only RocksDBs with new data have valid op ids, and bootstrap replays log after the lowest one.
+  int64_t flushed_index = std::numeric_limits<int64_t>::max();
+  FlushFlags flush_flags = FlushFlags::kNone;
+  if (max_persistent_op_id->regular.valid()) {
+    flushed_index = max_persistent_op_id->regular.index;
+    flush_flags = flush_flags | FlushFlags::kRegular;
+  }
+  if (max_persistent_op_id->intents.valid()) {
+    flushed_index = std::min(flushed_index, max_persistent_op_id->intents.index);
+    flush_flags = flush_flags | FlushFlags::kIntents;
+  }
+  // Don't request another flush until the previous one completes or fails. Flushed op id could
+  // remain behind the latest log entry even after successful flush, e.g. when the tail of the log
+  // does not write to RocksDB, so the flush state of RocksDB itself is checked.
+  if (flush_flags == FlushFlags::kNone || tablet_->HasFlushInProgress(flush_flags)) {
+    return;
+  }
+
+  const auto replay_size = log_->SizeOfSegmentsAfter(flushed_index);
+  if (replay_size <= static_cast<uint64_t>(max_replay_size)) {
+    return;
+  }
+  LOG_WITH_PREFIX(INFO)
+      << "Flushing tablet, since bootstrap would replay " << replay_size
+      << " bytes of log after op index " << flushed_index << ", while only " << max_replay_size
+      << " is allowed";
+  WARN_NOT_OK(tablet_->Flush(FlushMode::kAsync, flush_flags),
+              "Flush to bound bootstrap replay failed");
+}
+
 Status TabletPeer::GetMaxIndexesToSegmentSizeMap(MaxIdxToSegmentSizeMap* idx_size_map) const {
   RETURN_NOT_OK(CheckRunning());
   int64_t min_op_idx = VERIFY_RESULT(GetEarliestNeededLogIndex());
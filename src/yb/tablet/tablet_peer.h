@@ -161,7 +161,8 @@ class TabletPeer : public consensus::ConsensusContext,
       const scoped_refptr<MetricEntity>& tablet_metric_entity,
       ThreadPool* raft_pool,
       ThreadPool* tablet_prepare_pool,
-      consensus::RetryableRequests* retryable_requests);
+      consensus::RetryableRequests* retryable_requests,
+      consensus::MultiRaftManager* multi_raft_manager);
 
   // Starts the TabletPeer, making it available for Write()s. If this
   // TabletPeer is part of a consensus configuration this will connect it to other peers
@@ -326,7 +327,7 @@ class TabletPeer : public consensus::ConsensusContext,
     return clock_;
   }
 
-  void Enqueue(rpc::ThreadPoolTask* task);
+  void Enqueue(rpc::ThreadPoolTask* task) override;
   void StrandEnqueue(rpc::StrandTask* task) override;
 
   const std::shared_future<client::YBClient*>& client_future() const override {
@@ -484,6 +485,10 @@ class TabletPeer : public consensus::ConsensusContext,
   Result<HybridTime> ReportReadRestart() override;
 
   Result<FixedHybridTimeLease> HybridTimeLease(HybridTime min_allowed, CoarseTimePoint deadline);
+
+  // Flushes the tablet when the log that would be replayed by bootstrap, i.e. written after the
+  // last flush, exceeds max_wal_size_to_replay_mb.
+  void FlushIfReplayTooLarge();
   Result<HybridTime> PreparePeerRequest() override;
   void MajorityReplicated() override;
   void ChangeConfigReplicated(const consensus::RaftConfigPB& config) override;
@@ -0,0 +1,145 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/primitive_value.h"
+
+#include "yb/tablet/transaction_intents_ranges.h"
+
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace tablet {
+
+using docdb::DocKey;
+using docdb::KeyBytes;
+using docdb::PrimitiveValue;
+using docdb::PrimitiveValues;
+using docdb::SubDocKey;
+
+namespace {
+
+KeyBytes EncodedDocKey(const std::string& key) {
+  return DocKey(PrimitiveValues(key)).Encode();
+}
+
+KeyBytes EncodedColumnKey(const std::string& key) {
+  return SubDocKey(DocKey(PrimitiveValues(key)), PrimitiveValue(ColumnId(40))).EncodeWithoutHt();
+}
+
+// Registers intents range of write batch that updates column of each specified row.
+void AddWrittenRows(
+    const TransactionId& id, std::initializer_list<std::string> rows,
+    TransactionIntentsRanges* ranges) {
+  docdb::KeyValueWriteBatchPB put_batch;
+  for (const auto& row : rows) {
+    put_batch.add_write_pairs()->set_key(EncodedColumnKey(row).ToStringBuffer());
+  }
+  std::string lower, upper;
+  GetIntentsRange(put_batch, &lower, &upper);
+  ranges->Add(id, lower, upper);
+}
+
+bool MayHaveIntents(
+    const TransactionIntentsRanges& ranges, const KeyBytes& lower, const KeyBytes& upper) {
+  return ranges.MayHaveIntentsInRange(lower.AsSlice(), upper.AsSlice());
+}
+
+} // namespace
+
+class TransactionIntentsRangesTest : public YBTest {
+ protected:
+  TransactionIntentsRanges ranges_;
+};
+
+TEST_F(TransactionIntentsRangesTest, PointRead) {
+  ASSERT_FALSE(MayHaveIntents(ranges_, KeyBytes(), KeyBytes()));
+
+  auto id = TransactionId::GenerateRandom();
+  AddWrittenRows(id, {"b"}, &ranges_);
+
+  // Point read uses bare DocKey as both bounds, while intent is written for column of this row.
+  ASSERT_TRUE(MayHaveIntents(ranges_, EncodedDocKey("b"), EncodedDocKey("b")));
+  ASSERT_FALSE(MayHaveIntents(ranges_, EncodedDocKey("a"), EncodedDocKey("a")));
+  ASSERT_FALSE(MayHaveIntents(ranges_, EncodedDocKey("c"), EncodedDocKey("c")));
+
+  ranges_.Remove(id);
+  ASSERT_FALSE(MayHaveIntents(ranges_, EncodedDocKey("b"), EncodedDocKey("b")));
+  ASSERT_TRUE(ranges_.empty());
+}
+
+TEST_F(TransactionIntentsRangesTest, RangeRead) {
+  auto id1 = TransactionId::GenerateRandom();
+  auto id2 = TransactionId::GenerateRandom();
+  AddWrittenRows(id1, {"d", "f"}, &ranges_);
+
+  ASSERT_TRUE(MayHaveIntents(ranges_, KeyBytes(), KeyBytes()));
+  ASSERT_TRUE(MayHaveIntents(ranges_, EncodedDocKey("a"), EncodedDocKey("z")));
+  ASSERT_TRUE(MayHaveIntents(ranges_, EncodedDocKey("e"), EncodedDocKey("e")));
+  ASSERT_TRUE(MayHaveIntents(ranges_, KeyBytes(), EncodedDocKey("e")));
+  ASSERT_TRUE(MayHaveIntents(ranges_, EncodedDocKey("e"), KeyBytes()));
+  ASSERT_FALSE(MayHaveIntents(ranges_, EncodedDocKey("a"), EncodedDocKey("c")));
+  ASSERT_FALSE(MayHaveIntents(ranges_, KeyBytes(), EncodedDocKey("c")));
+  ASSERT_FALSE(MayHaveIntents(ranges_, EncodedDocKey("g"), EncodedDocKey("z")));
+  ASSERT_FALSE(MayHaveIntents(ranges_, EncodedDocKey("g"), KeyBytes()));
+
+  // Range of second transaction extends tracked range.
+  AddWrittenRows(id2, {"h"}, &ranges_);
+  ASSERT_TRUE(MayHaveIntents(ranges_, EncodedDocKey("g"), EncodedDocKey("z")));
+  ranges_.Remove(id1);
+  ASSERT_FALSE(MayHaveIntents(ranges_, EncodedDocKey("a"), EncodedDocKey("g")));
+  ASSERT_TRUE(MayHaveIntents(ranges_, EncodedDocKey("g"), EncodedDocKey("z")));
+
+  // Extending range of the same transaction.
+  AddWrittenRows(id2, {"b"}, &ranges_);
+  ASSERT_TRUE(MayHaveIntents(ranges_, EncodedDocKey("a"), EncodedDocKey("c")));
+  ranges_.Remove(id2);
+  ASSERT_FALSE(MayHaveIntents(ranges_, KeyBytes(), KeyBytes()));
+}
+
+TEST_F(TransactionIntentsRangesTest, Boundary) {
+  auto id = TransactionId::GenerateRandom();
+  AddWrittenRows(id, {"d", "f"}, &ranges_);
+
+  // Scan that ends at the row with intent.
+  ASSERT_TRUE(MayHaveIntents(ranges_, EncodedDocKey("a"), EncodedDocKey("d")));
+  ASSERT_TRUE(MayHaveIntents(ranges_, EncodedDocKey("a"), EncodedColumnKey("d")));
+  // Scan that starts at the row with intent.
+  ASSERT_TRUE(MayHaveIntents(ranges_, EncodedDocKey("f"), EncodedDocKey("z")));
+  ASSERT_TRUE(MayHaveIntents(ranges_, EncodedColumnKey("f"), EncodedDocKey("z")));
+}
+
+TEST_F(TransactionIntentsRangesTest, Full) {
+  auto id1 = TransactionId::GenerateRandom();
+  auto id2 = TransactionId::GenerateRandom();
+  AddWrittenRows(id1, {"d"}, &ranges_);
+  ranges_.AddFull(id2);
+  ASSERT_TRUE(MayHaveIntents(ranges_, EncodedDocKey("a"), EncodedDocKey("b")));
+
+  // Full range is not narrowed by later writes.
+  AddWrittenRows(id2, {"x"}, &ranges_);
+  ASSERT_TRUE(MayHaveIntents(ranges_, EncodedDocKey("a"), EncodedDocKey("b")));
+
+  ranges_.Remove(id2);
+  ASSERT_FALSE(MayHaveIntents(ranges_, EncodedDocKey("a"), EncodedDocKey("b")));
+  ASSERT_TRUE(MayHaveIntents(ranges_, EncodedDocKey("d"), EncodedDocKey("d")));
+
+  ranges_.AddFull(id1);
+  ranges_.Clear();
+  ASSERT_FALSE(MayHaveIntents(ranges_, KeyBytes(), KeyBytes()));
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,143 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/transaction_intents_ranges.h"
+
+#include "yb/docdb/value_type.h"
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+// Returns true if lhs + kMaxByte is less than rhs + kMaxByte.
+bool LessWithMaxByteAppended(const Slice& lhs, const Slice& rhs) {
+  const auto min_size = std::min(lhs.size(), rhs.size());
+  const auto cmp = memcmp(lhs.data(), rhs.data(), min_size);
+  if (cmp != 0) {
+    return cmp < 0;
+  }
+  const auto max_byte = static_cast<uint8_t>(docdb::ValueType::kMaxByte);
+  if (lhs.size() < rhs.size()) {
+    return rhs[min_size] == max_byte;
+  }
+  if (rhs.size() < lhs.size()) {
+    return lhs[min_size] != max_byte;
+  }
+  return false;
+}
+
+} // namespace
+
+void GetIntentsRange(
+    const docdb::KeyValueWriteBatchPB& put_batch, std::string* lower, std::string* upper) {
+  Slice min_key, max_key;
+  for (const auto& pair : put_batch.write_pairs()) {
+    Slice key(pair.key());
+    if (min_key.empty() || key.compare(min_key) < 0) {
+      min_key = key;
+    }
+    if (max_key.empty() || LessWithMaxByteAppended(max_key, key)) {
+      max_key = key;
+    }
+  }
+  lower->assign(min_key.cdata(), min_key.size());
+  upper->reserve(max_key.size() + 1);
+  upper->assign(max_key.cdata(), max_key.size());
+  upper->push_back(docdb::ValueTypeAsChar::kMaxByte);
+}
+
+void TransactionIntentsRanges::Add(
+    const TransactionId& id, const Slice& lower, const Slice& upper) {
+  auto it = ranges_.find(id);
+  if (it == ranges_.end()) {
+    it = ranges_.emplace(id, Range {
+      .lower = lower.ToBuffer(),
+      .upper = upper.ToBuffer(),
+    }).first;
+  } else {
+    auto& range = it->second;
+    if (range.full || (lower.compare(range.lower) >= 0 && upper.compare(range.upper) <= 0)) {
+      return;
+    }
+    RemoveBounds(range);
+    if (lower.compare(range.lower) < 0) {
+      range.lower = lower.ToBuffer();
+    }
+    if (upper.compare(range.upper) > 0) {
+      range.upper = upper.ToBuffer();
+    }
+  }
+  lower_bounds_.insert(it->second.lower);
+  upper_bounds_.insert(it->second.upper);
+}
+
+void TransactionIntentsRanges::AddFull(const TransactionId& id) {
+  auto& range = ranges_[id];
+  if (range.full) {
+    return;
+  }
+  if (!range.lower.empty() || !range.upper.empty()) {
+    RemoveBounds(range);
+  }
+  range.full = true;
+  ++num_full_ranges_;
+}
+
+void TransactionIntentsRanges::Remove(const TransactionId& id) {
+  auto it = ranges_.find(id);
+  if (it == ranges_.end()) {
+    return;
+  }
+  RemoveBounds(it->second);
+  ranges_.erase(it);
+}
+
+void TransactionIntentsRanges::Clear() {
+  ranges_.clear();
+  lower_bounds_.clear();
+  upper_bounds_.clear();
+  num_full_ranges_ = 0;
+}
+
+void TransactionIntentsRanges::RemoveBounds(const Range& range) {
+  if (range.full) {
+    --num_full_ranges_;
+    return;
+  }
+  lower_bounds_.erase(lower_bounds_.find(range.lower));
+  upper_bounds_.erase(upper_bounds_.find(range.upper));
+}
+
+bool TransactionIntentsRanges::MayHaveIntentsInRange(
+    const Slice& lower_bound, const Slice& upper_bound) const {
+  if (num_full_ranges_ != 0) {
+    return true;
+  }
+  if (lower_bounds_.empty()) {
+    return false;
+  }
+  // Intents range lower bound is usually SubDocKey, i.e. DocKey followed by column, while upper
+  // bound of point read is bare DocKey. So all keys that start with upper bound are treated as
+  // being in range.
+  Slice min_intents_key(*lower_bounds_.begin());
+  if (!upper_bound.empty() &&
+      min_intents_key.compare(upper_bound) > 0 && !min_intents_key.starts_with(upper_bound)) {
+    return false;
+  }
+  // Upper bound of intents range already covers all keys that start with the max written key.
+  return lower_bound.empty() || lower_bound.compare(*upper_bounds_.rbegin()) <= 0;
+}
+
+} // namespace tablet
+} // namespace yb
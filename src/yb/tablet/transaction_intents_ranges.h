@@ -0,0 +1,84 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_TRANSACTION_INTENTS_RANGES_H
+#define YB_TABLET_TRANSACTION_INTENTS_RANGES_H
+
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include "yb/common/transaction.h"
+
+#include "yb/docdb/docdb.pb.h"
+
+#include "yb/util/slice.h"
+
+namespace yb {
+namespace tablet {
+
+// Fills range of keys that could be affected by intents of specified write batch.
+// Intent keys for written key start with this key, also write could affect subkeys of written key,
+// for instance when the whole document is deleted. So lower is the min written key, and upper is
+// max written key + kMaxByte.
+void GetIntentsRange(
+    const docdb::KeyValueWriteBatchPB& put_batch, std::string* lower, std::string* upper);
+
+// Tracks ranges of keys of intents written by running transactions of a tablet.
+// Not thread safe, should be protected by owner.
+class TransactionIntentsRanges {
+ public:
+  // Extends range of keys of intents written by specified transaction.
+  // Upper bound is inclusive and should already cover all keys that start with the greatest
+  // written key, see GetIntentsRange.
+  void Add(const TransactionId& id, const Slice& lower, const Slice& upper);
+
+  // Marks that specified transaction could have intents in any range, e.g. it was loaded after
+  // restart and keys of its intents are unknown.
+  void AddFull(const TransactionId& id);
+
+  void Remove(const TransactionId& id);
+
+  void Clear();
+
+  // Returns false when none of tracked transactions has intents in the specified range.
+  // Lower bound is inclusive, upper bound covers itself and all keys that start with it, so bare
+  // DocKey could be used as upper bound of point read. Empty bound means that range is not limited
+  // from this side.
+  bool MayHaveIntentsInRange(const Slice& lower_bound, const Slice& upper_bound) const;
+
+  bool empty() const {
+    return ranges_.empty();
+  }
+
+ private:
+  struct Range {
+    std::string lower;
+    std::string upper;
+    bool full = false;
+  };
+
+  void RemoveBounds(const Range& range);
+
+  std::unordered_map<TransactionId, Range, TransactionIdHash> ranges_;
+  // Bounds of all non full ranges from ranges_. So union of those ranges is contained in
+  // [*lower_bounds_.begin(), *upper_bounds_.rbegin()].
+  std::multiset<std::string> lower_bounds_;
+  std::multiset<std::string> upper_bounds_;
+  size_t num_full_ranges_ = 0;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_TRANSACTION_INTENTS_RANGES_H
@@ -47,6 +47,7 @@
 #include "yb/tablet/cleanup_intents_task.h"
 #include "yb/tablet/operations/update_txn_operation.h"
 #include "yb/tablet/running_transaction.h"
+#include "yb/tablet/transaction_intents_ranges.h"
 #include "yb/tablet/transaction_loader.h"
 #include "yb/tablet/transaction_status_resolver.h"
 
@@ -111,6 +112,29 @@ namespace {
 
 YB_STRONGLY_TYPED_BOOL(PostApplyCleanup);
 
+// Invokes callback of request waiting in wait queue in tablet thread pool.
+class WaitDoneTask : public rpc::ThreadPoolTask {
+ public:
+  WaitDoneTask(docdb::WaitDoneCallback callback, const Status& status)
+      : callback_(std::move(callback)), status_(status) {}
+
+  void Run() override {
+    callback_(status_);
+    callback_ = nullptr;
+  }
+
+  void Done(const Status& status) override {
+    if (callback_) {
+      callback_(status);
+    }
+    delete this;
+  }
+
+ private:
+  docdb::WaitDoneCallback callback_;
+  Status status_;
+};
+
 } // namespace
 
 std::string TransactionApplyData::ToString() const {
@@ -125,6 +149,12 @@ class TransactionParticipant::Impl
        const scoped_refptr<MetricEntity>& entity)
       : RunningTransactionContext(context, applier),
         log_prefix_(context->LogPrefix()),
+        wait_queue_(
+            log_prefix_,
+            std::bind(&Impl::IsTransactionActive, this, _1),
+            [context](docdb::WaitDoneCallback callback, const Status& status) {
+              context->Enqueue(new WaitDoneTask(std::move(callback), status));
+            }),
         loader_(this, entity),
         poller_(log_prefix_, std::bind(&Impl::Poll, this)) {
     LOG_WITH_PREFIX(INFO) << "Create";
@@ -148,6 +178,7 @@ class TransactionParticipant::Impl
     }
 
     poller_.Shutdown();
+    wait_queue_.StartShutdown();
 
     if (start_latch_.count()) {
       start_latch_.CountDown();
@@ -165,6 +196,7 @@ class TransactionParticipant::Impl
       MinRunningNotifier min_running_notifier(nullptr /* applier */);
       std::lock_guard<std::mutex> lock(mutex_);
       transactions_.clear();
+      intents_ranges_.Clear();
       TransactionsModifiedUnlocked(&min_running_notifier);
       status_resolvers.swap(status_resolvers_);
     }
@@ -328,6 +360,24 @@ class TransactionParticipant::Impl
     (**it).BatchReplicated(data);
   }
 
+  void AddIntentsRange(const TransactionId& id, const Slice& lower, const Slice& upper) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (transactions_.find(id) == transactions_.end()) {
+      LOG_IF_WITH_PREFIX(DFATAL, !WasTransactionRecentlyRemoved(id))
+          << "Add intents range for unknown transaction: " << id;
+      return;
+    }
+    intents_ranges_.Add(id, lower, upper);
+  }
+
+  bool MayHaveIntentsInRange(const Slice& lower_bound, const Slice& upper_bound) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!loader_.complete()) {
+      return true;
+    }
+    return intents_ranges_.MayHaveIntentsInRange(lower_bound, upper_bound);
+  }
+
   void RequestStatusAt(const StatusRequest& request) {
     auto lock_and_iterator = LockAndFind(*request.id, *request.reason, request.flags);
     if (!lock_and_iterator.found()) {
@@ -667,6 +717,7 @@ class TransactionParticipant::Impl
     MinRunningNotifier min_running_notifier(&applier_);
     std::lock_guard<std::mutex> lock(mutex_);
     transactions_.clear();
+    intents_ranges_.Clear();
     TransactionsModifiedUnlocked(&min_running_notifier);
   }
 
@@ -695,6 +746,17 @@ class TransactionParticipant::Impl
     return &participant_context_;
   }
 
+  docdb::WaitQueue* wait_queue() {
+    return &wait_queue_;
+  }
+
+  // Whether transaction is running at this participant, so wait queue will be signaled when it is
+  // removed.
+  bool IsTransactionActive(const TransactionId& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return transactions_.find(id) != transactions_.end();
+  }
+
   HybridTime MinRunningHybridTime() {
     auto result = min_running_ht_.load(std::memory_order_acquire);
     if (result == HybridTime::kMax || result == HybridTime::kInvalid) {
@@ -1231,6 +1293,9 @@ class TransactionParticipant::Impl
       txn->SetLocalCommitData(pending_apply->commit_ht, pending_apply->state.aborted);
       txn->SetApplyData(pending_apply->state);
     }
+    // Keys of intents written before restart are unknown, so this transaction could have intents
+    // in any range.
+    intents_ranges_.AddFull(txn->id());
     transactions_.insert(txn);
     TransactionsModifiedUnlocked(&min_running_notifier);
   }
@@ -1267,6 +1332,10 @@ class TransactionParticipant::Impl
     LOG_IF_WITH_PREFIX(DFATAL, !recently_removed_transactions_.insert(transaction.id()).second)
         << "Transaction removed twice: " << transaction.id();
     VLOG_WITH_PREFIX(4) << "Remove transaction: " << transaction.id();
+    if (wait_queue_.HasWaiters()) {
+      min_running_notifier->TransactionRemoved(&wait_queue_, transaction.id());
+    }
+    intents_ranges_.Remove(transaction.id());
     transactions_.erase(it);
     TransactionsModifiedUnlocked(min_running_notifier);
   }
@@ -1410,6 +1479,7 @@ class TransactionParticipant::Impl
         CheckForAbortedTransactions();
       }
     }
+    wait_queue_.Poll(CoarseMonoClock::now());
     CleanupStatusResolvers();
   }
 
@@ -1488,12 +1558,18 @@ class TransactionParticipant::Impl
 
   std::string log_prefix_;
 
+  // Requests blocked by transactions running at this participant.
+  docdb::WaitQueue wait_queue_;
+
   docdb::DocDB db_;
   const docdb::KeyBounds* key_bounds_;
   // Owned externally, should be guaranteed that would not be destroyed before this.
   RWOperationCounter* pending_op_counter_ = nullptr;
 
   Transactions transactions_;
+
+  TransactionIntentsRanges intents_ranges_ GUARDED_BY(mutex_);
+
   // Ids of running requests, stored in increasing order.
   std::deque<int64_t> running_requests_;
   // Ids of complete requests, minimal request is on top.
@@ -1593,6 +1669,16 @@ void TransactionParticipant::BatchReplicated(
   return impl_->BatchReplicated(id, data);
 }
 
+void TransactionParticipant::AddIntentsRange(
+    const TransactionId& id, const Slice& lower, const Slice& upper) {
+  impl_->AddIntentsRange(id, lower, upper);
+}
+
+bool TransactionParticipant::MayHaveIntentsInRange(
+    const Slice& lower_bound, const Slice& upper_bound) const {
+  return impl_->MayHaveIntentsInRange(lower_bound, upper_bound);
+}
+
 HybridTime TransactionParticipant::LocalCommitTime(const TransactionId& id) {
   return impl_->LocalCommitTime(id);
 }
@@ -1688,6 +1774,10 @@ std::string TransactionParticipant::ReplicatedData::ToString() const {
   return YB_STRUCT_TO_STRING(leader_term, state, op_id, hybrid_time, already_applied_to_regular_db);
 }
 
+docdb::WaitQueue* TransactionParticipant::wait_queue() const {
+  return impl_->wait_queue();
+}
+
 void TransactionParticipant::StartShutdown() {
   impl_->StartShutdown();
 }
@@ -31,6 +31,7 @@
 #include "yb/consensus/opid_util.h"
 
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/docdb_fwd.h"
 
 #include "yb/rpc/rpc_fwd.h"
 
@@ -117,6 +118,8 @@ class TransactionParticipantContext {
 
   // Enqueue task to participant context strand.
   virtual void StrandEnqueue(rpc::StrandTask* task) = 0;
+  // Enqueue task to participant context thread pool.
+  virtual void Enqueue(rpc::ThreadPoolTask* task) = 0;
   virtual void UpdateClock(HybridTime hybrid_time) = 0;
   virtual bool IsLeader() = 0;
   virtual void SubmitUpdateTransaction(
@@ -178,6 +181,12 @@ class TransactionParticipant : public TransactionStatusManager {
 
   void BatchReplicated(const TransactionId& id, const TransactionalBatchData& data);
 
+  // Extends range of keys of intents written by specified transaction. Should be invoked before
+  // intents are written to intents DB. Upper bound is inclusive.
+  void AddIntentsRange(const TransactionId& id, const Slice& lower, const Slice& upper);
+
+  bool MayHaveIntentsInRange(const Slice& lower_bound, const Slice& upper_bound) const override;
+
   HybridTime LocalCommitTime(const TransactionId& id) override;
 
   boost::optional<CommitMetadata> LocalCommitData(const TransactionId& id) override;
@@ -221,6 +230,9 @@ class TransactionParticipant : public TransactionStatusManager {
 
   TransactionParticipantContext* context() const;
 
+  // Queue of requests waiting for transactions running at this participant.
+  docdb::WaitQueue* wait_queue() const;
+
   HybridTime MinRunningHybridTime() const override;
 
   Result<HybridTime> WaitForSafeTime(HybridTime safe_time, CoarseTimePoint deadline) override;
@@ -55,6 +55,40 @@ void SetupErrorAndRespond(TabletServerErrorPB* error,
       error, s, ts_error ? ts_error->value() : TabletServerErrorPB::UNKNOWN_ERROR, context);
 }
 
+void SetupError(TabletServerErrorPB* error, const Status& s) {
+  auto ts_error = TabletServerError::FromStatus(s);
+  StatusToPB(s, error->mutable_status());
+  error->set_code(ts_error ? ts_error->value() : TabletServerErrorPB::UNKNOWN_ERROR);
+}
+
+Result<TabletPeerTablet> LookupTabletPeer(
+    TabletPeerLookupIf* tablet_manager, const std::string& tablet_id) {
+  TabletPeerTablet result;
+  Status status = tablet_manager->GetTabletPeer(tablet_id, &result.tablet_peer);
+  if (PREDICT_FALSE(!status.ok())) {
+    // Generic "service unavailable" errors will cause the client to retry later.
+    if (status.IsServiceUnavailable()) {
+      return status;
+    }
+    return status.CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::TABLET_NOT_FOUND));
+  }
+
+  // Check RUNNING state.
+  tablet::RaftGroupStatePB state = result.tablet_peer->state();
+  if (PREDICT_FALSE(state != tablet::RUNNING)) {
+    return STATUS(IllegalState, "Tablet not RUNNING", tablet::RaftGroupStateError(state))
+        .CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::TABLET_NOT_RUNNING));
+  }
+
+  result.tablet = result.tablet_peer->shared_tablet();
+  if (!result.tablet) {
+    return STATUS(IllegalState,
+                  "Tablet not running",
+                  TabletServerError(TabletServerErrorPB::TABLET_NOT_RUNNING));
+  }
+  return result;
+}
+
 Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer) {
   std::shared_ptr<consensus::Consensus> consensus = tablet_peer.shared_consensus();
   if (!consensus) {
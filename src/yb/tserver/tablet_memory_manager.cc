@@ -26,6 +26,7 @@
 #include "yb/tablet/tablet_peer.h"
 
 #include "yb/util/background_task.h"
+#include "yb/util/cache_metrics.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/mem_tracker.h"
 
@@ -73,6 +74,18 @@ DEFINE_int32(db_block_cache_num_shard_bits, 4,
              "Number of bits to use for sharding the block cache (defaults to 4 bits)");
 TAG_FLAG(db_block_cache_num_shard_bits, advanced);
 
+DEFINE_int32(db_metadata_block_cache_percentage, 10,
+             "Percentage of the block cache size that is reserved for separate cache of index "
+             "and filter blocks, so they are not evicted by scans of data blocks. "
+             "0 means that index and filter blocks are stored in the regular block cache.");
+TAG_FLAG(db_metadata_block_cache_percentage, advanced);
+
+DEFINE_string(db_block_cache_type, "lru",
+              "Eviction policy of block cache and metadata block cache: lru or clock. "
+              "CLOCK cache does not take exclusive lock on lookup, and keeps hot blocks when "
+              "long scans are running.");
+TAG_FLAG(db_block_cache_type, advanced);
+
 DEFINE_test_flag(bool, pretend_memory_exceeded_enforce_flush, false,
                   "Always pretend memory has been exceeded to enforce background flush.");
 
@@ -83,6 +96,15 @@ using strings::Substitute;
 
 namespace {
 
+std::shared_ptr<rocksdb::Cache> NewBlockCache(size_t capacity) {
+  if (FLAGS_db_block_cache_type == "clock") {
+    return rocksdb::NewClockCache(capacity, FLAGS_db_block_cache_num_shard_bits);
+  }
+  CHECK_EQ(FLAGS_db_block_cache_type, "lru")
+      << "Flag db_block_cache_type must be either lru or clock";
+  return rocksdb::NewLRUCache(capacity, FLAGS_db_block_cache_num_shard_bits);
+}
+
 class FunctorGC : public GarbageCollector {
  public:
   explicit FunctorGC(std::function<void(size_t)> impl) : impl_(std::move(impl)) {}
@@ -193,8 +215,20 @@ void TabletMemoryManager::InitBlockCache(
       server_mem_tracker_);
 
   if (block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
-    options->block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
-                                                FLAGS_db_block_cache_num_shard_bits);
+    CHECK(FLAGS_db_metadata_block_cache_percentage >= 0 &&
+          FLAGS_db_metadata_block_cache_percentage < 100)
+        << "Flag db_metadata_block_cache_percentage must be between 0 and 99. Current value: "
+        << FLAGS_db_metadata_block_cache_percentage;
+    // Metadata block cache is carved out of block cache budget, so total memory is unchanged.
+    const int64_t metadata_block_cache_size_bytes =
+        block_cache_size_bytes * FLAGS_db_metadata_block_cache_percentage / 100;
+    if (metadata_block_cache_size_bytes > 0) {
+      options->metadata_block_cache = NewBlockCache(metadata_block_cache_size_bytes);
+      options->metadata_block_cache->SetMetrics(
+          metrics, CacheMetricsKind::kMetadataBlockCache);
+      block_cache_size_bytes -= metadata_block_cache_size_bytes;
+    }
+    options->block_cache = NewBlockCache(block_cache_size_bytes);
     options->block_cache->SetMetrics(metrics);
     block_based_table_gc_ = std::make_shared<LRUCacheGC>(options->block_cache);
     block_based_table_mem_tracker_->AddGarbageCollector(block_based_table_gc_);
@@ -356,7 +356,8 @@ Status TabletServer::RegisterServices() {
   LOG(INFO) << "yb::tserver::RemoteBootstrapServiceImpl created at " <<
     remote_bootstrap_service.get();
   RETURN_NOT_OK(RpcAndWebServerBase::RegisterService(FLAGS_ts_remote_bootstrap_svc_queue_length,
-                                                     std::move(remote_bootstrap_service)));
+                                                     std::move(remote_bootstrap_service),
+                                                     rpc::ServicePriority::kLow));
 
   std::unique_ptr<ServiceIf> forward_service =
     std::make_unique<TabletServerForwardServiceImpl>(tablet_server_service_, this);
@@ -56,6 +56,9 @@
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/stringprintf.h"
 #include "yb/gutil/strings/escaping.h"
+
+#include "yb/rpc/thread_pool.h"
+
 #include "yb/server/hybrid_clock.h"
 
 #include "yb/tablet/tablet_bootstrap_if.h"
@@ -83,6 +86,7 @@
 #include "yb/util/math_util.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/monotime.h"
+#include "yb/util/protobuf_util.h"
 #include "yb/util/random_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
@@ -230,6 +234,9 @@ DEFINE_test_flag(int32, transactional_read_delay_ms, 0,
 
 DEFINE_test_flag(int32, alter_schema_delay_ms, 0, "Delay before processing AlterSchema.");
 
+DEFINE_test_flag(int32, follower_read_delay_after_safe_time_ms, 0,
+                 "Amount of time to delay follower read after its safe time was picked.");
+
 DEFINE_test_flag(bool, disable_post_split_tablet_rbs_check, false,
                  "If true, bypass any checks made to reject remote boostrap requests for post "
                  "split tablets whose parent tablets are still present.");
@@ -239,6 +246,10 @@ DEFINE_test_flag(double, fail_tablet_split_probability, 0.0,
 
 DECLARE_int32(heartbeat_interval_ms);
 
+METRIC_DEFINE_counter(server, multi_raft_consensus_requests,
+                      "Batched Consensus Requests", yb::MetricUnit::kRequests,
+                      "Number of consensus requests received in MultiRaftUpdateConsensus batches.");
+
 double TEST_delay_create_transaction_probability = 0;
 
 namespace yb {
@@ -1682,7 +1693,15 @@ void TabletServiceImpl::Write(const WriteRequestPB* req,
   auto operation = std::make_unique<WriteOperation>(
       tablet.leader_term, context.GetClientDeadline(), tablet.peer.get(),
       tablet.peer->tablet(), resp);
-  *operation->AllocateRequest() = *req;
+  auto shared_request = context.SharedRequest();
+  if (shared_request) {
+    // Request is used by the operation and its replicate message without copying, and the RPC call
+    // arena that holds it is kept alive until both of them are destroyed.
+    operation->UseSharedRequest(std::shared_ptr<WriteRequestPB>(
+        shared_request, down_cast<WriteRequestPB*>(shared_request.get())));
+  } else {
+    *operation->AllocateRequest() = *req;
+  }
 
   auto context_ptr = std::make_shared<RpcContext>(std::move(context));
   if (RandomActWithProbability(GetAtomicFlag(&FLAGS_TEST_respond_write_failed_probability))) {
@@ -1743,15 +1762,17 @@ Status TabletServiceImpl::CheckPeerIsLeader(const TabletPeer& tablet_peer) {
 
 bool TabletServiceImpl::GetTabletOrRespond(
     const ReadRequestPB* req, ReadResponsePB* resp, rpc::RpcContext* context,
-    std::shared_ptr<tablet::AbstractTablet>* tablet, TabletPeerPtr tablet_peer) {
-  return DoGetTabletOrRespond(req, resp, context, tablet, tablet_peer);
+    std::shared_ptr<tablet::AbstractTablet>* tablet, TabletPeerPtr tablet_peer,
+    HybridTime* follower_safe_time) {
+  return DoGetTabletOrRespond(
+      req, resp, context, tablet, tablet_peer, AllowSplitTablet::kFalse, follower_safe_time);
 }
 
 template <class Req, class Resp>
 bool TabletServiceImpl::DoGetTabletOrRespond(
     const Req* req, Resp* resp, rpc::RpcContext* context,
     std::shared_ptr<tablet::AbstractTablet>* tablet, TabletPeerPtr tablet_peer,
-    AllowSplitTablet allow_split_tablet) {
+    AllowSplitTablet allow_split_tablet, HybridTime* follower_safe_time) {
   tablet::TabletPtr tablet_ptr = nullptr;
   if (tablet_peer) {
     DCHECK_EQ(tablet_peer->tablet_id(), req->tablet_id());
@@ -1800,11 +1821,19 @@ bool TabletServiceImpl::DoGetTabletOrRespond(
     // Peer is not the leader, so check that the time since it last heard from the leader is less
     // than FLAGS_max_stale_read_bound_time_ms.
     if (PREDICT_FALSE(!s.ok())) {
-      if (FLAGS_max_stale_read_bound_time_ms > 0) {
-        shared_ptr <consensus::Consensus> consensus = tablet_peer->shared_consensus();
-        // TODO(hector): This safe time could be reused by the read operation.
-        auto safe_time_micros = tablet_peer->tablet()->mvcc_manager()->SafeTimeForFollower(
-            HybridTime::kMin, CoarseTimePoint::min()).GetPhysicalValueMicros();
+      const bool check_staleness = FLAGS_max_stale_read_bound_time_ms > 0;
+      HybridTime safe_time;
+      if (check_staleness || follower_safe_time) {
+        // Safe time propagated by the leader, so the read could be served at it without
+        // contacting the leader.
+        safe_time = tablet_peer->tablet()->mvcc_manager()->SafeTimeForFollower(
+            HybridTime::kMin, CoarseTimePoint::min());
+        if (follower_safe_time) {
+          *follower_safe_time = safe_time;
+        }
+      }
+      if (check_staleness) {
+        auto safe_time_micros = safe_time.GetPhysicalValueMicros();
         auto now_micros = server_->Clock()->Now().GetPhysicalValueMicros();
         auto follower_staleness_ms = (now_micros - safe_time_micros) / 1000;
         if (follower_staleness_ms > FLAGS_max_stale_read_bound_time_ms) {
@@ -1825,6 +1854,11 @@ bool TabletServiceImpl::DoGetTabletOrRespond(
                   << follower_staleness_ms;
         }
       }
+      if (PREDICT_FALSE(FLAGS_TEST_follower_read_delay_after_safe_time_ms > 0)) {
+        LOG(INFO) << "Delaying follower read for "
+                  << FLAGS_TEST_follower_read_delay_after_safe_time_ms << " ms.";
+        SleepFor(MonoDelta::FromMilliseconds(FLAGS_TEST_follower_read_delay_after_safe_time_ms));
+      }
     } else {
       // We are here because we are the leader.
       if (PREDICT_FALSE(FLAGS_TEST_assert_reads_from_follower_rejected_because_of_staleness)) {
@@ -1862,6 +1896,9 @@ struct ReadContext {
   ReadHybridTime read_time;
   HybridTime safe_ht_to_read;
   ReadHybridTime used_read_time;
+  // Safe time of the follower that serves this read, picked while checking staleness.
+  // Invalid if the read is served by the leader.
+  HybridTime follower_safe_time;
   tablet::RequireLease require_lease = tablet::RequireLease::kFalse;
   HostPortPB* host_port_pb = nullptr;
   bool allow_retry = false;
@@ -1905,7 +1942,13 @@ struct ReadContext {
   // Picks read based for specified read context.
   CHECKED_STATUS DoPickReadTime(server::Clock* clock) {
     if (!read_time) {
-      safe_ht_to_read = VERIFY_RESULT(tablet->SafeTime(require_lease));
+      // Follower reads use the same safe time that passed the staleness check, so the read is
+      // never more stale than allowed.
+      if (follower_safe_time.is_valid()) {
+        safe_ht_to_read = follower_safe_time;
+      } else {
+        safe_ht_to_read = VERIFY_RESULT(tablet->SafeTime(require_lease));
+      }
       // If the read time is not specified, then it is a single-shard read.
       // So we should restart it in server in case of failure.
       read_time.read = safe_ht_to_read;
@@ -1918,6 +1961,10 @@ struct ReadContext {
         read_time.local_limit = read_time.read;
         read_time.global_limit = read_time.read;
       }
+    } else if (follower_safe_time.is_valid() && follower_safe_time >= read_time.read) {
+      // Follower has already applied everything up to the requested read time, so there is no
+      // need to wait for safe time again.
+      safe_ht_to_read = follower_safe_time;
     } else {
       safe_ht_to_read = VERIFY_RESULT(tablet->SafeTime(
           require_lease, read_time.read, context.GetClientDeadline()));
@@ -2095,7 +2142,7 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
   } else {
     if (!GetTabletOrRespond(
         req, resp, &read_context->context, &read_context->tablet,
-        std::move(peer_tablet.tablet_peer))) {
+        std::move(peer_tablet.tablet_peer), &read_context->follower_safe_time)) {
       return;
     }
     leader_peer.leader_term = yb::OpId::kUnknownTerm;
@@ -2394,12 +2441,13 @@ Result<ReadHybridTime> TabletServiceImpl::DoReadImpl(ReadContext* read_context)
     DCHECK_EQ(read_context->tablet->table_type(), TableType::YQL_TABLE_TYPE);
     ReadRequestPB* mutable_req = const_cast<ReadRequestPB*>(read_context->req);
     for (QLReadRequestPB& ql_read_req : *mutable_req->mutable_ql_batch()) {
-      // Update the remote endpoint.
-      ql_read_req.set_allocated_remote_endpoint(read_context->host_port_pb);
-      ql_read_req.set_allocated_proxy_uuid(mutable_req->mutable_proxy_uuid());
+      // Update the remote endpoint. Fields are copied, because request could be allocated in the
+      // call arena, that would take ownership of fields set with set_allocated.
+      *ql_read_req.mutable_remote_endpoint() = *read_context->host_port_pb;
+      ql_read_req.set_proxy_uuid(mutable_req->proxy_uuid());
       auto se = ScopeExit([&ql_read_req] {
-        ql_read_req.release_remote_endpoint();
-        ql_read_req.release_proxy_uuid();
+        ql_read_req.clear_remote_endpoint();
+        ql_read_req.clear_proxy_uuid();
       });
 
       tablet::QLReadRequestResult result;
@@ -2412,7 +2460,7 @@ Result<ReadHybridTime> TabletServiceImpl::DoReadImpl(ReadContext* read_context)
         return read_context->FormRestartReadHybridTime(result.restart_read_ht);
       }
       result.response.set_rows_data_sidecar(read_context->context.AddRpcSidecar(result.rows_data));
-      read_context->resp->add_ql_batch()->Swap(&result.response);
+      MoveToRepeatedField(&result.response, read_context->resp->mutable_ql_batch());
     }
     return ReadHybridTime();
   }
@@ -2437,7 +2485,7 @@ Result<ReadHybridTime> TabletServiceImpl::DoReadImpl(ReadContext* read_context)
         return read_context->FormRestartReadHybridTime(result.restart_read_ht);
       }
       result.response.set_rows_data_sidecar(read_context->context.AddRpcSidecar(result.rows_data));
-      read_context->resp->add_pgsql_batch()->Swap(&result.response);
+      MoveToRepeatedField(&result.response, read_context->resp->mutable_pgsql_batch());
     }
 
     if (read_context->req->consistency_level() == YBConsistencyLevel::CONSISTENT_PREFIX &&
@@ -2458,7 +2506,9 @@ Result<ReadHybridTime> TabletServiceImpl::DoReadImpl(ReadContext* read_context)
 ConsensusServiceImpl::ConsensusServiceImpl(const scoped_refptr<MetricEntity>& metric_entity,
                                            TabletPeerLookupIf* tablet_manager)
     : ConsensusServiceIf(metric_entity),
-      tablet_manager_(tablet_manager) {
+      tablet_manager_(tablet_manager),
+      multi_raft_consensus_requests_(
+          METRIC_multi_raft_consensus_requests.Instantiate(metric_entity)) {
 }
 
 ConsensusServiceImpl::~ConsensusServiceImpl() {
@@ -2473,17 +2523,8 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
   }
   auto peer_tablet = VERIFY_RESULT_OR_RETURN(LookupTabletPeerOrRespond(
       tablet_manager_, req->tablet_id(), resp, &context));
-  auto tablet_peer = peer_tablet.tablet_peer;
-
-  // Submit the update directly to the TabletPeer's Consensus instance.
-  shared_ptr<Consensus> consensus;
-  if (!GetConsensusOrRespond(tablet_peer, resp, &context, &consensus)) return;
 
-  // Unfortunately, we have to use const_cast here, because the protobuf-generated interface only
-  // gives us a const request, but we need to be able to move messages out of the request for
-  // efficiency.
-  Status s = consensus->Update(
-      const_cast<ConsensusRequestPB*>(req), resp, context.GetClientDeadline());
+  Status s = DoUpdateConsensus(peer_tablet.tablet_peer, req, resp, context.GetClientDeadline());
   if (PREDICT_FALSE(!s.ok())) {
     // Clear the response first, since a partially-filled response could
     // result in confusing a caller, or in having missing required fields
@@ -2494,13 +2535,128 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
     return;
   }
 
+  context.RespondSuccess();
+}
+
+namespace {
+
+// Applies single request of MultiRaftUpdateConsensus in the service thread pool of its tablet.
+class MultiRaftUpdateTask : public rpc::ThreadPoolTask {
+ public:
+  explicit MultiRaftUpdateTask(std::function<void(const Status&)> update)
+      : update_(std::move(update)) {}
+
+  void Run() override {
+    update_(Status::OK());
+    update_ = nullptr;
+  }
+
+  void Done(const Status& status) override {
+    // Task was not run, so its request is completed with failure.
+    if (update_) {
+      update_(status);
+    }
+    delete this;
+  }
+
+ private:
+  std::function<void(const Status&)> update_;
+};
+
+} // namespace
+
+void ConsensusServiceImpl::MultiRaftUpdateConsensus(
+    const consensus::MultiRaftConsensusRequestPB* req,
+    consensus::MultiRaftConsensusResponsePB* resp,
+    rpc::RpcContext context) {
+  DVLOG(3) << "Received Multi Raft Consensus Update RPC with "
+           << req->consensus_request().size() << " requests";
+  const auto num_requests = req->consensus_request().size();
+  multi_raft_consensus_requests_->IncrementBy(num_requests);
+  if (num_requests == 0) {
+    context.RespondSuccess();
+    return;
+  }
+
+  // All responses are added before dispatching, so requests could fill them concurrently.
+  for (int i = 0; i != num_requests; ++i) {
+    resp->add_consensus_response();
+  }
+
+  const auto deadline = context.GetClientDeadline();
+  auto shared_context = std::make_shared<rpc::RpcContext>(std::move(context));
+  auto num_pending = std::make_shared<std::atomic<int>>(num_requests);
+  const auto& local_uuid = tablet_manager_->NodeInstance().permanent_uuid();
+
+  // Failure of a single tablet should not fail the whole batch, so error is reported in
+  // response of this tablet only. RPC is responded after the last request is completed.
+  auto complete = [resp, shared_context, num_pending](int idx, const Status& status) {
+    if (PREDICT_FALSE(!status.ok())) {
+      auto* consensus_resp = resp->mutable_consensus_response(idx);
+      consensus_resp->Clear();
+      SetupError(consensus_resp->mutable_error(), status);
+    }
+    if (num_pending->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      shared_context->RespondSuccess();
+    }
+  };
+
+  // Tablets are updated in parallel, so slow tablet does not delay heartbeats of others.
+  // The first request is applied in the current thread.
+  TabletPeerPtr first_tablet_peer;
+  for (int i = num_requests; i-- > 0;) {
+    const auto& consensus_req = req->consensus_request(i);
+    if (PREDICT_FALSE(!consensus_req.dest_uuid().empty() &&
+                      consensus_req.dest_uuid() != local_uuid)) {
+      complete(i, STATUS_FORMAT(
+          InvalidArgument, "Wrong destination UUID requested. Local UUID: $0. Requested UUID: $1",
+          local_uuid, consensus_req.dest_uuid()).CloneAndAddErrorCode(
+              TabletServerError(TabletServerErrorPB::WRONG_SERVER_UUID)));
+      continue;
+    }
+    auto peer_tablet = LookupTabletPeer(tablet_manager_, consensus_req.tablet_id());
+    if (PREDICT_FALSE(!peer_tablet.ok())) {
+      complete(i, peer_tablet.status());
+      continue;
+    }
+    auto update = [this, req, resp, deadline, complete, i,
+                   tablet_peer = peer_tablet->tablet_peer](const Status& status) {
+      complete(i, status.ok()
+          ? DoUpdateConsensus(tablet_peer, &req->consensus_request(i),
+                              resp->mutable_consensus_response(i), deadline)
+          : status);
+    };
+    if (i == 0) {
+      update(Status::OK());
+    } else {
+      peer_tablet->tablet_peer->Enqueue(new MultiRaftUpdateTask(std::move(update)));
+    }
+  }
+}
+
+Status ConsensusServiceImpl::DoUpdateConsensus(const TabletPeerPtr& tablet_peer,
+                                               const ConsensusRequestPB* req,
+                                               ConsensusResponsePB* resp,
+                                               CoarseTimePoint deadline) {
+  // Submit the update directly to the TabletPeer's Consensus instance.
+  auto consensus = tablet_peer->shared_raft_consensus();
+  if (!consensus) {
+    return STATUS(ServiceUnavailable, "Consensus unavailable. Tablet not running")
+        .CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::TABLET_NOT_RUNNING));
+  }
+
+  // Unfortunately, we have to use const_cast here, because the protobuf-generated interface only
+  // gives us a const request, but we need to be able to move messages out of the request for
+  // efficiency.
+  RETURN_NOT_OK(consensus->Update(const_cast<ConsensusRequestPB*>(req), resp, deadline));
+
   auto tablet = tablet_peer->shared_tablet();
   if (tablet) {
     resp->set_num_sst_files(tablet->GetCurrentVersionNumSSTFiles());
   }
 
   resp->set_propagated_hybrid_time(tablet_peer->clock().Now().ToUint64());
-  context.RespondSuccess();
+  return Status::OK();
 }
 
 void ConsensusServiceImpl::RequestConsensusVote(const VoteRequestPB* req,
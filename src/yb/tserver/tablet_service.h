@@ -167,19 +167,23 @@ class TabletServiceImpl : public TabletServerServiceIf {
   // etc.
   // allow_split_tablet specifies whether to reject requests to tablets which have been already
   // split.
+  // If the request is served by a follower and follower_safe_time is not null, it is set to the
+  // follower safe time that was used for the bounded staleness check.
   template <class Req, class Resp>
   bool DoGetTabletOrRespond(
       const Req* req, Resp* resp, rpc::RpcContext* context,
       std::shared_ptr<tablet::AbstractTablet>* tablet,
       tablet::TabletPeerPtr tablet_peer = nullptr,
-      AllowSplitTablet allow_split_tablet = AllowSplitTablet::kFalse);
+      AllowSplitTablet allow_split_tablet = AllowSplitTablet::kFalse,
+      HybridTime* follower_safe_time = nullptr);
 
   virtual WARN_UNUSED_RESULT bool GetTabletOrRespond(
       const ReadRequestPB* req,
       ReadResponsePB* resp,
       rpc::RpcContext* context,
       std::shared_ptr<tablet::AbstractTablet>* tablet,
-      tablet::TabletPeerPtr tablet_peer = nullptr);
+      tablet::TabletPeerPtr tablet_peer = nullptr,
+      HybridTime* follower_safe_time = nullptr);
 
   template<class Resp>
   bool CheckWriteThrottlingOrRespond(
@@ -290,6 +294,10 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                consensus::ConsensusResponsePB *resp,
                                rpc::RpcContext context) override;
 
+  void MultiRaftUpdateConsensus(const consensus::MultiRaftConsensusRequestPB *req,
+                                consensus::MultiRaftConsensusResponsePB *resp,
+                                rpc::RpcContext context) override;
+
   virtual void RequestConsensusVote(const consensus::VoteRequestPB* req,
                                     consensus::VoteResponsePB* resp,
                                     rpc::RpcContext context) override;
@@ -327,7 +335,18 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                     rpc::RpcContext context) override;
 
  private:
+  // Applies update to consensus of the specified tablet and fills response on success, used by
+  // both UpdateConsensus and MultiRaftUpdateConsensus. Errors are returned with corresponding
+  // TabletServerError attached, instead of responding to the RPC.
+  CHECKED_STATUS DoUpdateConsensus(const tablet::TabletPeerPtr& tablet_peer,
+                                   const consensus::ConsensusRequestPB* req,
+                                   consensus::ConsensusResponsePB* resp,
+                                   CoarseTimePoint deadline);
+
   TabletPeerLookupIf* tablet_manager_;
+
+  // Number of consensus requests received through MultiRaftUpdateConsensus.
+  scoped_refptr<Counter> multi_raft_consensus_requests_;
 };
 
 class TabletServerForwardServiceImpl : public TabletServerForwardServiceIf {
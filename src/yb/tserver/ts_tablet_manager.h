@@ -580,6 +580,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   std::unordered_set<std::string> bootstrap_source_addresses_;
 
+  // Coalesces heartbeats of tablet peers hosted by this server.
+  std::unique_ptr<consensus::MultiRaftManager> multi_raft_manager_;
+
   std::atomic<int32_t> num_tablets_being_remote_bootstrapped_{0};
 
   mutable simple_spinlock snapshot_schedule_allowed_history_cutoff_mutex_;
@@ -71,11 +71,50 @@ METRIC_DEFINE_gauge_uint64(server, block_cache_multi_touch_usage,
                            "Multi Cache Block Cache Memory Usage",
                            yb::MetricUnit::kBytes,
                            "Memory consumed by the multi cache block cache");
+
+METRIC_DEFINE_counter(server, metadata_block_cache_inserts,
+                      "Metadata Block Cache Inserts", yb::MetricUnit::kBlocks,
+                      "Number of index and filter blocks inserted in the metadata cache");
+METRIC_DEFINE_counter(server, metadata_block_cache_lookups,
+                      "Metadata Block Cache Lookups", yb::MetricUnit::kBlocks,
+                      "Number of index and filter blocks looked up from the metadata cache");
+METRIC_DEFINE_counter(server, metadata_block_cache_evictions,
+                      "Metadata Block Cache Evictions", yb::MetricUnit::kBlocks,
+                      "Number of index and filter blocks evicted from the metadata cache");
+METRIC_DEFINE_counter(server, metadata_block_cache_misses,
+                      "Metadata Block Cache Misses", yb::MetricUnit::kBlocks,
+                      "Number of metadata cache lookups that didn't yield a block");
+METRIC_DEFINE_counter(server, metadata_block_cache_misses_caching,
+                      "Metadata Block Cache Misses (Caching)", yb::MetricUnit::kBlocks,
+                      "Number of metadata cache lookups that were expecting a block that didn't "
+                      "yield one");
+METRIC_DEFINE_counter(server, metadata_block_cache_hits,
+                      "Metadata Block Cache Hits", yb::MetricUnit::kBlocks,
+                      "Number of metadata cache lookups that found a block");
+METRIC_DEFINE_counter(server, metadata_block_cache_hits_caching,
+                      "Metadata Block Cache Hits (Caching)", yb::MetricUnit::kBlocks,
+                      "Number of metadata cache lookups that were expecting a block that found "
+                      "one");
+
+METRIC_DEFINE_gauge_uint64(server, metadata_block_cache_usage, "Metadata Block Cache Memory Usage",
+                           yb::MetricUnit::kBytes,
+                           "Memory consumed by the metadata block cache");
+METRIC_DEFINE_gauge_uint64(server, metadata_block_cache_single_touch_usage,
+                           "Single Touch Metadata Block Cache Memory Usage",
+                           yb::MetricUnit::kBytes,
+                           "Memory consumed by the single touch metadata block cache");
+METRIC_DEFINE_gauge_uint64(server, metadata_block_cache_multi_touch_usage,
+                           "Multi Cache Metadata Block Cache Memory Usage",
+                           yb::MetricUnit::kBytes,
+                           "Memory consumed by the multi cache metadata block cache");
+
 namespace yb {
 
-#define MINIT(member, x) member(METRIC_##x.Instantiate(entity))
-#define GINIT(member, x) member(METRIC_##x.Instantiate(entity, 0))
-CacheMetrics::CacheMetrics(const scoped_refptr<MetricEntity>& entity)
+#define METRIC_PROTOTYPE(x) \
+    (kind == CacheMetricsKind::kMetadataBlockCache ? METRIC_metadata_##x : METRIC_##x)
+#define MINIT(member, x) member(METRIC_PROTOTYPE(x).Instantiate(entity))
+#define GINIT(member, x) member(METRIC_PROTOTYPE(x).Instantiate(entity, 0))
+CacheMetrics::CacheMetrics(const scoped_refptr<MetricEntity>& entity, CacheMetricsKind kind)
   : MINIT(inserts, block_cache_inserts),
     MINIT(lookups, block_cache_lookups),
     MINIT(evictions, block_cache_evictions),
@@ -89,5 +128,6 @@ CacheMetrics::CacheMetrics(const scoped_refptr<MetricEntity>& entity)
 }
 #undef MINIT
 #undef GINIT
+#undef METRIC_PROTOTYPE
 
 } // namespace yb
@@ -44,8 +44,18 @@ class AtomicGauge;
 class Counter;
 class MetricEntity;
 
+// Determines set of metrics used by the cache, so several caches could report metrics to the same
+// metric entity.
+enum class CacheMetricsKind {
+  // Block cache for data blocks, or for all blocks if metadata block cache is not used.
+  kBlockCache,
+  // Block cache for index and filter blocks.
+  kMetadataBlockCache,
+};
+
 struct CacheMetrics {
-  explicit CacheMetrics(const scoped_refptr<MetricEntity>& metric_entity);
+  explicit CacheMetrics(const scoped_refptr<MetricEntity>& metric_entity,
+                        CacheMetricsKind kind = CacheMetricsKind::kBlockCache);
 
   scoped_refptr<Counter> inserts;
   scoped_refptr<Counter> lookups;
@@ -53,6 +53,7 @@
 namespace yb {
 namespace pb_util {
 
+using google::protobuf::FileDescriptorProto;
 using google::protobuf::FileDescriptorSet;
 using internal::WritableFileOutputStream;
 using std::ostringstream;
@@ -480,5 +481,61 @@ TEST_F(TestPBUtil, TestPBRequiredToRepeated) {
   ASSERT_OK(env_->DeleteFile(path_));
 }
 
+namespace {
+
+void FillFileDescriptor(int num_messages, FileDescriptorProto* file) {
+  file->set_name("test.proto");
+  for (int i = 0; i != num_messages; ++i) {
+    auto* message = file->add_message_type();
+    message->set_name(Format("Message$0", i));
+    for (int j = 0; j != 10; ++j) {
+      auto* field = message->add_field();
+      field->set_name(Format("field_$0", j));
+      field->set_number(j + 1);
+    }
+  }
+}
+
+} // namespace
+
+// Moving a heap allocated message to a repeated field from an arena should not copy it, while Swap
+// copies the whole message into the arena.
+TEST_F(TestPBUtil, MoveToRepeatedFieldInArena) {
+  constexpr int kNumMessages = 20;
+  constexpr int kIterations = 1000;
+
+  google::protobuf::Arena swap_arena;
+  auto* swap_set = google::protobuf::Arena::CreateMessage<FileDescriptorSet>(&swap_arena);
+  google::protobuf::Arena move_arena;
+  auto* move_set = google::protobuf::Arena::CreateMessage<FileDescriptorSet>(&move_arena);
+
+  MonoDelta swap_time = MonoDelta::kZero;
+  MonoDelta move_time = MonoDelta::kZero;
+  for (int i = 0; i != kIterations; ++i) {
+    FileDescriptorProto file;
+    FillFileDescriptor(kNumMessages, &file);
+    auto start = MonoTime::Now();
+    swap_set->add_file()->Swap(&file);
+    swap_time += MonoTime::Now() - start;
+    ASSERT_EQ(file.message_type_size(), 0);
+
+    FillFileDescriptor(kNumMessages, &file);
+    const auto* first_message = &file.message_type(0);
+    start = MonoTime::Now();
+    MoveToRepeatedField(&file, move_set->mutable_file());
+    move_time += MonoTime::Now() - start;
+    ASSERT_EQ(&move_set->file(i).message_type(0), first_message);
+    ASSERT_EQ(file.message_type_size(), 0);
+  }
+
+  ASSERT_EQ(move_set->file_size(), kIterations);
+  std::string diff;
+  ASSERT_TRUE(ArePBsEqual(*swap_set, *move_set, &diff)) << diff;
+  LOG(INFO) << "Swap: " << swap_time << ", arena bytes: " << swap_arena.SpaceUsed()
+            << "; move: " << move_time << ", arena bytes: " << move_arena.SpaceUsed();
+  // Moved messages are only registered for destruction in the arena.
+  ASSERT_LT(move_arena.SpaceUsed() * 10, swap_arena.SpaceUsed());
+}
+
 } // namespace pb_util
 } // namespace yb
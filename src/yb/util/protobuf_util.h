@@ -35,7 +35,9 @@
 #ifndef YB_UTIL_PROTOBUF_UTIL_H
 #define YB_UTIL_PROTOBUF_UTIL_H
 
+#include <google/protobuf/arena.h>
 #include <google/protobuf/message_lite.h>
+#include <google/protobuf/repeated_field.h>
 
 #include "yb/util/enums.h"
 #include "yb/util/format.h"
@@ -55,6 +57,22 @@ inline bool AppendPBToString(const google::protobuf::MessageLite &msg, faststrin
   return true;
 }
 
+// Moves message to the end of repeated field, leaving the source message empty.
+// Swap between messages from different arenas copies the whole message. So when only the repeated
+// field belongs to an arena, the message is moved to the heap, and the arena takes ownership of it.
+template <class T>
+void MoveToRepeatedField(T* message, google::protobuf::RepeatedPtrField<T>* field) {
+  auto* arena = field->GetArena();
+  if (!arena || message->GetArena()) {
+    field->Add()->Swap(message);
+    return;
+  }
+  auto* moved = new T;
+  moved->Swap(message);
+  arena->Own(moved);
+  field->UnsafeArenaAddAllocated(moved);
+}
+
 } // namespace yb
 
 #define PB_ENUM_FORMATTERS(EnumType) \